@@ -10,7 +10,10 @@
 #ifndef PHASAR_CONTROLLER_ANALYSIS_CONTROLLER_H_
 #define PHASAR_CONTROLLER_ANALYSIS_CONTROLLER_H_
 
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -50,9 +53,20 @@ enum class AnalysisControllerEmitterOptions : uint32_t {
 class AnalysisController {
 private:
   ProjectIRDB &IRDB;
-  LLVMTypeHierarchy TH;
-  LLVMPointsToSet PT;
-  LLVMBasedICFG ICF;
+  // the number of threads that solve whole-program analyses, or the modules
+  // or shards of an analysis, concurrently (--analysis-threads), which
+  // determines how the points-to information is computed
+  unsigned NumAnalysisThreads;
+  // whether whole-program IFDS analyses are solved by NativeIFDSSolver
+  // instead of IFDSSolver, which has to be requested explicitly as it ignores
+  // most of the solver configuration
+  bool UseNativeIFDSSolver;
+  // the whole-program helper analyses, which are not built for module-wise
+  // analyses unless their results are to be emitted, as each module is
+  // analyzed using helper analyses of its own
+  std::unique_ptr<LLVMTypeHierarchy> TH;
+  std::unique_ptr<LLVMPointsToSet> PT;
+  std::unique_ptr<LLVMBasedICFG> ICF;
   std::vector<DataFlowAnalysisKind> DataFlowAnalyses;
   std::vector<std::string> AnalysisConfigs;
   std::set<std::string> EntryPoints;
@@ -63,6 +77,10 @@ private:
   std::string OutDirectory;
   boost::filesystem::path ResultDirectory;
   [[maybe_unused]] Soundness S;
+  // the index of the analysis whose results are emitted next
+  size_t NextToEmit = 0;
+  std::mutex EmitMutex;
+  std::condition_variable EmitTurn;
 
   ///
   /// \brief The maximum length of the CallStrings used in the InterMonoSolver
@@ -75,10 +93,29 @@ private:
 
   void executeModuleWise();
 
+  void executeSharded();
+
   void executeVariational();
 
   void executeWholeProgram();
 
+  /// Solves the whole-program analysis DataFlowAnalyses[Idx] and emits its
+  /// results once the ones of all preceding analyses have been emitted.
+  void executeWholeProgramAnalysis(size_t Idx);
+
+  /// Solves the whole-program IFDS analysis DataFlowAnalyses[Idx] of type
+  /// ProblemTy, whose problem takes Args before the entry points, and emits
+  /// its results in turn.
+  template <typename ProblemTy, typename... ArgTys>
+  void executeWholeProgramIFDSAnalysis(size_t Idx, const ArgTys &...Args);
+
+  /// Blocks until the results of the analyses preceding DataFlowAnalyses[Idx]
+  /// have been emitted.
+  void waitForTurn(size_t Idx);
+
+  /// Lets the analyses succeeding DataFlowAnalyses[Idx] emit their results.
+  void passTurn(size_t Idx);
+
   void emitRequestedHelperAnalysisResults();
 
   template <typename T> void emitRequestedDataFlowResults(T &WPA) {
@@ -112,6 +149,29 @@ private:
     }
   }
 
+  template <typename T>
+  void emitRequestedDataFlowResultsInTurn(size_t Idx, T &WPA) {
+    waitForTurn(Idx);
+    emitRequestedDataFlowResults(WPA);
+    passTurn(Idx);
+  }
+
+  /// Answers the given queries using a DemandDrivenAnalysis.
+  template <typename T>
+  void emitDemandQueryResults(
+      T &DDA, const std::vector<const llvm::Instruction *> &Queries) {
+    if (!ResultDirectory.empty()) {
+      std::ofstream OFS(ResultDirectory.string() + "/psr-demand-results.txt");
+      for (const auto *Query : Queries) {
+        DDA.printResultsAt(Query, OFS);
+      }
+    } else {
+      for (const auto *Query : Queries) {
+        DDA.printResultsAt(Query, std::cout);
+      }
+    }
+  }
+
 public:
   AnalysisController(ProjectIRDB &IRDB,
                      std::vector<DataFlowAnalysisKind> DataFlowAnalyses,
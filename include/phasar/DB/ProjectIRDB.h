@@ -101,6 +101,13 @@ public:
   // get a completely linked module for the WPA_MODE
   llvm::Module *getWPAModule();
 
+  /// Returns a ProjectIRDB that contains only the given module of this
+  /// ProjectIRDB and that does not own it, e.g., to analyze the modules of a
+  /// project that has not been linked one by one. The module is not
+  /// preprocessed again.
+  [[nodiscard]] std::unique_ptr<ProjectIRDB>
+  getModuleIRDB(llvm::Module *M) const;
+
   [[nodiscard]] inline bool containsSourceFile(const std::string &File) const {
     return Modules.find(File) != Modules.end();
   };
@@ -169,6 +176,7 @@ public:
   };
 
   [[nodiscard]] llvm::Instruction *getInstruction(std::size_t id);
+  [[nodiscard]] const llvm::Instruction *getInstruction(std::size_t id) const;
 
   [[nodiscard]] static std::size_t getInstructionID(const llvm::Instruction *I);
 
@@ -10,9 +10,281 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_DEMANDDRIVENANALYSIS_H_
 
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+
 namespace psr {
 
-class DemandDrivenAnalysis {};
+/// Answers queries for the data-flow facts that hold at individual nodes
+/// instead of solving the problem for the whole program.
+///
+/// A query for a node n restricts the IFDS/IDE solver to the part of the
+/// interprocedural control-flow graph that may reach n: the nodes from which
+/// n can be reached within their functions and along returns to their
+/// callers, as well as the complete bodies of the functions that are called
+/// along the way and of their transitive callees. Only the exploded
+/// super-graph of this part is constructed, and the values are computed at n
+/// only. The solver is kept across queries, such that a later query only
+/// explores the part that is relevant to it and has not been explored for an
+/// earlier one, and the results at queried nodes are cached.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class DemandDrivenAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+  using l_t = typename Solver::l_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  ProblemDescription ProblemDesc;
+  Solver DataFlowSolver;
+
+  // the nodes that may reach a queried node within their functions or along
+  // returns, and the functions that are relevant as a whole
+  std::unordered_set<n_t> RelevantNodes;
+  std::unordered_set<f_t> RelevantFunctions;
+  // the results at the queried nodes
+  std::unordered_map<n_t, std::unordered_map<d_t, l_t>> Results;
+
+  bool isRelevant(n_t n) const {
+    return RelevantNodes.count(n) ||
+           RelevantFunctions.count(ProblemDesc.getICFG()->getFunctionOf(n));
+  }
+
+  /// Adds the part of the ICFG that may reach n to the relevant part.
+  void explore(n_t n) {
+    const auto *ICF = ProblemDesc.getICFG();
+    std::vector<n_t> NodeWL = {n};
+    std::vector<f_t> FunctionWL;
+    auto AddCallees = [&](n_t CallSite) {
+      for (f_t Callee : ICF->getCalleesOfCallAt(CallSite)) {
+        if (RelevantFunctions.insert(Callee).second) {
+          FunctionWL.push_back(Callee);
+        }
+      }
+    };
+    RelevantNodes.insert(n);
+    while (!NodeWL.empty()) {
+      n_t Curr = NodeWL.back();
+      NodeWL.pop_back();
+      if (ICF->isStartPoint(Curr)) {
+        // ascend to the callers without descending into their other callees
+        for (n_t CallSite : ICF->getCallersOf(ICF->getFunctionOf(Curr))) {
+          if (RelevantNodes.insert(CallSite).second) {
+            NodeWL.push_back(CallSite);
+          }
+        }
+      }
+      for (n_t Pred : ICF->getPredsOf(Curr)) {
+        if (ICF->isCallSite(Pred)) {
+          // the callees' effects reach Curr along their returns
+          AddCallees(Pred);
+        }
+        if (RelevantNodes.insert(Pred).second) {
+          NodeWL.push_back(Pred);
+        }
+      }
+    }
+    while (!FunctionWL.empty()) {
+      f_t Fun = FunctionWL.back();
+      FunctionWL.pop_back();
+      for (n_t CallSite : ICF->getCallsFromWithin(Fun)) {
+        AddCallees(CallSite);
+      }
+    }
+  }
+
+public:
+  DemandDrivenAnalysis(ProjectIRDB &IRDB,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), EntryPoints),
+        DataFlowSolver(ProblemDesc) {
+    DataFlowSolver.setNodeFilter([this](n_t n) { return isRelevant(n); });
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *Config, EntryPoints),
+        DataFlowSolver(ProblemDesc) {
+    DataFlowSolver.setNodeFilter([this](n_t n) { return isRelevant(n); });
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  DemandDrivenAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                       std::set<std::string> EntryPoints = {},
+                       PointerAnalysisTy *PointerInfo = nullptr,
+                       CallGraphAnalysisTy *CallGraph = nullptr,
+                       TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *this->Config, EntryPoints),
+        DataFlowSolver(ProblemDesc) {
+    DataFlowSolver.setNodeFilter([this](n_t n) { return isRelevant(n); });
+  }
+
+  // the solver's node filter refers to this analysis
+  DemandDrivenAnalysis(const DemandDrivenAnalysis &) = delete;
+  DemandDrivenAnalysis &operator=(const DemandDrivenAnalysis &) = delete;
+
+  /// Returns the data-flow facts that hold at n, except for the zero value,
+  /// and their values.
+  const std::unordered_map<d_t, l_t> &resultsAt(n_t n) {
+    if (auto Search = Results.find(n); Search != Results.end()) {
+      return Search->second;
+    }
+    // the relevant nodes are closed under exploration, such that n's part of
+    // the exploded super-graph is complete if it has been explored before
+    if (!RelevantNodes.count(n)) {
+      explore(n);
+    }
+    DataFlowSolver.tabulate();
+    DataFlowSolver.computeValuesAt({n});
+    return Results[n] = DataFlowSolver.resultsAt(n, /* stripZero */ true);
+  }
+
+  /// Returns true if d holds at n.
+  bool holds(n_t n, d_t d) { return resultsAt(n).count(d); }
+
+  /// Returns the value of d at n, or std::nullopt if d does not hold at n.
+  std::optional<l_t> resultAt(n_t n, d_t d) {
+    const auto &Res = resultsAt(n);
+    if (auto Search = Res.find(d); Search != Res.end()) {
+      return Search->second;
+    }
+    return std::nullopt;
+  }
+
+  /// Returns the number of nodes that are relevant to the queries so far,
+  /// not counting the nodes of the functions that are relevant as a whole.
+  [[nodiscard]] size_t getNumRelevantNodes() const {
+    return RelevantNodes.size();
+  }
+
+  /// Returns the number of functions that are relevant as a whole to the
+  /// queries so far.
+  [[nodiscard]] size_t getNumRelevantFunctions() const {
+    return RelevantFunctions.size();
+  }
+
+  /// Prints the results of the query for n.
+  void printResultsAt(n_t n, std::ostream &OS = std::cout) {
+    OS << "Query: ";
+    ProblemDesc.printNode(OS, n);
+    OS << '\n';
+    for (const auto &[Fact, Value] : resultsAt(n)) {
+      OS << "\tD: ";
+      ProblemDesc.printDataFlowFact(OS, Fact);
+      if constexpr (!std::is_same_v<l_t, BinaryDomain>) {
+        OS << " | V: ";
+        ProblemDesc.printEdgeFact(OS, Value);
+      }
+      OS << '\n';
+    }
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
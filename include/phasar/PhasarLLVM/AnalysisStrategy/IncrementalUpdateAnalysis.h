@@ -10,9 +10,290 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_INCREMENTALUPDATEANALYSIS_H_
 
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "llvm/IR/Function.h"
+#include "llvm/Support/FileSystem.h"
+
+#include "nlohmann/json.hpp"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+
 namespace psr {
 
-class IncrementalUpdateAnalysis {};
+/// Re-analyzes a program after changes to its IR, re-using the results of a
+/// previous run wherever the changes cannot affect them.
+///
+/// The state of the previous run is kept in a directory: the content hash of
+/// each function and the end summaries and jump functions that the IFDS/IDE
+/// solver has persisted, see IFDSIDESolverConfig::setPersistJumpFunctions().
+/// The persisted summaries are keyed by the contents of their function, of
+/// the functions that it may call transitively and of the functions that are
+/// coupled to these through global variables. A change thus invalidates the
+/// summaries and jump functions of the changed functions, of their transitive
+/// callers and of the functions whose call-graph edges or points-to sets it
+/// may affect. Only these functions are re-tabulated, the exploded
+/// super-graph of all others is restored, such that the results match those
+/// of a run from scratch. The type hierarchy, points-to information and call
+/// graph are recomputed for the new IR.
+///
+/// Problems without an analysis ID, see
+/// IFDSTabulationProblem::getSummaryAnalysisID(), are solved from scratch.
+/// Findings that a problem records as a side effect of its flow functions
+/// are recorded for the restored functions as well, as the solver applies
+/// the flow functions along their restored jump functions once more.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class IncrementalUpdateAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  std::string StateDirectory;
+  ProblemDescription ProblemDesc;
+  Solver DataFlowSolver;
+
+  // the content hashes of the functions by their names
+  std::map<std::string, std::string> PreviousHashes;
+  std::map<std::string, std::string> CurrentHashes;
+
+  /// Lets the solver persist its summaries and jump functions in the state
+  /// directory and apply those of the previous run; must precede the
+  /// construction of the solver.
+  static ProblemDescription &configure(ProblemDescription &Problem,
+                                       const std::string &StateDirectory) {
+    auto &SolverConfig = Problem.getIFDSIDESolverConfig();
+    SolverConfig.setComputePersistedSummaries();
+    SolverConfig.setPersistJumpFunctions();
+    SolverConfig.setSummaryStore(StateDirectory + "/summaries");
+    return Problem;
+  }
+
+  [[nodiscard]] std::string getFunctionsPath() const {
+    return StateDirectory + "/functions.json";
+  }
+
+  void loadHashes() {
+    for (const auto *F : IRDB.getAllFunctions()) {
+      if (!F->isDeclaration()) {
+        CurrentHashes[F->getName().str()] = getFunctionContentHash(F);
+      }
+    }
+    std::ifstream IFS(getFunctionsPath());
+    if (!IFS) {
+      // the first run
+      return;
+    }
+    try {
+      nlohmann::json J;
+      IFS >> J;
+      PreviousHashes = J.at("Functions").get<decltype(PreviousHashes)>();
+    } catch (const nlohmann::json::exception &E) {
+      // re-analyze everything
+      PreviousHashes.clear();
+      std::cerr << "Discarding the state of the previous run: " << E.what()
+                << '\n';
+    }
+  }
+
+  void storeHashes() const {
+    if (llvm::sys::fs::create_directories(StateDirectory)) {
+      std::cerr << "Could not create directory: " << StateDirectory << '\n';
+      return;
+    }
+    nlohmann::json J;
+    J["Functions"] = CurrentHashes;
+    std::ofstream OFS(getFunctionsPath());
+    OFS << J.dump(2) << '\n';
+  }
+
+public:
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, std::string StateDirectory,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints), StateDirectory(std::move(StateDirectory)),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), EntryPoints),
+        DataFlowSolver(configure(ProblemDesc, this->StateDirectory)) {
+    loadHashes();
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, std::string StateDirectory,
+                            ConfigurationTy *Config,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath(""),
+        StateDirectory(std::move(StateDirectory)),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *Config, EntryPoints),
+        DataFlowSolver(configure(ProblemDesc, this->StateDirectory)) {
+    loadHashes();
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  IncrementalUpdateAnalysis(ProjectIRDB &IRDB, std::string StateDirectory,
+                            std::string ConfigPath,
+                            std::set<std::string> EntryPoints = {},
+                            PointerAnalysisTy *PointerInfo = nullptr,
+                            CallGraphAnalysisTy *CallGraph = nullptr,
+                            TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(EntryPoints),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath), StateDirectory(std::move(StateDirectory)),
+        ProblemDesc(&IRDB, this->TypeHierarchy.get(), this->CallGraph.get(),
+                    this->PointerInfo.get(), *this->Config, EntryPoints),
+        DataFlowSolver(configure(ProblemDesc, this->StateDirectory)) {
+    loadHashes();
+  }
+
+  /// Solves the problem, re-using the results of the previous run, and
+  /// records the state of this run in the state directory.
+  void solve() {
+    DataFlowSolver.solve();
+    storeHashes();
+  }
+
+  void operator()() { solve(); }
+
+  /// Returns true if there is no state of a previous run to re-use.
+  [[nodiscard]] bool isInitialRun() const { return PreviousHashes.empty(); }
+
+  /// Returns the names of the functions that have been added or whose
+  /// contents have changed since the previous run.
+  [[nodiscard]] std::set<std::string> getChangedFunctions() const {
+    std::set<std::string> Changed;
+    for (const auto &[Name, Hash] : CurrentHashes) {
+      auto Search = PreviousHashes.find(Name);
+      if (Search == PreviousHashes.end() || Search->second != Hash) {
+        Changed.insert(Name);
+      }
+    }
+    return Changed;
+  }
+
+  /// Returns the names of the functions that have been removed since the
+  /// previous run.
+  [[nodiscard]] std::set<std::string> getRemovedFunctions() const {
+    std::set<std::string> Removed;
+    for (const auto &Entry : PreviousHashes) {
+      if (!CurrentHashes.count(Entry.first)) {
+        Removed.insert(Entry.first);
+      }
+    }
+    return Removed;
+  }
+
+  auto resultsAt(n_t n, bool StripZero = false) {
+    return DataFlowSolver.resultsAt(n, StripZero);
+  }
+
+  [[nodiscard]] const ProblemDescription &getProblem() const {
+    return ProblemDesc;
+  }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    DataFlowSolver.dumpResults(OS);
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    DataFlowSolver.emitTextReport(OS);
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    DataFlowSolver.emitGraphicalReport(OS);
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
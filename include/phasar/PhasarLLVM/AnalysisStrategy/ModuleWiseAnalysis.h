@@ -10,9 +10,523 @@
 #ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 #define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_MODULEWISEANALYSIS_H_
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Value.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryPool.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSummaryGenerator.h"
+#include "phasar/PhasarLLVM/Utils/SummaryStrategy.h"
+#include "phasar/Utils/Concurrency.h"
+
 namespace psr {
 
-class ModuleWiseAnalysis {};
+/// Analyzes the modules of a program one by one instead of linking them into
+/// a single module, such that only the IR of a single module and its helper
+/// analyses have to be processed at once. The ProjectIRDB must not have been
+/// linked, i.e., it must be constructed without IRDBOptions::WPA.
+///
+/// Module M depends on module N if M calls a function that N defines. The
+/// analysis works in two passes over this module dependency graph, each of
+/// which analyzes independent modules in parallel:
+///
+///  1. Bottom-up, the functions that a module exports to other modules are
+///     summarized, see IFDSSummaryGenerator. The calls of functions that
+///     other modules define are open within a module and are analyzed with
+///     the summaries of the modules that it depends on, see
+///     IFDSIDESolverConfig::setLibrarySummaries().
+///  2. Top-down, each module is solved with the summaries of all modules. A
+///     module is seeded with the problem's initial seeds if it defines an
+///     entry point, and with the facts that the solved modules pass to its
+///     functions at their call sites, such that the results within a
+///     function include the flows from other modules.
+///
+/// Composition is restricted to IFDS problems on LLVM IR, as it is based on
+/// IFDSSummaryPool. The modules within cycles of the module dependency graph
+/// are summarized and solved together in a wave, without the summaries and
+/// seeds that they contribute to each other. The flows along such cycles are
+/// only partly resolved, which solve() reports on std::cerr, see
+/// isComplete().
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class ModuleWiseAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+  // Check if the problem can be composed using IFDS summaries
+  static_assert(
+      std::is_base_of_v<IFDSTabulationProblem<
+                            typename ProblemDescription::ProblemAnalysisDomain>,
+                        ProblemDescription> &&
+          std::is_same_v<typename ProblemDescription::d_t,
+                         const llvm::Value *>,
+      "Module-wise analysis requires an IFDS problem on LLVM IR!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+
+  /// Solves ProblemDescription on a single module, additionally seeded with
+  /// the facts that other modules pass to the module's functions.
+  class ModuleProblem : public ProblemDescription {
+  public:
+    using l_t = typename ProblemDescription::l_t;
+
+    template <typename... ArgTys>
+    ModuleProblem(ArgTys &&...Args)
+        : ProblemDescription(std::forward<ArgTys>(Args)...) {}
+
+    InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+      InitialSeeds<n_t, d_t, l_t> Seeds;
+      if (!this->getEntryPoints().empty()) {
+        Seeds = ProblemDescription::initialSeeds();
+      }
+      for (const auto &[Node, Facts] : ModuleSeeds) {
+        for (d_t Fact : Facts) {
+          Seeds.addSeed(Node, Fact);
+        }
+      }
+      return Seeds;
+    }
+
+    void addModuleSeed(n_t Node, d_t Fact) { ModuleSeeds[Node].insert(Fact); }
+
+  private:
+    std::map<n_t, std::set<d_t>> ModuleSeeds;
+  };
+
+  /// The analysis of a single module.
+  struct ModuleAnalysis {
+    llvm::Module *Mod = nullptr;
+    std::unique_ptr<ProjectIRDB> IRDB;
+    std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+    std::unique_ptr<PointerAnalysisTy> PointerInfo;
+    std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+    // the entry points that the module defines
+    std::set<std::string> EntryPoints;
+    std::unique_ptr<ModuleProblem> Problem;
+    std::unique_ptr<Solver> DataFlowSolver;
+  };
+
+  ProjectIRDB &IRDB;
+  std::set<std::string> EntryPoints;
+  // the number of modules that are set up, summarized and solved at the same
+  // time; 1 if PAMM is enabled, see getNumPAMMSafeThreads()
+  unsigned NumThreads;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  SummaryGenerationStrategy Strategy = SummaryGenerationStrategy::powerset;
+
+  // the modules ordered by their identifiers
+  std::vector<const llvm::Module *> ModuleOrder;
+  std::map<const llvm::Module *, ModuleAnalysis> Modules;
+  // the module dependency graph in both directions
+  std::map<const llvm::Module *, std::set<const llvm::Module *>> Callees;
+  std::map<const llvm::Module *, std::set<const llvm::Module *>> Callers;
+  // the names of the functions that a module defines and other modules call
+  std::map<const llvm::Module *, std::set<std::string>> Exports;
+  // the modules that a module depends on directly or transitively
+  std::map<const llvm::Module *, std::set<const llvm::Module *>> Reachable;
+  // the modules that are part of cycles of the module dependency graph, or
+  // are connected to them, whose results miss the flows along the cycles
+  std::set<const llvm::Module *> IncompleteModules;
+  std::shared_ptr<const IFDSSummaryPool> Summaries;
+
+  void buildDependencies() {
+    for (auto *M : IRDB.getAllModules()) {
+      ModuleOrder.push_back(M);
+      Modules[M].Mod = M;
+      Callees[M];
+      Callers[M];
+      Exports[M];
+    }
+    std::sort(ModuleOrder.begin(), ModuleOrder.end(),
+              [](const llvm::Module *LHS, const llvm::Module *RHS) {
+                return LHS->getModuleIdentifier() <
+                       RHS->getModuleIdentifier();
+              });
+    for (const auto *M : ModuleOrder) {
+      for (const auto &F : *M) {
+        if (!F.isDeclaration() || F.isIntrinsic()) {
+          continue;
+        }
+        const llvm::Module *Def =
+            IRDB.getModuleDefiningFunction(F.getName().str());
+        if (Def && Def != M) {
+          Callees[M].insert(Def);
+          Callers[Def].insert(M);
+          Exports[Def].insert(F.getName().str());
+        }
+      }
+    }
+    for (const auto *M : ModuleOrder) {
+      auto &Deps = Reachable[M];
+      std::vector<const llvm::Module *> WorkList(Callees.at(M).begin(),
+                                                 Callees.at(M).end());
+      while (!WorkList.empty()) {
+        const auto *Callee = WorkList.back();
+        WorkList.pop_back();
+        if (Deps.insert(Callee).second) {
+          WorkList.insert(WorkList.end(), Callees.at(Callee).begin(),
+                          Callees.at(Callee).end());
+        }
+      }
+    }
+    // the summaries of a cycle's modules are incomplete for their callers,
+    // and so are the seeds that they pass to their callees
+    for (const auto *Cyclic : ModuleOrder) {
+      if (!Reachable.at(Cyclic).count(Cyclic)) {
+        continue;
+      }
+      for (const auto *M : ModuleOrder) {
+        if (M == Cyclic || Reachable.at(M).count(Cyclic) ||
+            Reachable.at(Cyclic).count(M)) {
+          IncompleteModules.insert(M);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] bool inSameCycle(const llvm::Module *M,
+                                 const llvm::Module *N) const {
+    return Reachable.at(M).count(N) && Reachable.at(N).count(M);
+  }
+
+  /// Orders the modules into waves, such that the dependencies of a module
+  /// are part of earlier waves. The modules of a cycle are part of the same
+  /// wave, once the dependencies outside of the cycle are done.
+  [[nodiscard]] std::vector<std::vector<const llvm::Module *>> getWaves(
+      const std::map<const llvm::Module *, std::set<const llvm::Module *>>
+          &Dependencies) const {
+    std::vector<std::vector<const llvm::Module *>> Waves;
+    std::set<const llvm::Module *> Done;
+    while (Done.size() < ModuleOrder.size()) {
+      std::vector<const llvm::Module *> Wave;
+      for (const auto *M : ModuleOrder) {
+        const auto &Deps = Dependencies.at(M);
+        if (!Done.count(M) &&
+            std::all_of(Deps.begin(), Deps.end(),
+                        [&](const auto *Dep) { return Done.count(Dep); })) {
+          Wave.push_back(M);
+        }
+      }
+      if (Wave.empty()) {
+        // the cycles whose dependencies outside of the cycle are done
+        for (const auto *M : ModuleOrder) {
+          if (!Done.count(M) && inSameCycle(M, M) &&
+              std::all_of(
+                  ModuleOrder.begin(), ModuleOrder.end(), [&](const auto *N) {
+                    const auto &Deps = Dependencies.at(N);
+                    return !inSameCycle(M, N) ||
+                           std::all_of(Deps.begin(), Deps.end(),
+                                       [&](const auto *Dep) {
+                                         return Done.count(Dep) ||
+                                                inSameCycle(M, Dep);
+                                       });
+                  })) {
+            Wave.push_back(M);
+          }
+        }
+      }
+      Done.insert(Wave.begin(), Wave.end());
+      Waves.push_back(std::move(Wave));
+    }
+    return Waves;
+  }
+
+  /// Calls Fn with the arguments of ProblemDescription's constructor for the
+  /// given module.
+  template <typename Fn> void withProblemArgs(ModuleAnalysis &MA, Fn &&F) {
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      F(MA.IRDB.get(), MA.TypeHierarchy.get(), MA.CallGraph.get(),
+        MA.PointerInfo.get(), MA.EntryPoints);
+    } else {
+      F(MA.IRDB.get(), MA.TypeHierarchy.get(), MA.CallGraph.get(),
+        MA.PointerInfo.get(), std::ref(*Config), MA.EntryPoints);
+    }
+  }
+
+  /// Sets up the helper analyses and the problem of a module. All functions
+  /// that the module defines are part of its call graph, as each of them may
+  /// be called from other modules.
+  void setupModule(ModuleAnalysis &MA) {
+    MA.IRDB = IRDB.getModuleIRDB(MA.Mod);
+    std::set<std::string> Functions;
+    for (const auto &F : *MA.Mod) {
+      if (F.isDeclaration()) {
+        continue;
+      }
+      Functions.insert(F.getName().str());
+      if (EntryPoints.count(F.getName().str())) {
+        MA.EntryPoints.insert(F.getName().str());
+      }
+    }
+    MA.TypeHierarchy = std::make_unique<TypeHierarchyTy>(*MA.IRDB);
+    MA.PointerInfo = std::make_unique<PointerAnalysisTy>(*MA.IRDB);
+    MA.CallGraph = std::make_unique<CallGraphAnalysisTy>(
+        *MA.IRDB, CallGraphAnalysisType::OTF, Functions,
+        MA.TypeHierarchy.get(), MA.PointerInfo.get());
+    withProblemArgs(MA, [&MA](auto... Args) {
+      MA.Problem = std::make_unique<ModuleProblem>(Args...);
+    });
+  }
+
+  /// Pass 1: summarizes the exported functions of the modules bottom-up.
+  void summarizeModules() {
+    IFDSSummaryPool Pool;
+    // keep the summaries of the program's libraries, which are the same for
+    // all modules
+    if (!ModuleOrder.empty()) {
+      const auto &MA = Modules.at(ModuleOrder.front());
+      if (const auto *Lib =
+              MA.Problem->getIFDSIDESolverConfig().librarySummaries()) {
+        Pool.merge(*Lib);
+      }
+    }
+    for (const auto &Wave : getWaves(Callees)) {
+      auto Snapshot = std::make_shared<const IFDSSummaryPool>(Pool);
+      std::vector<IFDSSummaryPool> WavePools(Wave.size());
+      parallelFor(Wave.size(), NumThreads, [&](size_t Idx) {
+        const auto *M = Wave[Idx];
+        std::vector<f_t> Functions;
+        for (const auto &Name : Exports.at(M)) {
+          Functions.push_back(M->getFunction(Name));
+        }
+        if (Functions.empty()) {
+          return;
+        }
+        withProblemArgs(Modules.at(M), [&](auto... Args) {
+          IFDSSummaryGenerator<ProblemDescription, Solver> Generator(Strategy,
+                                                                     Args...);
+          Generator.setLibrarySummaries(Snapshot);
+          Generator.generateSummaries(Functions, WavePools[Idx]);
+        });
+      });
+      for (const auto &WavePool : WavePools) {
+        Pool.merge(WavePool);
+      }
+    }
+    Summaries = std::make_shared<const IFDSSummaryPool>(std::move(Pool));
+  }
+
+  /// Seeds Callee with the facts that the solved module Caller passes to it.
+  void addModuleSeeds(ModuleAnalysis &Caller, ModuleAnalysis &Callee) {
+    const auto &Exported = Exports.at(Callee.Mod);
+    for (const auto &Decl : *Caller.Mod) {
+      if (!Decl.isDeclaration() || !Exported.count(Decl.getName().str())) {
+        continue;
+      }
+      const auto *Def = Callee.Mod->getFunction(Decl.getName());
+      // maps a fact that is passed to Decl to the respective fact of Def
+      auto MapFact = [&](d_t Fact) -> d_t {
+        if (Caller.Problem->isZeroValue(Fact)) {
+          return Callee.Problem->getZeroValue();
+        }
+        if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(Fact)) {
+          return Arg->getParent() == &Decl && Arg->getArgNo() < Def->arg_size()
+                     ? Def->getArg(Arg->getArgNo())
+                     : nullptr;
+        }
+        if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(Fact)) {
+          return G->hasName() ? Callee.Mod->getNamedValue(G->getName())
+                              : nullptr;
+        }
+        return nullptr;
+      };
+      for (const auto *User : Decl.users()) {
+        const auto *CS = llvm::dyn_cast<llvm::CallBase>(User);
+        if (!CS || CS->getCalledFunction() != &Decl) {
+          continue;
+        }
+        auto CallFF = Caller.Problem->getCallFlowFunction(CS, &Decl);
+        for (d_t Fact : Caller.DataFlowSolver->ifdsResultsAt(CS)) {
+          for (d_t Target : CallFF->computeTargets(Fact)) {
+            if (d_t Mapped = MapFact(Target)) {
+              for (n_t StartPoint : Callee.CallGraph->getStartPointsOf(Def)) {
+                Callee.Problem->addModuleSeed(StartPoint, Mapped);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// Pass 2: solves the modules top-down, seeding each one with the facts
+  /// that its solved callers pass to it.
+  void composeModules() {
+    for (const auto &Wave : getWaves(Callers)) {
+      for (const auto *M : Wave) {
+        auto &MA = Modules.at(M);
+        for (const auto *Caller : Callers.at(M)) {
+          auto &CA = Modules.at(Caller);
+          if (CA.DataFlowSolver) {
+            addModuleSeeds(CA, MA);
+          }
+        }
+        MA.Problem->getIFDSIDESolverConfig().setLibrarySummaries(Summaries);
+      }
+      // the modules of a wave are only seeded by modules of earlier waves
+      parallelFor(Wave.size(), NumThreads, [&](size_t Idx) {
+        auto &MA = Modules.at(Wave[Idx]);
+        MA.DataFlowSolver = std::make_unique<Solver>(*MA.Problem);
+        MA.DataFlowSolver->solve();
+      });
+    }
+  }
+
+  void printModuleHeader(const llvm::Module *M, std::ostream &OS) const {
+    OS << "Module: " << M->getModuleIdentifier();
+    if (IncompleteModules.count(M)) {
+      OS << " (incomplete due to a module dependency cycle)";
+    }
+    OS << '\n';
+  }
+
+  [[nodiscard]] Solver &getSolver(n_t n) {
+    auto Search = Modules.find(n->getModule());
+    assert(Search != Modules.end() && Search->second.DataFlowSolver &&
+           "node does not belong to a solved module");
+    return *Search->second.DataFlowSolver;
+  }
+
+public:
+  ModuleWiseAnalysis(ProjectIRDB &IRDB, std::set<std::string> EntryPoints = {},
+                     unsigned NumThreads = 1)
+      : IRDB(IRDB), EntryPoints(std::move(EntryPoints)),
+        NumThreads(getNumPAMMSafeThreads(std::max(1U, NumThreads))) {
+    buildDependencies();
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                     std::set<std::string> EntryPoints = {},
+                     unsigned NumThreads = 1)
+      : IRDB(IRDB), EntryPoints(std::move(EntryPoints)),
+        NumThreads(getNumPAMMSafeThreads(std::max(1U, NumThreads))),
+        Config(std::unique_ptr<ConfigurationTy>(Config)), ConfigPath("") {
+    buildDependencies();
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ModuleWiseAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                     std::set<std::string> EntryPoints = {},
+                     unsigned NumThreads = 1)
+      : IRDB(IRDB), EntryPoints(std::move(EntryPoints)),
+        NumThreads(getNumPAMMSafeThreads(std::max(1U, NumThreads))),
+        Config(std::make_unique<ConfigurationTy>(ConfigPath)),
+        ConfigPath(ConfigPath) {
+    buildDependencies();
+  }
+
+  /// Sets the calling contexts for which the exported functions are
+  /// summarized; powerset by default.
+  void setSummaryStrategy(SummaryGenerationStrategy S) { Strategy = S; }
+
+  void solve() {
+    if (!isComplete()) {
+      std::cerr << "Module-wise analysis does not resolve the flows along "
+                   "module dependency cycles, the results of";
+      for (const auto *M : ModuleOrder) {
+        if (IncompleteModules.count(M)) {
+          std::cerr << " '" << M->getModuleIdentifier() << '\'';
+        }
+      }
+      std::cerr << " are incomplete\n";
+    }
+    parallelFor(ModuleOrder.size(), NumThreads, [this](size_t Idx) {
+      setupModule(Modules.at(ModuleOrder[Idx]));
+    });
+    summarizeModules();
+    composeModules();
+  }
+
+  void operator()() { solve(); }
+
+  /// Returns the modules that the given module calls functions of.
+  [[nodiscard]] const std::set<const llvm::Module *> &
+  getModuleDependencies(const llvm::Module *M) const {
+    return Callees.at(M);
+  }
+
+  /// Returns false if the module dependency graph has cycles, such that the
+  /// results of the modules along them, and of the modules connected to
+  /// them, miss the flows along the cycles.
+  [[nodiscard]] bool isComplete() const { return IncompleteModules.empty(); }
+
+  /// Returns the modules whose results are incomplete, see isComplete().
+  [[nodiscard]] const std::set<const llvm::Module *> &
+  getIncompleteModules() const {
+    return IncompleteModules;
+  }
+
+  /// Returns the summaries of the functions that the modules export, or
+  /// nullptr if the analysis has not been solved yet.
+  [[nodiscard]] const IFDSSummaryPool *getModuleSummaries() const {
+    return Summaries.get();
+  }
+
+  auto resultsAt(n_t n, bool StripZero = false) {
+    return getSolver(n).resultsAt(n, StripZero);
+  }
+
+  std::set<d_t> ifdsResultsAt(n_t n) { return getSolver(n).ifdsResultsAt(n); }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    for (const auto *M : ModuleOrder) {
+      printModuleHeader(M, OS);
+      Modules.at(M).DataFlowSolver->dumpResults(OS);
+    }
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    for (const auto *M : ModuleOrder) {
+      printModuleHeader(M, OS);
+      Modules.at(M).DataFlowSolver->emitTextReport(OS);
+    }
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    for (const auto *M : ModuleOrder) {
+      Modules.at(M).DataFlowSolver->emitGraphicalReport(OS);
+    }
+  }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
 
 } // namespace psr
 
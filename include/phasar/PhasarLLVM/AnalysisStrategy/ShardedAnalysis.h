@@ -0,0 +1,449 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_ANALYSISSTRATEGY_SHARDEDANALYSIS_H_
+#define PHASAR_PHASARLLVM_ANALYSISSTRATEGY_SHARDEDANALYSIS_H_
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/EquivalenceClasses.h"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/AnalysisSetup.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/Utils/Concurrency.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/// Determines how a ShardedAnalysis partitions the initial seeds.
+enum class ShardingPolicy {
+  /// one shard per function that contains seeds, e.g., per entry point
+  EntryPoint,
+  /// one shard per connected component of the call graph that contains seeds
+  Component
+};
+
+/// Partitions the initial seeds of a problem into shards and solves each
+/// shard with its own solver, with the shards being solved in parallel. The
+/// per-shard results are merged at the end, joining the values of facts that
+/// hold in several shards.
+///
+/// The shards share the helper analyses, and the end summaries of the callees
+/// they have in common through a SummaryStore that is kept in memory, see
+/// IFDSIDESolverConfig::setSharedSummaryStore(): a shard applies the
+/// summaries of a callee once another shard has persisted them, which
+/// happens when that shard has been solved, and analyzes the callee itself
+/// otherwise. Summaries are only shared for problems that identify their
+/// analysis, see IFDSTabulationProblem::getSummaryAnalysisID(), and on LLVM
+/// IR; solve() reports on std::cerr if they are not. If several shards are
+/// solved at the same time, see setNumThreads(), the points-to information
+/// is queried concurrently and must have been computed eagerly.
+///
+/// Facts that the problem records as side effects, e.g., for its reports, are
+/// recorded by the shard that analyzes the respective function, so reports
+/// are emitted per shard.
+template <typename Solver, typename ProblemDescription,
+          typename Setup = psr::DefaultAnalysisSetup>
+class ShardedAnalysis {
+  // Check if the solver is able to solve the given problem description
+  static_assert(
+      std::is_base_of_v<typename Solver::ProblemTy, ProblemDescription>,
+      "Problem description does not match solver type!");
+  // Check if the setup is a valid analysis setup
+  static_assert(std::is_base_of_v<psr::AnalysisSetup, Setup>,
+                "Setup is not a valid analysis setup!");
+
+public:
+  using n_t = typename Solver::n_t;
+  using d_t = typename Solver::d_t;
+  using f_t = typename Solver::f_t;
+  using l_t = typename Solver::l_t;
+
+private:
+  using TypeHierarchyTy = typename Setup::TypeHierarchyTy;
+  using PointerAnalysisTy = typename Setup::PointerAnalysisTy;
+  using CallGraphAnalysisTy = typename Setup::CallGraphAnalysisTy;
+  using ConfigurationTy = typename ProblemDescription::ConfigurationTy;
+  using SeedsTy = typename InitialSeeds<
+      n_t, d_t, typename ProblemDescription::l_t>::GeneralizedSeeds;
+
+  /// Solves ProblemDescription from the seeds of a single shard.
+  class ShardProblem : public ProblemDescription {
+  public:
+    using l_t = typename ProblemDescription::l_t;
+
+    template <typename... ArgTys>
+    ShardProblem(ArgTys &&...Args)
+        : ProblemDescription(std::forward<ArgTys>(Args)...) {}
+
+    InitialSeeds<n_t, d_t, l_t> initialSeeds() override {
+      return InitialSeeds<n_t, d_t, l_t>(ShardSeeds);
+    }
+
+    /// Returns the seeds of ProblemDescription for the whole program.
+    InitialSeeds<n_t, d_t, l_t> allSeeds() {
+      return ProblemDescription::initialSeeds();
+    }
+
+    void setShardSeeds(SeedsTy Seeds) { ShardSeeds = std::move(Seeds); }
+
+  private:
+    SeedsTy ShardSeeds;
+  };
+
+  struct Shard {
+    // the names of the functions that contain the shard's seeds
+    std::set<std::string> Functions;
+    SeedsTy Seeds;
+    std::unique_ptr<ShardProblem> Problem;
+    std::unique_ptr<Solver> DataFlowSolver;
+  };
+
+  ProjectIRDB &IRDB;
+  std::unique_ptr<TypeHierarchyTy> TypeHierarchy;
+  std::unique_ptr<PointerAnalysisTy> PointerInfo;
+  std::unique_ptr<CallGraphAnalysisTy> CallGraph;
+  std::set<std::string> EntryPoints;
+  std::unique_ptr<ConfigurationTy> Config;
+  std::string ConfigPath;
+  ShardingPolicy Policy = ShardingPolicy::EntryPoint;
+  unsigned NumThreads = 1;
+
+  // the shards ordered by the names of their functions
+  std::vector<Shard> Shards;
+  // null if the shards cannot share their summaries
+  std::shared_ptr<SummaryStore> Summaries;
+  // the merged results of all shards
+  Table<n_t, d_t, l_t> Results;
+  bool Complete = true;
+
+  std::unique_ptr<ShardProblem> makeProblem() {
+    if constexpr (std::is_same_v<ConfigurationTy, HasNoConfigurationType>) {
+      return std::make_unique<ShardProblem>(&IRDB, TypeHierarchy.get(),
+                                            CallGraph.get(), PointerInfo.get(),
+                                            EntryPoints);
+    } else {
+      return std::make_unique<ShardProblem>(
+          &IRDB, TypeHierarchy.get(), CallGraph.get(), PointerInfo.get(),
+          std::ref(*Config), EntryPoints);
+    }
+  }
+
+  /// Partitions the seeds of Problem into shards according to the policy.
+  void partition(ShardProblem &Problem) {
+    const auto *ICF = Problem.getICFG();
+    llvm::EquivalenceClasses<f_t> Components;
+    if (Policy == ShardingPolicy::Component) {
+      for (f_t Fun : ICF->getAllFunctions()) {
+        Components.insert(Fun);
+        for (n_t CallSite : ICF->getCallsFromWithin(Fun)) {
+          for (f_t Callee : ICF->getCalleesOfCallAt(CallSite)) {
+            Components.unionSets(Fun, Callee);
+          }
+        }
+      }
+    }
+    std::unordered_map<f_t, Shard> ShardOf;
+    for (const auto &[Node, Facts] : Problem.allSeeds().getSeeds()) {
+      f_t Fun = ICF->getFunctionOf(Node);
+      f_t Key = Policy == ShardingPolicy::Component
+                    ? Components.getOrInsertLeaderValue(Fun)
+                    : Fun;
+      auto &S = ShardOf[Key];
+      S.Functions.insert(ICF->getFunctionName(Fun));
+      S.Seeds[Node].insert(Facts.begin(), Facts.end());
+    }
+    for (auto &Entry : ShardOf) {
+      Shards.push_back(std::move(Entry.second));
+    }
+    std::sort(Shards.begin(), Shards.end(),
+              [](const Shard &LHS, const Shard &RHS) {
+                return LHS.Functions < RHS.Functions;
+              });
+  }
+
+  /// Returns why the shards cannot share the problem's summaries, or an
+  /// empty string if they can.
+  static std::string getSharingObstacle(const ProblemDescription &Problem) {
+    if constexpr (!std::is_same_v<n_t, const llvm::Instruction *> ||
+                  !std::is_same_v<d_t, const llvm::Value *> ||
+                  !std::is_same_v<f_t, const llvm::Function *>) {
+      return "the problem is not an analysis on LLVM IR";
+    }
+    if (Problem.getSummaryAnalysisID().empty()) {
+      return "the problem does not provide a summary analysis ID";
+    }
+    return {};
+  }
+
+  /// Lets the solver of the shard with the given index share summaries with
+  /// the other shards. The files that a solver writes get a per-shard suffix.
+  void configureShard(size_t Idx, IFDSIDESolverConfig &SolverConfig) {
+    auto Suffix = ".shard" + std::to_string(Idx);
+    // the shards are solved in parallel instead
+    SolverConfig.setNumThreads(1);
+    if (!SolverConfig.checkpointFile().empty()) {
+      SolverConfig.setCheckpointFile(SolverConfig.checkpointFile() + Suffix);
+    }
+    if (!SolverConfig.esgLogFile().empty()) {
+      SolverConfig.setESGLogFile(SolverConfig.esgLogFile() + Suffix);
+    }
+    if (!SolverConfig.profileFile().empty()) {
+      SolverConfig.setProfileFile(SolverConfig.profileFile() + Suffix);
+    }
+    if (!Summaries) {
+      // solve() has reported why once for all shards
+      SolverConfig.setComputePersistedSummaries(false);
+      return;
+    }
+    SolverConfig.setComputePersistedSummaries();
+    // summaries that are persisted to a directory are shared as well
+    if (SolverConfig.summaryStore().empty()) {
+      SolverConfig.setSharedSummaryStore(Summaries);
+    }
+    if constexpr (!std::is_same_v<l_t, BinaryDomain>) {
+      // the values within a callee whose summaries are applied depend on the
+      // values at its call sites
+      SolverConfig.setPersistJumpFunctions();
+    }
+  }
+
+  void mergeResults() {
+    for (auto &S : Shards) {
+      auto ShardResults = S.DataFlowSolver->getSolverResults();
+      Complete &= ShardResults.isComplete();
+      for (const auto &Cell : ShardResults.getAllResultEntries()) {
+        n_t Node = Cell.getRowKey();
+        d_t Fact = Cell.getColumnKey();
+        if constexpr (std::is_same_v<l_t, BinaryDomain>) {
+          Results.insert(Node, Fact, Cell.getValue());
+        } else {
+          Results.insert(Node, Fact,
+                         Results.contains(Node, Fact)
+                             ? S.Problem->join(Results.get(Node, Fact),
+                                               Cell.getValue())
+                             : Cell.getValue());
+        }
+      }
+    }
+  }
+
+public:
+  ShardedAnalysis(ProjectIRDB &IRDB, std::set<std::string> EntryPoints = {},
+                  PointerAnalysisTy *PointerInfo = nullptr,
+                  CallGraphAnalysisTy *CallGraph = nullptr,
+                  TypeHierarchyTy *TypeHierarchy = nullptr)
+      : IRDB(IRDB),
+        TypeHierarchy(TypeHierarchy == nullptr
+                          ? std::make_unique<TypeHierarchyTy>(IRDB)
+                          : std::unique_ptr<TypeHierarchyTy>(TypeHierarchy)),
+        PointerInfo(PointerInfo == nullptr
+                        ? std::make_unique<PointerAnalysisTy>(IRDB, false)
+                        : std::unique_ptr<PointerAnalysisTy>(PointerInfo)),
+        CallGraph(CallGraph == nullptr
+                      ? std::make_unique<CallGraphAnalysisTy>(
+                            IRDB, CallGraphAnalysisType::OTF, EntryPoints,
+                            this->TypeHierarchy.get(), this->PointerInfo.get())
+                      : std::unique_ptr<CallGraphAnalysisTy>(CallGraph)),
+        EntryPoints(std::move(EntryPoints)) {}
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ShardedAnalysis(ProjectIRDB &IRDB, ConfigurationTy *Config,
+                  std::set<std::string> EntryPoints = {},
+                  PointerAnalysisTy *PointerInfo = nullptr,
+                  CallGraphAnalysisTy *CallGraph = nullptr,
+                  TypeHierarchyTy *TypeHierarchy = nullptr)
+      : ShardedAnalysis(IRDB, std::move(EntryPoints), PointerInfo, CallGraph,
+                        TypeHierarchy) {
+    this->Config = std::unique_ptr<ConfigurationTy>(Config);
+  }
+
+  template <typename T = ProblemDescription,
+            typename = typename std::enable_if_t<!std::is_same_v<
+                typename T::ConfigurationTy, HasNoConfigurationType>>>
+  ShardedAnalysis(ProjectIRDB &IRDB, std::string ConfigPath,
+                  std::set<std::string> EntryPoints = {},
+                  PointerAnalysisTy *PointerInfo = nullptr,
+                  CallGraphAnalysisTy *CallGraph = nullptr,
+                  TypeHierarchyTy *TypeHierarchy = nullptr)
+      : ShardedAnalysis(IRDB, std::move(EntryPoints), PointerInfo, CallGraph,
+                        TypeHierarchy) {
+    this->Config = std::make_unique<ConfigurationTy>(ConfigPath);
+    this->ConfigPath = std::move(ConfigPath);
+  }
+
+  /// Sets how the seeds are partitioned; one shard per entry point by
+  /// default.
+  void setShardingPolicy(ShardingPolicy P) { Policy = P; }
+
+  /// Sets the number of shards that are solved at the same time, which is 1
+  /// if PAMM is enabled, see getNumPAMMSafeThreads().
+  void setNumThreads(unsigned N) {
+    NumThreads = getNumPAMMSafeThreads(std::max(1U, N));
+  }
+
+  /// Reports on std::cerr, once for all shards, if the shards cannot share
+  /// their summaries, such that each shard analyzes all of its callees.
+  void solve() {
+    auto Problem = makeProblem();
+    partition(*Problem);
+    Summaries = nullptr;
+    if (auto Obstacle = getSharingObstacle(*Problem); Obstacle.empty()) {
+      Summaries = std::make_shared<SummaryStore>();
+    } else if (Shards.size() > 1 ||
+               !Problem->getIFDSIDESolverConfig().summaryStore().empty()) {
+      std::cerr << "The " << Shards.size()
+                << " shard(s) share and persist no summaries: " << Obstacle
+                << '\n';
+    }
+    if (NumThreads > 1) {
+      PointerInfo->setThreadSafe();
+    }
+    for (size_t Idx = 0; Idx < Shards.size(); ++Idx) {
+      auto &S = Shards[Idx];
+      // reuse the problem that has computed the seeds for the first shard
+      S.Problem = Idx == 0 ? std::move(Problem) : makeProblem();
+      S.Problem->setShardSeeds(S.Seeds);
+      configureShard(Idx, S.Problem->getIFDSIDESolverConfig());
+    }
+    parallelFor(Shards.size(), NumThreads, [this](size_t Idx) {
+      auto &S = Shards[Idx];
+      S.DataFlowSolver = std::make_unique<Solver>(*S.Problem);
+      S.DataFlowSolver->solve();
+    });
+    mergeResults();
+  }
+
+  void operator()() { solve(); }
+
+  [[nodiscard]] size_t getNumShards() const { return Shards.size(); }
+
+  /// Returns the names of the functions that contain the seeds of the shard
+  /// with the given index.
+  [[nodiscard]] const std::set<std::string> &
+  getShardFunctions(size_t Idx) const {
+    return Shards.at(Idx).Functions;
+  }
+
+  /// Returns false if the budget of any shard's solver was exhausted.
+  [[nodiscard]] bool isComplete() const { return Complete; }
+
+  SolverResults<n_t, d_t, l_t> getSolverResults() {
+    d_t ZeroValue =
+        Shards.empty() ? d_t{} : Shards.front().Problem->getZeroValue();
+    return SolverResults<n_t, d_t, l_t>(Results, ZeroValue, Complete);
+  }
+
+  std::unordered_map<d_t, l_t> resultsAt(n_t n, bool StripZero = false) {
+    return getSolverResults().resultsAt(n, StripZero);
+  }
+
+  template <typename ValueDomain = l_t,
+            typename = typename std::enable_if_t<
+                std::is_same_v<ValueDomain, BinaryDomain>>>
+  std::set<d_t> ifdsResultsAt(n_t n) {
+    return getSolverResults().ifdsResultsAt(n);
+  }
+
+  void dumpResults(std::ostream &OS = std::cout) {
+    OS << "\n***************************************************************\n"
+       << "*                Raw ShardedAnalysis results                  *\n"
+       << "***************************************************************\n";
+    if (!Complete) {
+      OS << "Results are incomplete, the budget of a shard was exhausted\n";
+    }
+    auto Cells = Results.cellVec();
+    if (Cells.empty()) {
+      OS << "No results computed!" << std::endl;
+      return;
+    }
+    const auto &Problem = *Shards.front().Problem;
+    const auto *ICF = Problem.getICFG();
+    std::sort(Cells.begin(), Cells.end(), [](const auto &A, const auto &B) {
+      if constexpr (std::is_same_v<n_t, const llvm::Instruction *>) {
+        return llvmValueIDLess{}(A.getRowKey(), B.getRowKey());
+      } else {
+        return A.getRowKey() < B.getRowKey();
+      }
+    });
+    n_t PrevNode = n_t{};
+    f_t PrevFun = f_t{};
+    for (const auto &Cell : Cells) {
+      n_t Node = Cell.getRowKey();
+      if (f_t Fun = ICF->getFunctionOf(Node); Fun != PrevFun) {
+        PrevFun = Fun;
+        OS << "\n\n============ Results for function '" +
+                  ICF->getFunctionName(Fun) + "' ============\n";
+      }
+      if (Node != PrevNode) {
+        PrevNode = Node;
+        std::string NString = Problem.NtoString(Node);
+        OS << "\n\nN: " << NString << "\n---"
+           << std::string(NString.size(), '-') << '\n';
+      }
+      OS << "\tD: " << Problem.DtoString(Cell.getColumnKey());
+      if constexpr (!std::is_same_v<l_t, BinaryDomain>) {
+        OS << " | V: " << Problem.LtoString(Cell.getValue());
+      }
+      OS << '\n';
+    }
+    OS << '\n';
+  }
+
+  void emitTextReport(std::ostream &OS = std::cout) {
+    for (auto &S : Shards) {
+      OS << "Shard: " << *S.Functions.begin() << '\n';
+      S.DataFlowSolver->emitTextReport(OS);
+    }
+  }
+
+  void emitGraphicalReport(std::ostream &OS = std::cout) {
+    for (auto &S : Shards) {
+      S.DataFlowSolver->emitGraphicalReport(OS);
+    }
+  }
+
+  void releaseAllHelperAnalyses() {
+    releasePointerInformation();
+    releaseCallGraph();
+    releaseTypeHierarchy();
+  }
+
+  PointerAnalysisTy *releasePointerInformation() {
+    return PointerInfo.release();
+  }
+
+  CallGraphAnalysisTy *releaseCallGraph() { return CallGraph.release(); }
+
+  TypeHierarchyTy *releaseTypeHierarchy() { return TypeHierarchy.release(); }
+
+  ConfigurationTy *releaseConfiguration() { return Config.release(); }
+};
+
+} // namespace psr
+
+#endif
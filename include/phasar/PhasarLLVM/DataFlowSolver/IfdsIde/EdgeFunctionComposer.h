@@ -70,10 +70,8 @@ public:
    * by providing an own implementation of this function.
    */
   EdgeFunctionPtrType composeWith(EdgeFunctionPtrType secondFunction) override {
-    if (auto *EI = dynamic_cast<EdgeIdentity<L> *>(secondFunction.get())) {
-      return this->shared_from_this();
-    }
-    if (auto *AB = dynamic_cast<AllBottom<L> *>(secondFunction.get())) {
+    if (secondFunction->getKind() == EdgeFunctionKind::Identity ||
+        secondFunction->getKind() == EdgeFunctionKind::AllBottom) {
       return this->shared_from_this();
     }
     return F->composeWith(G->composeWith(secondFunction));
@@ -0,0 +1,242 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONHANDLE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_EDGEFUNCTIONHANDLE_H_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <variant>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+
+namespace psr {
+
+/**
+ * A lightweight value type that refers to an edge function.
+ *
+ * The edge functions whose semantics is known to PhASAR, i.e. EdgeIdentity,
+ * AllTop and AllBottom, are tagged inline. Their compositions, joins and
+ * comparisons are dispatched statically through tables that are indexed by
+ * the kinds of both operands, which neither requires virtual calls and
+ * dynamic_casts nor allocates a new edge function. The constant of an AllTop
+ * or AllBottom function can be stored in the handle itself, such that those
+ * functions can be created without any allocation. All other edge functions
+ * are referred to by an EdgeFunctionPtrType and fall back to the virtual
+ * EdgeFunction interface.
+ */
+template <typename L> class EdgeFunctionHandle {
+public:
+  using EdgeFunctionPtrType = typename EdgeFunction<L>::EdgeFunctionPtrType;
+
+  EdgeFunctionHandle() : Kind(EdgeFunctionKind::Identity) {}
+
+  /// Wraps the given edge function; the kind is read from the edge function.
+  EdgeFunctionHandle(EdgeFunctionPtrType EF)
+      : Kind(EF ? EF->getKind() : EdgeFunctionKind::Other),
+        Storage(std::move(EF)) {}
+
+  /// Returns a handle to the identity edge function.
+  [[nodiscard]] static EdgeFunctionHandle identity() { return {}; }
+
+  /// Returns a handle to the edge function that maps every value to Top. The
+  /// constant is stored in the handle.
+  [[nodiscard]] static EdgeFunctionHandle allTop(L Top) {
+    return EdgeFunctionHandle(EdgeFunctionKind::AllTop, std::move(Top));
+  }
+
+  /// Returns a handle to the edge function that maps every value to Bottom.
+  /// The constant is stored in the handle.
+  [[nodiscard]] static EdgeFunctionHandle allBottom(L Bottom) {
+    return EdgeFunctionHandle(EdgeFunctionKind::AllBottom, std::move(Bottom));
+  }
+
+  [[nodiscard]] EdgeFunctionKind getKind() const noexcept { return Kind; }
+
+  [[nodiscard]] bool isIdentity() const noexcept {
+    return Kind == EdgeFunctionKind::Identity;
+  }
+
+  [[nodiscard]] bool isAllTop() const noexcept {
+    return Kind == EdgeFunctionKind::AllTop;
+  }
+
+  [[nodiscard]] bool isAllBottom() const noexcept {
+    return Kind == EdgeFunctionKind::AllBottom;
+  }
+
+  [[nodiscard]] bool isConstant() const noexcept {
+    return isAllTop() || isAllBottom();
+  }
+
+  /// Returns the constant of an AllTop or AllBottom edge function.
+  [[nodiscard]] const L &getConstant() const {
+    assert(isConstant() && "Only constant edge functions have a constant!");
+    if (const auto *Val = std::get_if<L>(&Storage)) {
+      return *Val;
+    }
+    const auto *EF = std::get<EdgeFunctionPtrType>(Storage).get();
+    if (isAllTop()) {
+      return static_cast<const AllTop<L> *>(EF)->getTopElement();
+    }
+    return static_cast<const AllBottom<L> *>(EF)->getBottomElement();
+  }
+
+  /// Returns the edge function this handle refers to. Only constant edge
+  /// functions that are stored inline need to be allocated.
+  [[nodiscard]] EdgeFunctionPtrType get() const {
+    if (const auto *EF = std::get_if<EdgeFunctionPtrType>(&Storage)) {
+      return *EF;
+    }
+    switch (Kind) {
+    case EdgeFunctionKind::AllTop:
+      return std::make_shared<AllTop<L>>(std::get<L>(Storage));
+    case EdgeFunctionKind::AllBottom:
+      return std::make_shared<AllBottom<L>>(std::get<L>(Storage));
+    default:
+      return EdgeIdentity<L>::getInstance();
+    }
+  }
+
+  [[nodiscard]] L computeTarget(L Source) const {
+    switch (Kind) {
+    case EdgeFunctionKind::Identity:
+      return Source;
+    case EdgeFunctionKind::AllTop:
+    case EdgeFunctionKind::AllBottom:
+      return getConstant();
+    default:
+      return std::get<EdgeFunctionPtrType>(Storage)->computeTarget(
+          std::move(Source));
+    }
+  }
+
+  /// Equivalent to this->get()->composeWith(Second).
+  [[nodiscard]] EdgeFunctionHandle
+  composeWith(const EdgeFunctionHandle &Second) const {
+    return ComposeTable[index(Kind)][index(Second.Kind)](*this, Second);
+  }
+
+  /// Equivalent to this->get()->joinWith(Other).
+  [[nodiscard]] EdgeFunctionHandle
+  joinWith(const EdgeFunctionHandle &Other) const {
+    return JoinTable[index(Kind)][index(Other.Kind)](*this, Other);
+  }
+
+  /// Equivalent to this->get()->equal_to(Other).
+  [[nodiscard]] bool equal_to(const EdgeFunctionHandle &Other) const {
+    if (Kind == EdgeFunctionKind::Other) {
+      return std::get<EdgeFunctionPtrType>(Storage)->equal_to(Other.get());
+    }
+    if (Kind != Other.Kind) {
+      return false;
+    }
+    return isIdentity() || getConstant() == Other.getConstant();
+  }
+
+  friend bool operator==(const EdgeFunctionHandle &Lhs,
+                         const EdgeFunctionHandle &Rhs) {
+    return Lhs.equal_to(Rhs);
+  }
+
+  friend bool operator!=(const EdgeFunctionHandle &Lhs,
+                         const EdgeFunctionHandle &Rhs) {
+    return !Lhs.equal_to(Rhs);
+  }
+
+  friend std::ostream &operator<<(std::ostream &OS,
+                                  const EdgeFunctionHandle &EF) {
+    switch (EF.Kind) {
+    case EdgeFunctionKind::Identity:
+      return OS << "EdgeIdentity";
+    case EdgeFunctionKind::AllTop:
+      return OS << "AllTop";
+    case EdgeFunctionKind::AllBottom:
+      return OS << "AllBottom";
+    default:
+      return OS << std::get<EdgeFunctionPtrType>(EF.Storage)->str();
+    }
+  }
+
+private:
+  using BinaryOp = EdgeFunctionHandle (*)(const EdgeFunctionHandle &,
+                                          const EdgeFunctionHandle &);
+  static constexpr size_t NumKinds = 4;
+  using DispatchTable = std::array<std::array<BinaryOp, NumKinds>, NumKinds>;
+
+  EdgeFunctionHandle(EdgeFunctionKind Kind, L Constant)
+      : Kind(Kind), Storage(std::move(Constant)) {}
+
+  static constexpr size_t index(EdgeFunctionKind Kind) noexcept {
+    return static_cast<size_t>(Kind);
+  }
+
+  static EdgeFunctionHandle first(const EdgeFunctionHandle &F,
+                                  const EdgeFunctionHandle & /*G*/) {
+    return F;
+  }
+
+  static EdgeFunctionHandle second(const EdgeFunctionHandle & /*F*/,
+                                   const EdgeFunctionHandle &G) {
+    return G;
+  }
+
+  static EdgeFunctionHandle composeVirtual(const EdgeFunctionHandle &F,
+                                           const EdgeFunctionHandle &G) {
+    return F.get()->composeWith(G.get());
+  }
+
+  static EdgeFunctionHandle composeReversed(const EdgeFunctionHandle &F,
+                                            const EdgeFunctionHandle &G) {
+    return G.get()->composeWith(F.get());
+  }
+
+  static EdgeFunctionHandle joinVirtual(const EdgeFunctionHandle &F,
+                                        const EdgeFunctionHandle &G) {
+    return F.get()->joinWith(G.get());
+  }
+
+  static EdgeFunctionHandle joinIdentity(const EdgeFunctionHandle &F,
+                                         const EdgeFunctionHandle &G) {
+    auto Other = G.get();
+    auto Identity = F.get();
+    if (Other->equal_to(Identity)) {
+      return F;
+    }
+    return Other->joinWith(std::move(Identity));
+  }
+
+  // Rows are indexed by the kind of this, columns by the kind of the other
+  // operand, both in the order Other, Identity, AllTop, AllBottom. The tables
+  // mirror the virtual implementations of EdgeIdentity, AllTop and AllBottom.
+  static constexpr DispatchTable ComposeTable = {{
+      {&composeVirtual, &composeVirtual, &composeVirtual, &composeVirtual},
+      {&second, &second, &second, &second},
+      {&first, &first, &first, &first},
+      {&composeReversed, &first, &second, &first},
+  }};
+
+  static constexpr DispatchTable JoinTable = {{
+      {&joinVirtual, &joinVirtual, &joinVirtual, &joinVirtual},
+      {&joinIdentity, &first, &first, &second},
+      {&second, &second, &second, &second},
+      {&first, &first, &first, &first},
+  }};
+
+  EdgeFunctionKind Kind;
+  std::variant<std::monostate, L, EdgeFunctionPtrType> Storage;
+};
+
+} // namespace psr
+
+#endif
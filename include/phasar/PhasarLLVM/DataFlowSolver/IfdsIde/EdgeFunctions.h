@@ -19,23 +19,29 @@
 
 #include "llvm/Support/Compiler.h"
 
-#include <atomic>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <iostream>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <ostream>
 #include <set>
+#include <shared_mutex>
 #include <sstream>
 #include <string>
-#include <thread>
+#include <unordered_map>
 #include <utility>
 
 namespace psr {
-namespace internal {
-struct TestEdgeFunction;
-} // namespace internal
+
+//
+// Tags the edge functions that are shipped with PhASAR and whose semantics is
+// known to the solvers, such that they can be handled without virtual calls or
+// dynamic_casts. All user-defined edge functions are of kind Other.
+//
+enum class EdgeFunctionKind : uint8_t { Other, Identity, AllTop, AllBottom };
 
 //
 // This class models an edge function for distributive data-flow problems.
@@ -47,8 +53,16 @@ template <typename L> class EdgeFunction {
 public:
   using EdgeFunctionPtrType = std::shared_ptr<EdgeFunction<L>>;
 
+  EdgeFunction() = default;
+  EdgeFunction(const EdgeFunction &) = default;
+  EdgeFunction &operator=(const EdgeFunction &) = default;
+  EdgeFunction(EdgeFunction &&) noexcept = default;
+  EdgeFunction &operator=(EdgeFunction &&) noexcept = default;
+
   virtual ~EdgeFunction() = default;
 
+  [[nodiscard]] EdgeFunctionKind getKind() const noexcept { return Kind; }
+
   //
   // This function describes the concrete value computation for its respective
   // exploded supergraph edge. The function(s) will be evaluated once the
@@ -89,6 +103,12 @@ public:
     print(OSS);
     return OSS.str();
   }
+
+protected:
+  explicit EdgeFunction(EdgeFunctionKind Kind) noexcept : Kind(Kind) {}
+
+private:
+  EdgeFunctionKind Kind = EdgeFunctionKind::Other;
 };
 
 template <typename L>
@@ -114,10 +134,13 @@ private:
   const L topElement;
 
 public:
-  AllTop(L topElement) : topElement(topElement) {}
+  AllTop(L topElement)
+      : EdgeFunction<L>(EdgeFunctionKind::AllTop), topElement(topElement) {}
 
   ~AllTop() override = default;
 
+  [[nodiscard]] const L &getTopElement() const noexcept { return topElement; }
+
   L computeTarget(L source) override { return topElement; }
 
   EdgeFunctionPtrType composeWith(EdgeFunctionPtrType secondFunction) override {
@@ -129,8 +152,8 @@ public:
   }
 
   bool equal_to(EdgeFunctionPtrType other) const override {
-    if (auto *alltop = dynamic_cast<AllTop<L> *>(other.get())) {
-      return (alltop->topElement == topElement);
+    if (other->getKind() == EdgeFunctionKind::AllTop) {
+      return static_cast<AllTop<L> *>(other.get())->topElement == topElement;
     }
     return false;
   }
@@ -152,39 +175,36 @@ private:
   const L bottomElement;
 
 public:
-  AllBottom(L bottomElement) : bottomElement(bottomElement) {}
+  AllBottom(L bottomElement)
+      : EdgeFunction<L>(EdgeFunctionKind::AllBottom),
+        bottomElement(bottomElement) {}
 
   ~AllBottom() override = default;
 
+  [[nodiscard]] const L &getBottomElement() const noexcept {
+    return bottomElement;
+  }
+
   L computeTarget(L source) override { return bottomElement; }
 
   EdgeFunctionPtrType composeWith(EdgeFunctionPtrType secondFunction) override {
-    if (auto *ab = dynamic_cast<AllBottom<L> *>(secondFunction.get())) {
+    switch (secondFunction->getKind()) {
+    case EdgeFunctionKind::AllBottom:
+    case EdgeFunctionKind::Identity:
       return this->shared_from_this();
+    default:
+      return secondFunction->composeWith(this->shared_from_this());
     }
-    if (auto *ei = dynamic_cast<EdgeIdentity<L> *>(secondFunction.get())) {
-      return this->shared_from_this();
-    }
-    return secondFunction->composeWith(this->shared_from_this());
   }
 
   EdgeFunctionPtrType joinWith(EdgeFunctionPtrType otherFunction) override {
-    if (otherFunction.get() == this ||
-        otherFunction->equal_to(this->shared_from_this())) {
-      return this->shared_from_this();
-    }
-    if (auto *alltop = dynamic_cast<AllTop<L> *>(otherFunction.get())) {
-      return this->shared_from_this();
-    }
-    if (auto *ei = dynamic_cast<EdgeIdentity<L> *>(otherFunction.get())) {
-      return this->shared_from_this();
-    }
     return this->shared_from_this();
   }
 
   bool equal_to(EdgeFunctionPtrType other) const override {
-    if (auto *allbottom = dynamic_cast<AllBottom<L> *>(other.get())) {
-      return (allbottom->bottomElement == bottomElement);
+    if (other->getKind() == EdgeFunctionKind::AllBottom) {
+      return static_cast<AllBottom<L> *>(other.get())->bottomElement ==
+             bottomElement;
     }
     return false;
   }
@@ -201,7 +221,7 @@ public:
   using typename EdgeFunction<L>::EdgeFunctionPtrType;
 
 private:
-  EdgeIdentity() = default;
+  EdgeIdentity() : EdgeFunction<L>(EdgeFunctionKind::Identity) {}
 
 public:
   EdgeIdentity(const EdgeIdentity &ei) = delete;
@@ -217,14 +237,16 @@ public:
   }
 
   EdgeFunctionPtrType joinWith(EdgeFunctionPtrType otherFunction) override {
-    if ((otherFunction.get() == this) ||
-        otherFunction->equal_to(this->shared_from_this())) {
+    switch (otherFunction->getKind()) {
+    case EdgeFunctionKind::Identity:
+    case EdgeFunctionKind::AllTop:
       return this->shared_from_this();
-    }
-    if (auto *ab = dynamic_cast<AllBottom<L> *>(otherFunction.get())) {
+    case EdgeFunctionKind::AllBottom:
       return otherFunction;
+    default:
+      break;
     }
-    if (auto *at = dynamic_cast<AllTop<L> *>(otherFunction.get())) {
+    if (otherFunction->equal_to(this->shared_from_this())) {
       return this->shared_from_this();
     }
     // do not know how to join; hence ask other function to decide on this
@@ -491,9 +513,12 @@ public:
 // inheriting from EdgeFunctionSingletonFactory and only allocating
 // EdgeFunction throught the provided createEdgeFunction method.
 //
-// Old unused EdgeFunction that were deallocated need to/should be clean from
-// the factory by either calling cleanExpiredEdgeFunctions or initializing the
-// automatic cleaner thread with initEdgeFunctionCleaner.
+// The interned EdgeFunctions are kept in a hash table that is split into
+// NumShards independently locked shards, such that concurrent solvers rarely
+// contend on the same lock. Lookups of existing EdgeFunctions only need a
+// shared lock. An EdgeFunction removes its own entry from the table as soon as
+// its last owner releases it, hence, no cleaning is required. CtorArgT must be
+// hashable with std::hash.
 template <typename EdgeFunctionType, typename CtorArgT>
 class EdgeFunctionSingletonFactory {
 public:
@@ -506,125 +531,103 @@ public:
   EdgeFunctionSingletonFactory &
   operator=(EdgeFunctionSingletonFactory &&) noexcept = default;
 
-  virtual ~EdgeFunctionSingletonFactory() {
-    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
-  }
+  virtual ~EdgeFunctionSingletonFactory() = default;
 
   // Creates a new EdgeFunction of type EdgeFunctionType, reusing the previous
   // allocation if an EdgeFunction with the same values was already created.
   static inline std::shared_ptr<EdgeFunctionType>
   createEdgeFunction(CtorArgT K) {
-    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
-
-    auto &Storage = getCacheData().Storage;
-    auto SearchVal = Storage.find(K);
-    if (SearchVal != Storage.end() && !SearchVal->second.expired()) {
-      return SearchVal->second.lock();
-    } else {
-      auto NewEdgeFunc = std::make_shared<EdgeFunctionType>(K);
-      Storage[K] = NewEdgeFunc;
-      return NewEdgeFunc;
+    auto &S = getShard(K);
+    {
+      std::shared_lock<std::shared_mutex> ReadLock(S.DataMutex);
+      auto SearchVal = S.Storage.find(K);
+      if (SearchVal != S.Storage.end()) {
+        if (auto EF = SearchVal->second.lock()) {
+          return EF;
+        }
+      }
     }
+    std::unique_lock<std::shared_mutex> WriteLock(S.DataMutex);
+    auto &Entry = S.Storage[K];
+    // Another thread may have created the EdgeFunction in the meantime.
+    if (auto EF = Entry.lock()) {
+      return EF;
+    }
+    std::shared_ptr<EdgeFunctionType> NewEdgeFunc(new EdgeFunctionType(K),
+                                                  Reclaimer{K});
+    Entry = NewEdgeFunc;
+    return NewEdgeFunc;
   }
 
-  // Initialize a cleaner thread to automatically remove unused/expired
-  // EdgeFunctions. The thread is only started the first time this function is
-  // called.
-  static inline void initEdgeFunctionCleaner() { getCleaner(); }
-
-  static inline void stopEdgeFunctionCleaner() { getCleaner().stop(); }
-
-  // Clean all unused/expired EdgeFunctions from the internal storage.
-  static inline void cleanExpiredEdgeFunctions() {
-    cleanExpiredMapEntries(getCacheData());
+  // Returns the number of EdgeFunctions that are currently alive.
+  static size_t size() {
+    size_t Size = 0;
+    for (auto &S : getShards()) {
+      std::shared_lock<std::shared_mutex> ReadLock(S.DataMutex);
+      Size += S.Storage.size();
+    }
+    return Size;
   }
 
   LLVM_DUMP_METHOD
   static void dump(bool PrintElements = false) {
-    std::lock_guard<std::mutex> DataLock(getCacheData().DataMutex);
-
-    std::cout << "Elements in cache: " << getCacheData().Storage.size();
+    std::cout << "Elements in cache: " << size();
 
     if (PrintElements) {
       std::cout << "\n";
-      for (auto &KVPair : getCacheData().Storage) {
-        std::cout << "(" << KVPair.first << ") -> " << std::boolalpha
-                  << KVPair.second.expired() << std::endl;
+      for (auto &S : getShards()) {
+        std::shared_lock<std::shared_mutex> ReadLock(S.DataMutex);
+        for (auto &KVPair : S.Storage) {
+          std::cout << "(" << KVPair.first << ") -> " << std::boolalpha
+                    << KVPair.second.expired() << std::endl;
+        }
       }
     }
     std::cout << std::endl;
   }
 
 private:
-  struct EFStorageData {
-    std::map<CtorArgT, std::weak_ptr<EdgeFunctionType>> Storage{};
-    std::mutex DataMutex;
-  };
+  static constexpr size_t NumShards = 64;
 
-  static inline EFStorageData &getCacheData() {
-    static EFStorageData StoredData{};
-    return StoredData;
-  }
-
-  static void cleanExpiredMapEntries(EFStorageData &CData) {
-    std::lock_guard<std::mutex> DataLock(CData.DataMutex);
-
-    auto &Storage = CData.Storage;
-    for (auto Iter = Storage.begin(); Iter != Storage.end();) {
-      if (Iter->second.expired()) {
-        Iter = Storage.erase(Iter);
-      } else {
-        ++Iter;
-      }
-    }
-  }
-
-  class EdgeFactoryStorageCleaner {
-  public:
-    EdgeFactoryStorageCleaner()
-        : CleanerThread(&EdgeFactoryStorageCleaner::runCleaner, this,
-                        std::reference_wrapper<EFStorageData>(
-                            EdgeFunctionSingletonFactory::getCacheData())) {
-#ifdef __linux__
-      pthread_setname_np(CleanerThread.native_handle(),
-                         "EdgeFactoryStorageCleanerThread");
-#endif
-    }
-    EdgeFactoryStorageCleaner(const EdgeFactoryStorageCleaner &) = delete;
-    EdgeFactoryStorageCleaner &
-    operator=(const EdgeFactoryStorageCleaner &) = delete;
-    EdgeFactoryStorageCleaner(EdgeFactoryStorageCleaner &&) = delete;
-    EdgeFactoryStorageCleaner &operator=(EdgeFactoryStorageCleaner &&) = delete;
-    ~EdgeFactoryStorageCleaner() { stop(); }
-
-    // Stops the cleaning thread running in the background.
-    void stop() {
-      KeepRunning = false;
-      if (CleanerThread.joinable()) {
-        CleanerThread.join();
-      }
-    }
+  // Each shard lives on its own cache line to avoid false sharing between
+  // threads that work on different shards.
+  struct alignas(64) EFStorageShard {
+    std::unordered_map<CtorArgT, std::weak_ptr<EdgeFunctionType>> Storage{};
+    std::shared_mutex DataMutex;
+  };
 
-  private:
-    void runCleaner(EFStorageData &CData) {
-      while (KeepRunning) {
-        std::this_thread::sleep_for(CleaningPauseTime);
-        cleanExpiredMapEntries(CData);
+  using EFStorageData = std::array<EFStorageShard, NumShards>;
+
+  // Deleter of the interned EdgeFunctions that removes the corresponding
+  // entry from the table before the EdgeFunction is destroyed.
+  struct Reclaimer {
+    CtorArgT K;
+
+    void operator()(EdgeFunctionType *EF) const {
+      {
+        auto &S = getShard(K);
+        std::unique_lock<std::shared_mutex> WriteLock(S.DataMutex);
+        auto SearchVal = S.Storage.find(K);
+        // The entry may already refer to a new EdgeFunction that was created
+        // after the last owner of EF released it.
+        if (SearchVal != S.Storage.end() && SearchVal->second.expired()) {
+          S.Storage.erase(SearchVal);
+        }
       }
+      delete EF;
     }
-
-    static constexpr auto CleaningPauseTime = std::chrono::seconds(2);
-
-    std::atomic_bool KeepRunning{true};
-    std::thread CleanerThread;
   };
 
-  static inline EdgeFactoryStorageCleaner &getCleaner() {
-    static EdgeFactoryStorageCleaner EdgeFunctionCleaner{};
-    return EdgeFunctionCleaner;
+  static inline EFStorageData &getShards() {
+    // Intentionally leaked, as EdgeFunctions may still be released during
+    // static destruction.
+    static auto *StoredData = new EFStorageData();
+    return *StoredData;
   }
 
-  friend internal::TestEdgeFunction;
+  static inline EFStorageShard &getShard(const CtorArgT &K) {
+    return getShards()[std::hash<CtorArgT>{}(K) % NumShards];
+  }
 };
 
 } // namespace psr
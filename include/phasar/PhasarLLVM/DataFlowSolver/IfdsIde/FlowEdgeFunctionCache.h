@@ -13,17 +13,21 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFact.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
 #include "phasar/Utils/EquivalenceClassMap.h"
+#include "phasar/Utils/LRUCache.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
 
@@ -63,6 +67,11 @@ private:
  * When a flow or edge function must be applied to multiple times, a cached
  * version is used if existend, otherwise a new one is created and inserted
  * into the cache.
+ *
+ * The caches are hash tables keyed by the compressed IDs of the instructions
+ * and data-flow facts. Their number of entries can be bounded, see
+ * setCapacity(), in which case the least recently used entries are evicted
+ * and reconstructed if they are needed again.
  */
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>>
@@ -98,6 +107,50 @@ private:
   using InnerEdgeFunctionMapType =
       EquivalenceClassMap<EdgeFuncNodeKey, EdgeFunctionPtrType>;
 
+  using NKey = typename NTKeyCompressorType::CompressedType;
+  using DKey = typename DTKeyCompressorType::CompressedType;
+
+  struct TupleHash {
+    template <typename... Ts>
+    size_t operator()(const std::tuple<Ts...> &Key) const {
+      return std::apply(
+          [](const auto &...Elems) -> size_t {
+            return llvm::hash_combine(
+                std::hash<std::decay_t<decltype(Elems)>>{}(Elems)...);
+          },
+          Key);
+    }
+  };
+
+  // The set of callees is hashed only once, when the key is created.
+  struct CallToRetKey {
+    CallToRetKey(EdgeFuncInstKey InstKey, std::set<f_t> Callees)
+        : InstKey(InstKey), Callees(std::move(Callees)), Hash(InstKey) {
+      for (const auto &Callee : this->Callees) {
+        Hash = llvm::hash_combine(Hash, std::hash<f_t>{}(Callee));
+      }
+    }
+
+    friend bool operator==(const CallToRetKey &Lhs, const CallToRetKey &Rhs) {
+      return Lhs.Hash == Rhs.Hash && Lhs.InstKey == Rhs.InstKey &&
+             Lhs.Callees == Rhs.Callees;
+    }
+
+    EdgeFuncInstKey InstKey;
+    std::set<f_t> Callees;
+    size_t Hash;
+  };
+
+  struct CallToRetKeyHash {
+    size_t operator()(const CallToRetKey &Key) const { return Key.Hash; }
+  };
+
+  template <typename KeyT, typename ValueT>
+  using CacheType =
+      LRUCache<KeyT, ValueT,
+               std::conditional_t<std::is_integral_v<KeyT>, std::hash<KeyT>,
+                                  TupleHash>>;
+
   IDETabulationProblem<AnalysisDomainTy, Container> &problem;
   // Auto add zero
   bool autoAddZero;
@@ -114,25 +167,38 @@ private:
   };
 
   // Caches for the flow/edge functions
-  std::map<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
+  CacheType<EdgeFuncInstKey, NormalEdgeFlowData> NormalFunctionCache;
 
   // Caches for the flow functions
-  std::map<std::tuple<n_t, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType>
+  CacheType<std::tuple<NKey, f_t>, FlowFunctionPtrType> CallFlowFunctionCache;
+  CacheType<std::tuple<EdgeFuncInstKey, NKey, f_t>, FlowFunctionPtrType>
       ReturnFlowFunctionCache;
-  std::map<std::tuple<n_t, n_t, std::set<f_t>>, FlowFunctionPtrType>
+  LRUCache<CallToRetKey, FlowFunctionPtrType, CallToRetKeyHash>
       CallToRetFlowFunctionCache;
   // Caches for the edge functions
-  std::map<std::tuple<n_t, d_t, f_t, d_t>, EdgeFunctionPtrType>
+  CacheType<std::tuple<NKey, DKey, f_t, DKey>, EdgeFunctionPtrType>
       CallEdgeFunctionCache;
-  std::map<std::tuple<n_t, f_t, n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
+  CacheType<std::tuple<EdgeFuncInstKey, NKey, f_t, DKey, DKey>,
+            EdgeFunctionPtrType>
       ReturnEdgeFunctionCache;
-  std::map<EdgeFuncInstKey, InnerEdgeFunctionMapType>
+  CacheType<EdgeFuncInstKey, InnerEdgeFunctionMapType>
       CallToRetEdgeFunctionCache;
-  std::map<std::tuple<n_t, d_t, n_t, d_t>, EdgeFunctionPtrType>
+  CacheType<std::tuple<EdgeFuncInstKey, DKey, DKey>, EdgeFunctionPtrType>
       SummaryEdgeFunctionCache;
 
+  bool ThreadSafe = false;
+  // shared to keep the cache copyable
+  std::shared_ptr<std::mutex> CacheMutex = std::make_shared<std::mutex>();
+
 public:
+  /// Statistics of one of the caches.
+  struct CacheStatistics {
+    size_t Hits = 0;
+    size_t Misses = 0;
+    size_t Evictions = 0;
+    size_t Size = 0;
+  };
+
   // Ctor allows access to the IDEProblem in order to get access to flow and
   // edge function factory functions.
   FlowEdgeFunctionCache(
@@ -170,6 +236,15 @@ public:
     // Counters for the summary edge functions
     REG_COUNTER("Summary-EF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
     REG_COUNTER("Summary-EF Cache Hit", 0, PAMM_SEVERITY_LEVEL::Full);
+    // Counters for the sizes of and the evictions from the caches
+    forEachCache([&](const char *Name, const auto & /*Cache*/) {
+      REG_COUNTER(std::string(Name) + " Cache Size", 0,
+                  PAMM_SEVERITY_LEVEL::Full);
+      REG_COUNTER(std::string(Name) + " Cache Eviction", 0,
+                  PAMM_SEVERITY_LEVEL::Full);
+    });
+    setCapacity(
+        problem.getIFDSIDESolverConfig().flowEdgeFunctionCacheCapacity());
   }
 
   ~FlowEdgeFunctionCache() = default;
@@ -181,7 +256,37 @@ public:
   FlowEdgeFunctionCache &
   operator=(FlowEdgeFunctionCache &&FEFC) noexcept = default;
 
+  /// If set, queries may be issued from multiple threads concurrently. The
+  /// queries are then serialized, which includes the calls to the problem's
+  /// flow and edge function factories.
+  void setThreadSafe(bool Set = true) { ThreadSafe = Set; }
+
+  [[nodiscard]] bool isThreadSafe() const { return ThreadSafe; }
+
+  /// Bounds the number of entries of each of the caches, zero means
+  /// unbounded. The least recently used entries are evicted first.
+  void setCapacity(size_t Capacity) {
+    auto Lock = lockCache();
+    forEachCache([Capacity](const char * /*Name*/, auto &Cache) {
+      Cache.setCapacity(Capacity);
+    });
+  }
+
+  /// Returns the statistics of each of the caches by their names. The
+  /// "Normal" cache holds the normal flow functions along with their edge
+  /// functions.
+  [[nodiscard]] std::map<std::string, CacheStatistics> getStatistics() {
+    auto Lock = lockCache();
+    std::map<std::string, CacheStatistics> Stats;
+    forEachCache([&Stats](const char *Name, const auto &Cache) {
+      Stats[Name] = {Cache.hits(), Cache.misses(), Cache.evictions(),
+                     Cache.size()};
+    });
+    return Stats;
+  }
+
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Normal flow function factory call";
@@ -190,21 +295,21 @@ public:
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Succ Inst : " << problem.NtoString(succ));
     auto Key = createEdgeFunctionInstKey(curr, succ);
-    auto SearchNormalFlowFunction = NormalFunctionCache.find(Key);
-    if (SearchNormalFlowFunction != NormalFunctionCache.end()) {
+    auto *SearchNormalFlowFunction = NormalFunctionCache.lookup(Key);
+    if (SearchNormalFlowFunction) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Normal-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      if (SearchNormalFlowFunction->second.FlowFuncPtr != nullptr) {
-        return SearchNormalFlowFunction->second.FlowFuncPtr;
+      if (SearchNormalFlowFunction->FlowFuncPtr != nullptr) {
+        return SearchNormalFlowFunction->FlowFuncPtr;
       } else {
         auto ff =
             (autoAddZero)
                 ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                       problem.getNormalFlowFunction(curr, succ), zeroValue)
                 : problem.getNormalFlowFunction(curr, succ);
-        SearchNormalFlowFunction->second.FlowFuncPtr = ff;
+        SearchNormalFlowFunction->FlowFuncPtr = ff;
         return ff;
       }
     } else {
@@ -213,7 +318,7 @@ public:
                     ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                           problem.getNormalFlowFunction(curr, succ), zeroValue)
                     : problem.getNormalFlowFunction(curr, succ);
-      NormalFunctionCache.insert(std::make_pair(Key, NormalEdgeFlowData(ff)));
+      insertInto(NormalFunctionCache, "Normal", Key, NormalEdgeFlowData(ff));
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -222,6 +327,7 @@ public:
   }
 
   FlowFunctionPtrType getCallFlowFunction(n_t callSite, f_t destFun) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Call flow function factory call";
@@ -229,14 +335,15 @@ public:
                   << "(N) Call Stmt : " << problem.NtoString(callSite);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(F) Dest Fun : " << problem.FtoString(destFun));
-    auto Key = std::tie(callSite, destFun);
-    auto SearchCallFlowFunction = CallFlowFunctionCache.find(Key);
-    if (SearchCallFlowFunction != CallFlowFunctionCache.end()) {
+    auto Key =
+        std::make_tuple(KeyCompressor.getCompressedID(callSite), destFun);
+    auto *SearchCallFlowFunction = CallFlowFunctionCache.lookup(Key);
+    if (SearchCallFlowFunction) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Call-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchCallFlowFunction->second;
+      return *SearchCallFlowFunction;
     } else {
       INC_COUNTER("Call-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff =
@@ -244,7 +351,7 @@ public:
               ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
                     problem.getCallFlowFunction(callSite, destFun), zeroValue)
               : problem.getCallFlowFunction(callSite, destFun);
-      CallFlowFunctionCache.insert(std::make_pair(Key, ff));
+      insertInto(CallFlowFunctionCache, "Call-FF", Key, ff);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -254,6 +361,7 @@ public:
 
   FlowFunctionPtrType getRetFlowFunction(n_t callSite, f_t calleeFun,
                                          n_t exitInst, n_t retSite) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Return flow function factory call";
@@ -265,14 +373,16 @@ public:
                   << "(N) Exit Stmt : " << problem.NtoString(exitInst);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(N) Ret Site  : " << problem.NtoString(retSite));
-    auto Key = std::tie(callSite, calleeFun, exitInst, retSite);
-    auto SearchReturnFlowFunction = ReturnFlowFunctionCache.find(Key);
-    if (SearchReturnFlowFunction != ReturnFlowFunctionCache.end()) {
+    auto Key = std::make_tuple(createEdgeFunctionInstKey(callSite, retSite),
+                               KeyCompressor.getCompressedID(exitInst),
+                               calleeFun);
+    auto *SearchReturnFlowFunction = ReturnFlowFunctionCache.lookup(Key);
+    if (SearchReturnFlowFunction) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("Return-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchReturnFlowFunction->second;
+      return *SearchReturnFlowFunction;
     } else {
       INC_COUNTER("Return-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ff = (autoAddZero)
@@ -282,7 +392,7 @@ public:
                           zeroValue)
                     : problem.getRetFlowFunction(callSite, calleeFun, exitInst,
                                                  retSite);
-      ReturnFlowFunctionCache.insert(std::make_pair(Key, ff));
+      insertInto(ReturnFlowFunctionCache, "Return-FF", Key, ff);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -292,6 +402,7 @@ public:
 
   FlowFunctionPtrType getCallToRetFlowFunction(n_t callSite, n_t retSite,
                                                std::set<f_t> callees) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -304,24 +415,26 @@ public:
                                                                     : callees) {
           BOOST_LOG_SEV(lg::get(), DEBUG) << "  " << problem.FtoString(callee);
         });
-    auto Key = std::tie(callSite, retSite, callees);
-    auto SearchCallToRetFlowFunction = CallToRetFlowFunctionCache.find(Key);
-    if (SearchCallToRetFlowFunction != CallToRetFlowFunctionCache.end()) {
+    CallToRetKey Key(createEdgeFunctionInstKey(callSite, retSite),
+                     std::move(callees));
+    auto *SearchCallToRetFlowFunction = CallToRetFlowFunctionCache.lookup(Key);
+    if (SearchCallToRetFlowFunction) {
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       INC_COUNTER("CallToRet-FF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
-      return SearchCallToRetFlowFunction->second;
+      return *SearchCallToRetFlowFunction;
     } else {
       INC_COUNTER("CallToRet-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
-      auto ff =
-          (autoAddZero)
-              ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
-                    problem.getCallToRetFlowFunction(callSite, retSite,
-                                                     callees),
-                    zeroValue)
-              : problem.getCallToRetFlowFunction(callSite, retSite, callees);
-      CallToRetFlowFunctionCache.insert(std::make_pair(Key, ff));
+      auto ff = (autoAddZero)
+                    ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+                          problem.getCallToRetFlowFunction(callSite, retSite,
+                                                           Key.Callees),
+                          zeroValue)
+                    : problem.getCallToRetFlowFunction(callSite, retSite,
+                                                       Key.Callees);
+      insertInto(CallToRetFlowFunctionCache, "CallToRet-FF", std::move(Key),
+                 ff);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Flow function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -330,6 +443,7 @@ public:
   }
 
   FlowFunctionPtrType getSummaryFlowFunction(n_t callSite, f_t destFun) {
+    auto Lock = lockCache();
     // PAMM_GET_INSTANCE;
     // INC_COUNTER("Summary-FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -345,6 +459,7 @@ public:
 
   EdgeFunctionPtrType getNormalEdgeFunction(n_t curr, d_t currNode, n_t succ,
                                             d_t succNode) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Normal edge function factory call";
@@ -358,11 +473,11 @@ public:
                   << "(D) Succ Node : " << problem.DtoString(succNode));
 
     EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(curr, succ);
-    auto SearchInnerMap = NormalFunctionCache.find(OuterMapKey);
-    if (SearchInnerMap != NormalFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.EdgeFunctionMap.find(
+    auto *SearchInnerMap = NormalFunctionCache.lookup(OuterMapKey);
+    if (SearchInnerMap) {
+      auto SearchEdgeFunc = SearchInnerMap->EdgeFunctionMap.find(
           createEdgeFunctionNodeKey(currNode, succNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.EdgeFunctionMap.end()) {
+      if (SearchEdgeFunc != SearchInnerMap->EdgeFunctionMap.end()) {
         INC_COUNTER("Normal-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Edge function fetched from cache";
@@ -375,7 +490,7 @@ public:
       INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
 
-      SearchInnerMap->second.EdgeFunctionMap.insert(
+      SearchInnerMap->EdgeFunctionMap.insert(
           createEdgeFunctionNodeKey(currNode, succNode), ef);
 
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -388,9 +503,9 @@ public:
     INC_COUNTER("Normal-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     auto ef = problem.getNormalEdgeFunction(curr, currNode, succ, succNode);
 
-    NormalFunctionCache.try_emplace(
-        OuterMapKey, NormalEdgeFlowData(InnerEdgeFunctionMapType{std::make_pair(
-                         createEdgeFunctionNodeKey(currNode, succNode), ef)}));
+    insertInto(NormalFunctionCache, "Normal", OuterMapKey,
+               NormalEdgeFlowData(InnerEdgeFunctionMapType{std::make_pair(
+                   createEdgeFunctionNodeKey(currNode, succNode), ef)}));
 
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Edge function constructed";
@@ -403,6 +518,7 @@ public:
   EdgeFunctionPtrType getCallEdgeFunction(n_t callSite, d_t srcNode,
                                           f_t destinationFunction,
                                           d_t destNode) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG) << "Call edge function factory call";
@@ -414,22 +530,25 @@ public:
         << "(F) Dest Fun : " << problem.FtoString(destinationFunction);
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "(D) Dest Node : " << problem.DtoString(destNode));
-    auto Key = std::tie(callSite, srcNode, destinationFunction, destNode);
-    auto SearchCallEdgeFunction = CallEdgeFunctionCache.find(Key);
-    if (SearchCallEdgeFunction != CallEdgeFunctionCache.end()) {
+    auto Key = std::make_tuple(KeyCompressor.getCompressedID(callSite),
+                               KeyCompressor.getCompressedID(srcNode),
+                               destinationFunction,
+                               KeyCompressor.getCompressedID(destNode));
+    auto *SearchCallEdgeFunction = CallEdgeFunctionCache.lookup(Key);
+    if (SearchCallEdgeFunction) {
       INC_COUNTER("Call-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                     << "Provide Edge Function: "
-                    << SearchCallEdgeFunction->second->str());
-      return SearchCallEdgeFunction->second;
+                    << (*SearchCallEdgeFunction)->str());
+      return *SearchCallEdgeFunction;
     } else {
       INC_COUNTER("Call-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getCallEdgeFunction(callSite, srcNode,
                                             destinationFunction, destNode);
-      CallEdgeFunctionCache.insert(std::make_pair(Key, ef));
+      insertInto(CallEdgeFunctionCache, "Call-EF", Key, ef);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -442,6 +561,7 @@ public:
   EdgeFunctionPtrType getReturnEdgeFunction(n_t callSite, f_t calleeFunction,
                                             n_t exitInst, d_t exitNode,
                                             n_t reSite, d_t retNode) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Return edge function factory call";
@@ -457,23 +577,26 @@ public:
                   << "(N) Ret Site  : " << problem.NtoString(reSite);
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retNode));
-    auto Key =
-        std::tie(callSite, calleeFunction, exitInst, exitNode, reSite, retNode);
-    auto SearchReturnEdgeFunction = ReturnEdgeFunctionCache.find(Key);
-    if (SearchReturnEdgeFunction != ReturnEdgeFunctionCache.end()) {
+    auto Key = std::make_tuple(createEdgeFunctionInstKey(callSite, reSite),
+                               KeyCompressor.getCompressedID(exitInst),
+                               calleeFunction,
+                               KeyCompressor.getCompressedID(exitNode),
+                               KeyCompressor.getCompressedID(retNode));
+    auto *SearchReturnEdgeFunction = ReturnEdgeFunctionCache.lookup(Key);
+    if (SearchReturnEdgeFunction) {
       INC_COUNTER("Return-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                     << "Provide Edge Function: "
-                    << SearchReturnEdgeFunction->second->str());
-      return SearchReturnEdgeFunction->second;
+                    << (*SearchReturnEdgeFunction)->str());
+      return *SearchReturnEdgeFunction;
     } else {
       INC_COUNTER("Return-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getReturnEdgeFunction(
           callSite, calleeFunction, exitInst, exitNode, reSite, retNode);
-      ReturnEdgeFunctionCache.insert(std::make_pair(Key, ef));
+      insertInto(ReturnEdgeFunctionCache, "Return-EF", Key, ef);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -486,6 +609,7 @@ public:
   EdgeFunctionPtrType getCallToRetEdgeFunction(n_t callSite, d_t callNode,
                                                n_t retSite, d_t retSiteNode,
                                                std::set<f_t> callees) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -504,11 +628,11 @@ public:
         });
 
     EdgeFuncInstKey OuterMapKey = createEdgeFunctionInstKey(callSite, retSite);
-    auto SearchInnerMap = CallToRetEdgeFunctionCache.find(OuterMapKey);
-    if (SearchInnerMap != CallToRetEdgeFunctionCache.end()) {
-      auto SearchEdgeFunc = SearchInnerMap->second.find(
+    auto *SearchInnerMap = CallToRetEdgeFunctionCache.lookup(OuterMapKey);
+    if (SearchInnerMap) {
+      auto SearchEdgeFunc = SearchInnerMap->find(
           createEdgeFunctionNodeKey(callNode, retSiteNode));
-      if (SearchEdgeFunc != SearchInnerMap->second.end()) {
+      if (SearchEdgeFunc != SearchInnerMap->end()) {
         INC_COUNTER("CallToRet-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Edge function fetched from cache";
@@ -522,8 +646,8 @@ public:
       auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
                                                  retSiteNode, callees);
 
-      SearchInnerMap->second.insert(
-          createEdgeFunctionNodeKey(callNode, retSiteNode), ef);
+      SearchInnerMap->insert(createEdgeFunctionNodeKey(callNode, retSiteNode),
+                             ef);
 
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
@@ -537,10 +661,9 @@ public:
     auto ef = problem.getCallToRetEdgeFunction(callSite, callNode, retSite,
                                                retSiteNode, callees);
 
-    CallToRetEdgeFunctionCache.emplace(
-        OuterMapKey,
-        InnerEdgeFunctionMapType{std::make_pair(
-            createEdgeFunctionNodeKey(callNode, retSiteNode), ef)});
+    insertInto(CallToRetEdgeFunctionCache, "CallToRet-EF", OuterMapKey,
+               InnerEdgeFunctionMapType{std::make_pair(
+                   createEdgeFunctionNodeKey(callNode, retSiteNode), ef)});
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Edge function constructed";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -551,6 +674,7 @@ public:
 
   EdgeFunctionPtrType getSummaryEdgeFunction(n_t callSite, d_t callNode,
                                              n_t retSite, d_t retSiteNode) {
+    auto Lock = lockCache();
     PAMM_GET_INSTANCE;
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Summary edge function factory call";
@@ -563,22 +687,24 @@ public:
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "(D) Ret Node  : " << problem.DtoString(retSiteNode);
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-    auto Key = std::tie(callSite, callNode, retSite, retSiteNode);
-    auto SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.find(Key);
-    if (SearchSummaryEdgeFunction != SummaryEdgeFunctionCache.end()) {
+    auto Key = std::make_tuple(createEdgeFunctionInstKey(callSite, retSite),
+                               KeyCompressor.getCompressedID(callNode),
+                               KeyCompressor.getCompressedID(retSiteNode));
+    auto *SearchSummaryEdgeFunction = SummaryEdgeFunctionCache.lookup(Key);
+    if (SearchSummaryEdgeFunction) {
       INC_COUNTER("Summary-EF Cache Hit", 1, PAMM_SEVERITY_LEVEL::Full);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function fetched from cache";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                     << "Provide Edge Function: "
-                    << SearchSummaryEdgeFunction->second->str());
-      return SearchSummaryEdgeFunction->second;
+                    << (*SearchSummaryEdgeFunction)->str());
+      return *SearchSummaryEdgeFunction;
     } else {
       INC_COUNTER("Summary-EF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
       auto ef = problem.getSummaryEdgeFunction(callSite, callNode, retSite,
                                                retSiteNode);
-      SummaryEdgeFunctionCache.insert(std::make_pair(Key, ef));
+      insertInto(SummaryEdgeFunctionCache, "Summary-EF", Key, ef);
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                         << "Edge function constructed";
                     BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
@@ -680,6 +806,12 @@ public:
                             "Return-EF Construction",
                             "CallToRet-EF Construction",
                             "Summary-EF Construction"}));
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << ' ');
+      for (const auto &[Name, Stats] : getStatistics()) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                      << Name << " cache size: " << Stats.Size
+                      << ", evictions: " << Stats.Evictions);
+      }
       LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                     << "----------------------------------------------");
     } else {
@@ -690,6 +822,43 @@ public:
   }
 
 private:
+  template <typename HandlerFn> void forEachCache(HandlerFn Handler) {
+    Handler("Normal", NormalFunctionCache);
+    Handler("Call-FF", CallFlowFunctionCache);
+    Handler("Return-FF", ReturnFlowFunctionCache);
+    Handler("CallToRet-FF", CallToRetFlowFunctionCache);
+    Handler("Call-EF", CallEdgeFunctionCache);
+    Handler("Return-EF", ReturnEdgeFunctionCache);
+    Handler("CallToRet-EF", CallToRetEdgeFunctionCache);
+    Handler("Summary-EF", SummaryEdgeFunctionCache);
+  }
+
+  // Inserts into the given cache and keeps the PAMM counters for its size and
+  // evictions up to date.
+  template <typename CacheT, typename KeyT, typename ValueT>
+  void insertInto(CacheT &Cache, [[maybe_unused]] const char *Name, KeyT &&Key,
+                  ValueT &&Value) {
+    [[maybe_unused]] size_t Evictions = Cache.evictions();
+    Cache.insert(std::forward<KeyT>(Key), std::forward<ValueT>(Value));
+    if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Full) {
+      PAMM_GET_INSTANCE;
+      size_t Evicted = Cache.evictions() - Evictions;
+      INC_COUNTER(std::string(Name) + " Cache Size", 1,
+                  PAMM_SEVERITY_LEVEL::Full);
+      if (Evicted != 0) {
+        DEC_COUNTER(std::string(Name) + " Cache Size", Evicted,
+                    PAMM_SEVERITY_LEVEL::Full);
+        INC_COUNTER(std::string(Name) + " Cache Eviction", Evicted,
+                    PAMM_SEVERITY_LEVEL::Full);
+      }
+    }
+  }
+
+  std::unique_lock<std::mutex> lockCache() {
+    return ThreadSafe ? std::unique_lock<std::mutex>(*CacheMutex)
+                      : std::unique_lock<std::mutex>();
+  }
+
   inline EdgeFuncInstKey createEdgeFunctionInstKey(n_t n1, n_t n2) {
     uint64_t val = 0;
     val |= KeyCompressor.getCompressedID(n1);
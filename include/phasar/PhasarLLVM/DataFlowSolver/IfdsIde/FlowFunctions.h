@@ -21,6 +21,7 @@
 #include <memory>
 #include <set>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace psr {
@@ -98,7 +99,8 @@ private:
 };
 
 template <typename D, typename Fn, typename Container = std::set<D>>
-typename FlowFunction<D>::FlowFunctionPtrType makeLambdaFlow(Fn &&fn) {
+typename FlowFunction<D, Container>::FlowFunctionPtrType
+makeLambdaFlow(Fn &&fn) {
   return std::make_shared<LambdaFlow<D, std::decay_t<Fn>, Container>>(
       std::forward<Fn>(fn));
 }
@@ -275,7 +277,7 @@ class KillMultiple : public FlowFunction<D, Container> {
 public:
   using typename FlowFunction<D, Container>::container_type;
 
-  KillMultiple(std::set<D> killValues) : killValues(killValues) {}
+  KillMultiple(container_type killValues) : killValues(std::move(killValues)) {}
   virtual ~KillMultiple() = default;
   container_type computeTargets(D source) override {
     if (killValues.find(source) != killValues.end()) {
@@ -298,7 +300,7 @@ public:
   KillAll(const KillAll &k) = delete;
   KillAll &operator=(const KillAll &k) = delete;
   container_type computeTargets(D source) override { return container_type(); }
-  static std::shared_ptr<KillAll<D>> getInstance() {
+  static std::shared_ptr<KillAll> getInstance() {
     static std::shared_ptr<KillAll> instance =
         std::shared_ptr<KillAll>(new KillAll);
     return instance;
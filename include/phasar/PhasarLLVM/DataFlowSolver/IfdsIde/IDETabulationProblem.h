@@ -66,6 +66,21 @@ public:
   /// Returns an edge function that represents the top element of the analysis.
   virtual EdgeFunctionPtrType allTopFunction() = 0;
 
+  /// Returns a string that represents the edge function of an end summary in
+  /// a store of persisted summaries, or an empty string if the edge function
+  /// cannot be persisted, which is the default.
+  [[nodiscard]] virtual std::string
+  edgeFunctionToSummaryString(const EdgeFunctionPtrType &EF) {
+    return {};
+  }
+
+  /// Returns the edge function represented by a string that has been created
+  /// by edgeFunctionToSummaryString(), or nullptr if there is none.
+  virtual EdgeFunctionPtrType
+  edgeFunctionFromSummaryString(const std::string &S) {
+    return nullptr;
+  }
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Winconsistent-missing-override"
 #pragma clang diagnostic ignored "-Wsuggest-override"
@@ -18,14 +18,20 @@
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVERCONFIGURATION_H_
 
 #include <iosfwd>
+#include <memory>
+#include <string>
 
 #include "phasar/Config/Configuration.h"
 #include "phasar/Utils/EnumFlags.h"
 #include "phasar/Utils/Logger.h"
+#include "phasar/Utils/SolverBudget.h"
 #include "phasar/Utils/Utilities.h"
 
 namespace psr {
 
+class IFDSSummaryPool;
+class SummaryStore;
+
 enum class SolverConfigOptions : uint32_t {
   None = 0,
   FollowReturnsPastSeeds = 1,
@@ -34,10 +40,29 @@ enum class SolverConfigOptions : uint32_t {
   RecordEdges = 8,
   EmitESG = 16,
   ComputePersistedSummaries = 32,
+  DenseJumpFunctions = 64,
+  RetireJumpFunctions = 128,
+  PersistJumpFunctions = 256,
+  ResumeFromCheckpoint = 512,
+  LazyValues = 1024,
 
   All = ~0u
 };
 
+/// Determines the order in which the IDESolver's worklist hands out pending
+/// path edges during the tabulation (Phase I).
+enum class WorklistPolicy {
+#define WORKLIST_POLICY_TYPE(NAME, TYPE) TYPE,
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicy.def"
+  Invalid
+};
+
+std::string toString(const WorklistPolicy &P);
+
+WorklistPolicy toWorklistPolicy(const std::string &S);
+
+std::ostream &operator<<(std::ostream &OS, const WorklistPolicy &P);
+
 struct IFDSIDESolverConfig {
   IFDSIDESolverConfig();
   IFDSIDESolverConfig(SolverConfigOptions Options);
@@ -53,13 +78,131 @@ struct IFDSIDESolverConfig {
   bool recordEdges() const;
   bool emitESG() const;
   bool computePersistedSummaries() const;
+  bool denseJumpFunctions() const;
+  bool retireJumpFunctions() const;
+  bool persistJumpFunctions() const;
+  bool resumeFromCheckpoint() const;
+  bool lazyValues() const;
+  WorklistPolicy worklistPolicy() const;
+  unsigned numThreads() const;
+  size_t flowEdgeFunctionCacheCapacity() const;
+  const std::string &esgLogFile() const;
+  const std::string &profileFile() const;
+  const std::string &summaryStore() const;
+  const SolverBudget &budget() const;
+  const std::string &checkpointFile() const;
+  unsigned checkpointInterval() const;
+  const IFDSSummaryPool *librarySummaries() const;
+  const std::shared_ptr<psr::SummaryStore> &sharedSummaryStore() const;
 
   void setFollowReturnsPastSeeds(bool Set = true);
   void setAutoAddZero(bool Set = true);
   void setComputeValues(bool Set = true);
   void setRecordEdges(bool Set = true);
   void setEmitESG(bool Set = true);
+  /// Lets the solver apply the end summaries persisted in the summary store at
+  /// call sites instead of descending into the callees, and persist the end
+  /// summaries it computes, see setSummaryStore(). Summaries are keyed by the
+  /// contents of a function and of all functions it may call, and by the
+  /// problem's IFDSTabulationProblem::getSummaryAnalysisID(); problems without
+  /// such an ID are solved as usual, which the solver reports on std::cerr.
+  /// Values are not computed within the callees whose persisted summaries
+  /// have been applied, unless setPersistJumpFunctions() is set.
   void setComputePersistedSummaries(bool Set = true);
+  /// Stores the jump functions in a DenseJumpFunctions, which keeps each jump
+  /// function only once, rather than in the table-based JumpFunctions.
+  void setDenseJumpFunctions(bool Set = true);
+  /// Drops the jump functions inside of a function whenever no path edge of
+  /// the function is pending, keeping only those at start points, call sites
+  /// and exits. Phase II re-tabulates each function from its end summaries
+  /// to compute the values. This bounds the memory used by the jump functions
+  /// at the cost of re-processing path edges, and is only effective with a
+  /// single thread and without emitting the ESG.
+  void setRetireJumpFunctions(bool Set = true);
+  /// Persists the jump functions within a function along with its end
+  /// summaries, see setComputePersistedSummaries(). When such a summary is
+  /// applied, the jump functions of the callee and of the functions it calls
+  /// are restored instead of being re-tabulated, such that values are computed
+  /// within these functions just as if they had been analyzed. The flow
+  /// functions are applied along the restored jump functions, such that
+  /// findings that the problem records as their side effects are complete.
+  /// Summaries persisted without jump functions are not applied. Implies that
+  /// jump functions are not retired.
+  void setPersistJumpFunctions(bool Set = true);
+  /// Sets the order in which the solver processes its pending path edges,
+  /// see PathEdgeWorklist.
+  void setWorklistPolicy(WorklistPolicy Policy);
+  /// Sets the number of threads used to tabulate the exploded super-graph.
+  /// Using more than one thread requires the problem's flow functions and
+  /// edge functions to be safe to evaluate concurrently. The solvers run
+  /// single-threaded if PAMM is enabled, see getNumPAMMSafeThreads().
+  void setNumThreads(unsigned NumThreads);
+  /// Bounds the number of entries of each of the solver's flow and edge
+  /// function caches, see FlowEdgeFunctionCache. The least recently used
+  /// entries are evicted and reconstructed when needed again. Zero, the
+  /// default, leaves the caches unbounded.
+  void setFlowEdgeFunctionCacheCapacity(size_t Capacity);
+  /// Streams the recorded exploded super-graph edges to the ESG edge log at
+  /// the given path rather than keeping them in memory, see ESGEdgeLog. The
+  /// log can be turned into a DOT graph or JSON using the esg-reader tool.
+  /// Path-edge statistics are only computed for edges kept in memory.
+  void setESGLogFile(std::string Path);
+  /// Lets the solver profile the construction of the exploded super-graph per
+  /// function and call site and write the profile as JSON to the given path
+  /// and as collapsed stacks, which flame graph tools render, to Path.folded,
+  /// see SolverProfile. The profile is written once the solver finishes.
+  /// Profiling is off if the path is empty.
+  void setProfileFile(std::string Path);
+  /// Sets the directory in which summaries are persisted, see
+  /// setComputePersistedSummaries().
+  void setSummaryStore(std::string Directory);
+  /// Bounds the time, memory and number of path edges that the solver may
+  /// use to construct the exploded super-graph (Phase I). If the budget is
+  /// exhausted, the solver stops the construction, computes the values of
+  /// what has been constructed so far and reports its results as incomplete,
+  /// see IDESolver::isComplete(), i.e., facts and values may be missing. The
+  /// pending path edges are dropped, unless they are checkpointed, see
+  /// setCheckpointFile(). Summaries are not persisted then.
+  void setBudget(SolverBudget Budget);
+  /// Lets the solver checkpoint the construction of the exploded super-graph
+  /// (Phase I) to the given path, see SolverCheckpointer. The solver
+  /// commits a checkpoint at the configured interval, when its budget is
+  /// exhausted and when Phase I is done. Checkpointing is off if the path is
+  /// empty. Only applies to problems on LLVM IR that identify their analysis,
+  /// see IFDSTabulationProblem::getSummaryAnalysisID(), and whose edge
+  /// functions can be persisted, see
+  /// IDETabulationProblem::edgeFunctionToSummaryString(), with a single
+  /// thread, without retiring jump functions and without a node filter, see
+  /// IDESolver::setNodeFilter(). Otherwise, the solver reports on std::cerr
+  /// that it does not checkpoint.
+  void setCheckpointFile(std::string Path);
+  /// Sets the number of seconds between two commits of the checkpoint.
+  void setCheckpointInterval(unsigned Seconds);
+  /// Lets the solver resume Phase I from the checkpoint at checkpointFile(),
+  /// e.g., with a larger budget, if it has been written by the same analysis
+  /// for the same IR and initial seeds. The solver then restores its state
+  /// instead of submitting the initial seeds, and starts from scratch
+  /// otherwise.
+  void setResumeFromCheckpoint(bool Set = true);
+  /// Lets the solver compute the values (Phase II) at the nodes other than
+  /// start points and call sites only when they are queried, such that the
+  /// time and memory spent on the values is proportional to the nodes that
+  /// are looked at. The solver keeps its jump functions for the queries.
+  /// Queries then compute and store values, so they must not be issued by
+  /// several threads at once; the analysis strategies and the controller
+  /// query each of their solvers from a single thread. Clients that look at
+  /// all results, e.g., IDESolver::getSolverResults(), compute the values
+  /// that are still missing first.
+  void setLazyValues(bool Set = true);
+  /// Lets the solver apply the given precomputed summaries of library
+  /// functions at their call sites, see IFDSSummaryGenerator. Problems' own
+  /// summary flow functions take precedence. Only applies to IFDS problems on
+  /// LLVM IR.
+  void setLibrarySummaries(std::shared_ptr<const IFDSSummaryPool> Summaries);
+  /// Lets the solver persist summaries to the given store, which it may share
+  /// with other solvers, e.g., one that is kept in memory, instead of to the
+  /// directory set by setSummaryStore(), see setComputePersistedSummaries().
+  void setSharedSummaryStore(std::shared_ptr<psr::SummaryStore> Store);
 
   friend std::ostream &operator<<(std::ostream &OS,
                                   const IFDSIDESolverConfig &SC);
@@ -68,6 +211,17 @@ private:
   SolverConfigOptions Options = SolverConfigOptions::AutoAddZero |
                                 SolverConfigOptions::ComputeValues |
                                 SolverConfigOptions::RecordEdges;
+  WorklistPolicy Policy = WorklistPolicy::FIFO;
+  unsigned NumThreads = 1;
+  size_t FlowEdgeFunctionCacheCapacity = 0;
+  std::string ESGLogFile;
+  std::string ProfileFile;
+  std::string SummaryStore;
+  SolverBudget Budget;
+  std::string CheckpointFile;
+  unsigned CheckpointInterval = 600;
+  std::shared_ptr<const IFDSSummaryPool> LibrarySummaries;
+  std::shared_ptr<psr::SummaryStore> SharedSummaryStore;
 };
 
 } // namespace psr
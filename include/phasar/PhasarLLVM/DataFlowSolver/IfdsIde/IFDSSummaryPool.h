@@ -17,54 +17,108 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_IFDSSUMMARYPOOL_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_IFDSSUMMARYPOOL_H_
 
-#include <algorithm>
-#include <iostream> // Suppress the cout as soon as to possible and get rid of this header
+#include <iosfwd>
 #include <map>
+#include <memory>
+#include <optional>
 #include <set>
+#include <string>
 #include <vector>
 
-#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummary.h"
+#include "nlohmann/json.hpp"
 
-namespace psr {
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 
-template <typename D, typename N> class IFDSSummaryPool {
-private:
-  /// Stores the summary that starts at a given node.
-  std::map<N, std::map<std::vector<bool>, IFDSSummary<D, N>>> SummaryMap;
+namespace llvm {
+class Function;
+class Instruction;
+class Value;
+} // namespace llvm
 
+namespace psr {
+
+/// Precomputed IFDS summaries of library functions, which allow to analyze
+/// calls to these functions without their bodies, see IFDSSummaryGenerator.
+///
+/// A function's summaries are expressed in terms of its interface: its n-th
+/// formal parameter "a<n>", its return value "ret" and named globals
+/// "@<name>". The inputs of a function are its formal parameters. For each
+/// calling context, i.e., each subset of the inputs that hold when the
+/// function is entered, the pool stores the outputs that hold when the
+/// function returns.
+class IFDSSummaryPool {
 public:
+  struct FunctionSummaries {
+    std::vector<std::string> Inputs;
+    /// Maps a calling context, a bit pattern over Inputs, to its outputs.
+    std::map<std::vector<bool>, std::set<std::string>> Outputs;
+  };
+
   IFDSSummaryPool() = default;
   ~IFDSSummaryPool() = default;
 
-  void insertSummary(N StartNode, std::vector<bool> Context,
-                     IFDSSummary<D, N> Summary) {
-    SummaryMap[StartNode][Context] = Summary;
-  }
-
-  bool containsSummary(N StartNode) { return SummaryMap.count(StartNode); }
-
-  std::set<D> getSummary(N StartNode, std::vector<bool> Context) {
-    return SummaryMap[StartNode][Context];
-  }
-
-  void print() {
-    std::cout << "DynamicSummaries:\n";
-    for (auto &entry : SummaryMap) {
-      std::cout << "Function: " << entry.first << "\n";
-      for (auto &context_summaries : entry.second) {
-        std::cout << "Context: ";
-        for_each(context_summaries.first.begin(), context_summaries.first.end(),
-                 [](bool b) { std::cout << b; });
-        std::cout << "\n";
-        std::cout << "Beg results:\n";
-        for (auto &result : context_summaries.second) {
-          // result->dump();
-          std::cout << "fixme\n";
-        }
-        std::cout << "End results!\n";
-      }
-    }
-  }
+  /// Returns the interface ID of V within F, or std::nullopt if V is not part
+  /// of F's interface. Values returned by Exit are referred to as "ret".
+  [[nodiscard]] static std::optional<std::string>
+  getInterfaceID(const llvm::Function *F, const llvm::Instruction *Exit,
+                 const llvm::Value *V);
+
+  /// Returns the inputs of F, i.e., the IDs of its formal parameters.
+  [[nodiscard]] static std::vector<std::string>
+  getInputs(const llvm::Function *F);
+
+  void insertSummary(const std::string &FunctionName,
+                     std::vector<std::string> Inputs, std::vector<bool> Context,
+                     std::set<std::string> Outputs);
+
+  /// Adds the summaries of Other, which replace the summaries of the same
+  /// calling contexts in this pool.
+  void merge(const IFDSSummaryPool &Other);
+
+  [[nodiscard]] bool containsSummary(const std::string &FunctionName) const;
+
+  /// Returns the summaries of the given function or nullptr if there are
+  /// none.
+  [[nodiscard]] const FunctionSummaries *
+  getSummaries(const std::string &FunctionName) const;
+
+  /// Returns the outputs for the given calling context or nullptr if the
+  /// context has not been summarized.
+  [[nodiscard]] const std::set<std::string> *
+  getSummary(const std::string &FunctionName,
+             const std::vector<bool> &Context) const;
+
+  /// Returns the outputs of the smallest summarized calling context that
+  /// includes all of the given inputs, or nullptr if there is none.
+  [[nodiscard]] const std::set<std::string> *
+  getCoveringSummary(const std::string &FunctionName,
+                     const std::vector<bool> &Inputs) const;
+
+  /// Returns a flow function that applies the summaries of Callee at
+  /// CallSite, mapping the facts passed to Callee to its inputs and its
+  /// outputs back to the caller, or nullptr if Callee has no summaries. Facts
+  /// that are not passed to Callee are left to the call-to-return flow
+  /// function.
+  [[nodiscard]] std::shared_ptr<FlowFunction<const llvm::Value *>>
+  getSummaryFlowFunction(const llvm::Instruction *CallSite,
+                         const llvm::Function *Callee,
+                         const llvm::Value *ZeroValue) const;
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+
+  /// Creates a pool from JSON created by getAsJson(). Throws
+  /// nlohmann::json::exception if the JSON is malformed.
+  [[nodiscard]] static IFDSSummaryPool fromJson(const nlohmann::json &J);
+
+  /// Reads a pool from a JSON file. Throws std::ios_base::failure if the file
+  /// cannot be read and nlohmann::json::exception if it is malformed.
+  [[nodiscard]] static IFDSSummaryPool loadFromFile(const std::string &Path);
+
+  void print(std::ostream &OS) const;
+
+private:
+  /// Stores the summaries of each function by its name.
+  std::map<std::string, FunctionSummaries> SummaryMap;
 };
 
 } // namespace psr
@@ -141,6 +141,16 @@ public:
   /// Sets the level of soundness to be used by the analysis. Returns false if
   /// the level of soundness is ignored. Otherwise, true.
   virtual bool setSoundness(Soundness S) { return false; }
+
+  /// Returns an ID that identifies the analysis, including everything besides
+  /// the IR that its results depend on, e.g., its configuration. The solver
+  /// only persists the summaries of problems with a non-empty ID, see
+  /// IFDSIDESolverConfig::computePersistedSummaries(). Findings that are
+  /// collected as side effects of flow functions are not reported within
+  /// callees whose persisted summaries are applied, unless their jump
+  /// functions are persisted as well, see
+  /// IFDSIDESolverConfig::persistJumpFunctions().
+  [[nodiscard]] virtual std::string getSummaryAnalysisID() const { return {}; }
 };
 } // namespace psr
 
@@ -34,9 +34,9 @@ public:
   ObservedCallingContexts() = default;
   ~ObservedCallingContexts() = default;
   void addObservedCTX(const std::string &FName, const std::vector<bool> &CTX);
-  bool containsCTX(const std::string &FName);
-  std::set<std::vector<bool>> getObservedCTX(const std::string &FName);
-  void print();
+  bool containsCTX(const std::string &FName) const;
+  std::set<std::vector<bool>> getObservedCTX(const std::string &FName) const;
+  void print() const;
 };
 } // namespace psr
 
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -36,6 +37,8 @@
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
 
+#include "nlohmann/json.hpp"
+
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
@@ -124,8 +127,6 @@ public:
     this->ZeroValue =
         IDEInstInteractionAnalysisT<EdgeFactType, SyntacticAnalysisOnly,
                                     EnableIndirectTaints>::createZeroValue();
-    IIAAAddLabelsEF::initEdgeFunctionCleaner();
-    IIAAKillOrReplaceEF::initEdgeFunctionCleaner();
   }
 
   ~IDEInstInteractionAnalysisT() override = default;
@@ -133,9 +134,15 @@ public:
   /// Offer a special hook to the user that allows to generate additional
   /// edge facts on-the-fly. Above the generator function, the ordinary
   /// edge facts are generated according to the usual edge functions.
+  ///
+  /// Summaries of the analysis can only be persisted if GeneratorID
+  /// identifies the generator across analysis runs, see
+  /// getSummaryAnalysisID().
   inline void registerEdgeFactGenerator(
-      std::function<EdgeFactGeneratorTy> EdgeFactGenerator) {
+      std::function<EdgeFactGeneratorTy> EdgeFactGenerator,
+      std::string GeneratorID = {}) {
     edgeFactGen = std::move(EdgeFactGenerator);
+    edgeFactGenID = std::move(GeneratorID);
   }
 
   // start formulating our analysis by specifying the parts required for IFDS
@@ -1103,6 +1110,80 @@ public:
     return std::make_shared<AllTop<l_t>>(topElement());
   }
 
+  // Summaries can be persisted for labels of type std::string only, unless
+  // the edge fact generator is unknown
+  std::string getSummaryAnalysisID() const override {
+    if (!std::is_same_v<e_t, std::string> ||
+        (edgeFactGen && edgeFactGenID.empty())) {
+      return {};
+    }
+    std::string ID = "ide-iia";
+    if (SyntacticAnalysisOnly) {
+      ID += "-syntactic";
+    }
+    if (EnableIndirectTaints) {
+      ID += "-indirect";
+    }
+    if (edgeFactGen) {
+      ID += ":" + edgeFactGenID;
+    }
+    return ID;
+  }
+
+  // The labels are represented as a JSON array of strings, prefixed by "k"
+  // for IIAAKillOrReplaceEF and by "a" for IIAAAddLabelsEF
+  std::string edgeFunctionToSummaryString(
+      const std::shared_ptr<EdgeFunction<l_t>> &EF) override {
+    switch (EF->getKind()) {
+    case EdgeFunctionKind::Identity:
+      return "id";
+    case EdgeFunctionKind::AllTop:
+      return "top";
+    case EdgeFunctionKind::AllBottom:
+      return "bottom";
+    default:
+      break;
+    }
+    if constexpr (std::is_same_v<e_t, std::string>) {
+      if (auto *KR = dynamic_cast<IIAAKillOrReplaceEF *>(EF.get())) {
+        return "k" + labelsToJson(KR->Replacement).dump();
+      }
+      if (auto *AL = dynamic_cast<IIAAAddLabelsEF *>(EF.get())) {
+        return "a" + labelsToJson(AL->Data).dump();
+      }
+    }
+    return {};
+  }
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  edgeFunctionFromSummaryString(const std::string &S) override {
+    if (S == "id") {
+      return EdgeIdentity<l_t>::getInstance();
+    }
+    if (S == "top") {
+      return allTopFunction();
+    }
+    if (S == "bottom") {
+      return std::make_shared<AllBottom<l_t>>(BottomElement);
+    }
+    if constexpr (std::is_same_v<e_t, std::string>) {
+      if (S.empty() || (S[0] != 'k' && S[0] != 'a')) {
+        return nullptr;
+      }
+      auto J = nlohmann::json::parse(S.begin() + 1, S.end(), nullptr,
+                                     /* allow_exceptions */ false);
+      auto Labels = labelsFromJson(J);
+      if (!Labels) {
+        return nullptr;
+      }
+      if (S[0] == 'k') {
+        return IIAAKillOrReplaceEF::createEdgeFunction(std::move(*Labels));
+      }
+      return IIAAAddLabelsEF::createEdgeFunction(std::move(*Labels));
+    }
+    return nullptr;
+  }
+
   // Provide some handy helper edge functions to improve reuse.
 
   // Edge function that kills all labels in a set (and may replaces them with
@@ -1448,10 +1529,46 @@ private:
   }
 
   std::function<EdgeFactGeneratorTy> edgeFactGen;
+  std::string edgeFactGenID;
   static inline const l_t BottomElement = Bottom{};
   static inline const l_t TopElement = Top{};
   const bool OnlyConsiderLocalAliases = true;
 
+  // Top and Bottom are represented by the strings "top" and "bottom"
+  static nlohmann::json labelsToJson(const l_t &Labels) {
+    if (std::holds_alternative<Top>(Labels)) {
+      return "top";
+    }
+    if (std::holds_alternative<Bottom>(Labels)) {
+      return "bottom";
+    }
+    auto J = nlohmann::json::array();
+    for (const auto &Label : std::get<BitVectorSet<e_t>>(Labels)) {
+      J.push_back(Label);
+    }
+    return J;
+  }
+
+  static std::optional<l_t> labelsFromJson(const nlohmann::json &J) {
+    if (J == "top") {
+      return l_t(Top{});
+    }
+    if (J == "bottom") {
+      return l_t(Bottom{});
+    }
+    if (!J.is_array()) {
+      return std::nullopt;
+    }
+    BitVectorSet<e_t> Labels;
+    for (const auto &Label : J) {
+      if (!Label.is_string()) {
+        return std::nullopt;
+      }
+      Labels.insert(Label.get<std::string>());
+    }
+    return l_t(std::move(Labels));
+  }
+
   inline BitVectorSet<e_t> edgeFactGenToBitVectorSet(n_t curr) {
     if (edgeFactGen) {
       auto Results = edgeFactGen(curr);
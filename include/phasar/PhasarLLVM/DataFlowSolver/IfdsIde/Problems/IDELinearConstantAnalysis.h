@@ -10,14 +10,17 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_PROBLEMS_IDELINEARCONSTANTANALYSIS_H_
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionComposer.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 
 namespace llvm {
@@ -41,10 +44,18 @@ class LLVMPointsToInfo;
 class IDELinearConstantAnalysis
     : public IDETabulationProblem<IDELinearConstantAnalysisDomain> {
 private:
-  // For debug purpose only
-  static unsigned CurrGenConstantId;
-  static unsigned CurrLCAIDId;
-  static unsigned CurrBinaryId;
+  // For debug purpose only; the edge functions may be created by several
+  // solver threads, see IFDSIDESolverConfig::setNumThreads()
+  static std::atomic<unsigned> CurrGenConstantId;
+  static std::atomic<unsigned> CurrLCAIDId;
+  static std::atomic<unsigned> CurrBinaryId;
+
+  // The function-local IDs that identify the instructions of binary
+  // operations in persisted edge functions, computed once per function
+  std::mutex LocalIDsMutex;
+  std::map<const llvm::Function *, FunctionLocalIDs> LocalIDs;
+
+  const FunctionLocalIDs &getLocalIDs(const llvm::Function *F);
 
 public:
   using IDETabProblemType =
@@ -153,9 +164,21 @@ public:
 
   std::shared_ptr<EdgeFunction<l_t>> allTopFunction() override;
 
+  std::string getSummaryAnalysisID() const override;
+
+  /// Binary operations are represented by the function-local ID of their
+  /// instruction, such that they can be restored on the same IR only.
+  std::string edgeFunctionToSummaryString(
+      const std::shared_ptr<EdgeFunction<l_t>> &EF) override;
+
+  std::shared_ptr<EdgeFunction<l_t>>
+  edgeFunctionFromSummaryString(const std::string &S) override;
+
   // Custom EdgeFunction declarations
 
   class LCAEdgeFunctionComposer : public EdgeFunctionComposer<l_t> {
+    friend class IDELinearConstantAnalysis;
+
   public:
     LCAEdgeFunctionComposer(std::shared_ptr<EdgeFunction<l_t>> F,
                             std::shared_ptr<EdgeFunction<l_t>> G)
@@ -170,6 +193,8 @@ public:
 
   class GenConstant : public EdgeFunction<l_t>,
                       public std::enable_shared_from_this<GenConstant> {
+    friend class IDELinearConstantAnalysis;
+
   private:
     const unsigned GenConstant_Id;
     const l_t IntConst;
@@ -213,6 +238,8 @@ public:
 
   class BinOp : public EdgeFunction<l_t>,
                 public std::enable_shared_from_this<BinOp> {
+    friend class IDELinearConstantAnalysis;
+
   private:
     const unsigned EdgeFunctionID, Op;
     d_t lop, rop, currNode;
@@ -65,6 +65,8 @@ public:
   void printDataFlowFact(std::ostream &os, d_t d) const override;
 
   void printFunction(std::ostream &os, f_t M) const override;
+
+  std::string getSummaryAnalysisID() const override;
 };
 
 } // namespace psr
@@ -96,6 +96,11 @@ public:
 
   void emitTextReport(const SolverResults<n_t, d_t, BinaryDomain> &SR,
                       std::ostream &OS = std::cout) override;
+
+  /// The ID includes the source and sink functions and the kind of points-to
+  /// information; it is empty for inter-procedural points-to information,
+  /// since the aliases within a function then depend on the whole program.
+  std::string getSummaryAnalysisID() const override;
 };
 } // namespace psr
 
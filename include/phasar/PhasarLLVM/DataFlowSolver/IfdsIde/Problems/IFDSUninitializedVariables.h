@@ -86,6 +86,10 @@ public:
   void emitTextReport(const SolverResults<n_t, d_t, BinaryDomain> &SR,
                       std::ostream &OS = std::cout) override;
 
+  std::string getSummaryAnalysisID() const override;
+
+  /// Returns the uses of undefined values. Uses within callees whose
+  /// persisted summaries have been applied are not included.
   const std::map<n_t, std::set<d_t>> &getAllUndefUses() const;
 
   std::vector<UninitResult> aggregateResults();
@@ -0,0 +1,505 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_DENSEJUMPFUNCTIONS_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_DENSEJUMPFUNCTIONS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactInterner.h"
+#include "phasar/Utils/Logger.h"
+
+namespace psr {
+
+// Forward declare the IDETabulationProblem as we require its toString
+// functionality.
+template <typename AnalysisDomainTy, typename Container>
+class IDETabulationProblem;
+
+/// Flat open-addressing hash map from pairs of dense 32-bit IDs, packed into
+/// a single 64-bit key, to 32-bit values. Entries are never erased.
+class DenseIDPairMap {
+public:
+  [[nodiscard]] const uint32_t *find(uint32_t First, uint32_t Second) const {
+    if (Keys.empty()) {
+      return nullptr;
+    }
+    uint64_t Key = pack(First, Second);
+    for (size_t Idx = slotOf(Key);; Idx = (Idx + 1) & (Keys.size() - 1)) {
+      if (Keys[Idx] == Key) {
+        return &Values[Idx];
+      }
+      if (Keys[Idx] == EmptyKey) {
+        return nullptr;
+      }
+    }
+  }
+
+  uint32_t *find(uint32_t First, uint32_t Second) {
+    return const_cast<uint32_t *>(
+        static_cast<const DenseIDPairMap *>(this)->find(First, Second));
+  }
+
+  /// Returns the value for the given key, which is inserted with the given
+  /// default value if not present.
+  uint32_t &getOrInsert(uint32_t First, uint32_t Second, uint32_t Default) {
+    if ((NumEntries + 1) * 4 > Keys.size() * 3) {
+      grow();
+    }
+    uint64_t Key = pack(First, Second);
+    size_t Idx = slotOf(Key);
+    while (Keys[Idx] != Key && Keys[Idx] != EmptyKey) {
+      Idx = (Idx + 1) & (Keys.size() - 1);
+    }
+    if (Keys[Idx] == EmptyKey) {
+      Keys[Idx] = Key;
+      Values[Idx] = Default;
+      ++NumEntries;
+    }
+    return Values[Idx];
+  }
+
+  [[nodiscard]] size_t size() const { return NumEntries; }
+
+  void clear() {
+    Keys.clear();
+    Values.clear();
+    NumEntries = 0;
+  }
+
+private:
+  // cannot be a valid key as the maximal 32-bit ID is reserved
+  static constexpr uint64_t EmptyKey = std::numeric_limits<uint64_t>::max();
+
+  static uint64_t pack(uint32_t First, uint32_t Second) {
+    return (uint64_t(First) << 32) | Second;
+  }
+
+  [[nodiscard]] size_t slotOf(uint64_t Key) const {
+    // finalizer of splitmix64
+    Key = (Key ^ (Key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    Key = (Key ^ (Key >> 27)) * 0x94d049bb133111ebULL;
+    Key ^= Key >> 31;
+    return Key & (Keys.size() - 1);
+  }
+
+  void grow() {
+    std::vector<uint64_t> OldKeys(std::max<size_t>(Keys.size() * 2, 16),
+                                  EmptyKey);
+    std::vector<uint32_t> OldValues(OldKeys.size());
+    OldKeys.swap(Keys);
+    OldValues.swap(Values);
+    for (size_t Idx = 0; Idx < OldKeys.size(); ++Idx) {
+      if (OldKeys[Idx] == EmptyKey) {
+        continue;
+      }
+      size_t NewIdx = slotOf(OldKeys[Idx]);
+      while (Keys[NewIdx] != EmptyKey) {
+        NewIdx = (NewIdx + 1) & (Keys.size() - 1);
+      }
+      Keys[NewIdx] = OldKeys[Idx];
+      Values[NewIdx] = OldValues[Idx];
+    }
+  }
+
+  std::vector<uint64_t> Keys;
+  std::vector<uint32_t> Values;
+  size_t NumEntries = 0;
+};
+
+/// Stores the jump functions like JumpFunctions does, but keeps each jump
+/// function exactly once. Nodes and facts are mapped to dense 32-bit IDs and
+/// all jump functions live in a single flat array, in which the entries that
+/// share a (source fact, target node), a (target node, target fact) or a
+/// target node are chained through 32-bit indices. The heads of these chains
+/// are found through flat open-addressing hash maps or, for the target nodes,
+/// a plain array indexed by the node's ID.
+///
+/// The lookups return non-owning views into this array, which are invalidated
+/// by any subsequent modification.
+template <typename AnalysisDomainTy, typename Container>
+class DenseJumpFunctions {
+public:
+  using l_t = typename AnalysisDomainTy::l_t;
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+
+  using EdgeFunctionType = EdgeFunction<l_t>;
+  using EdgeFunctionPtrType = std::shared_ptr<EdgeFunctionType>;
+
+private:
+  static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+  struct Entry {
+    uint32_t SourceFact;
+    uint32_t Target;
+    uint32_t TargetFact;
+    uint32_t NextForward;
+    uint32_t NextReverse;
+    uint32_t NextByTarget;
+    EdgeFunctionPtrType Function;
+  };
+
+public:
+  /// A view on the jump functions of a chain, which yields pairs of the fact
+  /// selected by FactOf and the associated edge function.
+  template <uint32_t Entry::*NextOf, uint32_t Entry::*FactOf>
+  class FactFunctionView {
+  public:
+    class iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<d_t, EdgeFunctionPtrType>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = std::pair<d_t, const EdgeFunctionPtrType &>;
+
+      iterator(const DenseJumpFunctions *JF, uint32_t Idx) : JF(JF), Idx(Idx) {}
+
+      reference operator*() const {
+        const auto &E = JF->Entries[Idx];
+        return {JF->Facts.getFact(E.*FactOf), E.Function};
+      }
+
+      iterator &operator++() {
+        Idx = JF->Entries[Idx].*NextOf;
+        return *this;
+      }
+
+      iterator operator++(int) {
+        iterator Tmp = *this;
+        ++*this;
+        return Tmp;
+      }
+
+      friend bool operator==(const iterator &LHS, const iterator &RHS) {
+        return LHS.Idx == RHS.Idx;
+      }
+
+      friend bool operator!=(const iterator &LHS, const iterator &RHS) {
+        return !(LHS == RHS);
+      }
+
+    private:
+      const DenseJumpFunctions *JF;
+      uint32_t Idx;
+    };
+
+    FactFunctionView(const DenseJumpFunctions *JF, uint32_t Head)
+        : JF(JF), Head(Head) {}
+
+    [[nodiscard]] iterator begin() const { return {JF, Head}; }
+    [[nodiscard]] iterator end() const { return {JF, None}; }
+    [[nodiscard]] bool empty() const { return Head == None; }
+
+  private:
+    const DenseJumpFunctions *JF;
+    uint32_t Head;
+  };
+
+  /// Target values and functions for a source value and target node.
+  using ForwardView =
+      FactFunctionView<&Entry::NextForward, &Entry::TargetFact>;
+  /// Source values and functions for a target node and target value.
+  using ReverseView =
+      FactFunctionView<&Entry::NextReverse, &Entry::SourceFact>;
+
+  /// A view on all jump functions with the same target node.
+  class TargetView {
+  public:
+    TargetView(const DenseJumpFunctions *JF, uint32_t Head)
+        : JF(JF), Head(Head) {}
+
+    /// Calls Fn(source value, target value, edge function) for each jump
+    /// function of the target node.
+    template <typename FnTy> void foreachCell(FnTy Fn) const {
+      for (uint32_t Idx = Head; Idx != None;
+           Idx = JF->Entries[Idx].NextByTarget) {
+        const auto &E = JF->Entries[Idx];
+        Fn(JF->Facts.getFact(E.SourceFact), JF->Facts.getFact(E.TargetFact),
+           E.Function);
+      }
+    }
+
+    [[nodiscard]] bool empty() const { return Head == None; }
+
+  private:
+    const DenseJumpFunctions *JF;
+    uint32_t Head;
+  };
+
+  DenseJumpFunctions(EdgeFunctionPtrType allTop,
+                     const IDETabulationProblem<AnalysisDomainTy, Container> &p)
+      : allTop(std::move(allTop)), problem(p) {}
+
+  ~DenseJumpFunctions() = default;
+
+  DenseJumpFunctions(const DenseJumpFunctions &) = default;
+  DenseJumpFunctions &operator=(const DenseJumpFunctions &) = delete;
+  DenseJumpFunctions(DenseJumpFunctions &&) noexcept = default;
+  DenseJumpFunctions &operator=(DenseJumpFunctions &&) noexcept = delete;
+
+  /**
+   * Records a jump function. The source statement is implicit.
+   * @see PathEdge
+   */
+  void addFunction(d_t sourceVal, n_t target, d_t targetVal,
+                   EdgeFunctionPtrType function) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                      << "Start adding new jump function";
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Fact at source : " << problem.DtoString(sourceVal);
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Fact at target : " << problem.DtoString(targetVal);
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Destination    : " << problem.NtoString(target);
+                  BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Edge Function  : " << function->str());
+    // we do not store the default function (all-top)
+    if (function->equal_to(allTop)) {
+      return;
+    }
+    uint32_t Source = getOrCreateFactID(sourceVal);
+    uint32_t Target = getOrCreateNodeID(target);
+    uint32_t TargetFact = getOrCreateFactID(targetVal);
+    uint32_t &ForwardHead = ForwardHeads.getOrInsert(Source, Target, None);
+    for (uint32_t Idx = ForwardHead; Idx != None;
+         Idx = Entries[Idx].NextForward) {
+      if (Entries[Idx].TargetFact == TargetFact) {
+        // it is important that existing values are overwritten
+        Entries[Idx].Function = std::move(function);
+        return;
+      }
+    }
+    uint32_t &ReverseHead = ReverseHeads.getOrInsert(Target, TargetFact, None);
+    Entry NewEntry{Source,      Target,      TargetFact,
+                   ForwardHead, ReverseHead, ByTargetHeads[Target],
+                   std::move(function)};
+    uint32_t NewIdx;
+    // reuse the entries of removed jump functions
+    if (!FreeEntries.empty()) {
+      NewIdx = FreeEntries.back();
+      FreeEntries.pop_back();
+      Entries[NewIdx] = std::move(NewEntry);
+    } else {
+      NewIdx = static_cast<uint32_t>(Entries.size());
+      Entries.push_back(std::move(NewEntry));
+    }
+    // ForwardHead may have been invalidated by the insertion of ReverseHead
+    *ForwardHeads.find(Source, Target) = NewIdx;
+    ReverseHead = NewIdx;
+    ByTargetHeads[Target] = NewIdx;
+    ++NumFunctions;
+  }
+
+  /**
+   * Returns, for a given target statement and value all associated
+   * source values, and for each the associated edge function.
+   */
+  std::optional<ReverseView> reverseLookup(n_t target, d_t targetVal) const {
+    uint32_t Target = getNodeID(target);
+    uint32_t TargetFact = getFactID(targetVal);
+    if (Target == None || TargetFact == None) {
+      return std::nullopt;
+    }
+    const uint32_t *Head = ReverseHeads.find(Target, TargetFact);
+    if (!Head || *Head == None) {
+      return std::nullopt;
+    }
+    return ReverseView(this, *Head);
+  }
+
+  /**
+   * Returns, for a given source value and target statement all
+   * associated target values, and for each the associated edge function.
+   */
+  std::optional<ForwardView> forwardLookup(d_t sourceVal, n_t target) const {
+    uint32_t Source = getFactID(sourceVal);
+    uint32_t Target = getNodeID(target);
+    if (Source == None || Target == None) {
+      return std::nullopt;
+    }
+    const uint32_t *Head = ForwardHeads.find(Source, Target);
+    if (!Head || *Head == None) {
+      return std::nullopt;
+    }
+    return ForwardView(this, *Head);
+  }
+
+  /**
+   * Returns for a given target statement all jump function records with this
+   * target.
+   */
+  TargetView lookupByTarget(n_t target) const {
+    uint32_t Target = getNodeID(target);
+    return TargetView(this, Target == None ? None : ByTargetHeads[Target]);
+  }
+
+  /**
+   * Removes a jump function. The source statement is implicit.
+   * @see PathEdge
+   * @return True if the function has actually been removed. False if it was
+   * not there anyway.
+   */
+  bool removeFunction(d_t sourceVal, n_t target, d_t targetVal) {
+    uint32_t Source = getFactID(sourceVal);
+    uint32_t Target = getNodeID(target);
+    uint32_t TargetFact = getFactID(targetVal);
+    if (Source == None || Target == None || TargetFact == None) {
+      return false;
+    }
+    uint32_t *ForwardHead = ForwardHeads.find(Source, Target);
+    if (!ForwardHead) {
+      return false;
+    }
+    uint32_t Idx = *ForwardHead;
+    while (Idx != None && Entries[Idx].TargetFact != TargetFact) {
+      Idx = Entries[Idx].NextForward;
+    }
+    if (Idx == None) {
+      return false;
+    }
+    unlink(*ForwardHead, Idx, &Entry::NextForward);
+    unlink(*ReverseHeads.find(Target, TargetFact), Idx, &Entry::NextReverse);
+    unlink(ByTargetHeads[Target], Idx, &Entry::NextByTarget);
+    freeEntry(Idx);
+    return true;
+  }
+
+  /**
+   * Removes all jump functions with the given target statement.
+   * @return The number of jump functions that have been removed.
+   */
+  size_t removeFunctionsAt(n_t target) {
+    uint32_t Target = getNodeID(target);
+    if (Target == None) {
+      return 0;
+    }
+    size_t NumRemoved = 0;
+    // the forward and reverse chains of the removed functions consist of
+    // functions with the same target only, so they become empty entirely
+    for (uint32_t Idx = ByTargetHeads[Target]; Idx != None;) {
+      const auto &E = Entries[Idx];
+      *ForwardHeads.find(E.SourceFact, Target) = None;
+      *ReverseHeads.find(Target, E.TargetFact) = None;
+      uint32_t Next = E.NextByTarget;
+      freeEntry(Idx);
+      ++NumRemoved;
+      Idx = Next;
+    }
+    ByTargetHeads[Target] = None;
+    return NumRemoved;
+  }
+
+  /**
+   * Removes all jump functions
+   */
+  void clear() {
+    Entries.clear();
+    FreeEntries.clear();
+    ForwardHeads.clear();
+    ReverseHeads.clear();
+    ByTargetHeads.clear();
+    Facts.clear();
+    NodeIDs.clear();
+    Nodes.clear();
+    NumFunctions = 0;
+  }
+
+  /// Returns the number of jump functions stored.
+  [[nodiscard]] size_t size() const { return NumFunctions; }
+
+  void printJumpFunctions(std::ostream &os) const {
+    os << "\n******************************************************";
+    os << "\n*              Print all Jump Functions              *";
+    os << "\n******************************************************\n";
+    for (uint32_t Target = 0; Target < Nodes.size(); ++Target) {
+      if (ByTargetHeads[Target] == None) {
+        continue;
+      }
+      std::string nLabel = problem.NtoString(Nodes[Target]);
+      os << "\nN: " << nLabel << "\n---" << std::string(nLabel.size(), '-')
+         << '\n';
+      lookupByTarget(Nodes[Target])
+          .foreachCell([&](d_t D1, d_t D2, const EdgeFunctionPtrType &EF) {
+            os << "D1: " << problem.DtoString(D1) << '\n'
+               << "\tD2: " << problem.DtoString(D2) << '\n'
+               << "\tEF: " << EF->str() << "\n\n";
+          });
+    }
+  }
+
+private:
+  uint32_t getFactID(d_t Fact) const { return Facts.getID(Fact); }
+
+  uint32_t getNodeID(n_t Node) const {
+    auto It = NodeIDs.find(Node);
+    return It != NodeIDs.end() ? It->second : None;
+  }
+
+  uint32_t getOrCreateFactID(d_t Fact) { return Facts.getOrCreateID(Fact); }
+
+  uint32_t getOrCreateNodeID(n_t Node) {
+    auto [It, Inserted] =
+        NodeIDs.try_emplace(Node, static_cast<uint32_t>(Nodes.size()));
+    if (Inserted) {
+      Nodes.push_back(Node);
+      ByTargetHeads.push_back(None);
+    }
+    return It->second;
+  }
+
+  /// Keeps the entry of a removed jump function for reuse by addFunction().
+  void freeEntry(uint32_t Idx) {
+    Entries[Idx].Function = nullptr;
+    FreeEntries.push_back(Idx);
+    --NumFunctions;
+  }
+
+  void unlink(uint32_t &Head, uint32_t Idx, uint32_t Entry::*NextOf) {
+    if (Head == Idx) {
+      Head = Entries[Idx].*NextOf;
+      return;
+    }
+    for (uint32_t Prev = Head; Prev != None; Prev = Entries[Prev].*NextOf) {
+      if (Entries[Prev].*NextOf == Idx) {
+        Entries[Prev].*NextOf = Entries[Idx].*NextOf;
+        return;
+      }
+    }
+  }
+
+  EdgeFunctionPtrType allTop;
+  const IDETabulationProblem<AnalysisDomainTy, Container> &problem;
+
+  std::vector<Entry> Entries;
+  std::vector<uint32_t> FreeEntries;
+  DenseIDPairMap ForwardHeads;
+  DenseIDPairMap ReverseHeads;
+  std::vector<uint32_t> ByTargetHeads;
+  FactInterner<d_t> Facts;
+  std::unordered_map<n_t, uint32_t> NodeIDs;
+  std::vector<n_t> Nodes;
+  size_t NumFunctions = 0;
+};
+
+} // namespace psr
+
+#endif
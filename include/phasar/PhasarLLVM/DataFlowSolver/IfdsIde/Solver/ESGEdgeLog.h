@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_ESGEDGELOG_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_ESGEDGELOG_H_
+
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace llvm {
+namespace sys {
+namespace fs {
+class mapped_file_region;
+} // namespace fs
+} // namespace sys
+} // namespace llvm
+
+namespace psr {
+
+/// The kind of an exploded super-graph (ESG) edge record.
+enum class ESGEdgeKind : uint8_t {
+  // an intra-procedural flow
+  Normal,
+  // a flow alongside a call site, including special summaries
+  CallToReturn,
+  // a flow from a call site into a callee
+  Call,
+  // a flow from a callee's exit to a return site
+  Return,
+  // attaches the label of an edge function to the edge it was queried for
+  EdgeFunction
+};
+
+std::string toString(ESGEdgeKind Kind);
+
+/// A fixed-width record of an ESG edge from (SourceNode, SourceFact) to
+/// (TargetNode, TargetFact). Nodes, facts and edge function labels are
+/// referred to by the IDs under which they are listed in the log's name table.
+struct ESGEdgeRecord {
+  static constexpr uint32_t None = ~0U;
+
+  uint32_t SourceNode;
+  uint32_t SourceFact;
+  uint32_t TargetNode;
+  uint32_t TargetFact;
+  // the edge function's label for EdgeFunction records, None otherwise
+  uint32_t Label;
+  ESGEdgeKind Kind;
+  uint8_t Padding[3];
+};
+
+static_assert(sizeof(ESGEdgeRecord) == 24,
+              "ESGEdgeRecord is part of the ESG edge log's file format");
+
+struct ESGNodeName {
+  std::string Function;
+  std::string StmtId;
+  std::string Label;
+  bool IsExit = false;
+};
+
+struct ESGFactName {
+  std::string Label;
+  bool IsZero = false;
+};
+
+/// An exploded super-graph as recorded by an ESGEdgeLogWriter, i.e., the
+/// sequence of edge records and the names of the nodes, facts and edge
+/// functions they refer to.
+///
+/// The records are stored in the file Path, which starts with a header that
+/// occupies the space of one record. The names are stored in the text file
+/// Path.names, one name per line.
+struct ESGEdgeLog {
+  std::vector<ESGEdgeRecord> Records;
+  std::vector<ESGNodeName> Nodes;
+  std::vector<ESGFactName> Facts;
+  std::vector<std::string> Labels;
+
+  /// Reads the log that has been written to Path. Throws
+  /// std::ios_base::failure if the log cannot be read or is malformed.
+  static ESGEdgeLog read(const std::string &Path);
+
+  /// Prints the exploded super-graph as DOT graph, as the IDESolver does if
+  /// IFDSIDESolverConfig::emitESG() is set. The DOTConfig must have been
+  /// imported already.
+  void printAsDot(std::ostream &OS) const;
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+};
+
+/// Appends ESG edge records to a file through a memory-mapped window that is
+/// moved along the file as it grows, such that the records do not occupy
+/// the memory of the process that records them. New names are appended to
+/// the log's name table as they are added.
+class ESGEdgeLogWriter {
+public:
+  /// Creates or truncates the log at Path. Throws std::ios_base::failure if
+  /// the log cannot be created.
+  explicit ESGEdgeLogWriter(std::string Path);
+  ~ESGEdgeLogWriter();
+
+  ESGEdgeLogWriter(const ESGEdgeLogWriter &) = delete;
+  ESGEdgeLogWriter &operator=(const ESGEdgeLogWriter &) = delete;
+  ESGEdgeLogWriter(ESGEdgeLogWriter &&) = delete;
+  ESGEdgeLogWriter &operator=(ESGEdgeLogWriter &&) = delete;
+
+  void append(const ESGEdgeRecord &Record);
+
+  /// Add a name to the name table and return its ID.
+  uint32_t addNode(const ESGNodeName &Name);
+  uint32_t addFact(const ESGFactName &Name);
+  uint32_t addLabel(const std::string &Label);
+
+  /// Writes the number of records to the header and truncates the log to its
+  /// actual size. Nothing can be appended afterwards.
+  void close();
+
+  [[nodiscard]] bool isClosed() const { return FD < 0; }
+  [[nodiscard]] const std::string &getPath() const { return Path; }
+  [[nodiscard]] uint64_t size() const { return NextSlot - 1; }
+
+private:
+  void mapWindow(uint64_t FirstSlot);
+
+  std::string Path;
+  std::ofstream Names;
+  int FD = -1;
+  std::unique_ptr<llvm::sys::fs::mapped_file_region> Window;
+  uint64_t SlotsPerWindow = 0;
+  uint64_t WindowBegin = 0;
+  // slot 0 holds the header
+  uint64_t NextSlot = 1;
+  uint32_t NumNodes = 0;
+  uint32_t NumFacts = 0;
+  uint32_t NumLabels = 0;
+};
+
+/// Records the ESG edges of a solver run in an ESG edge log, assigning IDs
+/// to the solver's nodes, facts and edge function labels as they are seen.
+template <typename N, typename D> class ESGEdgeRecorder {
+public:
+  explicit ESGEdgeRecorder(std::string Path) : Writer(std::move(Path)) {}
+
+  /// Returns n's ID, adding the name returned by GetName() to the log's name
+  /// table if n has not been seen before.
+  template <typename NameFnTy> uint32_t getNodeID(N n, NameFnTy GetName) {
+    auto [It, Inserted] = NodeIDs.try_emplace(n, 0);
+    if (Inserted) {
+      It->second = Writer.addNode(GetName());
+    }
+    return It->second;
+  }
+
+  /// Returns d's ID, adding the name returned by GetName() to the log's name
+  /// table if d has not been seen before.
+  template <typename NameFnTy> uint32_t getFactID(D d, NameFnTy GetName) {
+    auto [It, Inserted] = FactIDs.try_emplace(d, 0);
+    if (Inserted) {
+      It->second = Writer.addFact(GetName());
+    }
+    return It->second;
+  }
+
+  uint32_t getLabelID(const std::string &Label) {
+    auto [It, Inserted] = LabelIDs.try_emplace(Label, 0);
+    if (Inserted) {
+      It->second = Writer.addLabel(Label);
+    }
+    return It->second;
+  }
+
+  void record(ESGEdgeKind Kind, uint32_t SourceNode, uint32_t SourceFact,
+              uint32_t TargetNode, uint32_t TargetFact,
+              uint32_t Label = ESGEdgeRecord::None) {
+    Writer.append({SourceNode, SourceFact, TargetNode, TargetFact, Label, Kind,
+                   {0, 0, 0}});
+  }
+
+  void close() { Writer.close(); }
+
+  [[nodiscard]] const std::string &getPath() const { return Writer.getPath(); }
+
+private:
+  ESGEdgeLogWriter Writer;
+  std::unordered_map<N, uint32_t> NodeIDs;
+  std::unordered_map<D, uint32_t> FactIDs;
+  std::unordered_map<std::string, uint32_t> LabelIDs;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FACTINTERNER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_FACTINTERNER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace psr {
+
+/// Assigns each distinct data-flow fact a dense 32-bit ID, starting at zero
+/// in the order in which the facts are interned, and maps IDs back to facts.
+///
+/// Every fact is stored exactly once and hashed exactly once; afterwards the
+/// solver's tables can compare and hash the IDs instead of the facts, which
+/// pays off for fact types such as ExtendedValue whose comparison and hashing
+/// walk vectors and strings. IDs stay valid until clear() is called.
+template <typename D> class FactInterner {
+public:
+  using IdType = uint32_t;
+
+  /// An ID that is never handed out for a fact.
+  static constexpr IdType None = std::numeric_limits<IdType>::max();
+
+  /// Returns the ID of the given fact, which is interned if necessary.
+  IdType getOrCreateID(const D &Fact) {
+    if ((Facts.size() + 1) * 4 > Slots.size() * 3) {
+      grow();
+    }
+    size_t Hash = hashOf(Fact);
+    size_t Idx = Hash & (Slots.size() - 1);
+    for (; Slots[Idx].ID != None; Idx = (Idx + 1) & (Slots.size() - 1)) {
+      if (Slots[Idx].Hash == Hash && Facts[Slots[Idx].ID] == Fact) {
+        return Slots[Idx].ID;
+      }
+    }
+    assert(Facts.size() < None && "Too many distinct facts!");
+    auto ID = static_cast<IdType>(Facts.size());
+    Facts.push_back(Fact);
+    Slots[Idx] = {Hash, ID};
+    return ID;
+  }
+
+  /// Returns the ID of the given fact or None if it has not been interned.
+  [[nodiscard]] IdType getID(const D &Fact) const {
+    if (Slots.empty()) {
+      return None;
+    }
+    size_t Hash = hashOf(Fact);
+    for (size_t Idx = Hash & (Slots.size() - 1); Slots[Idx].ID != None;
+         Idx = (Idx + 1) & (Slots.size() - 1)) {
+      if (Slots[Idx].Hash == Hash && Facts[Slots[Idx].ID] == Fact) {
+        return Slots[Idx].ID;
+      }
+    }
+    return None;
+  }
+
+  /// Returns the fact with the given ID.
+  [[nodiscard]] const D &getFact(IdType ID) const {
+    assert(ID < Facts.size() && "Unknown fact ID!");
+    return Facts[ID];
+  }
+
+  /// Returns the number of interned facts.
+  [[nodiscard]] size_t size() const { return Facts.size(); }
+
+  void clear() {
+    Slots.clear();
+    Facts.clear();
+  }
+
+private:
+  struct Slot {
+    size_t Hash = 0;
+    IdType ID = None;
+  };
+
+  static size_t hashOf(const D &Fact) {
+    // std::hash is the identity for pointers, whose low bits are always zero,
+    // so scramble it using the finalizer of splitmix64
+    uint64_t Hash = std::hash<D>{}(Fact);
+    Hash = (Hash ^ (Hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    Hash = (Hash ^ (Hash >> 27)) * 0x94d049bb133111ebULL;
+    return Hash ^ (Hash >> 31);
+  }
+
+  void grow() {
+    std::vector<Slot> NewSlots(std::max<size_t>(Slots.size() * 2, 16));
+    for (const auto &S : Slots) {
+      if (S.ID == None) {
+        continue;
+      }
+      size_t Idx = S.Hash & (NewSlots.size() - 1);
+      while (NewSlots[Idx].ID != None) {
+        Idx = (Idx + 1) & (NewSlots.size() - 1);
+      }
+      NewSlots[Idx] = S;
+    }
+    Slots.swap(NewSlots);
+  }
+
+  // open-addressing index into Facts; the hashes are kept to neither rehash
+  // nor compare facts needlessly
+  std::vector<Slot> Slots;
+  std::vector<D> Facts;
+};
+
+} // namespace psr
+
+#endif
@@ -17,42 +17,66 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESOLVER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "nlohmann/json.hpp"
 
 #include "boost/algorithm/string/trim.hpp"
 
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include "phasar/Config/Configuration.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionHandle.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowEdgeFunctionCache.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IDETabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryPool.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/JoinLattice.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSSolverTest.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/DenseJumpFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGEdgeLog.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSToIDETabulationProblem.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JoinHandlingNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/JumpFunctions.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/LinkedNode.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ResultsView.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverProfile.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/WorkStealingPathEdgeWorklist.h"
 #include "phasar/PhasarLLVM/Domain/AnalysisDomain.h"
 #include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+#include "phasar/Utils/Concurrency.h"
+#include "phasar/Utils/FlatTable.h"
 #include "phasar/Utils/LLVMShorthands.h"
 #include "phasar/Utils/Logger.h"
 #include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/SolverBudget.h"
 #include "phasar/Utils/Table.h"
 
 namespace psr {
@@ -79,8 +103,17 @@ template <typename AnalysisDomainTy, typename Container> struct IFDSExtension {
 /// Solves the given IDETabulationProblem as described in the 1996 paper by
 /// Sagiv, Horwitz and Reps. To solve the problem, call solve(). Results
 /// can then be queried by using resultAt() and resultsAt().
+///
+/// Path edges are processed from a worklist rather than recursively. The
+/// solver's optional features, e.g., budgets, checkpoints and persisted
+/// summaries, are enabled via the problem's IFDSIDESolverConfig, whose
+/// setters describe them.
+///
+/// TableTy is the table implementation that the solver uses for its values,
+/// summaries and recorded edges; it is either Table or FlatTable.
 template <typename AnalysisDomainTy,
           typename Container = std::set<typename AnalysisDomainTy::d_t>,
+          template <typename, typename, typename> class TableTy = Table,
           bool = is_analysis_domain_extensions<AnalysisDomainTy>::value>
 class IDESolver
     : protected std::conditional_t<
@@ -103,9 +136,13 @@ public:
   IDESolver(IDETabulationProblem<AnalysisDomainTy, Container> &Problem)
       : IDEProblem(Problem), ZeroValue(Problem.getZeroValue()),
         ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
+        Worklist(ICF, SolverConfig.worklistPolicy()),
         cachedFlowEdgeFunctions(Problem), allTop(Problem.allTopFunction()),
         jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
             allTop, IDEProblem)),
+        DenseJumpFn(makeDenseJumpFunctions()),
+        ESGRecorder(makeESGRecorder()), Profiler(makeProfiler()),
+        PersistedSummaries(makeSummaryStore()),
         Seeds(Problem.initialSeeds()) {}
 
   IDESolver(const IDESolver &) = delete;
@@ -119,6 +156,7 @@ public:
     using TableCell = typename Table<n_t, d_t, l_t>::Cell;
     const static std::string DataFlowID = "DataFlow";
     nlohmann::json J;
+    computePendingValues();
     auto results = this->valtab.cellSet();
     if (results.empty()) {
       J[DataFlowID] = "EMPTY";
@@ -148,24 +186,7 @@ public:
   /// \brief Runs the solver on the configured problem. This can take some time.
   virtual void solve() {
     PAMM_GET_INSTANCE;
-    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Kill facts", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Summary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Intra Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("Inter Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
-    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Value Propagation", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Value Computation", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
-    REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
-    REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
+    registerCounters();
 
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
                       << "IDE solver is solving the specified problem";
@@ -173,29 +194,119 @@ public:
                   << "Submit initial seeds, construct exploded super graph");
     // computations starting here
     START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    startBudget();
     // We start our analysis and construct exploded supergraph
-    submitInitialSeeds();
+    Checkpointer = makeCheckpointer();
+    if (!resumeFromCheckpoint()) {
+      checkpoint([](auto &C) { C.start(); });
+      submitInitialSeeds();
+    }
+    checkpoint([this](auto &C) { C.finish(Worklist, PathEdgeCount); });
+    Checkpointer.reset();
     STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    if (isComplete()) {
+      savePersistedSummaries();
+    } else {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Stopped the construction of the exploded super-graph "
+                       "after "
+                    << Budget->getNumWorkItems() << " path edges ("
+                    << Budget->exhaustion() << "), the results are incomplete");
+    }
     if (SolverConfig.computeValues()) {
       START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
       // Computing the final values for the edge functions
       LOG_IF_ENABLE(
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Compute the final values according to the edge functions");
-      computeValues();
+      if (SolverConfig.lazyValues()) {
+        // the values at the other nodes are computed when they are queried
+        computeValuesAtAnchors();
+        ValuesOnDemand = true;
+      } else {
+        computeValues();
+      }
       STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
     }
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO) << "Problem solved");
     if constexpr (PAMM_CURR_SEV_LEVEL >= PAMM_SEVERITY_LEVEL::Core) {
       computeAndPrintStatistics();
     }
+    if (ESGRecorder) {
+      ESGRecorder->close();
+    }
+    if (Profiler) {
+      writeProfile();
+    }
     if (SolverConfig.emitESG()) {
       emitESGAsDot();
     }
   }
 
+  /// Restricts the construction of the exploded super-graph to the nodes for
+  /// which Relevant returns true. The path edges to other nodes are deferred
+  /// and processed by a later call to tabulate() once they are relevant. The
+  /// filter may only ever admit more nodes, as the deferred path edges are
+  /// the only record of the work that is left. Jump functions are not retired
+  /// while a filter is set. The values of such a partial exploded super-graph
+  /// are computed for individual nodes by computeValuesAt(), which is how
+  /// DemandDrivenAnalysis answers queries.
+  void setNodeFilter(std::function<bool(n_t)> Relevant) {
+    NodeFilter = std::move(Relevant);
+  }
+
+  /// Constructs the exploded super-graph (Phase I) without computing values
+  /// or persisting summaries. Subsequent calls continue the construction with
+  /// the deferred path edges that pass the node filter by now, see
+  /// setNodeFilter().
+  void tabulate() {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    if (!SeedsSubmitted) {
+      registerCounters();
+      startBudget();
+      submitInitialSeeds();
+    } else {
+      processDeferredPathEdges();
+    }
+    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Computes the values at the given nodes only (Phase II) from the exploded
+  /// super-graph constructed by tabulate(). The values that have been
+  /// computed before are discarded.
+  void computeValuesAt(const std::vector<n_t> &Nodes) {
+    PAMM_GET_INSTANCE;
+    START_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+    valtab.clear();
+    NodesWithValues.clear();
+    NodesWithValues.insert(Nodes.begin(), Nodes.end());
+    computeValuesAtAnchors();
+    valueComputationTask(Nodes);
+    STOP_TIMER("DFA Phase II", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Returns false if Phase I stopped because the solver's budget was
+  /// exhausted, see IFDSIDESolverConfig::setBudget(), in which case the
+  /// results lack the facts and values of the dropped path edges.
+  [[nodiscard]] bool isComplete() const {
+    return !Budget || !Budget->isExhausted();
+  }
+
+  /// Returns why Phase I stopped before reaching its fixpoint, if it did.
+  [[nodiscard]] BudgetExhaustion getBudgetExhaustion() const {
+    return Budget ? Budget->exhaustion() : BudgetExhaustion::None;
+  }
+
+  /// Returns the number of path edges that have been deferred by the node
+  /// filter and are still pending.
+  [[nodiscard]] size_t getNumDeferredPathEdges() const {
+    return DeferredPathEdges.size();
+  }
+
   /// Returns the L-type result for the given value at the given statement.
   [[nodiscard]] virtual l_t resultAt(n_t stmt, d_t value) {
+    computeValuesOnDemand(stmt);
     return valtab.get(stmt, value);
   }
 
@@ -219,10 +330,10 @@ public:
       std::is_same_v<std::remove_reference_t<NTy>, llvm::Instruction *>, l_t>
   resultAtInLLVMSSA(NTy stmt, d_t value) {
     if (stmt->getType()->isVoidTy()) {
-      return valtab.get(stmt, value);
+      return resultAt(stmt, value);
     }
     assert(stmt->getNextNode() && "Expected to find a valid successor node!");
-    return valtab.get(stmt->getNextNode(), value);
+    return resultAt(stmt->getNextNode(), value);
   }
 
   /// Returns the resulting environment for the given statement.
@@ -230,19 +341,34 @@ public:
   /// TOP values are never returned.
   [[nodiscard]] virtual std::unordered_map<d_t, l_t>
   resultsAt(n_t stmt, bool stripZero = false) /*TODO const*/ {
-    std::unordered_map<d_t, l_t> result = valtab.row(stmt);
-    if (stripZero) {
-      for (auto it = result.begin(); it != result.end();) {
-        if (IDEProblem.isZeroValue(it->first)) {
-          it = result.erase(it);
-        } else {
-          ++it;
-        }
-      }
+    std::unordered_map<d_t, l_t> result;
+    for (const auto &[d, l] : resultsViewAt(stmt, stripZero)) {
+      result.emplace(d, l);
     }
     return result;
   }
 
+  /// Returns a view of the (fact, value) pairs at the given statement that
+  /// refers to the solver's results instead of copying them. The artificial
+  /// zero value can be automatically stripped.
+  [[nodiscard]] auto resultsViewAt(n_t stmt, bool stripZero = false) {
+    computeValuesOnDemand(stmt);
+    return makeResultsView(std::as_const(valtab).row(stmt), ZeroValue,
+                           stripZero);
+  }
+
+  /// Calls Fn(stmt, fact, value) for all results at the statements of the
+  /// given function without copying them. The artificial zero value can be
+  /// automatically stripped.
+  template <typename FnTy>
+  void foreachResultIn(f_t fun, FnTy Fn, bool stripZero = false) {
+    for (n_t stmt : ICF->getAllInstructionsOf(fun)) {
+      for (const auto &[d, l] : resultsViewAt(stmt, stripZero)) {
+        Fn(stmt, d, l);
+      }
+    }
+  }
+
   /// Returns the data-flow results at the given statement while respecting
   /// LLVM's SSA semantics.
   ///
@@ -263,23 +389,10 @@ public:
       std::is_same_v<std::remove_reference_t<NTy>, llvm::Instruction *>,
       std::unordered_map<d_t, l_t>>
   resultsAtInLLVMSSA(NTy stmt, bool stripZero = false) {
-    std::unordered_map<d_t, l_t> result = [this, stmt]() {
-      if (stmt->getType()->isVoidTy()) {
-        return valtab.row(stmt);
-      }
-      return valtab.row(stmt->getNextNode());
-    }();
-    if (stripZero) {
-      // TODO: replace with std::erase_if (C++20)
-      for (auto it = result.begin(); it != result.end();) {
-        if (IDEProblem.isZeroValue(it->first)) {
-          it = result.erase(it);
-        } else {
-          ++it;
-        }
-      }
+    if (stmt->getType()->isVoidTy()) {
+      return resultsAt(stmt, stripZero);
     }
-    return result;
+    return resultsAt(stmt->getNextNode(), stripZero);
   }
 
   virtual void emitTextReport(std::ostream &OS = std::cout) {
@@ -296,6 +409,11 @@ public:
     OS << "\n***************************************************************\n"
        << "*                  Raw IDESolver results                      *\n"
        << "***************************************************************\n";
+    if (!isComplete()) {
+      OS << "Results are incomplete, the solver's budget was exhausted ("
+         << getBudgetExhaustion() << ")\n";
+    }
+    computePendingValues();
     auto cells = this->valtab.cellVec();
     if (cells.empty()) {
       OS << "No results computed!" << std::endl;
@@ -378,8 +496,9 @@ public:
   }
 
   SolverResults<n_t, d_t, l_t> getSolverResults() {
-    return SolverResults<n_t, d_t, l_t>(this->valtab,
-                                        IDEProblem.getZeroValue());
+    computePendingValues();
+    return SolverResults<n_t, d_t, l_t>(this->valtab, IDEProblem.getZeroValue(),
+                                        isComplete());
   }
 
 protected:
@@ -390,26 +509,87 @@ protected:
   IFDSIDESolverConfig &SolverConfig;
   unsigned PathEdgeCount = 0;
 
+  // Unlike NativeIFDSSolver's, the tables below (except DenseJumpFn) are
+  // keyed on the facts rather than on FactInterner IDs: WPDSSolver, the
+  // summary store, checkpoints and the ESG log access them in terms of d_t,
+  // so interning them would have to translate IDs back at each of these.
+
+  // path edges that have been propagated but not yet processed
+  PathEdgeWorklist<n_t, d_t, f_t, i_t> Worklist;
+
+  // replaces Worklist while path edges are processed by multiple threads
+  std::unique_ptr<WorkStealingPathEdgeWorklist<n_t, d_t>> ConcurrentWorklist;
+
+  // guard the solver's tables while path edges are processed concurrently
+  std::mutex JumpFnMutex;
+  std::mutex SummaryMutex;
+  std::mutex RecordedEdgesMutex;
+  std::mutex ProfileMutex;
+
   FlowEdgeFunctionCache<AnalysisDomainTy, Container> cachedFlowEdgeFunctions;
 
-  Table<n_t, n_t, std::map<d_t, Container>> computedIntraPathEdges;
+  TableTy<n_t, n_t, std::map<d_t, Container>> computedIntraPathEdges;
 
-  Table<n_t, n_t, std::map<d_t, Container>> computedInterPathEdges;
+  TableTy<n_t, n_t, std::map<d_t, Container>> computedInterPathEdges;
 
   EdgeFunctionPtrType allTop;
 
   std::shared_ptr<JumpFunctions<AnalysisDomainTy, Container>> jumpFn;
 
+  // replaces jumpFn if IFDSIDESolverConfig::denseJumpFunctions() is set
+  std::unique_ptr<DenseJumpFunctions<AnalysisDomainTy, Container>>
+      DenseJumpFn;
+
   std::map<std::tuple<n_t, d_t, n_t, d_t>, std::vector<EdgeFunctionPtrType>>
       intermediateEdgeFunctions;
 
+  // replaces computedIntraPathEdges, computedInterPathEdges and
+  // intermediateEdgeFunctions if IFDSIDESolverConfig::esgLogFile() is set
+  std::unique_ptr<ESGEdgeRecorder<n_t, d_t>> ESGRecorder;
+
+  // the per-function profile if IFDSIDESolverConfig::profileFile() is set
+  std::unique_ptr<SolverProfiler<n_t, f_t>> Profiler;
+
+  // tracks IFDSIDESolverConfig::budget() from the start of Phase I, nullptr
+  // if the budget is unlimited
+  std::unique_ptr<BudgetMonitor> Budget;
+
+  // checkpoints to IFDSIDESolverConfig::checkpointFile() while solve()
+  // constructs the exploded super-graph, nullptr if the solver does not
+  // checkpoint
+  std::unique_ptr<SolverCheckpointer<EdgeFunctionPtrType>> Checkpointer;
+
   // stores summaries that were queried before they were computed
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<n_t, d_t, Table<n_t, d_t, EdgeFunctionPtrType>> endsummarytab;
+  TableTy<n_t, d_t, TableTy<n_t, d_t, EdgeFunctionPtrType>> endsummarytab;
+
+  // end summaries loaded from the summary store, which are complete for each
+  // start point and fact that they contain, see
+  // IFDSIDESolverConfig::computePersistedSummaries()
+  TableTy<n_t, d_t, TableTy<n_t, d_t, EdgeFunctionPtrType>>
+      persistedsummarytab;
+  std::shared_ptr<SummaryStore> PersistedSummaries;
+  // the keys of the functions whose persisted summaries have been looked up
+  std::unordered_map<f_t, std::string> PersistedSummaryKeys;
+  std::unordered_map<f_t, std::string> ContentHashes;
+  // the jump functions within the callees of the persisted summaries, see
+  // IFDSIDESolverConfig::persistJumpFunctions()
+  struct PersistedJumpFunction {
+    n_t Target;
+    d_t TargetFact;
+    EdgeFunctionPtrType Function;
+  };
+  std::map<std::pair<n_t, d_t>, std::vector<PersistedJumpFunction>>
+      persistedjumpfntab;
+  // the persisted summaries whose jump functions have been restored, or
+  // cannot be restored, respectively
+  std::set<std::pair<n_t, d_t>> ReplayedSummaries;
+  std::set<std::pair<n_t, d_t>> UnreplayableSummaries;
+  std::mutex PersistedSummaryMutex;
 
   // edges going along calls
   // see CC 2010 paper by Naeem, Lhotak and Rodriguez
-  Table<n_t, d_t, std::map<n_t, Container>> incomingtab;
+  TableTy<n_t, d_t, std::map<n_t, Container>> incomingtab;
 
   // stores the return sites (inside callers) to which we have unbalanced
   // returns if SolverConfig.followReturnPastSeeds is enabled
@@ -417,10 +597,30 @@ protected:
 
   InitialSeeds<n_t, d_t, l_t> Seeds;
 
-  Table<n_t, d_t, l_t> valtab;
+  TableTy<n_t, d_t, l_t> valtab;
+  // set if the values at the nodes other than start points and call sites are
+  // computed on demand, see IFDSIDESolverConfig::lazyValues(), and the nodes
+  // whose values have been computed so far
+  bool ValuesOnDemand = false;
+  std::unordered_set<n_t> NodesWithValues;
 
   std::map<std::pair<n_t, d_t>, size_t> fSummaryReuse;
 
+  // bookkeeping for IFDSIDESolverConfig::retireJumpFunctions(): the number of
+  // pending path edges per function and the nodes at which jump functions
+  // have been added since the function's jump functions were last retired
+  std::unordered_map<f_t, size_t> NumPendingEdges;
+  std::unordered_map<f_t, std::vector<n_t>> RetirableNodes;
+  // set while a function is re-tabulated in Phase II
+  bool Retabulating = false;
+
+  // restricts Phase I to the relevant nodes, see setNodeFilter(), and the
+  // path edges to other nodes that have been deferred so far
+  std::function<bool(n_t)> NodeFilter;
+  std::vector<PathEdge<n_t, d_t>> DeferredPathEdges;
+  std::mutex DeferredPathEdgesMutex;
+  bool SeedsSubmitted = false;
+
   // When transforming an IFDSTabulationProblem into an IDETabulationProblem,
   // we need to allocate dynamically, otherwise the objects lifetime runs out
   // - as a modifiable r-value reference created here that should be stored in
@@ -436,12 +636,273 @@ protected:
         IDEProblem(*this->TransformedProblem),
         ZeroValue(IDEProblem.getZeroValue()), ICF(IDEProblem.getICFG()),
         SolverConfig(IDEProblem.getIFDSIDESolverConfig()),
+        Worklist(ICF, SolverConfig.worklistPolicy()),
         cachedFlowEdgeFunctions(IDEProblem),
         allTop(IDEProblem.allTopFunction()),
         jumpFn(std::make_shared<JumpFunctions<AnalysisDomainTy, Container>>(
             allTop, IDEProblem)),
+        DenseJumpFn(makeDenseJumpFunctions()),
+        ESGRecorder(makeESGRecorder()), Profiler(makeProfiler()),
+        PersistedSummaries(makeSummaryStore()),
         Seeds(IDEProblem.initialSeeds()) {}
 
+  void registerCounters() {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Kill facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Summary-reuse", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Intra Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Inter Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Value Propagation", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Value Computation", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("SpecialSummary-EF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("PersistedSummary Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("JumpFn Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("JumpFn Re-propagation", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("JumpFn Retirement", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("JumpFn Replay", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Worklist Max Size", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("[Calls] getPointsToSet", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_HISTOGRAM("Data-flow facts", PAMM_SEVERITY_LEVEL::Full);
+    REG_HISTOGRAM("Points-to", PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  std::unique_ptr<DenseJumpFunctions<AnalysisDomainTy, Container>>
+  makeDenseJumpFunctions() {
+    if (!SolverConfig.denseJumpFunctions()) {
+      return nullptr;
+    }
+    return std::make_unique<DenseJumpFunctions<AnalysisDomainTy, Container>>(
+        allTop, IDEProblem);
+  }
+
+  std::unique_ptr<ESGEdgeRecorder<n_t, d_t>> makeESGRecorder() {
+    if (SolverConfig.esgLogFile().empty()) {
+      return nullptr;
+    }
+    return std::make_unique<ESGEdgeRecorder<n_t, d_t>>(
+        SolverConfig.esgLogFile());
+  }
+
+  std::unique_ptr<SolverProfiler<n_t, f_t>> makeProfiler() {
+    if (SolverConfig.profileFile().empty()) {
+      return nullptr;
+    }
+    return std::make_unique<SolverProfiler<n_t, f_t>>();
+  }
+
+  /// The profile counters of the path edge that the current thread is
+  /// processing, nullptr if the solver does not profile.
+  static SolverProfileCounters *&currentProfileCounters() {
+    static thread_local SolverProfileCounters *Counters = nullptr;
+    return Counters;
+  }
+
+  void profileTargets(size_t NumFacts) {
+    if (auto *Counters = currentProfileCounters()) {
+      Counters->addTargets(NumFacts);
+    }
+  }
+
+  void profileCompositions(uint64_t NumCompositions) {
+    if (auto *Counters = currentProfileCounters()) {
+      Counters->Compositions += NumCompositions;
+    }
+  }
+
+  void startBudget() {
+    if (!SolverConfig.budget().isUnlimited()) {
+      Budget = std::make_unique<BudgetMonitor>(SolverConfig.budget());
+    }
+  }
+
+  /// Accounts for processing a path edge against the solver's budget and
+  /// returns true if Phase I has to stop instead. The re-tabulation in
+  /// Phase II is not subject to the budget.
+  bool exhaustsBudget() { return Budget && !Retabulating && Budget->step(); }
+
+  /// Returns why the problem's summaries cannot be persisted, or an empty
+  /// string if they can. Persisting them requires a problem on LLVM IR that
+  /// identifies its analysis, see
+  /// IFDSTabulationProblem::getSummaryAnalysisID().
+  std::string getSummaryObstacle() const {
+    if (!CanPersistSummaries) {
+      return "the problem is not an analysis on LLVM IR";
+    }
+    if (IDEProblem.getSummaryAnalysisID().empty()) {
+      return "the problem does not provide a summary analysis ID";
+    }
+    return {};
+  }
+
+  /// Returns why the solver's state cannot be checkpointed, or an empty
+  /// string if it can. Checkpoints are made of the same parts as persisted
+  /// summaries, see getSummaryObstacle().
+  std::string getCheckpointObstacle() const {
+    if (auto Obstacle = getSummaryObstacle(); !Obstacle.empty()) {
+      return Obstacle;
+    }
+    if (getNumThreads() > 1) {
+      return "the solver uses several threads";
+    }
+    if (retiresJumpFunctions()) {
+      return "the solver retires jump functions";
+    }
+    if (NodeFilter) {
+      return "the solver is restricted to a part of the program";
+    }
+    return {};
+  }
+
+  /// Returns the checkpointer for IFDSIDESolverConfig::checkpointFile(), or
+  /// nullptr if no checkpoint file is set. Reports on std::cerr if the solver
+  /// cannot checkpoint, as the user has asked for it.
+  std::unique_ptr<SolverCheckpointer<EdgeFunctionPtrType>> makeCheckpointer() {
+    if (SolverConfig.checkpointFile().empty()) {
+      return nullptr;
+    }
+    if (auto Obstacle = getCheckpointObstacle(); !Obstacle.empty()) {
+      std::cerr << "Not writing the solver checkpoint "
+                << SolverConfig.checkpointFile() << ": " << Obstacle << '\n';
+      return nullptr;
+    }
+    if constexpr (CanPersistSummaries) {
+      return std::make_unique<SolverCheckpointer<EdgeFunctionPtrType>>(
+          SolverConfig.checkpointFile(), SolverConfig.checkpointInterval(),
+          IDEProblem.getSummaryAnalysisID(), *IDEProblem.getProjectIRDB(),
+          ZeroValue,
+          [this](const EdgeFunctionPtrType &F) {
+            return IDEProblem.edgeFunctionToSummaryString(F);
+          },
+          [this](const std::string &Label) {
+            return IDEProblem.edgeFunctionFromSummaryString(Label);
+          });
+    }
+    return nullptr;
+  }
+
+  /// Calls Hook with the checkpointer if the solver checkpoints.
+  template <typename HookFn> void checkpoint(HookFn Hook) {
+    if constexpr (CanPersistSummaries) {
+      if (Checkpointer) {
+        Hook(*Checkpointer);
+      }
+    }
+  }
+
+  /// Restores the state of Phase I from IFDSIDESolverConfig::checkpointFile()
+  /// and continues Phase I from there. Returns false, leaving the solver
+  /// untouched, if resuming is not configured or the checkpoint cannot be
+  /// resumed, see SolverCheckpointer::resume().
+  bool resumeFromCheckpoint() {
+    if constexpr (CanPersistSummaries) {
+      if (!Checkpointer || !SolverConfig.resumeFromCheckpoint()) {
+        return false;
+      }
+      completeInitialSeeds();
+      std::set<std::pair<n_t, d_t>> SeedNodes;
+      for (const auto &[StartPoint, SeedFacts] : Seeds.getSeeds()) {
+        for (const auto &Seed : SeedFacts) {
+          SeedNodes.emplace(StartPoint, Seed.first);
+        }
+      }
+      auto State = Checkpointer->resume(SeedNodes);
+      if (!State) {
+        return false;
+      }
+      withJumpFunctions([&](auto &JF) {
+        for (auto &[Source, Target, TargetFact, F] : State->JumpFunctions) {
+          JF.addFunction(Source, Target, TargetFact, std::move(F));
+        }
+      });
+      for (auto &[sP, d1, eP, d2, F] : State->EndSummaries) {
+        endsummarytab.get(sP, d1).insert(eP, d2, std::move(F));
+      }
+      for (const auto &[sP, d3, n, d2] : State->Incomings) {
+        incomingtab.get(sP, d3)[n].insert(d2);
+      }
+      unbalancedRetSites.insert(State->UnbalancedReturnSites.begin(),
+                                State->UnbalancedReturnSites.end());
+      for (const auto &[Source, Target, TargetFact] : State->Worklist) {
+        Worklist.push(PathEdge<n_t, d_t>(Source, Target, TargetFact));
+      }
+      PathEdgeCount = State->NumPathEdges;
+      SeedsSubmitted = true;
+      processPathEdges();
+      return true;
+    }
+    return false;
+  }
+
+  /// Writes the profile to IFDSIDESolverConfig::profileFile().
+  void writeProfile() {
+    auto Profile = Profiler->getProfile(
+        [this](f_t Fun) { return ICF->getFunctionName(Fun); },
+        [this](n_t CallSite) {
+          std::string Label = IDEProblem.NtoString(CallSite);
+          boost::algorithm::trim(Label);
+          return std::make_pair(ICF->getStatementId(CallSite),
+                                std::move(Label));
+        });
+    try {
+      Profile.write(SolverConfig.profileFile());
+    } catch (const std::ios_base::failure &E) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), ERROR)
+                    << "Could not write the solver profile: " << E.what());
+    }
+  }
+
+  // summaries can only be persisted for LLVM IR, whose functions can be
+  // hashed and whose values can be identified across modules
+  static constexpr bool CanPersistSummaries =
+      std::is_same_v<n_t, const llvm::Instruction *> &&
+      std::is_same_v<d_t, const llvm::Value *> &&
+      std::is_same_v<f_t, const llvm::Function *>;
+
+  /// Returns a flow function that applies the precomputed summaries of
+  /// callee at callSite, or nullptr if there are none.
+  FlowFunctionPtrType librarySummaryFlowFunction(n_t callSite, f_t callee) {
+    if constexpr (CanPersistSummaries &&
+                  std::is_same_v<FlowFunctionPtrType,
+                                 std::shared_ptr<FlowFunction<d_t>>>) {
+      if (const auto *Pool = SolverConfig.librarySummaries()) {
+        return Pool->getSummaryFlowFunction(callSite, callee, ZeroValue);
+      }
+    }
+    return nullptr;
+  }
+
+  /// Reports on std::cerr if the user has asked for a store of persisted
+  /// summaries that the problem cannot use. Analysis strategies that share
+  /// an in-memory store report on their own.
+  std::shared_ptr<SummaryStore> makeSummaryStore() {
+    if (!SolverConfig.computePersistedSummaries()) {
+      return nullptr;
+    }
+    if (auto Obstacle = getSummaryObstacle(); !Obstacle.empty()) {
+      if (!SolverConfig.summaryStore().empty()) {
+        std::cerr << "Not persisting summaries in "
+                  << SolverConfig.summaryStore() << ": " << Obstacle << '\n';
+      }
+      return nullptr;
+    }
+    if constexpr (CanPersistSummaries) {
+      if (SolverConfig.sharedSummaryStore()) {
+        return SolverConfig.sharedSummaryStore();
+      }
+      if (!SolverConfig.summaryStore().empty()) {
+        return std::make_shared<SummaryStore>(SolverConfig.summaryStore());
+      }
+    }
+    return nullptr;
+  }
+
   /// Lines 13-20 of the algorithm; processing a call site in the caller's
   /// context.
   ///
@@ -490,13 +951,19 @@ protected:
       // check if a special summary for the called procedure exists
       FlowFunctionPtrType specialSum =
           cachedFlowEdgeFunctions.getSummaryFlowFunction(n, sCalledProcN);
+      if (!specialSum) {
+        specialSum = librarySummaryFlowFunction(n, sCalledProcN);
+      }
       // if a special summary is available, treat this as a normal flow
       // and use the summary flow and edge functions
       if (specialSum) {
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Found and process special summary");
+        // the summary's targets do not depend on the return site
+        const container_type res =
+            computeSummaryFlowFunction(specialSum, d1, d2);
+        profileTargets(res.size());
         for (n_t returnSiteN : returnSiteNs) {
-          container_type res = computeSummaryFlowFunction(specialSum, d1, d2);
           INC_COUNTER("SpecialSummary-FF Application", 1,
                       PAMM_SEVERITY_LEVEL::Full);
           ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
@@ -514,6 +981,7 @@ protected:
                 BOOST_LOG_SEV(lg::get(), DEBUG)
                 << "Compose: " << sumEdgFnE->str() << " * " << f->str();
                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+            profileCompositions(1);
             propagate(d1, returnSiteN, d3, f->composeWith(sumEdgFnE), n, false);
           }
         }
@@ -525,6 +993,7 @@ protected:
         container_type res = computeCallFlowFunction(function, d1, d2);
         ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                          PAMM_SEVERITY_LEVEL::Full);
+        profileTargets(res.size());
         // for each callee's start point(s)
         std::set<n_t> startPointsOf = ICF->getStartPointsOf(sCalledProcN);
         if (startPointsOf.empty()) {
@@ -535,6 +1004,7 @@ protected:
                         BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
         }
         // if startPointsOf is empty, the called function is a declaration
+        const container_type CallerSideDs{d2};
         for (n_t sP : startPointsOf) {
           saveEdges(n, sP, d2, res, true);
           // for each result node of the call-flow function
@@ -545,11 +1015,22 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Create initial self-loop with D: "
                           << IDEProblem.DtoString(d3));
-            propagate(d3, sP, d3, EdgeIdentity<l_t>::getInstance(), n,
-                      false); // line 15
+            // a persisted summary replaces the descent into the callee
+            auto PersistedSumm = persistedEndSummary(sP, d3);
+            // a re-tabulation only applies the callee's existing summaries
+            bool Descend = !Retabulating && !PersistedSumm;
+            if (Descend) {
+              propagate(d3, sP, d3, EdgeIdentity<l_t>::getInstance(), n,
+                        false); // line 15
+            }
             // register the fact that <sp,d3> has an incoming edge from <n,d2>
             // line 15.1 of Naeem/Lhotak/Rodriguez
-            addIncoming(sP, d3, n, d2);
+            // (registering and reading the summaries must not interleave with
+            // processExit() in order not to miss a summary)
+            auto SummaryLock = lockIfConcurrent(SummaryMutex);
+            if (Descend) {
+              addIncoming(sP, d3, n, d2);
+            }
             // line 15.2, copy to avoid concurrent modification exceptions by
             // other threads
             // const std::set<TableCell> endSumm(endSummary(sP, d3));
@@ -564,7 +1045,12 @@ protected:
             // <sP,d3>, create new caller-side jump functions to the return
             // sites because we have observed a potentially new incoming
             // edge into <sP,d3>
-            for (const TableCell entry : endSummary(sP, d3)) {
+            const auto EndSumm =
+                PersistedSumm ? std::move(*PersistedSumm) : endSummary(sP, d3);
+            if (SummaryLock) {
+              SummaryLock.unlock();
+            }
+            for (const TableCell entry : EndSumm) {
               n_t eP = entry.getRowKey();
               d_t d4 = entry.getColumnKey();
               EdgeFunctionPtrType fCalleeSummary = entry.getValue();
@@ -576,9 +1062,10 @@ protected:
                                                                eP, retSiteN);
                 INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
                 const container_type returnedFacts = computeReturnFlowFunction(
-                    retFunction, d3, d4, n, Container{d2});
+                    retFunction, d3, d4, n, CallerSideDs);
                 ADD_TO_HISTOGRAM("Data-flow facts", returnedFacts.size(), 1,
                                  PAMM_SEVERITY_LEVEL::Full);
+                profileTargets(returnedFacts.size());
                 saveEdges(eP, retSiteN, d4, returnedFacts, true);
                 // for each target value of the function
                 for (d_t d5 : returnedFacts) {
@@ -598,12 +1085,9 @@ protected:
                                 << f5->str());
                   if (SolverConfig.emitESG()) {
                     for (auto sP : ICF->getStartPointsOf(sCalledProcN)) {
-                      intermediateEdgeFunctions[std::make_tuple(n, d2, sP, d3)]
-                          .push_back(f4);
+                      recordEdgeFunction(n, d2, sP, d3, f4);
                     }
-                    intermediateEdgeFunctions[std::make_tuple(eP, d4, retSiteN,
-                                                              d5)]
-                        .push_back(f5);
+                    recordEdgeFunction(eP, d4, retSiteN, d5, f5);
                   }
                   INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
                   // compose call * calleeSummary * return edge functions
@@ -613,6 +1097,7 @@ protected:
                                     << f4->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG)
                                 << "         (return * calleeSummary * call)");
+                  profileCompositions(2);
                   EdgeFunctionPtrType fPrime =
                       f4->composeWith(fCalleeSummary)->composeWith(f5);
                   LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -624,6 +1109,7 @@ protected:
                                     << "Compose: " << fPrime->str() << " * "
                                     << f->str();
                                 BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+                  profileCompositions(1);
                   propagate(d1, retSiteN, d5_restoredCtx,
                             f->composeWith(fPrime), n, false);
                 }
@@ -644,6 +1130,7 @@ protected:
           computeCallToReturnFlowFunction(callToReturnFlowFunction, d1, d2);
       ADD_TO_HISTOGRAM("Data-flow facts", returnFacts.size(), 1,
                        PAMM_SEVERITY_LEVEL::Full);
+      profileTargets(returnFacts.size());
       saveEdges(n, returnSiteN, d2, returnFacts, false);
       for (d_t d3 : returnFacts) {
         EdgeFunctionPtrType edgeFnE =
@@ -653,10 +1140,10 @@ protected:
                       << "Queried Call-to-Return Edge Function: "
                       << edgeFnE->str());
         if (SolverConfig.emitESG()) {
-          intermediateEdgeFunctions[std::make_tuple(n, d2, returnSiteN, d3)]
-              .push_back(edgeFnE);
+          recordEdgeFunction(n, d2, returnSiteN, d3, edgeFnE);
         }
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        profileCompositions(1);
         auto fPrime = f->composeWith(edgeFnE);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Compose: " << edgeFnE->str() << " * " << f->str()
@@ -681,6 +1168,7 @@ protected:
     n_t n = edge.getTarget();
     d_t d2 = edge.factAtTarget();
     EdgeFunctionPtrType f = jumpFunction(edge);
+    EdgeFunctionHandle<l_t> F(f);
     for (const auto fn : ICF->getSuccsOf(n)) {
       FlowFunctionPtrType flowFunction =
           cachedFlowEdgeFunctions.getNormalFlowFunction(n, fn);
@@ -689,16 +1177,17 @@ protected:
           computeNormalFlowFunction(flowFunction, d1, d2);
       ADD_TO_HISTOGRAM("Data-flow facts", res.size(), 1,
                        PAMM_SEVERITY_LEVEL::Full);
+      profileTargets(res.size());
       saveEdges(n, fn, d2, res, false);
       for (d_t d3 : res) {
         EdgeFunctionPtrType g =
             cachedFlowEdgeFunctions.getNormalEdgeFunction(n, d2, fn, d3);
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Queried Normal Edge Function: " << g->str());
-        EdgeFunctionPtrType fprime = f->composeWith(g);
+        profileCompositions(1);
+        EdgeFunctionPtrType fprime = F.composeWith(g).get();
         if (SolverConfig.emitESG()) {
-          intermediateEdgeFunctions[std::make_tuple(n, d2, fn, d3)].push_back(
-              g);
+          recordEdgeFunction(n, d2, fn, d3, g);
         }
         LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Compose: " << g->str() << " * " << f->str()
@@ -715,18 +1204,20 @@ protected:
     d_t d = nAndD.second;
     f_t p = ICF->getFunctionOf(n);
     for (const n_t c : ICF->getCallsFromWithin(p)) {
-      auto lookupResults = jumpFn->forwardLookup(d, c);
-      if (!lookupResults) {
-        continue;
-      }
-      for (auto entry : lookupResults->get()) {
-        d_t dPrime = entry.first;
-        EdgeFunctionPtrType fPrime = entry.second;
-        n_t sP = n;
-        l_t value = val(sP, d);
-        INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
-        propagateValue(c, dPrime, fPrime->computeTarget(value));
-      }
+      withJumpFunctions([&](const auto &JF) {
+        auto lookupResults = JF.forwardLookup(d, c);
+        if (!lookupResults) {
+          return;
+        }
+        for (auto entry : *lookupResults) {
+          d_t dPrime = entry.first;
+          EdgeFunctionPtrType fPrime = entry.second;
+          n_t sP = n;
+          l_t value = val(sP, d);
+          INC_COUNTER("Value Propagation", 1, PAMM_SEVERITY_LEVEL::Full);
+          propagateValue(c, dPrime, fPrime->computeTarget(value));
+        }
+      });
     }
   }
 
@@ -744,8 +1235,7 @@ protected:
                       << "Queried Call Edge Function: " << edgeFn->str());
         if (SolverConfig.emitESG()) {
           for (const auto sP : ICF->getStartPointsOf(q)) {
-            intermediateEdgeFunctions[std::make_tuple(n, d, sP, dPrime)]
-                .push_back(edgeFn);
+            recordEdgeFunction(n, d, sP, dPrime, edgeFn);
           }
         }
         INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
@@ -768,7 +1258,8 @@ protected:
 
   l_t val(n_t nHashN, d_t nHashD) {
     if (valtab.contains(nHashN, nHashD)) {
-      return valtab.get(nHashN, nHashD);
+      // const lookup, as Phase II(ii) may read valtab concurrently
+      return std::as_const(valtab).get(nHashN, nHashD);
     }
     // implicitly initialized to top; see line [1] of Fig. 7 in SRH96 paper
     return IDEProblem.topElement();
@@ -806,38 +1297,79 @@ protected:
         BOOST_LOG_SEV(lg::get(), DEBUG)
         << "   Target D: " << IDEProblem.DtoString(edge.factAtTarget()));
 
-    auto fwdLookupRes =
-        jumpFn->forwardLookup(edge.factAtSource(), edge.getTarget());
-    if (fwdLookupRes) {
-      auto &ref = fwdLookupRes->get();
-      if (auto Find = std::find_if(ref.begin(), ref.end(),
-                                   [edge](const auto &Pair) {
-                                     return edge.factAtTarget() == Pair.first;
-                                   });
-          Find != ref.end()) {
-        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                          << "  => EdgeFn: " << Find->second->str();
-                      BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-        return Find->second;
+    auto Lock = lockIfConcurrent(JumpFnMutex);
+    return withJumpFunctions([&](const auto &JF) -> EdgeFunctionPtrType {
+      if (auto fwdLookupRes =
+              JF.forwardLookup(edge.factAtSource(), edge.getTarget())) {
+        for (const auto &[TargetVal, Function] : *fwdLookupRes) {
+          if (TargetVal == edge.factAtTarget()) {
+            LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                              << "  => EdgeFn: " << Function->str();
+                          BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
+            return Function;
+          }
+        }
+      }
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "  => EdgeFn: " << allTop->str();
+                    BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
+      // JumpFn initialized to all-top, see line [2] in SRH96 paper
+      return allTop;
+    });
+  }
+
+  /// Returns a copy of the jump functions that lead to the given node and
+  /// fact, i.e. pairs of source facts and their edge functions.
+  llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>
+  jumpFunctionsInto(n_t target, d_t targetVal) {
+    auto Lock = lockIfConcurrent(JumpFnMutex);
+    return withJumpFunctions([&](const auto &JF) {
+      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1> Copy;
+      if (auto revLookupResult = JF.reverseLookup(target, targetVal)) {
+        for (const auto &[SourceVal, Function] : *revLookupResult) {
+          Copy.emplace_back(SourceVal, Function);
+        }
       }
+      return Copy;
+    });
+  }
+
+  /// Applies Fn to the jump functions, which are kept in a DenseJumpFunctions
+  /// if IFDSIDESolverConfig::denseJumpFunctions() is set, and in jumpFn
+  /// otherwise.
+  template <typename FnTy> decltype(auto) withJumpFunctions(FnTy Fn) {
+    if (DenseJumpFn) {
+      return Fn(*DenseJumpFn);
     }
-    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                      << "  => EdgeFn: " << allTop->str();
-                  BOOST_LOG_SEV(lg::get(), DEBUG) << " ");
-    // JumpFn initialized to all-top, see line [2] in SRH96 paper
-    return allTop;
+    return Fn(*jumpFn);
+  }
+
+  /// Locks the given mutex if path edges are currently processed by multiple
+  /// threads; returns a lock that does not own a mutex otherwise.
+  std::unique_lock<std::mutex> lockIfConcurrent(std::mutex &M) {
+    return ConcurrentWorklist ? std::unique_lock<std::mutex>(M)
+                              : std::unique_lock<std::mutex>();
   }
 
   void addEndSummary(n_t sP, d_t d1, n_t eP, d_t d2, EdgeFunctionPtrType f) {
     // note: at this point we don't need to join with a potential previous f
     // because f is a jump function, which is already properly joined
-    // within propagate(..)
+    // within propagate(..); processExit() reads it under SummaryMutex, such
+    // that no older jump function replaces a newer one
+    checkpoint([&](auto &C) { C.addEndSummary(sP, d1, eP, d2, f); });
     endsummarytab.get(sP, d1).insert(eP, d2, std::move(f));
   }
 
   // should be made a callable at some point
   void pathEdgeProcessingTask(const PathEdge<n_t, d_t> edge) {
     PAMM_GET_INSTANCE;
+    if (NodeFilter && !NodeFilter(edge.getTarget())) {
+      // the edge is processed using its then current jump function once its
+      // target is relevant
+      auto Lock = lockIfConcurrent(DeferredPathEdgesMutex);
+      DeferredPathEdges.push_back(edge);
+      return;
+    }
     INC_COUNTER("JumpFn Construction", 1, PAMM_SEVERITY_LEVEL::Full);
     LOG_IF_ENABLE(
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -854,6 +1386,25 @@ protected:
         << "  D target: " << IDEProblem.DtoString(edge.factAtTarget()) << " >";
         BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
 
+    if (!Profiler) {
+      dispatchPathEdge(edge);
+      return;
+    }
+    SolverProfileCounters Counters;
+    Counters.PathEdges = 1;
+    currentProfileCounters() = &Counters;
+    auto Start = std::chrono::steady_clock::now();
+    dispatchPathEdge(edge);
+    Counters.Time = std::chrono::steady_clock::now() - Start;
+    currentProfileCounters() = nullptr;
+    n_t n = edge.getTarget();
+    bool IsCall = ICF->isCallSite(n);
+    auto Lock = lockIfConcurrent(ProfileMutex);
+    Profiler->add(ICF->getFunctionOf(n),
+                  IsCall ? std::optional<n_t>(n) : std::nullopt, Counters);
+  }
+
+  void dispatchPathEdge(const PathEdge<n_t, d_t> &edge) {
     if (!ICF->isCallSite(edge.getTarget())) {
       if (ICF->isExitInst(edge.getTarget())) {
         processExit(edge);
@@ -872,8 +1423,7 @@ protected:
     // our initial seeds are not necessarily method-start points but here they
     // should be treated as such the same also for unbalanced return sites in
     // an unbalanced problem
-    if (ICF->isStartPoint(n) || Seeds.countInitialSeeds(n) ||
-        unbalancedRetSites.count(n)) {
+    if (isAnchor(n)) {
       // FIXME: is currently not executed for main!!!
       // initial seeds are set in the global constructor, and main is also not
       // officially called by any other function
@@ -884,27 +1434,212 @@ protected:
     }
   }
 
+  /// Returns true if the values at n are propagated to the calls within its
+  /// function in Phase II(i), i.e., if n is a start point, an initial seed or
+  /// an unbalanced return site.
+  bool isAnchor(n_t n) {
+    return ICF->isStartPoint(n) || Seeds.countInitialSeeds(n) ||
+           unbalancedRetSites.count(n);
+  }
+
+  /// Returns the number of threads used to tabulate the exploded super-graph
+  /// and to compute the values, see IFDSIDESolverConfig::numThreads(). The
+  /// solver counts its work in PAMM, which is not synchronized, so it runs
+  /// single-threaded if PAMM is enabled.
+  unsigned getNumThreads() const {
+    return getNumPAMMSafeThreads(SolverConfig.numThreads());
+  }
+
+  /// Returns true if the jump functions of a function are retired once no
+  /// path edge of the function is pending, see
+  /// IFDSIDESolverConfig::retireJumpFunctions().
+  bool retiresJumpFunctions() const {
+    return SolverConfig.retireJumpFunctions() &&
+           getNumThreads() <= 1 && !SolverConfig.emitESG() &&
+           !SolverConfig.persistJumpFunctions() && !NodeFilter;
+  }
+
+  /// Removes the jump functions that have been added to fun's nodes since its
+  /// jump functions were last retired, except for those at anchors and, if
+  /// KeepBoundaries is set, at call sites and exits. The jump functions that
+  /// are kept suffice to continue Phase I: new path edges are joined at the
+  /// call sites and exits, and the ones in between are re-derived from them.
+  void retireJumpFunctions(f_t fun, bool KeepBoundaries) {
+    PAMM_GET_INSTANCE;
+    auto It = RetirableNodes.find(fun);
+    if (It == RetirableNodes.end()) {
+      return;
+    }
+    size_t NumRetired = 0;
+    std::vector<n_t> Kept;
+    withJumpFunctions([&](auto &JF) {
+      for (n_t n : It->second) {
+        if (isAnchor(n)) {
+          continue;
+        }
+        if (KeepBoundaries && (ICF->isCallSite(n) || ICF->isExitInst(n))) {
+          // to be retired after Phase II
+          Kept.push_back(n);
+          continue;
+        }
+        NumRetired += JF.removeFunctionsAt(n);
+      }
+    });
+    if (Kept.empty()) {
+      RetirableNodes.erase(It);
+    } else {
+      std::sort(Kept.begin(), Kept.end());
+      Kept.erase(std::unique(Kept.begin(), Kept.end()), Kept.end());
+      It->second = std::move(Kept);
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Retired " << NumRetired << " jump functions of "
+                  << ICF->getFunctionName(fun));
+    INC_COUNTER("JumpFn Retirement", NumRetired, PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Re-computes the jump functions of fun whose jump functions have been
+  /// retired from those at its anchors and from the end summaries of its
+  /// callees, without propagating anything into other functions.
+  void retabulate(f_t fun, const std::vector<n_t> &Anchors) {
+    retireJumpFunctions(fun, /* KeepBoundaries */ false);
+    withJumpFunctions([&](const auto &JF) {
+      for (n_t Anchor : Anchors) {
+        JF.lookupByTarget(Anchor).foreachCell(
+            [&](d_t d1, d_t d2, const EdgeFunctionPtrType & /*f*/) {
+              Worklist.push(PathEdge<n_t, d_t>(d1, Anchor, d2));
+            });
+      }
+    });
+    Retabulating = true;
+    processPathEdges();
+    Retabulating = false;
+  }
+
   // should be made a callable at some point
   void valueComputationTask(const std::vector<n_t> &values) {
     PAMM_GET_INSTANCE;
+    size_t NumComputations = valueComputationTask(values, valtab);
+    INC_COUNTER("Value Computation", NumComputations,
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Computes the values at the given nodes from the values at the start
+  /// points of their functions and writes them to Values, which is either
+  /// valtab itself or a thread-local shard of it. Only reads from valtab
+  /// otherwise, so that tasks for disjoint nodes may run concurrently.
+  /// Returns the number of edge functions that have been evaluated.
+  size_t valueComputationTask(const std::vector<n_t> &values,
+                              TableTy<n_t, d_t, l_t> &Values) {
+    size_t NumComputations = 0;
     for (n_t n : values) {
       for (n_t sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-        using TableCell = typename Table<d_t, d_t, EdgeFunctionPtrType>::Cell;
-        Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget;
-        lookupByTarget = jumpFn->lookupByTarget(n);
-        for (const TableCell &sourceValTargetValAndFunction :
-             lookupByTarget.cellSet()) {
-          d_t dPrime = sourceValTargetValAndFunction.getRowKey();
-          d_t d = sourceValTargetValAndFunction.getColumnKey();
-          EdgeFunctionPtrType fPrime = sourceValTargetValAndFunction.getValue();
+        auto ComputeValue = [&](d_t dPrime, d_t d,
+                                const EdgeFunctionPtrType &fPrime) {
           l_t targetVal = val(sP, dPrime);
-          setVal(n, d,
-                 IDEProblem.join(val(n, d),
-                                 fPrime->computeTarget(std::move(targetVal))));
-          INC_COUNTER("Value Computation", 1, PAMM_SEVERITY_LEVEL::Full);
-        }
+          l_t Current = Values.contains(n, d) ? Values.get(n, d) : val(n, d);
+          l_t Joined =
+              IDEProblem.join(std::move(Current),
+                              fPrime->computeTarget(std::move(targetVal)));
+          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "Computed value at " << IDEProblem.NtoString(n)
+                        << " for fact " << IDEProblem.DtoString(d) << ": "
+                        << IDEProblem.LtoString(Joined));
+          Values.insert(n, d, std::move(Joined));
+          ++NumComputations;
+        };
+        withJumpFunctions([&](const auto &JF) {
+          JF.lookupByTarget(n).foreachCell(ComputeValue);
+        });
+      }
+    }
+    return NumComputations;
+  }
+
+  /// Phase II(ii) using the given number of threads. The nodes are
+  /// partitioned by their functions, each thread computes the values of its
+  /// partition into a shard of its own, and the shards are merged into valtab
+  /// afterwards.
+  void computeValuesConcurrently(const std::set<n_t> &Nodes,
+                                 unsigned NumThreads) {
+    PAMM_GET_INSTANCE;
+    std::unordered_map<f_t, std::vector<n_t>> NodesOfFunction;
+    for (n_t n : Nodes) {
+      NodesOfFunction[ICF->getFunctionOf(n)].push_back(n);
+    }
+    std::vector<std::vector<n_t> *> ByNumNodes;
+    ByNumNodes.reserve(NodesOfFunction.size());
+    for (auto &[Fun, FunNodes] : NodesOfFunction) {
+      ByNumNodes.push_back(&FunNodes);
+    }
+    std::sort(ByNumNodes.begin(), ByNumNodes.end(),
+              [](const auto *LHS, const auto *RHS) {
+                return LHS->size() > RHS->size() ||
+                       (LHS->size() == RHS->size() &&
+                        LHS->front() < RHS->front());
+              });
+    // assign the largest functions first, each to the smallest partition
+    std::vector<std::vector<n_t>> Partitions(NumThreads);
+    for (const auto *FunNodes : ByNumNodes) {
+      auto &Smallest = *std::min_element(
+          Partitions.begin(), Partitions.end(),
+          [](const auto &LHS, const auto &RHS) {
+            return LHS.size() < RHS.size();
+          });
+      Smallest.insert(Smallest.end(), FunNodes->begin(), FunNodes->end());
+    }
+    std::vector<TableTy<n_t, d_t, l_t>> Shards(NumThreads);
+    std::vector<size_t> NumComputations(NumThreads, 0);
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads);
+    for (unsigned Idx = 0; Idx < NumThreads; ++Idx) {
+      Workers.emplace_back(
+          [this, &Partitions, &Shards, &NumComputations, Idx]() {
+            NumComputations[Idx] =
+                valueComputationTask(Partitions[Idx], Shards[Idx]);
+          });
+    }
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    // the shards are disjoint and already joined with valtab's prior values
+    for (unsigned Idx = 0; Idx < NumThreads; ++Idx) {
+      Shards[Idx].foreachCell([this](n_t n, d_t d, const l_t &l) {
+        valtab.insert(n, d, l);
+      });
+      INC_COUNTER("Value Computation", NumComputations[Idx],
+                  PAMM_SEVERITY_LEVEL::Full);
+    }
+  }
+
+  /// Phase II(ii) if the jump functions have been retired in Phase I. Each
+  /// function is re-tabulated from the jump functions at its anchors, its
+  /// values are computed, and its jump functions are retired again before the
+  /// next function is considered, such that the jump functions of at most one
+  /// function are alive at a time.
+  void computeValuesRetabulating(const std::set<n_t> &Nodes) {
+    std::map<f_t, std::vector<n_t>> NodesOfFunction;
+    for (n_t n : Nodes) {
+      NodesOfFunction[ICF->getFunctionOf(n)].push_back(n);
+    }
+    std::unordered_map<f_t, std::vector<n_t>> AnchorsOfFunction;
+    for (const auto &[Fun, FunNodes] : NodesOfFunction) {
+      for (n_t sP : ICF->getStartPointsOf(Fun)) {
+        AnchorsOfFunction[Fun].push_back(sP);
       }
     }
+    for (const auto &[Seed, Facts] : Seeds.getSeeds()) {
+      AnchorsOfFunction[ICF->getFunctionOf(Seed)].push_back(Seed);
+    }
+    for (n_t unbalancedRetSite : unbalancedRetSites) {
+      AnchorsOfFunction[ICF->getFunctionOf(unbalancedRetSite)].push_back(
+          unbalancedRetSite);
+    }
+    for (const auto &[Fun, FunNodes] : NodesOfFunction) {
+      retabulate(Fun, AnchorsOfFunction[Fun]);
+      valueComputationTask(FunNodes);
+      retireJumpFunctions(Fun, /* KeepBoundaries */ false);
+    }
   }
 
   virtual void saveEdges(n_t sourceNode, n_t sinkStmt, d_t sourceVal,
@@ -912,16 +1647,126 @@ protected:
     if (!SolverConfig.recordEdges()) {
       return;
     }
-    Table<n_t, n_t, std::map<d_t, container_type>> &tgtMap =
+    auto Lock = lockIfConcurrent(RecordedEdgesMutex);
+    if (ESGRecorder) {
+      ESGEdgeKind Kind;
+      if (interP) {
+        Kind = ICF->isCallSite(sourceNode) ? ESGEdgeKind::Call
+                                           : ESGEdgeKind::Return;
+      } else {
+        Kind = ICF->isCallSite(sourceNode) ? ESGEdgeKind::CallToReturn
+                                           : ESGEdgeKind::Normal;
+      }
+      uint32_t SourceNode = getESGNodeID(sourceNode);
+      uint32_t SinkNode = getESGNodeID(sinkStmt);
+      uint32_t SourceFact = getESGFactID(sourceVal);
+      for (d_t destVal : destVals) {
+        ESGRecorder->record(Kind, SourceNode, SourceFact, SinkNode,
+                            getESGFactID(destVal));
+      }
+      return;
+    }
+    TableTy<n_t, n_t, std::map<d_t, container_type>> &tgtMap =
         (interP) ? computedInterPathEdges : computedIntraPathEdges;
     tgtMap.get(sourceNode, sinkStmt)[sourceVal].insert(destVals.begin(),
                                                        destVals.end());
   }
 
+  /// Records the edge function that has been queried for the ESG edge from
+  /// (n1, d1) to (n2, d2), such that it can be emitted as the edge's label.
+  void recordEdgeFunction(n_t n1, d_t d1, n_t n2, d_t d2,
+                          const EdgeFunctionPtrType &EF) {
+    auto Lock = lockIfConcurrent(RecordedEdgesMutex);
+    if (ESGRecorder) {
+      ESGRecorder->record(ESGEdgeKind::EdgeFunction, getESGNodeID(n1),
+                          getESGFactID(d1), getESGNodeID(n2), getESGFactID(d2),
+                          ESGRecorder->getLabelID(EF->str()));
+      return;
+    }
+    intermediateEdgeFunctions[std::make_tuple(n1, d1, n2, d2)].push_back(EF);
+  }
+
+  uint32_t getESGNodeID(n_t n) {
+    return ESGRecorder->getNodeID(n, [this, n] {
+      return ESGNodeName{ICF->getFunctionName(ICF->getFunctionOf(n)),
+                         ICF->getStatementId(n), IDEProblem.NtoString(n),
+                         ICF->isExitInst(n)};
+    });
+  }
+
+  uint32_t getESGFactID(d_t d) {
+    return ESGRecorder->getFactID(d, [this, d] {
+      return ESGFactName{IDEProblem.DtoString(d), IDEProblem.isZeroValue(d)};
+    });
+  }
+
   /// Computes the final values for edge functions.
   void computeValues() {
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "Start computing values");
-    // Phase II(i)
+    computeValuesAtAnchors();
+    // Phase II(ii)
+    // we create an array of all nodes and then dispatch fractions of this
+    // array to multiple threads
+    computeValuesOf(ICF->allNonCallStartNodes());
+  }
+
+  /// Phase II(ii) for the given nodes.
+  void computeValuesOf(const std::set<n_t> &Nodes) {
+    if (retiresJumpFunctions()) {
+      computeValuesRetabulating(Nodes);
+    } else if (getNumThreads() > 1) {
+      computeValuesConcurrently(Nodes, getNumThreads());
+    } else {
+      valueComputationTask({Nodes.begin(), Nodes.end()});
+    }
+  }
+
+  /// Phase II(ii) for n if the values are computed on demand and have not
+  /// been computed at n yet. If the jump functions have been retired, the
+  /// values of all nodes of n's function are computed at once, as the
+  /// function has to be re-tabulated anyway. Not synchronized: it writes
+  /// NodesWithValues and valtab, which the result views refer to, so a lock
+  /// would not make concurrent queries safe either.
+  void computeValuesOnDemand(n_t n) {
+    if (!ValuesOnDemand || ICF->isStartPoint(n) || ICF->isCallSite(n) ||
+        NodesWithValues.count(n)) {
+      return;
+    }
+    if (!retiresJumpFunctions()) {
+      NodesWithValues.insert(n);
+      valueComputationTask({n});
+      return;
+    }
+    std::set<n_t> FunNodes;
+    for (n_t m : ICF->getAllInstructionsOf(ICF->getFunctionOf(n))) {
+      if (!ICF->isStartPoint(m) && !ICF->isCallSite(m)) {
+        FunNodes.insert(m);
+      }
+    }
+    NodesWithValues.insert(FunNodes.begin(), FunNodes.end());
+    computeValuesRetabulating(FunNodes);
+  }
+
+  /// Completes Phase II(ii) if the values are computed on demand, for the
+  /// clients that look at all results.
+  void computePendingValues() {
+    if (!ValuesOnDemand) {
+      return;
+    }
+    std::set<n_t> Pending;
+    for (n_t n : ICF->allNonCallStartNodes()) {
+      if (!NodesWithValues.count(n)) {
+        Pending.insert(n);
+      }
+    }
+    ValuesOnDemand = false;
+    NodesWithValues.clear();
+    computeValuesOf(Pending);
+  }
+
+  /// Phase II(i): propagates the values of the initial seeds and unbalanced
+  /// return sites to the start points of the functions they reach.
+  void computeValuesAtAnchors() {
     std::map<n_t, std::map<d_t, l_t>> AllSeeds = Seeds.getSeeds();
     for (n_t unbalancedRetSite : unbalancedRetSites) {
       if (AllSeeds.find(unbalancedRetSite) == AllSeeds.end()) {
@@ -943,22 +1788,12 @@ protected:
         valuePropagationTask(superGraphNode);
       }
     }
-    // Phase II(ii)
-    // we create an array of all nodes and then dispatch fractions of this
-    // array to multiple threads
-    const std::set<n_t> allNonCallStartNodes = ICF->allNonCallStartNodes();
-    valueComputationTask(
-        {allNonCallStartNodes.begin(), allNonCallStartNodes.end()});
   }
 
-  /// Schedules the processing of initial seeds, initiating the analysis.
-  /// Clients should only call this methods if performing synchronization on
-  /// their own. Normally, solve() should be called instead.
-  void submitInitialSeeds() {
-    PAMM_GET_INSTANCE;
-    // Check if the initial seeds contain the zero value at every starting
-    // point. If not, the zero value needs to be added to allow for correct
-    // solving of the problem.
+  /// Check if the initial seeds contain the zero value at every starting
+  /// point. If not, the zero value needs to be added to allow for correct
+  /// solving of the problem.
+  void completeInitialSeeds() {
     for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
       if (Facts.find(ZeroValue) == Facts.end()) {
         // Add zero value if it's not in the set of facts.
@@ -969,6 +1804,14 @@ protected:
         Seeds.addSeed(StartPoint, ZeroValue, IDEProblem.bottomElement());
       }
     }
+  }
+
+  /// Schedules the processing of initial seeds, initiating the analysis.
+  /// Clients should only call this methods if performing synchronization on
+  /// their own. Normally, solve() should be called instead.
+  void submitInitialSeeds() {
+    PAMM_GET_INSTANCE;
+    completeInitialSeeds();
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Number of initial seeds: " << Seeds.countInitialSeeds());
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG) << "List of initial seeds: ");
@@ -994,12 +1837,137 @@ protected:
         if (!IDEProblem.isZeroValue(Fact)) {
           INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
         }
-        propagate(Fact, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
-                  nullptr, false);
-        jumpFn->addFunction(Fact, StartPoint, Fact,
-                            EdgeIdentity<l_t>::getInstance());
+        submitInitialSeed(StartPoint, Fact);
       }
     }
+    SeedsSubmitted = true;
+    processPathEdges();
+  }
+
+  void submitInitialSeed(n_t StartPoint, d_t Fact) {
+    checkpoint([&](auto &C) { C.addSeed(StartPoint, Fact); });
+    propagate(Fact, StartPoint, Fact, EdgeIdentity<l_t>::getInstance(),
+              nullptr, false);
+    withJumpFunctions([&](auto &JF) {
+      JF.addFunction(Fact, StartPoint, Fact, EdgeIdentity<l_t>::getInstance());
+    });
+    checkpoint([&](auto &C) {
+      C.addJumpFunction(Fact, StartPoint, Fact,
+                        EdgeIdentity<l_t>::getInstance());
+    });
+  }
+
+  /// Continues Phase I with the deferred path edges whose targets pass the
+  /// node filter by now, see setNodeFilter().
+  void processDeferredPathEdges() {
+    std::vector<PathEdge<n_t, d_t>> Deferred;
+    Deferred.swap(DeferredPathEdges);
+    for (const auto &Edge : Deferred) {
+      if (NodeFilter && !NodeFilter(Edge.getTarget())) {
+        DeferredPathEdges.push_back(Edge);
+      } else {
+        Worklist.push(Edge);
+      }
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Resume " << Deferred.size() - DeferredPathEdges.size()
+                  << " deferred path edges");
+    processPathEdges();
+  }
+
+  /// Processes the pending path edges until the worklist runs empty, i.e.,
+  /// until the construction of the exploded super-graph reached its fixpoint,
+  /// or until the solver's budget is exhausted.
+  void processPathEdges() {
+    if (getNumThreads() > 1) {
+      processPathEdgesConcurrently(getNumThreads());
+      return;
+    }
+    PAMM_GET_INSTANCE;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process path edges using worklist policy: "
+                  << Worklist.getPolicy());
+    bool Retire = retiresJumpFunctions() && !Retabulating;
+    while (!Worklist.empty()) {
+      if (exhaustsBudget()) {
+        // the pending path edges let a later run resume with a larger budget
+        checkpoint([this](auto &C) { C.finish(Worklist, PathEdgeCount); });
+        Worklist.clear();
+        break;
+      }
+      checkpoint([this](auto &C) {
+        if (C.isDue(PathEdgeCount)) {
+          C.commit(Worklist, PathEdgeCount);
+        }
+      });
+      PathEdgeCount++;
+      auto Edge = Worklist.pop();
+      pathEdgeProcessingTask(Edge);
+      if (Retire) {
+        f_t Fun = ICF->getFunctionOf(Edge.getTarget());
+        if (--NumPendingEdges[Fun] == 0) {
+          retireJumpFunctions(Fun, /* KeepBoundaries */ true);
+        }
+      }
+    }
+    INC_COUNTER("Worklist Max Size", Worklist.maxSize(),
+                PAMM_SEVERITY_LEVEL::Full);
+  }
+
+  /// Processes the pending path edges using the given number of threads that
+  /// balance their work by stealing path edges from each other. The jump
+  /// functions as well as the end summaries and incoming edges are guarded by
+  /// locks for the time being, so that the resulting exploded super-graph
+  /// equals the one constructed by processPathEdges(). The cached flow and
+  /// edge function factories are serialized, whereas the flow and edge
+  /// functions themselves are evaluated concurrently and must therefore be
+  /// free of unsynchronized side effects.
+  void processPathEdgesConcurrently(unsigned NumThreads) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process path edges using " << NumThreads << " threads");
+    ConcurrentWorklist =
+        std::make_unique<WorkStealingPathEdgeWorklist<n_t, d_t>>(NumThreads);
+    // distribute the seeds among all workers
+    for (size_t Idx = 0; !Worklist.empty(); ++Idx) {
+      ConcurrentWorklist->pushTo(Idx % NumThreads, Worklist.pop());
+    }
+    bool CacheWasThreadSafe = cachedFlowEdgeFunctions.isThreadSafe();
+    cachedFlowEdgeFunctions.setThreadSafe();
+    std::atomic<unsigned> NumProcessed{0};
+    auto Work = [this, &NumProcessed](size_t WorkerId) {
+      WorkStealingPathEdgeWorklist<n_t, d_t>::setCurrentWorker(WorkerId);
+      // the path edges left once the budget is exhausted are dropped along
+      // with the worklist
+      while (!ConcurrentWorklist->finished() &&
+             !(Budget && Budget->isExhausted())) {
+        if (auto Edge = ConcurrentWorklist->tryPop()) {
+          if (exhaustsBudget()) {
+            ConcurrentWorklist->done();
+            break;
+          }
+          pathEdgeProcessingTask(*Edge);
+          ConcurrentWorklist->done();
+          NumProcessed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    };
+    std::vector<std::thread> Workers;
+    Workers.reserve(NumThreads - 1);
+    for (size_t WorkerId = 1; WorkerId < NumThreads; ++WorkerId) {
+      Workers.emplace_back(Work, WorkerId);
+    }
+    Work(0);
+    for (auto &Worker : Workers) {
+      Worker.join();
+    }
+    PathEdgeCount += NumProcessed;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Processed " << NumProcessed << " path edges, "
+                  << ConcurrentWorklist->getNumSteals() << " of them stolen");
+    cachedFlowEdgeFunctions.setThreadSafe(CacheWasThreadSafe);
+    ConcurrentWorklist.reset();
   }
 
   /// Lines 21-32 of the algorithm.
@@ -1016,8 +1984,12 @@ protected:
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "Process exit at target: "
                   << IDEProblem.NtoString(edge.getTarget()));
+    if (Retabulating) {
+      // the end summaries and the callers are up-to-date already
+      return;
+    }
     n_t n = edge.getTarget(); // an exit node; line 21...
-    EdgeFunctionPtrType f = jumpFunction(edge);
+    EdgeFunctionPtrType f;
     f_t functionThatNeedsSummary = ICF->getFunctionOf(n);
     d_t d1 = edge.factAtSource();
     d_t d2 = edge.factAtTarget();
@@ -1025,19 +1997,26 @@ protected:
     const std::set<n_t> startPointsOf =
         ICF->getStartPointsOf(functionThatNeedsSummary);
     std::map<n_t, container_type> inc;
-    for (n_t sP : startPointsOf) {
-      // line 21.1 of Naeem/Lhotak/Rodriguez
-      // register end-summary
-      addEndSummary(sP, d1, n, d2, f);
-      for (auto entry : incoming(d1, sP)) {
-        inc[entry.first] = Container{entry.second};
+    {
+      auto SummaryLock = lockIfConcurrent(SummaryMutex);
+      // Several threads may process the same exit edge with different jump
+      // functions. Reading the jump function under the lock ensures that the
+      // end summary stored last is the one read last, i.e., the largest one.
+      f = jumpFunction(edge);
+      for (n_t sP : startPointsOf) {
+        // line 21.1 of Naeem/Lhotak/Rodriguez
+        // register end-summary
+        addEndSummary(sP, d1, n, d2, f);
+        for (const auto &[CallSite, CallerSideDs] : incoming(d1, sP)) {
+          inc[CallSite] = CallerSideDs;
+        }
       }
+      printEndSummaryTab();
+      printIncomingTab();
     }
-    printEndSummaryTab();
-    printIncomingTab();
     // for each incoming call edge already processed
     //(see processCall(..))
-    for (auto entry : inc) {
+    for (const auto &entry : inc) {
       // line 22
       n_t c = entry.first;
       // for each return site
@@ -1047,13 +2026,16 @@ protected:
             cachedFlowEdgeFunctions.getRetFlowFunction(
                 c, functionThatNeedsSummary, n, retSiteC);
         INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        // the targets do not depend on the incoming-call value, compute them
+        // once for all of them
+        const container_type targets =
+            computeReturnFlowFunction(retFunction, d1, d2, c, entry.second);
+        ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
+                         PAMM_SEVERITY_LEVEL::Full);
+        profileTargets(targets.size());
+        saveEdges(n, retSiteC, d2, targets, true);
         // for each incoming-call value
         for (d_t d4 : entry.second) {
-          const container_type targets =
-              computeReturnFlowFunction(retFunction, d1, d2, c, entry.second);
-          ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
-                           PAMM_SEVERITY_LEVEL::Full);
-          saveEdges(n, retSiteC, d2, targets, true);
           // for each target value at the return site
           // line 23
           for (d_t d5 : targets) {
@@ -1072,11 +2054,9 @@ protected:
                           << "Queried Return Edge Function: " << f5->str());
             if (SolverConfig.emitESG()) {
               for (auto sP : ICF->getStartPointsOf(ICF->getFunctionOf(n))) {
-                intermediateEdgeFunctions[std::make_tuple(c, d4, sP, d1)]
-                    .push_back(f4);
+                recordEdgeFunction(c, d4, sP, d1, f4);
               }
-              intermediateEdgeFunctions[std::make_tuple(n, d2, retSiteC, d5)]
-                  .push_back(f5);
+              recordEdgeFunction(n, d2, retSiteC, d5, f5);
             }
             INC_COUNTER("EF Queries", 2, PAMM_SEVERITY_LEVEL::Full);
             // compose call function * function * return function
@@ -1085,26 +2065,25 @@ protected:
                               << " * " << f4->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "         (return * function * call)");
+            profileCompositions(2);
             EdgeFunctionPtrType fPrime = f4->composeWith(f)->composeWith(f5);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "       = " << fPrime->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
             // for each jump function coming into the call, propagate to
             // return site using the composed function
-            auto revLookupResult = jumpFn->reverseLookup(c, d4);
-            if (revLookupResult) {
-              for (auto valAndFunc : revLookupResult->get()) {
-                EdgeFunctionPtrType f3 = valAndFunc.second;
-                if (!f3->equal_to(allTop)) {
-                  d_t d3 = valAndFunc.first;
-                  d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
-                  LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
-                                    << "Compose: " << fPrime->str() << " * "
-                                    << f3->str();
-                                BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
-                  propagate(d3, retSiteC, d5_restoredCtx,
-                            f3->composeWith(fPrime), c, false);
-                }
+            for (auto valAndFunc : jumpFunctionsInto(c, d4)) {
+              EdgeFunctionPtrType f3 = valAndFunc.second;
+              if (!f3->equal_to(allTop)) {
+                d_t d3 = valAndFunc.first;
+                d_t d5_restoredCtx = restoreContextOnReturnedFact(c, d4, d5);
+                LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                                  << "Compose: " << fPrime->str() << " * "
+                                  << f3->str();
+                              BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+                profileCompositions(1);
+                propagate(d3, retSiteC, d5_restoredCtx,
+                          f3->composeWith(fPrime), c, false);
               }
             }
           }
@@ -1130,6 +2109,7 @@ protected:
               retFunction, d1, d2, c, Container{ZeroValue});
           ADD_TO_HISTOGRAM("Data-flow facts", targets.size(), 1,
                            PAMM_SEVERITY_LEVEL::Full);
+          profileTargets(targets.size());
           saveEdges(n, retSiteC, d2, targets, true);
           for (d_t d5 : targets) {
             EdgeFunctionPtrType f5 =
@@ -1138,16 +2118,20 @@ protected:
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                           << "Queried Return Edge Function: " << f5->str());
             if (SolverConfig.emitESG()) {
-              intermediateEdgeFunctions[std::make_tuple(n, d2, retSiteC, d5)]
-                  .push_back(f5);
+              recordEdgeFunction(n, d2, retSiteC, d5, f5);
             }
             INC_COUNTER("EF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
             LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                               << "Compose: " << f5->str() << " * " << f->str();
                           BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
+            profileCompositions(1);
             propagteUnbalancedReturnFlow(retSiteC, d5, f->composeWith(f5), c);
             // register for value processing (2nd IDE phase)
-            unbalancedRetSites.insert(retSiteC);
+            auto SummaryLock = lockIfConcurrent(SummaryMutex);
+            if (unbalancedRetSites.insert(retSiteC).second) {
+              checkpoint(
+                  [&](auto &C) { C.addUnbalancedReturnSite(retSiteC); });
+            }
           }
         }
       }
@@ -1289,22 +2273,25 @@ protected:
                   << " (result of previous compose)";
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
 
-    EdgeFunctionPtrType jumpFnE = [&]() {
-      const auto revLookupResult = jumpFn->reverseLookup(target, targetVal);
-      if (revLookupResult) {
-        const auto &JumpFnContainer = revLookupResult->get();
-        const auto Find = std::find_if(
-            JumpFnContainer.begin(), JumpFnContainer.end(),
-            [sourceVal](auto &KVpair) { return KVpair.first == sourceVal; });
-        if (Find != JumpFnContainer.end()) {
-          return Find->second;
-        }
-      }
-      // jump function is initialized to all-top if no entry was found
-      return allTop;
-    }();
-    EdgeFunctionPtrType fPrime = jumpFnE->joinWith(f);
-    bool newFunction = !(fPrime->equal_to(jumpFnE));
+    auto Lock = lockIfConcurrent(JumpFnMutex);
+    EdgeFunctionPtrType jumpFnE =
+        withJumpFunctions([&](const auto &JF) -> EdgeFunctionPtrType {
+          if (auto revLookupResult = JF.reverseLookup(target, targetVal)) {
+            for (const auto &[SourceVal, Function] : *revLookupResult) {
+              if (SourceVal == sourceVal) {
+                return Function;
+              }
+            }
+          }
+          // jump function is initialized to all-top if no entry was found
+          return allTop;
+        });
+    // Joins and comparisons with the identity and the constant edge functions
+    // are the common case here and do not need any virtual call.
+    EdgeFunctionHandle<l_t> JumpFnE(jumpFnE);
+    EdgeFunctionHandle<l_t> FPrime = JumpFnE.joinWith(f);
+    bool newFunction = !FPrime.equal_to(JumpFnE);
+    EdgeFunctionPtrType fPrime = FPrime.get();
 
     LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
                       << "Join: " << jumpFnE->str() << " & " << f.get()->str()
@@ -1314,10 +2301,36 @@ protected:
                   << (newFunction ? " (new jump func)" : " ");
                   BOOST_LOG_SEV(lg::get(), DEBUG) << ' ');
     if (newFunction) {
-      jumpFn->addFunction(sourceVal, target, targetVal, fPrime);
-      const PathEdge<n_t, d_t> edge(sourceVal, target, targetVal);
-      PathEdgeCount++;
-      pathEdgeProcessingTask(edge);
+      bool JumpFnIsAllTop = JumpFnE.equal_to(allTop);
+      if (!JumpFnIsAllTop) {
+        // an already existing path edge needs to be processed again
+        PAMM_GET_INSTANCE;
+        INC_COUNTER("JumpFn Re-propagation", 1, PAMM_SEVERITY_LEVEL::Full);
+      }
+      withJumpFunctions([&](auto &JF) {
+        JF.addFunction(sourceVal, target, targetVal, fPrime);
+      });
+      checkpoint([&](auto &C) {
+        C.addJumpFunction(sourceVal, target, targetVal, fPrime);
+      });
+      if (Lock) {
+        Lock.unlock();
+      }
+      // the edge is processed later on using its then current jump function
+      if (ConcurrentWorklist) {
+        ConcurrentWorklist->push(
+            PathEdge<n_t, d_t>(sourceVal, target, targetVal));
+      } else if (Worklist.push(
+                     PathEdge<n_t, d_t>(sourceVal, target, targetVal)) &&
+                 retiresJumpFunctions()) {
+        f_t Fun = ICF->getFunctionOf(target);
+        if (!Retabulating) {
+          ++NumPendingEdges[Fun];
+        }
+        if (JumpFnIsAllTop) {
+          RetirableNodes[Fun].push_back(target);
+        }
+      }
 
       LOG_IF_ENABLE(if (!IDEProblem.isZeroValue(targetVal)) {
         BOOST_LOG_SEV(lg::get(), DEBUG)
@@ -1354,12 +2367,436 @@ protected:
     return endsummarytab.get(sP, d3).cellSet();
   }
 
-  std::map<n_t, container_type> incoming(d_t d1, n_t sP) {
+  const std::map<n_t, container_type> &incoming(d_t d1, n_t sP) {
     return incomingtab.get(sP, d1);
   }
 
   void addIncoming(n_t sP, d_t d3, n_t n, d_t d2) {
     incomingtab.get(sP, d3)[n].insert(d2);
+    checkpoint([&](auto &C) { C.addIncoming(sP, d3, n, d2); });
+  }
+
+  /// Returns the persisted end summary of <sP, d3>, or std::nullopt if the
+  /// summary store has none. If IFDSIDESolverConfig::persistJumpFunctions()
+  /// is set, the summary is only returned if its jump functions have been
+  /// restored.
+  std::optional<std::set<typename Table<n_t, d_t, EdgeFunctionPtrType>::Cell>>
+  persistedEndSummary(n_t sP, d_t d3) {
+    if constexpr (CanPersistSummaries) {
+      if (!PersistedSummaries) {
+        return std::nullopt;
+      }
+      auto Lock = lockIfConcurrent(PersistedSummaryMutex);
+      loadPersistedSummaries(ICF->getFunctionOf(sP));
+      if (!persistedsummarytab.contains(sP, d3)) {
+        return std::nullopt;
+      }
+      if (SolverConfig.persistJumpFunctions() &&
+          !replayPersistedJumpFunctions(sP, d3)) {
+        return std::nullopt;
+      }
+      PAMM_GET_INSTANCE;
+      INC_COUNTER("PersistedSummary Application", 1,
+                  PAMM_SEVERITY_LEVEL::Full);
+      return std::as_const(persistedsummarytab).get(sP, d3).cellSet();
+    }
+    return std::nullopt;
+  }
+
+  /// Restores the persisted jump functions of <sP, d3> and of the persisted
+  /// summaries that are applied at the call sites they reach. Restores
+  /// nothing and returns false if any of these summaries is missing or has
+  /// been persisted without jump functions.
+  bool replayPersistedJumpFunctions(n_t sP, d_t d3) {
+    if (UnreplayableSummaries.count({sP, d3})) {
+      return false;
+    }
+    std::set<std::pair<n_t, d_t>> Required{{sP, d3}};
+    std::vector<std::pair<n_t, d_t>> WorkList{{sP, d3}};
+    while (!WorkList.empty()) {
+      auto [Start, Fact] = WorkList.back();
+      WorkList.pop_back();
+      if (ReplayedSummaries.count({Start, Fact})) {
+        continue;
+      }
+      loadPersistedSummaries(ICF->getFunctionOf(Start));
+      auto Search = persistedjumpfntab.find({Start, Fact});
+      if (Search == persistedjumpfntab.end() ||
+          !persistedsummarytab.contains(Start, Fact)) {
+        UnreplayableSummaries.emplace(sP, d3);
+        return false;
+      }
+      // mirror the descent of processCall() at the call sites
+      for (const auto &JumpFn : Search->second) {
+        n_t cs = JumpFn.Target;
+        if (!ICF->isCallSite(cs)) {
+          continue;
+        }
+        for (f_t callee : ICF->getCalleesOfCallAt(cs)) {
+          if (cachedFlowEdgeFunctions.getSummaryFlowFunction(cs, callee) ||
+              librarySummaryFlowFunction(cs, callee)) {
+            continue;
+          }
+          container_type Facts = computeCallFlowFunction(
+              cachedFlowEdgeFunctions.getCallFlowFunction(cs, callee), Fact,
+              JumpFn.TargetFact);
+          for (n_t CalleeStart : ICF->getStartPointsOf(callee)) {
+            for (d_t CalleeFact : Facts) {
+              if (Required.emplace(CalleeStart, CalleeFact).second) {
+                WorkList.emplace_back(CalleeStart, CalleeFact);
+              }
+            }
+          }
+        }
+      }
+    }
+    PAMM_GET_INSTANCE;
+    std::vector<std::pair<n_t, d_t>> Restored;
+    auto Lock = lockIfConcurrent(JumpFnMutex);
+    withJumpFunctions([&](auto &JF) {
+      for (const auto &StartNode : Required) {
+        // not a structured binding, which the lambdas below could not capture
+        d_t Fact = StartNode.second;
+        if (!ReplayedSummaries.insert(StartNode).second) {
+          continue;
+        }
+        Restored.push_back(StartNode);
+        const auto &JumpFns = persistedjumpfntab[StartNode];
+        for (const auto &JumpFn : JumpFns) {
+          JF.addFunction(Fact, JumpFn.Target, JumpFn.TargetFact,
+                         JumpFn.Function);
+          checkpoint([&](auto &C) {
+            C.addJumpFunction(Fact, JumpFn.Target, JumpFn.TargetFact,
+                              JumpFn.Function);
+          });
+        }
+        INC_COUNTER("JumpFn Replay", JumpFns.size(),
+                    PAMM_SEVERITY_LEVEL::Full);
+      }
+    });
+    if (Lock) {
+      Lock.unlock();
+    }
+    for (const auto &[Start, Fact] : Restored) {
+      replayFlowFunctions(Start, Fact);
+    }
+    return true;
+  }
+
+  /// Applies the flow functions along the restored jump functions of <sP, d3>
+  /// as their tabulation would have, but only for the side effects of the
+  /// flow functions, e.g., the findings that a problem records for its
+  /// reports. Their targets have been restored along with the jump functions.
+  /// The return flows out of the callees are applied at the call sites, as
+  /// processCall() does for the summaries it applies.
+  void replayFlowFunctions(n_t sP, d_t d3) {
+    for (const auto &JumpFn : persistedjumpfntab.at({sP, d3})) {
+      n_t n = JumpFn.Target;
+      d_t d2 = JumpFn.TargetFact;
+      if (!ICF->isCallSite(n)) {
+        for (n_t Succ : ICF->getSuccsOf(n)) {
+          computeNormalFlowFunction(
+              cachedFlowEdgeFunctions.getNormalFlowFunction(n, Succ), d3, d2);
+        }
+        continue;
+      }
+      const std::set<n_t> ReturnSites = ICF->getReturnSitesOfCallAt(n);
+      const std::set<f_t> Callees = ICF->getCalleesOfCallAt(n);
+      for (f_t Callee : Callees) {
+        FlowFunctionPtrType SpecialSum =
+            cachedFlowEdgeFunctions.getSummaryFlowFunction(n, Callee);
+        if (!SpecialSum) {
+          SpecialSum = librarySummaryFlowFunction(n, Callee);
+        }
+        if (SpecialSum) {
+          computeSummaryFlowFunction(SpecialSum, d3, d2);
+          continue;
+        }
+        const container_type CalleeFacts = computeCallFlowFunction(
+            cachedFlowEdgeFunctions.getCallFlowFunction(n, Callee), d3, d2);
+        const container_type CallerSideDs{d2};
+        for (n_t CalleeStart : ICF->getStartPointsOf(Callee)) {
+          for (d_t CalleeFact : CalleeFacts) {
+            // present, see replayPersistedJumpFunctions()
+            if (!persistedsummarytab.contains(CalleeStart, CalleeFact)) {
+              continue;
+            }
+            std::as_const(persistedsummarytab)
+                .get(CalleeStart, CalleeFact)
+                .foreachCell([&](n_t eP, d_t d4, const EdgeFunctionPtrType &) {
+                  for (n_t RetSite : ReturnSites) {
+                    computeReturnFlowFunction(
+                        cachedFlowEdgeFunctions.getRetFlowFunction(
+                            n, Callee, eP, RetSite),
+                        CalleeFact, d4, n, CallerSideDs);
+                  }
+                });
+          }
+        }
+      }
+      for (n_t RetSite : ReturnSites) {
+        computeCallToReturnFlowFunction(
+            cachedFlowEdgeFunctions.getCallToRetFlowFunction(n, RetSite,
+                                                             Callees),
+            d3, d2);
+      }
+    }
+  }
+
+  /// Returns the key of fun's persisted summaries, which depends on the
+  /// contents of fun and of all functions that it may call transitively, and
+  /// on the contents of the functions that use the same global variables,
+  /// which are coupled to them by the points-to information.
+  std::string getPersistedSummaryKey(f_t fun) {
+    if (auto Search = PersistedSummaryKeys.find(fun);
+        Search != PersistedSummaryKeys.end()) {
+      return Search->second;
+    }
+    if (PersistedSummaries->isInMemory()) {
+      // the IR does not change while the store is shared
+      return SummaryStore::getKey(IDEProblem.getSummaryAnalysisID(),
+                                  {ICF->getFunctionName(fun)});
+    }
+    std::vector<std::string> Hashes;
+    std::set<f_t> Visited{fun};
+    std::vector<f_t> WorkList{fun};
+    while (!WorkList.empty()) {
+      f_t Curr = WorkList.back();
+      WorkList.pop_back();
+      auto [Hash, Inserted] = ContentHashes.try_emplace(Curr);
+      if (Inserted) {
+        Hash->second = getFunctionContentHash(Curr);
+      }
+      Hashes.push_back(Hash->second);
+      for (n_t cs : ICF->getCallsFromWithin(Curr)) {
+        for (f_t callee : ICF->getCalleesOfCallAt(cs)) {
+          if (Visited.insert(callee).second) {
+            WorkList.push_back(callee);
+          }
+        }
+      }
+    }
+    for (f_t Coupled : getGlobalCoupledFunctions(Visited)) {
+      auto [Hash, Inserted] = ContentHashes.try_emplace(Coupled);
+      if (Inserted) {
+        Hash->second = getFunctionContentHash(Coupled);
+      }
+      // tell coupled functions apart from callees
+      Hashes.push_back("global:" + Hash->second);
+    }
+    return SummaryStore::getKey(IDEProblem.getSummaryAnalysisID(),
+                                std::move(Hashes));
+  }
+
+  /// Loads fun's persisted summaries into persistedsummarytab on the first
+  /// call for fun. Summaries that cannot be resolved in the current module
+  /// are discarded as a whole.
+  void loadPersistedSummaries(f_t fun) {
+    if (PersistedSummaryKeys.count(fun)) {
+      return;
+    }
+    std::string Key = getPersistedSummaryKey(fun);
+    PersistedSummaryKeys[fun] = Key;
+    auto Summaries = PersistedSummaries->load(Key);
+    if (!Summaries) {
+      return;
+    }
+    FunctionLocalIDs IDs(fun);
+    auto getNode = [&IDs](const nlohmann::json &J) -> n_t {
+      return llvm::dyn_cast_or_null<llvm::Instruction>(
+          IDs.getValue(J.get<std::string>()));
+    };
+    auto getFact = [this, &IDs](const nlohmann::json &J) -> d_t {
+      const auto &ID = J.get<std::string>();
+      return ID == "0" ? ZeroValue : IDs.getValue(ID);
+    };
+    decltype(persistedsummarytab) Loaded;
+    decltype(persistedjumpfntab) LoadedJumpFns;
+    try {
+      for (const auto &Summary : Summaries->at("Summaries")) {
+        n_t sP = getNode(Summary.at("StartPoint"));
+        d_t d3 = getFact(Summary.at("Fact"));
+        if (!sP || !d3) {
+          throw std::invalid_argument("unknown start point or fact");
+        }
+        // an empty summary is a summary nevertheless
+        auto &EndSumm = Loaded.get(sP, d3);
+        for (const auto &Exit : Summary.at("Exits")) {
+          n_t eP = getNode(Exit.at("ExitPoint"));
+          d_t d4 = getFact(Exit.at("Fact"));
+          auto f = IDEProblem.edgeFunctionFromSummaryString(
+              Exit.at("EdgeFunction").get<std::string>());
+          if (!eP || !d4 || !f) {
+            throw std::invalid_argument("unknown exit point, fact or edge "
+                                        "function");
+          }
+          EndSumm.insert(eP, d4, f);
+        }
+        if (!SolverConfig.persistJumpFunctions() ||
+            !Summary.contains("JumpFunctions")) {
+          continue;
+        }
+        auto &JumpFns = LoadedJumpFns[{sP, d3}];
+        for (const auto &JumpFn : Summary.at("JumpFunctions")) {
+          n_t n = getNode(JumpFn.at("Node"));
+          d_t d2 = getFact(JumpFn.at("Fact"));
+          auto f = IDEProblem.edgeFunctionFromSummaryString(
+              JumpFn.at("EdgeFunction").get<std::string>());
+          if (!n || !d2 || !f) {
+            throw std::invalid_argument("unknown node, fact or edge function");
+          }
+          JumpFns.push_back({n, d2, f});
+        }
+      }
+    } catch (const std::exception &E) {
+      LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                    << "Discarding persisted summaries of "
+                    << ICF->getFunctionName(fun) << ": " << E.what());
+      return;
+    }
+    persistedsummarytab.insert(Loaded);
+    persistedjumpfntab.insert(std::make_move_iterator(LoadedJumpFns.begin()),
+                              std::make_move_iterator(LoadedJumpFns.end()));
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Loaded persisted summaries of "
+                  << ICF->getFunctionName(fun));
+  }
+
+  /// Adds the end summaries of all functions that have been descended into to
+  /// the summary store, together with the persisted summaries of these
+  /// functions that have been loaded.
+  void savePersistedSummaries() {
+    if constexpr (CanPersistSummaries) {
+      if (!PersistedSummaries) {
+        return;
+      }
+      std::map<f_t, std::set<std::pair<n_t, d_t>>> Computed;
+      incomingtab.foreachCell([&](n_t sP, d_t d3, const auto &Callers) {
+        if (!Callers.empty()) {
+          Computed[ICF->getFunctionOf(sP)].emplace(sP, d3);
+        }
+      });
+      // seeds at a function's start point are summarized as well, which
+      // allows to precompute summaries, see IDESummaryGenerator
+      for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
+        f_t fun = ICF->getFunctionOf(StartPoint);
+        if (!ICF->getStartPointsOf(fun).count(StartPoint)) {
+          continue;
+        }
+        for (const auto &Fact : Facts) {
+          Computed[fun].emplace(StartPoint, Fact.first);
+        }
+      }
+      // keep the summaries that have been persisted for other facts
+      for (const auto &Entry : Computed) {
+        loadPersistedSummaries(Entry.first);
+      }
+      std::map<f_t, std::vector<std::pair<n_t, d_t>>> Loaded;
+      persistedsummarytab.foreachCell([&](n_t sP, d_t d3, const auto &) {
+        f_t fun = ICF->getFunctionOf(sP);
+        auto Search = Computed.find(fun);
+        if (Search != Computed.end() && !Search->second.count({sP, d3})) {
+          Loaded[fun].emplace_back(sP, d3);
+        }
+      });
+      for (const auto &[fun, Facts] : Computed) {
+        FunctionLocalIDs IDs(fun);
+        auto getFactID = [this, &IDs](d_t d) -> std::optional<std::string> {
+          if (IDEProblem.isZeroValue(d)) {
+            return "0";
+          }
+          return IDs.getID(d);
+        };
+        nlohmann::json J;
+        J["Function"] = ICF->getFunctionName(fun);
+        J["Summaries"] = nlohmann::json::array();
+        bool Persistable = true;
+        auto addJumpFunction = [&](nlohmann::json &JumpFns, n_t n, d_t d2,
+                                   const EdgeFunctionPtrType &f) {
+          auto NodeID = IDs.getID(n);
+          auto FactID = getFactID(d2);
+          auto EF = IDEProblem.edgeFunctionToSummaryString(f);
+          if (!NodeID || !FactID || EF.empty()) {
+            Persistable = false;
+            return;
+          }
+          JumpFns.push_back(
+              {{"Node", *NodeID}, {"Fact", *FactID}, {"EdgeFunction", EF}});
+        };
+        // the jump functions of tabulated summaries are taken from the
+        // exploded super-graph, those of loaded ones from the store
+        auto addSummary = [&](const auto &Tab, n_t sP, d_t d3,
+                              bool Tabulated) {
+          auto StartID = IDs.getID(sP);
+          auto FactID = getFactID(d3);
+          if (!StartID || !FactID) {
+            Persistable = false;
+            return;
+          }
+          nlohmann::json Summary;
+          Summary["StartPoint"] = *StartID;
+          Summary["Fact"] = *FactID;
+          Summary["Exits"] = nlohmann::json::array();
+          if (Tab.contains(sP, d3)) {
+            Tab.get(sP, d3).foreachCell(
+                [&](n_t eP, d_t d4, const EdgeFunctionPtrType &f) {
+                  auto ExitID = IDs.getID(eP);
+                  auto ExitFactID = getFactID(d4);
+                  auto EF = IDEProblem.edgeFunctionToSummaryString(f);
+                  if (!ExitID || !ExitFactID || EF.empty()) {
+                    Persistable = false;
+                    return;
+                  }
+                  Summary["Exits"].push_back({{"ExitPoint", *ExitID},
+                                              {"Fact", *ExitFactID},
+                                              {"EdgeFunction", EF}});
+                });
+          }
+          if (!SolverConfig.persistJumpFunctions()) {
+            J["Summaries"].push_back(std::move(Summary));
+            return;
+          }
+          if (Tabulated) {
+            auto &JumpFns = Summary["JumpFunctions"] = nlohmann::json::array();
+            withJumpFunctions([&](const auto &JF) {
+              for (n_t n : ICF->getAllInstructionsOf(ICF->getFunctionOf(sP))) {
+                JF.lookupByTarget(n).foreachCell(
+                    [&](d_t d1, d_t d2, const EdgeFunctionPtrType &f) {
+                      if (d1 == d3) {
+                        addJumpFunction(JumpFns, n, d2, f);
+                      }
+                    });
+              }
+            });
+          } else if (auto Search = persistedjumpfntab.find({sP, d3});
+                     Search != persistedjumpfntab.end()) {
+            auto &JumpFns = Summary["JumpFunctions"] = nlohmann::json::array();
+            for (const auto &JumpFn : Search->second) {
+              addJumpFunction(JumpFns, JumpFn.Target, JumpFn.TargetFact,
+                              JumpFn.Function);
+            }
+          }
+          J["Summaries"].push_back(std::move(Summary));
+        };
+        for (const auto &[sP, d3] : Facts) {
+          addSummary(std::as_const(endsummarytab), sP, d3, true);
+        }
+        for (const auto &[sP, d3] : Loaded[fun]) {
+          addSummary(std::as_const(persistedsummarytab), sP, d3, false);
+        }
+        if (!Persistable) {
+          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                        << "Summaries of " << ICF->getFunctionName(fun)
+                        << " cannot be persisted");
+          continue;
+        }
+        try {
+          PersistedSummaries->store(getPersistedSummaryKey(fun), J);
+        } catch (const std::ios_base::failure &E) {
+          LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING) << E.what());
+        }
+      }
+    }
   }
 
   void printIncomingTab() const {
@@ -1672,6 +3109,11 @@ protected:
           BOOST_LOG_SEV(lg::get(), INFO) << "Jump function construciton count: "
                                          << GET_COUNTER("JumpFn Construction");
           BOOST_LOG_SEV(lg::get(), INFO)
+          << "Jump function re-propagation count: "
+          << GET_COUNTER("JumpFn Re-propagation");
+          BOOST_LOG_SEV(lg::get(), INFO)
+          << "Maximal worklist size: " << GET_COUNTER("Worklist Max Size");
+          BOOST_LOG_SEV(lg::get(), INFO)
           << "Phase I duration: " << PRINT_TIMER("DFA Phase I");
           BOOST_LOG_SEV(lg::get(), INFO)
           << "Phase II duration: " << PRINT_TIMER("DFA Phase II");
@@ -1693,8 +3135,13 @@ public:
                   << "Process intra-procedural path egdes";
                   BOOST_LOG_SEV(lg::get(), DEBUG)
                   << "=============================================");
-    DOTGraph<d_t> G;
     DOTConfig::importDOTConfig(std::move(DotConfigDir));
+    if (ESGRecorder) {
+      // the edges have been streamed to the ESG edge log
+      ESGEdgeLog::read(ESGRecorder->getPath()).printAsDot(OS);
+      return;
+    }
+    DOTGraph<d_t> G;
     DOTFunctionSubGraph *FG = nullptr;
 
     // Sort intra-procedural path edges
@@ -1923,10 +3370,11 @@ public:
   };
 };
 
-template <typename AnalysisDomainTy, typename Container>
+template <typename AnalysisDomainTy, typename Container,
+          template <typename, typename, typename> class TableTy>
 std::ostream &
 operator<<(std::ostream &os,
-           const IDESolver<AnalysisDomainTy, Container> &ide_solver) {
+           const IDESolver<AnalysisDomainTy, Container, TableTy> &ide_solver) {
   ide_solver.dumpResults(os);
   return os;
 }
@@ -17,66 +17,160 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESUMMARYGENERATOR_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IDESUMMARYGENERATOR_H_
 
-#include <map>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <set>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include "llvm/IR/Function.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ObservedCallingContexts.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
 #include "phasar/PhasarLLVM/Utils/SummaryStrategy.h"
 
 namespace psr {
 
-template <typename N, typename D, typename F, typename I, typename V,
-          typename ConcreteTabulationProblem, typename ConcreteSolver>
+/// Precomputes the end summaries of library functions for an IDE problem on
+/// LLVM IR and adds them to a summary store, from which IDESolver applies
+/// them instead of analyzing these functions, see
+/// IFDSIDESolverConfig::setComputePersistedSummaries(). The problem has to
+/// provide an analysis ID and to be able to persist its edge functions.
+///
+/// Each function is solved in isolation, seeded with the zero value and the
+/// formal parameters that occur in the calling contexts of the strategy. As
+/// end summaries are kept per fact at the function's entry, a single solve
+/// covers all of the function's contexts.
+template <typename ConcreteTabulationProblem,
+          typename ConcreteSolver = IDESolver_P<ConcreteTabulationProblem>>
 class IDESummaryGenerator {
-protected:
-  const std::string toSummarize;
-  const I icfg;
-  const SummaryGenerationStrategy CTXStrategy;
+public:
+  using n_t = typename ConcreteTabulationProblem::n_t;
+  using d_t = typename ConcreteTabulationProblem::d_t;
+  using f_t = typename ConcreteTabulationProblem::f_t;
+  using l_t = typename ConcreteTabulationProblem::l_t;
 
+protected:
+  /// Solves ConcreteTabulationProblem from the given seeds only.
   class CTXFunctionProblem : public ConcreteTabulationProblem {
   public:
-    const N start;
-    std::set<D> facts;
-
-    CTXFunctionProblem(N start, std::set<D> facts, I icfg)
-        : ConcreteTabulationProblem(icfg), start(start), facts(facts) {
-      this->solver_config.followReturnsPastSeeds = false;
-      this->solver_config.autoAddZero = true;
-      this->solver_config.computeValues = true;
-      this->solver_config.recordEdges = false;
-      this->solver_config.computePersistedSummaries = false;
+    template <typename... ArgTys>
+    CTXFunctionProblem(ArgTys &&...Args)
+        : ConcreteTabulationProblem(std::forward<ArgTys>(Args)...) {
+      auto &Config = this->getIFDSIDESolverConfig();
+      Config.setFollowReturnsPastSeeds(false);
+      Config.setAutoAddZero(true);
+      Config.setComputeValues(false);
+      Config.setRecordEdges(false);
+      Config.setESGLogFile({});
+      Config.setProfileFile({});
+      Config.setBudget({});
+      Config.setCheckpointFile({});
     }
 
-    virtual std::map<N, std::set<D>> initialSeeds() override {
-      std::map<N, std::set<D>> seeds;
-      seeds.insert(make_pair(start, facts));
-      return seeds;
+    InitialSeeds<n_t, d_t, l_t> initialSeeds() override { return Seeds; }
+
+    void setInitialSeeds(InitialSeeds<n_t, d_t, l_t> S) {
+      Seeds = std::move(S);
     }
+
+  private:
+    InitialSeeds<n_t, d_t, l_t> Seeds;
   };
 
+  const SummaryGenerationStrategy CTXStrategy;
+  const ObservedCallingContexts *Observed = nullptr;
+  std::function<std::unique_ptr<CTXFunctionProblem>()> MakeProblem;
+
+  void summarize(f_t F, const std::set<unsigned> &Params,
+                 const std::string &SummaryStore) {
+    auto Problem = MakeProblem();
+    auto &Config = Problem->getIFDSIDESolverConfig();
+    Config.setComputePersistedSummaries();
+    Config.setSummaryStore(SummaryStore);
+    InitialSeeds<n_t, d_t, l_t> Seeds;
+    for (n_t StartPoint : Problem->getICFG()->getStartPointsOf(F)) {
+      Seeds.addSeed(StartPoint, Problem->getZeroValue(),
+                    Problem->bottomElement());
+      for (unsigned Param : Params) {
+        Seeds.addSeed(StartPoint, F->getArg(Param), Problem->bottomElement());
+      }
+    }
+    Problem->setInitialSeeds(std::move(Seeds));
+    ConcreteSolver Solver(*Problem);
+    Solver.solve();
+  }
+
 public:
-  IDESummaryGenerator(std::string Function, I Icfg,
-                      SummaryGenerationStrategy Strategy)
-      : toSummarize(Function), icfg(Icfg), CTXStrategy(Strategy) {}
+  /// The ProblemArgs are passed to ConcreteTabulationProblem's constructor
+  /// for each isolated solve.
+  template <typename... ArgTys>
+  IDESummaryGenerator(SummaryGenerationStrategy Strategy,
+                      ArgTys... ProblemArgs)
+      : CTXStrategy(Strategy), MakeProblem([ProblemArgs...]() {
+          return std::make_unique<CTXFunctionProblem>(ProblemArgs...);
+        }) {}
   virtual ~IDESummaryGenerator() = default;
-  void generateSummaries() {
-    // initialize the input combinations that should be considered
-    switch (CTXStrategy) {
-    case SummaryGenerationStrategy::always_all:
-
-      break;
-    case SummaryGenerationStrategy::always_none:
-
-      break;
-    case SummaryGenerationStrategy::all_and_none:
 
-      break;
-    case SummaryGenerationStrategy::powerset:
-
-      break;
-    case SummaryGenerationStrategy::all_observed:
-      // TODO here we have to track what we have already observed first!
-      break;
+  /// Sets the calling contexts used by the all_observed strategy.
+  void setObservedContexts(const ObservedCallingContexts *O) { Observed = O; }
+
+  /// Computes the end summaries of the given functions, and of the functions
+  /// they call, and adds them to the summary store in the given directory.
+  /// Declarations are skipped. Up to NumThreads isolated solves run in
+  /// parallel, which requires whatever the problems share, e.g., points-to
+  /// information, to be safe to query concurrently. Throws
+  /// std::invalid_argument if the problem has no analysis ID.
+  void generateSummaries(const std::vector<f_t> &Functions,
+                         const std::string &SummaryStore,
+                         unsigned NumThreads = 1) {
+    if (MakeProblem()->getSummaryAnalysisID().empty()) {
+      throw std::invalid_argument(
+          "cannot persist the summaries of a problem without analysis ID");
+    }
+    // the formal parameters to seed for each function
+    std::vector<std::pair<f_t, std::set<unsigned>>> Tasks;
+    for (f_t F : Functions) {
+      if (F->isDeclaration()) {
+        continue;
+      }
+      std::set<std::vector<bool>> ObservedCTX;
+      if (Observed) {
+        ObservedCTX = Observed->getObservedCTX(F->getName().str());
+      }
+      auto Contexts =
+          getSummaryContexts(CTXStrategy, F->arg_size(), ObservedCTX);
+      if (Contexts.empty()) {
+        continue;
+      }
+      std::set<unsigned> Params;
+      for (const auto &Context : Contexts) {
+        for (unsigned Idx = 0; Idx < Context.size(); ++Idx) {
+          if (Context[Idx]) {
+            Params.insert(Idx);
+          }
+        }
+      }
+      Tasks.emplace_back(F, std::move(Params));
+    }
+    std::atomic<size_t> Next = 0;
+    auto Work = [&] {
+      for (size_t Idx = Next++; Idx < Tasks.size(); Idx = Next++) {
+        summarize(Tasks[Idx].first, Tasks[Idx].second, SummaryStore);
+      }
+    };
+    std::vector<std::thread> Workers;
+    for (unsigned I = 1; I < NumThreads; ++I) {
+      Workers.emplace_back(Work);
+    }
+    Work();
+    for (auto &Worker : Workers) {
+      Worker.join();
     }
   }
 };
@@ -32,24 +32,31 @@ namespace psr {
 
 template <typename OriginalAnalysisDomain> struct AnalysisDomainExtender;
 
-template <typename AnalysisDomainTy>
-class IFDSSolver : public IDESolver<AnalysisDomainExtender<AnalysisDomainTy>> {
+/// Solves an IFDSTabulationProblem by lifting it to an IDE problem over the
+/// BinaryDomain. TableTy selects the solver's table implementation, see
+/// IDESolver.
+template <typename AnalysisDomainTy,
+          template <typename, typename, typename> class TableTy = Table>
+class IFDSSolver
+    : public IDESolver<AnalysisDomainExtender<AnalysisDomainTy>,
+                       std::set<typename AnalysisDomainTy::d_t>, TableTy> {
 public:
   using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy>;
   using D = typename AnalysisDomainTy::d_t;
   using N = typename AnalysisDomainTy::n_t;
 
   IFDSSolver(IFDSTabulationProblem<AnalysisDomainTy> &IFDSProblem)
-      : IDESolver<AnalysisDomainExtender<AnalysisDomainTy>>(IFDSProblem) {}
+      : IDESolver<AnalysisDomainExtender<AnalysisDomainTy>,
+                  std::set<typename AnalysisDomainTy::d_t>, TableTy>(
+            IFDSProblem) {}
 
   ~IFDSSolver() override = default;
 
   /// Returns the data-flow results at the given statement.
   [[nodiscard]] virtual std::set<D> ifdsResultsAt(N Inst) {
     std::set<D> KeySet;
-    std::unordered_map<D, BinaryDomain> ResultMap = this->resultsAt(Inst);
-    for (auto FlowFact : ResultMap) {
-      KeySet.insert(FlowFact.first);
+    for (const auto &[FlowFact, LatticeValue] : this->resultsViewAt(Inst)) {
+      KeySet.insert(FlowFact);
     }
     return KeySet;
   }
@@ -74,23 +81,14 @@ public:
       std::is_same_v<std::remove_reference_t<NTy>, llvm::Instruction *>,
       std::set<D>>
   ifdsResultsAtInLLVMSSA(NTy Inst) {
-    auto getResultMap = [this, Inst]() {
-      if (Inst->getType()->isVoidTy()) {
-        return this->resultsAt(Inst);
-      } else {
-        // In this case we have a value on the left-hand side and must return
-        // the results at the successor instruction. Note that terminator
-        // instructions are always of void type.
-        assert(Inst->getNextNode() &&
-               "Expected to find a valid successor node!");
-        return this->resultsAt(Inst->getNextNode());
-      }
-    };
-    std::set<D> KeySet;
-    for (auto &[FlowFact, LatticeValue] : getResultMap()) {
-      KeySet.insert(FlowFact);
+    if (Inst->getType()->isVoidTy()) {
+      return ifdsResultsAt(Inst);
     }
-    return KeySet;
+    // In this case we have a value on the left-hand side and must return the
+    // results at the successor instruction. Note that terminator instructions
+    // are always of void type.
+    assert(Inst->getNextNode() && "Expected to find a valid successor node!");
+    return ifdsResultsAt(Inst->getNextNode());
   }
 };
 
@@ -17,100 +17,171 @@
 #ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IFDSSUMMARYGENERATOR_H_
 #define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_IFDSSUMMARYGENERATOR_H_
 
-#include <iostream> // std::cout
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
-#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
-#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "llvm/IR/Function.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryPool.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/ObservedCallingContexts.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
 #include "phasar/PhasarLLVM/Utils/SummaryStrategy.h"
 
 namespace psr {
 
-template <typename N, typename D, typename F, typename I,
-          typename ConcreteTabulationProblem, typename ConcreteSolver>
+/// Precomputes the summaries of library functions for an IFDS problem on
+/// LLVM IR, such that calls to these functions can be analyzed without their
+/// bodies, see IFDSSummaryPool and IFDSIDESolverConfig::setLibrarySummaries().
+///
+/// For each function and each calling context that the strategy generates,
+/// the function is solved in isolation, seeded with the zero value and the
+/// formal parameters of the context. The facts that hold at the function's
+/// exits make up the context's summary.
+template <typename ConcreteTabulationProblem,
+          typename ConcreteSolver =
+              IFDSSolver<typename ConcreteTabulationProblem::ProblemAnalysisDomain>>
 class IFDSSummaryGenerator {
-protected:
-  const F toSummarize;
-  const I icfg;
-  const SummaryGenerationStrategy CTXStrategy;
-
-  virtual std::vector<D> getInputs() = 0;
-  virtual std::vector<bool> generateBitPattern(const std::vector<D> &inputs,
-                                               const std::set<D> &subset) = 0;
+public:
+  using n_t = typename ConcreteTabulationProblem::n_t;
+  using d_t = typename ConcreteTabulationProblem::d_t;
+  using f_t = typename ConcreteTabulationProblem::f_t;
+  using l_t = typename ConcreteTabulationProblem::l_t;
 
+protected:
+  /// Solves ConcreteTabulationProblem from the given seeds only.
   class CTXFunctionProblem : public ConcreteTabulationProblem {
   public:
-    const N start;
-    std::set<D> facts;
-
-    CTXFunctionProblem(N start, std::set<D> facts, I icfg)
-        : ConcreteTabulationProblem(icfg), start(start), facts(facts) {
-      this->solver_config.followReturnsPastSeeds = false;
-      this->solver_config.autoAddZero = true;
-      this->solver_config.computeValues = true;
-      this->solver_config.recordEdges = false;
-      this->solver_config.computePersistedSummaries = false;
+    template <typename... ArgTys>
+    CTXFunctionProblem(ArgTys &&...Args)
+        : ConcreteTabulationProblem(std::forward<ArgTys>(Args)...) {
+      auto &Config = this->getIFDSIDESolverConfig();
+      Config.setFollowReturnsPastSeeds(false);
+      Config.setAutoAddZero(true);
+      Config.setComputeValues(true);
+      Config.setRecordEdges(false);
+      Config.setComputePersistedSummaries(false);
+      Config.setESGLogFile({});
+      Config.setProfileFile({});
+      Config.setBudget({});
+      Config.setCheckpointFile({});
     }
 
-    virtual std::map<N, std::set<D>> initialSeeds() override {
-      std::map<N, std::set<D>> seeds;
-      seeds.insert(make_pair(start, facts));
-      return seeds;
+    InitialSeeds<n_t, d_t, l_t> initialSeeds() override { return Seeds; }
+
+    void setInitialSeeds(InitialSeeds<n_t, d_t, l_t> S) {
+      Seeds = std::move(S);
     }
+
+  private:
+    InitialSeeds<n_t, d_t, l_t> Seeds;
   };
 
+  const SummaryGenerationStrategy CTXStrategy;
+  const ObservedCallingContexts *Observed = nullptr;
+  std::shared_ptr<const IFDSSummaryPool> LibrarySummaries;
+  std::function<std::unique_ptr<CTXFunctionProblem>()> MakeProblem;
+
+  /// Returns the summary of F for the given calling context.
+  std::set<std::string> summarize(f_t F, const std::vector<bool> &Context) {
+    auto Problem = MakeProblem();
+    if (LibrarySummaries) {
+      Problem->getIFDSIDESolverConfig().setLibrarySummaries(LibrarySummaries);
+    }
+    const auto *ICF = Problem->getICFG();
+    InitialSeeds<n_t, d_t, l_t> Seeds;
+    for (n_t StartPoint : ICF->getStartPointsOf(F)) {
+      Seeds.addSeed(StartPoint, Problem->getZeroValue());
+      for (size_t Idx = 0; Idx < Context.size(); ++Idx) {
+        if (Context[Idx]) {
+          Seeds.addSeed(StartPoint, F->getArg(Idx));
+        }
+      }
+    }
+    Problem->setInitialSeeds(std::move(Seeds));
+    ConcreteSolver Solver(*Problem);
+    Solver.solve();
+    std::set<std::string> Outputs;
+    for (n_t Exit : ICF->getExitPointsOf(F)) {
+      for (d_t Fact : Solver.ifdsResultsAt(Exit)) {
+        if (Problem->isZeroValue(Fact)) {
+          continue;
+        }
+        if (auto ID = IFDSSummaryPool::getInterfaceID(F, Exit, Fact)) {
+          Outputs.insert(*ID);
+        }
+      }
+    }
+    return Outputs;
+  }
+
 public:
-  IFDSSummaryGenerator(F Function, I icfg, SummaryGenerationStrategy Strategy)
-      : toSummarize(Function), icfg(icfg), CTXStrategy(Strategy) {}
+  /// The ProblemArgs are passed to ConcreteTabulationProblem's constructor
+  /// for each isolated solve.
+  template <typename... ArgTys>
+  IFDSSummaryGenerator(SummaryGenerationStrategy Strategy,
+                       ArgTys... ProblemArgs)
+      : CTXStrategy(Strategy), MakeProblem([ProblemArgs...]() {
+          return std::make_unique<CTXFunctionProblem>(ProblemArgs...);
+        }) {}
   virtual ~IFDSSummaryGenerator() = default;
-  virtual std::set<
-      std::pair<std::vector<bool>, std::shared_ptr<FlowFunction<D>>>>
-  generateSummaryFlowFunction() {
-    std::set<std::pair<std::vector<bool>, std::shared_ptr<FlowFunction<D>>>>
-        summary;
-    std::vector<D> inputs = getInputs();
-    std::set<D> inputset;
-    inputset.insert(inputs.begin(), inputs.end());
-    std::set<std::set<D>> InputCombinations;
-    // initialize the input combinations that should be considered
-    switch (CTXStrategy) {
-    case SummaryGenerationStrategy::always_all:
-      InputCombinations.insert(inputset);
-      break;
-    case SummaryGenerationStrategy::always_none:
-      InputCombinations.insert(std::set<D>());
-      break;
-    case SummaryGenerationStrategy::all_and_none:
-      InputCombinations.insert(inputset);
-      InputCombinations.insert(std::set<D>());
-      break;
-    case SummaryGenerationStrategy::powerset:
-      InputCombinations = computePowerSet(inputset);
-      break;
-    case SummaryGenerationStrategy::all_observed:
-      // TODO here we have to track what we have already observed first!
-      break;
+
+  /// Sets the calling contexts used by the all_observed strategy.
+  void setObservedContexts(const ObservedCallingContexts *O) { Observed = O; }
+
+  /// Sets the summaries that the isolated solves apply to the calls of
+  /// functions whose bodies are not available, e.g., the functions of other
+  /// modules that have been summarized before.
+  void setLibrarySummaries(std::shared_ptr<const IFDSSummaryPool> Summaries) {
+    LibrarySummaries = std::move(Summaries);
+  }
+
+  /// Computes the summaries of the given functions and adds them to Pool.
+  /// Declarations are skipped. Up to NumThreads isolated solves run in
+  /// parallel, which requires whatever the problems share, e.g., points-to
+  /// information, to be safe to query concurrently.
+  void generateSummaries(const std::vector<f_t> &Functions,
+                         IFDSSummaryPool &Pool, unsigned NumThreads = 1) {
+    std::vector<std::pair<f_t, std::vector<bool>>> Tasks;
+    for (f_t F : Functions) {
+      if (F->isDeclaration()) {
+        continue;
+      }
+      std::set<std::vector<bool>> ObservedCTX;
+      if (Observed) {
+        ObservedCTX = Observed->getObservedCTX(F->getName().str());
+      }
+      for (auto Context :
+           getSummaryContexts(CTXStrategy, F->arg_size(), ObservedCTX)) {
+        Tasks.emplace_back(F, std::move(Context));
+      }
     }
-    for (auto subset : InputCombinations) {
-      std::cout << "Generate summary for specific context: "
-                << generateBitPattern(inputs, subset) << "\n";
-      CTXFunctionProblem functionProblem(
-          *icfg.getStartPointsOf(toSummarize).begin(), subset, icfg);
-      ConcreteSolver solver(functionProblem, true);
-      solver.solve();
-      // get the result at the end of this function and
-      // create a flow function from this set using the GenAll class
-      std::set<N> LastInsts = icfg.getExitPointsOf(toSummarize);
-      std::set<D> results;
-      for (auto fact : solver.resultsAt(*LastInsts.begin())) {
-        results.insert(fact.first);
+    std::mutex PoolMutex;
+    std::atomic<size_t> Next = 0;
+    auto Work = [&] {
+      for (size_t Idx = Next++; Idx < Tasks.size(); Idx = Next++) {
+        const auto &[F, Context] = Tasks[Idx];
+        auto Outputs = summarize(F, Context);
+        std::lock_guard<std::mutex> Lock(PoolMutex);
+        Pool.insertSummary(F->getName().str(), IFDSSummaryPool::getInputs(F),
+                           Context, std::move(Outputs));
       }
-      summary.insert(make_pair(
-          generateBitPattern(inputs, subset),
-          std::make_shared<GenAll<D>>(results, LLVMZeroValue::getInstance())));
+    };
+    std::vector<std::thread> Workers;
+    for (unsigned I = 1; I < NumThreads; ++I) {
+      Workers.emplace_back(Work);
+    }
+    Work();
+    for (auto &Worker : Workers) {
+      Worker.join();
     }
-    return summary;
   }
 };
 
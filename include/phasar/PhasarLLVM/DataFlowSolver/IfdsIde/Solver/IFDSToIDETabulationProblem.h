@@ -73,6 +73,8 @@ public:
             IFDSProblem.getEntryPoints()),
         Problem(IFDSProblem) {
     this->ZeroValue = Problem.createZeroValue();
+    // solve the promoted problem as configured for the IFDS problem
+    this->setIFDSIDESolverConfig(Problem.getIFDSIDESolverConfig());
   }
 
   FlowFunctionPtrType getNormalFlowFunction(n_t curr, n_t succ) override {
@@ -163,6 +165,43 @@ public:
     return EdgeIdentity<BinaryDomain>::getInstance();
   }
 
+  std::string getSummaryAnalysisID() const override {
+    return Problem.getSummaryAnalysisID();
+  }
+
+  // the edge functions of the binary domain are distinguished by their
+  // values for TOP and BOTTOM
+  std::string edgeFunctionToSummaryString(
+      const std::shared_ptr<EdgeFunction<BinaryDomain>> &EF) override {
+    bool FromTop = EF->computeTarget(BinaryDomain::TOP) == BinaryDomain::TOP;
+    bool FromBottom =
+        EF->computeTarget(BinaryDomain::BOTTOM) == BinaryDomain::TOP;
+    if (FromTop && !FromBottom) {
+      return "id";
+    }
+    if (!FromTop && !FromBottom) {
+      return "bottom";
+    }
+    if (FromTop && FromBottom) {
+      return "top";
+    }
+    return {};
+  }
+
+  std::shared_ptr<EdgeFunction<BinaryDomain>>
+  edgeFunctionFromSummaryString(const std::string &S) override {
+    if (S == "id") {
+      return EdgeIdentity<BinaryDomain>::getInstance();
+    }
+    if (S == "bottom") {
+      return ALLBOTTOM;
+    }
+    if (S == "top") {
+      return allTopFunction();
+    }
+    return nullptr;
+  }
+
   void printNode(std::ostream &os, n_t n) const override {
     Problem.printNode(os, n);
   }
@@ -24,6 +24,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
@@ -137,31 +138,29 @@ public:
   /**
    * Returns, for a given target statement and value all associated
    * source values, and for each the associated edge function.
-   * The return value is a mapping from source value to function.
+   * The return value is a non-owning view on pairs of source value and
+   * function.
    */
-  std::optional<std::reference_wrapper<
-      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>>
-  reverseLookup(n_t target, d_t targetVal) {
+  std::optional<llvm::ArrayRef<std::pair<d_t, EdgeFunctionPtrType>>>
+  reverseLookup(n_t target, d_t targetVal) const {
     if (!nonEmptyReverseLookup.contains(target, targetVal)) {
       return std::nullopt;
-    } else {
-      return {nonEmptyReverseLookup.get(target, targetVal)};
     }
+    return {nonEmptyReverseLookup.get(target, targetVal)};
   }
 
   /**
    * Returns, for a given source value and target statement all
    * associated target values, and for each the associated edge function.
-   * The return value is a mapping from target value to function.
+   * The return value is a non-owning view on pairs of target value and
+   * function.
    */
-  std::optional<std::reference_wrapper<
-      llvm::SmallVector<std::pair<d_t, EdgeFunctionPtrType>, 1>>>
-  forwardLookup(d_t sourceVal, n_t target) {
+  std::optional<llvm::ArrayRef<std::pair<d_t, EdgeFunctionPtrType>>>
+  forwardLookup(d_t sourceVal, n_t target) const {
     if (!nonEmptyForwardLookup.contains(sourceVal, target)) {
       return std::nullopt;
-    } else {
-      return {nonEmptyForwardLookup.get(sourceVal, target)};
     }
+    return {nonEmptyForwardLookup.get(sourceVal, target)};
   }
 
   /**
@@ -170,8 +169,15 @@ public:
    * The return value is a set of records of the form
    * (sourceVal,targetVal,edgeFunction).
    */
-  Table<d_t, d_t, EdgeFunctionPtrType> lookupByTarget(n_t target) {
-    return nonEmptyLookupByTargetNode[target];
+  const Table<d_t, d_t, EdgeFunctionPtrType> &lookupByTarget(n_t target) const {
+    // does not insert an entry for target, such that concurrent lookups are
+    // safe as long as no jump function is added
+    static const Table<d_t, d_t, EdgeFunctionPtrType> Empty;
+    if (auto It = nonEmptyLookupByTargetNode.find(target);
+        It != nonEmptyLookupByTargetNode.end()) {
+      return It->second;
+    }
+    return Empty;
   }
 
   /**
@@ -202,6 +208,26 @@ public:
     return nonEmptyLookupByTargetNode.erase(target);
   }
 
+  /**
+   * Removes all jump functions with the given target statement.
+   * @return The number of jump functions that have been removed.
+   */
+  size_t removeFunctionsAt(n_t target) {
+    auto It = nonEmptyLookupByTargetNode.find(target);
+    if (It == nonEmptyLookupByTargetNode.end()) {
+      return 0;
+    }
+    size_t NumRemoved = 0;
+    It->second.foreachCell(
+        [&](d_t sourceVal, d_t /*targetVal*/, const EdgeFunctionPtrType &) {
+          nonEmptyForwardLookup.remove(sourceVal, target);
+          ++NumRemoved;
+        });
+    nonEmptyReverseLookup.remove(target);
+    nonEmptyLookupByTargetNode.erase(It);
+    return NumRemoved;
+  }
+
   /**
    * Removes all jump functions
    */
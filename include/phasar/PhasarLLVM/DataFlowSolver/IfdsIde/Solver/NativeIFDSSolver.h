@@ -0,0 +1,591 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_NATIVEIFDSSOLVER_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_NATIVEIFDSSOLVER_H_
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/FlowFunctions.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSTabulationProblem.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/InitialSeeds.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactInterner.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdgeWorklist.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ResultsView.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverResults.h"
+#include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/Utils/FlatTable.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/PAMMMacros.h"
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+/// Returns the names of the command-line options that correspond to the
+/// settings of Config which NativeIFDSSolver ignores.
+inline std::vector<std::string>
+getOptionsUnsupportedByNativeIFDSSolver(const IFDSIDESolverConfig &Config) {
+  std::vector<std::string> Options;
+  auto Check = [&Options](bool IsSet, const char *Option) {
+    if (IsSet) {
+      Options.emplace_back(Option);
+    }
+  };
+  Check(Config.emitESG(), "emit-esg-as-dot");
+  Check(!Config.esgLogFile().empty(), "esg-log");
+  Check(!Config.profileFile().empty(), "solver-profile");
+  Check(Config.computePersistedSummaries() || Config.sharedSummaryStore(),
+        "persisted-summaries");
+  Check(Config.librarySummaries(), "library-summaries");
+  Check(Config.denseJumpFunctions(), "dense-jump-functions");
+  Check(Config.retireJumpFunctions(), "retire-jump-functions");
+  Check(Config.lazyValues(), "lazy-values");
+  Check(Config.numThreads() > 1, "solver-threads");
+  Check(Config.flowEdgeFunctionCacheCapacity() != 0,
+        "flow-edge-function-cache-capacity");
+  Check(Config.budget().TimeLimit.has_value(), "solver-time-limit");
+  Check(Config.budget().MaxResidentSetSize != 0, "solver-memory-limit");
+  Check(Config.budget().MaxWorkItems != 0, "solver-max-path-edges");
+  Check(!Config.checkpointFile().empty(), "solver-checkpoint");
+  return Options;
+}
+
+/// Solves the given IFDSTabulationProblem using the tabulation algorithm of
+/// Reps, Horwitz and Sagiv (POPL 1995) with the extensions of Naeem, Lhotak
+/// and Rodriguez (CC 2010).
+///
+/// In contrast to IFDSSolver, the problem is not lifted to an IDE problem
+/// over the BinaryDomain: the solver only records which path edges
+/// (d1, n, d2) are reachable, it neither constructs, composes nor joins edge
+/// functions, and each path edge is processed exactly once. There is no
+/// value computation (Phase II) either, a fact holds at a node as soon as
+/// some path edge reaches it. The results are reported as BinaryDomain::BOTTOM
+/// to remain compatible with the reporting facilities of the IFDS problems.
+///
+/// Internally, each distinct fact is interned once and referred to by a
+/// 32-bit ID (see FactInterner); the facts themselves are only handed to the
+/// flow functions and materialized in the results.
+///
+/// The solver offers the interface of IFDSSolver that the IFDS clients and
+/// WholeProgramAnalysis rely on, so that it can be used as a drop-in
+/// replacement. Of the solver configuration, autoAddZero(),
+/// followReturnsPastSeeds() and worklistPolicy() are taken into account, see
+/// getOptionsUnsupportedByNativeIFDSSolver(). IDESolver's
+/// restoreContextOnReturnedFact() hook is not applied to returned facts; it
+/// returns them unchanged in IDESolver as well. TableTy selects the table
+/// implementation for the summaries and results, see IDESolver.
+template <typename AnalysisDomainTy,
+          typename Container = std::set<typename AnalysisDomainTy::d_t>,
+          template <typename, typename, typename> class TableTy = Table>
+class NativeIFDSSolver {
+public:
+  using ProblemTy = IFDSTabulationProblem<AnalysisDomainTy, Container>;
+  using container_type = typename ProblemTy::container_type;
+  using FlowFunctionPtrType = typename ProblemTy::FlowFunctionPtrType;
+
+  using d_t = typename AnalysisDomainTy::d_t;
+  using n_t = typename AnalysisDomainTy::n_t;
+  using f_t = typename AnalysisDomainTy::f_t;
+  using i_t = typename AnalysisDomainTy::i_t;
+  using l_t = typename AnalysisDomainTy::l_t;
+
+  NativeIFDSSolver(IFDSTabulationProblem<AnalysisDomainTy, Container> &Problem)
+      : IFDSProblem(Problem), ZeroValue(Problem.getZeroValue()),
+        ICF(Problem.getICFG()), SolverConfig(Problem.getIFDSIDESolverConfig()),
+        ZeroID(Interner.getOrCreateID(ZeroValue)),
+        Worklist(ICF, SolverConfig.worklistPolicy()),
+        Seeds(Problem.initialSeeds()) {}
+
+  NativeIFDSSolver(const NativeIFDSSolver &) = delete;
+  NativeIFDSSolver &operator=(const NativeIFDSSolver &) = delete;
+  NativeIFDSSolver(NativeIFDSSolver &&) = delete;
+  NativeIFDSSolver &operator=(NativeIFDSSolver &&) = delete;
+
+  virtual ~NativeIFDSSolver() = default;
+
+  /// \brief Runs the solver on the configured problem. This can take some time.
+  virtual void solve() {
+    PAMM_GET_INSTANCE;
+    REG_COUNTER("Gen facts", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("Path Edges", 0, PAMM_SEVERITY_LEVEL::Core);
+    REG_COUNTER("FF Queries", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("FF Construction", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("SpecialSummary-FF Application", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Worklist Max Size", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Call", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Normal", 0, PAMM_SEVERITY_LEVEL::Full);
+    REG_COUNTER("Process Exit", 0, PAMM_SEVERITY_LEVEL::Full);
+
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Native IFDS solver is solving the specified problem");
+    START_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    submitInitialSeeds();
+    while (!Worklist.empty()) {
+      pathEdgeProcessingTask(Worklist.pop());
+    }
+    STOP_TIMER("DFA Phase I", PAMM_SEVERITY_LEVEL::Full);
+    INC_COUNTER("Path Edges", NumPathEdges, PAMM_SEVERITY_LEVEL::Core);
+    INC_COUNTER("Worklist Max Size", Worklist.maxSize(),
+                PAMM_SEVERITY_LEVEL::Full);
+    // materialize the results for the reporting facilities
+    Results.clear();
+    for (const auto &[Target, FactsAtTarget] : PathEdges) {
+      for (const auto &[Fact, Sources] : FactsAtTarget) {
+        Results.insert(Target, fact(Fact), BinaryDomain::BOTTOM);
+      }
+    }
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Problem solved using " << NumPathEdges << " path edges");
+  }
+
+  /// Returns BinaryDomain::BOTTOM if the given fact holds at the given
+  /// statement and BinaryDomain::TOP otherwise.
+  [[nodiscard]] virtual BinaryDomain resultAt(n_t Stmt, d_t Fact) {
+    return Results.contains(Stmt, Fact) ? BinaryDomain::BOTTOM
+                                        : BinaryDomain::TOP;
+  }
+
+  /// Returns the resulting environment for the given statement. The
+  /// artificial zero value can be automatically stripped.
+  [[nodiscard]] virtual std::unordered_map<d_t, BinaryDomain>
+  resultsAt(n_t Stmt, bool StripZero = false) {
+    std::unordered_map<d_t, BinaryDomain> Result;
+    for (const auto &[Fact, Value] : resultsViewAt(Stmt, StripZero)) {
+      Result.emplace(Fact, Value);
+    }
+    return Result;
+  }
+
+  /// Returns a view of the (fact, value) pairs at the given statement that
+  /// refers to the solver's results instead of copying them, see
+  /// IDESolver::resultsViewAt().
+  [[nodiscard]] auto resultsViewAt(n_t Stmt, bool StripZero = false) const {
+    return makeResultsView(Results.row(Stmt), ZeroValue, StripZero);
+  }
+
+  /// Calls Fn(Stmt, Fact, Value) for all results at the statements of the
+  /// given function without copying them.
+  template <typename FnTy>
+  void foreachResultIn(f_t Fun, FnTy Fn, bool StripZero = false) const {
+    for (n_t Stmt : ICF->getAllInstructionsOf(Fun)) {
+      for (const auto &[Fact, Value] : resultsViewAt(Stmt, StripZero)) {
+        Fn(Stmt, Fact, Value);
+      }
+    }
+  }
+
+  /// Returns the data-flow results at the given statement.
+  [[nodiscard]] virtual std::set<d_t> ifdsResultsAt(n_t Inst) {
+    std::set<d_t> KeySet;
+    if (auto It = PathEdges.find(Inst); It != PathEdges.end()) {
+      for (const auto &[Fact, Sources] : It->second) {
+        KeySet.insert(fact(Fact));
+      }
+    }
+    return KeySet;
+  }
+
+  /// Returns the data-flow results at the given statement while respecting
+  /// LLVM's SSA semantics, see IFDSSolver::ifdsResultsAtInLLVMSSA().
+  template <typename NTy = n_t>
+  [[nodiscard]] typename std::enable_if_t<
+      std::is_same_v<std::remove_reference_t<NTy>, llvm::Instruction *>,
+      std::set<d_t>>
+  ifdsResultsAtInLLVMSSA(NTy Inst) {
+    if (Inst->getType()->isVoidTy()) {
+      return ifdsResultsAt(Inst);
+    }
+    assert(Inst->getNextNode() && "Expected to find a valid successor node!");
+    return ifdsResultsAt(Inst->getNextNode());
+  }
+
+  SolverResults<n_t, d_t, BinaryDomain> getSolverResults() {
+    return SolverResults<n_t, d_t, BinaryDomain>(Results, ZeroValue);
+  }
+
+  /// Returns the number of path edges the solver has discovered.
+  [[nodiscard]] size_t getNumPathEdges() const { return NumPathEdges; }
+
+  virtual void emitTextReport(std::ostream &OS = std::cout) {
+    IFDSProblem.emitTextReport(getSolverResults(), OS);
+  }
+
+  virtual void emitGraphicalReport(std::ostream &OS = std::cout) {
+    IFDSProblem.emitGraphicalReport(getSolverResults(), OS);
+  }
+
+  virtual void dumpResults(std::ostream &OS = std::cout) {
+    OS << "\n***************************************************************\n"
+       << "*              Raw NativeIFDSSolver results                   *\n"
+       << "***************************************************************\n";
+    auto Cells = Results.cellVec();
+    if (Cells.empty()) {
+      OS << "No results computed!" << std::endl;
+      return;
+    }
+    llvmValueIDLess LlvmIDLess;
+    std::sort(Cells.begin(), Cells.end(),
+              [&LlvmIDLess](const auto &LHS, const auto &RHS) {
+                if constexpr (std::is_same_v<n_t, const llvm::Instruction *>) {
+                  return LlvmIDLess(LHS.getRowKey(), RHS.getRowKey());
+                } else {
+                  // If non-LLVM IR is used
+                  return LHS.getRowKey() < RHS.getRowKey();
+                }
+              });
+    n_t Prev = n_t{};
+    f_t PrevFn = f_t{};
+    for (const auto &Cell : Cells) {
+      n_t Curr = Cell.getRowKey();
+      f_t CurrFn = ICF->getFunctionOf(Curr);
+      if (PrevFn != CurrFn) {
+        PrevFn = CurrFn;
+        OS << "\n\n============ Results for function '" +
+                  ICF->getFunctionName(CurrFn) + "' ============\n";
+      }
+      if (Prev != Curr) {
+        Prev = Curr;
+        std::string NString = IFDSProblem.NtoString(Curr);
+        OS << "\n\nN: " << NString << "\n---"
+           << std::string(NString.size(), '-') << '\n';
+      }
+      OS << "\tD: " << IFDSProblem.DtoString(Cell.getColumnKey()) << '\n';
+    }
+    OS << '\n';
+  }
+
+protected:
+  using FactID = typename FactInterner<d_t>::IdType;
+
+  /// Adds the zero value to each start point's seeds and propagates all
+  /// seeds.
+  void submitInitialSeeds() {
+    PAMM_GET_INSTANCE;
+    for (const auto &[StartPoint, Facts] : Seeds.getSeeds()) {
+      if (Facts.find(ZeroValue) == Facts.end()) {
+        LOG_IF_ENABLE(
+            BOOST_LOG_SEV(lg::get(), DEBUG)
+            << "Zero-Value has been added automatically to start point: "
+            << IFDSProblem.NtoString(StartPoint));
+        propagate(ZeroID, StartPoint, ZeroID);
+      }
+      for (const auto &[Fact, Value] : Facts) {
+        if (!IFDSProblem.isZeroValue(Fact)) {
+          INC_COUNTER("Gen facts", 1, PAMM_SEVERITY_LEVEL::Core);
+        }
+        FactID ID = Interner.getOrCreateID(Fact);
+        propagate(ID, StartPoint, ID);
+      }
+    }
+  }
+
+  void pathEdgeProcessingTask(const PathEdge<n_t, FactID> &Edge) {
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), DEBUG)
+                  << "Process path edge: <D source: "
+                  << IFDSProblem.DtoString(fact(Edge.factAtSource()))
+                  << " ; N target: " << IFDSProblem.NtoString(Edge.getTarget())
+                  << " ; D target: "
+                  << IFDSProblem.DtoString(fact(Edge.factAtTarget())) << '>');
+    if (!ICF->isCallSite(Edge.getTarget())) {
+      if (ICF->isExitInst(Edge.getTarget())) {
+        processExit(Edge);
+      }
+      if (!ICF->getSuccsOf(Edge.getTarget()).empty()) {
+        processNormalFlow(Edge);
+      }
+    } else {
+      processCall(Edge);
+    }
+  }
+
+  /// Lines 13-20 of the algorithm; handles the flows into callees, along
+  /// special summaries and along the call-to-return edges.
+  virtual void processCall(const PathEdge<n_t, FactID> &Edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Call", 1, PAMM_SEVERITY_LEVEL::Full);
+    FactID D1 = Edge.factAtSource();
+    n_t N = Edge.getTarget();
+    FactID D2 = Edge.factAtTarget();
+    const std::set<n_t> ReturnSiteNs = ICF->getReturnSitesOfCallAt(N);
+    const std::set<f_t> Callees = ICF->getCalleesOfCallAt(N);
+    for (f_t Callee : Callees) {
+      // special summaries are treated like normal flows
+      if (FlowFunctionPtrType SpecialSum =
+              IFDSProblem.getSummaryFlowFunction(N, Callee)) {
+        INC_COUNTER("SpecialSummary-FF Application", 1,
+                    PAMM_SEVERITY_LEVEL::Full);
+        for (FactID D3 : computeTargets(SpecialSum, D2)) {
+          for (n_t ReturnSiteN : ReturnSiteNs) {
+            propagate(D1, ReturnSiteN, D3);
+          }
+        }
+        continue;
+      }
+      const std::vector<FactID> Res =
+          computeTargets(getCallFlowFunction(N, Callee), D2);
+      // if there are no start points, the callee is a declaration
+      for (n_t SP : ICF->getStartPointsOf(Callee)) {
+        for (FactID D3 : Res) {
+          // create the initial self-loop
+          propagate(D3, SP, D3); // line 15
+          // line 15.1 of Naeem/Lhotak/Rodriguez
+          IncomingTab.get(SP, D3)[N].insert(D2);
+          // line 15.2, apply the end summaries that have already been
+          // computed for <SP,D3>
+          if (!EndSummaryTab.contains(SP, D3)) {
+            continue;
+          }
+          for (const auto &[EP, D4] : EndSummaryTab.get(SP, D3)) {
+            for (n_t RetSiteN : ReturnSiteNs) {
+              for (FactID D5 : computeTargets(
+                       getRetFlowFunction(N, Callee, EP, RetSiteN), D4)) {
+                propagate(D1, RetSiteN, D5);
+              }
+            }
+          }
+        }
+      }
+    }
+    // line 17-19 of Naeem/Lhotak/Rodriguez
+    for (n_t ReturnSiteN : ReturnSiteNs) {
+      for (FactID D3 : computeTargets(
+               getCallToRetFlowFunction(N, ReturnSiteN, Callees), D2)) {
+        propagate(D1, ReturnSiteN, D3);
+      }
+    }
+  }
+
+  /// Lines 33-37 of the algorithm; handles intra-procedural flows.
+  virtual void processNormalFlow(const PathEdge<n_t, FactID> &Edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Normal", 1, PAMM_SEVERITY_LEVEL::Full);
+    FactID D1 = Edge.factAtSource();
+    n_t N = Edge.getTarget();
+    FactID D2 = Edge.factAtTarget();
+    for (n_t Succ : ICF->getSuccsOf(N)) {
+      for (FactID D3 : computeTargets(getNormalFlowFunction(N, Succ), D2)) {
+        propagate(D1, Succ, D3);
+      }
+    }
+  }
+
+  /// Lines 21-32 of the algorithm; stores the callee-side summaries and
+  /// applies them to all incoming calls that have been processed already.
+  virtual void processExit(const PathEdge<n_t, FactID> &Edge) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("Process Exit", 1, PAMM_SEVERITY_LEVEL::Full);
+    FactID D1 = Edge.factAtSource();
+    n_t N = Edge.getTarget();
+    FactID D2 = Edge.factAtTarget();
+    f_t Callee = ICF->getFunctionOf(N);
+    std::map<n_t, std::set<FactID>> Inc;
+    for (n_t SP : ICF->getStartPointsOf(Callee)) {
+      // line 21.1 of Naeem/Lhotak/Rodriguez
+      EndSummaryTab.get(SP, D1).emplace(N, D2);
+      if (IncomingTab.contains(SP, D1)) {
+        for (const auto &[CallSite, CallerFacts] : IncomingTab.get(SP, D1)) {
+          Inc[CallSite].insert(CallerFacts.begin(), CallerFacts.end());
+        }
+      }
+    }
+    // for each incoming call edge already processed, see processCall()
+    for (const auto &[CallSite, CallerFacts] : Inc) {
+      for (n_t RetSiteC : ICF->getReturnSitesOfCallAt(CallSite)) {
+        const std::vector<FactID> Targets = computeTargets(
+            getRetFlowFunction(CallSite, Callee, N, RetSiteC), D2);
+        if (Targets.empty()) {
+          continue;
+        }
+        for (FactID D4 : CallerFacts) {
+          // copy, as propagate() may add path edges into the call site
+          const auto CallerSources = sourcesOf(CallSite, D4);
+          for (FactID D3 : CallerSources) {
+            for (FactID D5 : Targets) {
+              propagate(D3, RetSiteC, D5);
+            }
+          }
+        }
+      }
+    }
+    // handling for unbalanced problems where we return out of a method with a
+    // fact for which we have no incoming flow; only values that originate
+    // from ZERO are propagated that way
+    if (SolverConfig.followReturnsPastSeeds() && Inc.empty() &&
+        D1 == ZeroID) {
+      const std::set<n_t> Callers = ICF->getCallersOf(Callee);
+      for (n_t CallSite : Callers) {
+        for (n_t RetSiteC : ICF->getReturnSitesOfCallAt(CallSite)) {
+          for (FactID D5 : computeTargets(
+                   getRetFlowFunction(CallSite, Callee, N, RetSiteC), D2)) {
+            propagate(ZeroID, RetSiteC, D5);
+          }
+        }
+      }
+      // the return flow function may have side effects, such as registering
+      // a taint, so call it with a null caller if there are no callers
+      if (Callers.empty()) {
+        INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+        IFDSProblem.getRetFlowFunction(nullptr, Callee, N, nullptr)
+            ->computeTargets(fact(D2));
+      }
+    }
+  }
+
+  /// Records the path edge <SourceVal> --> <Target,TargetVal> and schedules
+  /// it for processing unless it has been recorded before.
+  void propagate(FactID SourceVal, n_t Target, FactID TargetVal) {
+    if (!PathEdges[Target][TargetVal].insert(SourceVal).second) {
+      return;
+    }
+    ++NumPathEdges;
+    Worklist.push(PathEdge<n_t, FactID>(SourceVal, Target, TargetVal));
+  }
+
+  /// Returns the source values of all path edges into <Target,TargetVal>.
+  std::vector<FactID> sourcesOf(n_t Target, FactID TargetVal) const {
+    if (auto It = PathEdges.find(Target); It != PathEdges.end()) {
+      if (auto FactIt = It->second.find(TargetVal);
+          FactIt != It->second.end()) {
+        return {FactIt->second.begin(), FactIt->second.end()};
+      }
+    }
+    return {};
+  }
+
+  /// Applies the given flow function to the fact with the given ID and
+  /// returns the IDs of the resulting facts.
+  std::vector<FactID> computeTargets(const FlowFunctionPtrType &Function,
+                                     FactID Source) {
+    std::vector<FactID> Targets;
+    for (const d_t &Target : Function->computeTargets(fact(Source))) {
+      Targets.push_back(Interner.getOrCreateID(Target));
+    }
+    return Targets;
+  }
+
+  /// Materializes the fact with the given ID.
+  [[nodiscard]] const d_t &fact(FactID ID) const {
+    return Interner.getFact(ID);
+  }
+
+  FlowFunctionPtrType getNormalFlowFunction(n_t Curr, n_t Succ) {
+    return getOrCreateFlowFunction(NormalFFCache, std::make_pair(Curr, Succ),
+                                   [&] {
+                                     return IFDSProblem.getNormalFlowFunction(
+                                         Curr, Succ);
+                                   });
+  }
+
+  FlowFunctionPtrType getCallFlowFunction(n_t CallSite, f_t Callee) {
+    return getOrCreateFlowFunction(
+        CallFFCache, std::make_pair(CallSite, Callee),
+        [&] { return IFDSProblem.getCallFlowFunction(CallSite, Callee); });
+  }
+
+  FlowFunctionPtrType getRetFlowFunction(n_t CallSite, f_t Callee, n_t ExitInst,
+                                         n_t RetSite) {
+    return getOrCreateFlowFunction(
+        RetFFCache, std::make_tuple(CallSite, Callee, ExitInst, RetSite), [&] {
+          return IFDSProblem.getRetFlowFunction(CallSite, Callee, ExitInst,
+                                                RetSite);
+        });
+  }
+
+  FlowFunctionPtrType getCallToRetFlowFunction(n_t CallSite, n_t RetSite,
+                                               const std::set<f_t> &Callees) {
+    // the callees are determined by the call site
+    return getOrCreateFlowFunction(
+        CallToRetFFCache, std::make_pair(CallSite, RetSite), [&] {
+          return IFDSProblem.getCallToRetFlowFunction(CallSite, RetSite,
+                                                      Callees);
+        });
+  }
+
+  IFDSTabulationProblem<AnalysisDomainTy, Container> &IFDSProblem;
+  d_t ZeroValue;
+  const i_t *ICF;
+  IFDSIDESolverConfig &SolverConfig;
+
+  // all tables below refer to facts by their IDs, the facts themselves are
+  // only materialized for the flow functions and the results
+  FactInterner<d_t> Interner;
+  FactID ZeroID;
+
+  // path edges that have been recorded but not yet processed
+  PathEdgeWorklist<n_t, FactID, f_t, i_t> Worklist;
+
+  // all recorded path edges: target node -> target fact -> source facts
+  std::unordered_map<n_t,
+                     std::unordered_map<FactID, std::unordered_set<FactID>>>
+      PathEdges;
+  size_t NumPathEdges = 0;
+
+  // end summaries: <sP,d1> -> reachable <eP,d2>
+  // see CC 2010 paper by Naeem, Lhotak and Rodriguez
+  TableTy<n_t, FactID, std::set<std::pair<n_t, FactID>>> EndSummaryTab;
+
+  // edges going along calls: <sP,d3> -> call site -> caller-side facts
+  // see CC 2010 paper by Naeem, Lhotak and Rodriguez
+  TableTy<n_t, FactID, std::map<n_t, std::set<FactID>>> IncomingTab;
+
+  InitialSeeds<n_t, d_t, l_t> Seeds;
+
+  TableTy<n_t, d_t, BinaryDomain> Results;
+
+private:
+  template <typename CacheTy, typename KeyTy, typename FactoryTy>
+  FlowFunctionPtrType getOrCreateFlowFunction(CacheTy &Cache, const KeyTy &Key,
+                                              FactoryTy Factory) {
+    PAMM_GET_INSTANCE;
+    INC_COUNTER("FF Queries", 1, PAMM_SEVERITY_LEVEL::Full);
+    auto [It, Inserted] = Cache.try_emplace(Key, nullptr);
+    if (Inserted) {
+      INC_COUNTER("FF Construction", 1, PAMM_SEVERITY_LEVEL::Full);
+      It->second = SolverConfig.autoAddZero()
+                       ? std::make_shared<ZeroedFlowFunction<d_t, Container>>(
+                             Factory(), ZeroValue)
+                       : Factory();
+    }
+    return It->second;
+  }
+
+  std::map<std::pair<n_t, n_t>, FlowFunctionPtrType> NormalFFCache;
+  std::map<std::pair<n_t, f_t>, FlowFunctionPtrType> CallFFCache;
+  std::map<std::tuple<n_t, f_t, n_t, n_t>, FlowFunctionPtrType> RetFFCache;
+  std::map<std::pair<n_t, n_t>, FlowFunctionPtrType> CallToRetFFCache;
+};
+
+template <typename Problem>
+NativeIFDSSolver(Problem &)
+    -> NativeIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                        typename Problem::container_type>;
+
+template <typename Problem>
+using NativeIFDSSolver_P =
+    NativeIFDSSolver<typename Problem::ProblemAnalysisDomain,
+                     typename Problem::container_type>;
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_PATHEDGEWORKLIST_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/Hashing.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/// Holds the path edges that still have to be processed by the IDESolver's
+/// tabulation (Phase I). Replacing the solver's former recursion by this
+/// worklist keeps the stack depth independent of the length of the paths in
+/// the exploded super-graph.
+///
+/// A path edge that is already pending is not scheduled a second time; its
+/// jump function is looked up when the edge is processed, so the latest join
+/// is always taken into account.
+///
+/// The order in which pending edges are handed out is determined by a
+/// WorklistPolicy:
+///   - FIFO: breadth-first exploration of the exploded super-graph
+///   - LIFO: depth-first exploration, which mimics the former recursion
+///   - ReversePostOrder: edges whose target comes first in a reverse-postorder
+///     traversal of its function's CFG are processed first (FIFO on ties),
+///     which tends to reach loop heads only after all of their forward
+///     predecessors have been joined
+template <typename N, typename D, typename F, typename I>
+class PathEdgeWorklist {
+public:
+  PathEdgeWorklist(const I *ICF, WorklistPolicy Policy)
+      : ICF(ICF), Policy(Policy) {}
+
+  ~PathEdgeWorklist() = default;
+
+  PathEdgeWorklist(const PathEdgeWorklist &) = delete;
+  PathEdgeWorklist &operator=(const PathEdgeWorklist &) = delete;
+  PathEdgeWorklist(PathEdgeWorklist &&) noexcept = default;
+  PathEdgeWorklist &operator=(PathEdgeWorklist &&) noexcept = default;
+
+  /// Schedules the given path edge. Returns false if the edge was already
+  /// pending and thus has not been added again.
+  bool push(const PathEdge<N, D> &Edge) {
+    if (!Pending.emplace(Edge.factAtSource(), Edge.getTarget(),
+                         Edge.factAtTarget())
+             .second) {
+      return false;
+    }
+    if (Policy == WorklistPolicy::ReversePostOrder) {
+      Prioritized.push({getRPOIndex(Edge.getTarget()), NextSeqNo++,
+                        Edge.factAtSource(), Edge.getTarget(),
+                        Edge.factAtTarget()});
+    } else {
+      Queue.push_back(Edge);
+    }
+    MaxSize = std::max(MaxSize, size());
+    return true;
+  }
+
+  /// Removes and returns the next path edge according to the worklist policy.
+  /// The worklist must not be empty.
+  PathEdge<N, D> pop() {
+    auto Next = [this]() {
+      switch (Policy) {
+      case WorklistPolicy::LIFO: {
+        PathEdge<N, D> Edge = Queue.back();
+        Queue.pop_back();
+        return Edge;
+      }
+      case WorklistPolicy::ReversePostOrder: {
+        const auto &Top = Prioritized.top();
+        PathEdge<N, D> Edge(Top.Source, Top.Target, Top.TargetFact);
+        Prioritized.pop();
+        return Edge;
+      }
+      default: {
+        PathEdge<N, D> Edge = Queue.front();
+        Queue.pop_front();
+        return Edge;
+      }
+      }
+    }();
+    Pending.erase({Next.factAtSource(), Next.getTarget(), Next.factAtTarget()});
+    return Next;
+  }
+
+  [[nodiscard]] bool empty() const {
+    return Queue.empty() && Prioritized.empty();
+  }
+
+  [[nodiscard]] size_t size() const {
+    return Queue.size() + Prioritized.size();
+  }
+
+  /// Returns the largest number of path edges that have been pending at the
+  /// same time.
+  [[nodiscard]] size_t maxSize() const { return MaxSize; }
+
+  [[nodiscard]] WorklistPolicy getPolicy() const { return Policy; }
+
+  /// Calls Fn(Source, Target, TargetFact) for each pending path edge without
+  /// removing it. FIFO and LIFO worklists report their edges in the order
+  /// they have been pushed, so pushing them again restores the order.
+  template <typename Fn> void foreachPending(Fn &&Callback) const {
+    if (Policy == WorklistPolicy::ReversePostOrder) {
+      // the priority is recomputed on push, only the order of ties is lost
+      for (const auto &[Source, Target, TargetFact] : Pending) {
+        Callback(Source, Target, TargetFact);
+      }
+      return;
+    }
+    for (const auto &Edge : Queue) {
+      Callback(Edge.factAtSource(), Edge.getTarget(), Edge.factAtTarget());
+    }
+  }
+
+  void clear() {
+    Queue.clear();
+    Prioritized = {};
+    Pending.clear();
+  }
+
+private:
+  struct PrioritizedEdge {
+    unsigned RPOIndex;
+    size_t SeqNo;
+    D Source;
+    N Target;
+    D TargetFact;
+
+    // std::priority_queue is a max-heap, so invert the comparison to hand
+    // out the smallest reverse-postorder index first
+    friend bool operator<(const PrioritizedEdge &LHS,
+                          const PrioritizedEdge &RHS) {
+      return std::tie(LHS.RPOIndex, LHS.SeqNo) >
+             std::tie(RHS.RPOIndex, RHS.SeqNo);
+    }
+  };
+
+  struct EdgeKeyHash {
+    size_t operator()(const std::tuple<D, N, D> &Key) const {
+      return llvm::hash_combine(std::hash<D>{}(std::get<0>(Key)),
+                                std::hash<N>{}(std::get<1>(Key)),
+                                std::hash<D>{}(std::get<2>(Key)));
+    }
+  };
+
+  unsigned getRPOIndex(N Node) {
+    if (auto It = RPOIndex.find(Node); It != RPOIndex.end()) {
+      return It->second;
+    }
+    computeRPO(ICF->getFunctionOf(Node));
+    // nodes that are unreachable from their function's start points are
+    // scheduled last
+    return RPOIndex.try_emplace(Node, std::numeric_limits<unsigned>::max())
+        .first->second;
+  }
+
+  void computeRPO(F Fun) {
+    std::vector<N> PostOrder;
+    std::unordered_set<N> Visited;
+    // iterative depth-first search to stay independent of the CFG's depth
+    std::vector<std::pair<N, std::vector<N>>> Stack;
+    for (N StartPoint : ICF->getStartPointsOf(Fun)) {
+      if (!Visited.insert(StartPoint).second) {
+        continue;
+      }
+      Stack.emplace_back(StartPoint, ICF->getSuccsOf(StartPoint));
+      while (!Stack.empty()) {
+        auto &Succs = Stack.back().second;
+        if (Succs.empty()) {
+          PostOrder.push_back(Stack.back().first);
+          Stack.pop_back();
+          continue;
+        }
+        N Succ = Succs.back();
+        Succs.pop_back();
+        if (Visited.insert(Succ).second) {
+          Stack.emplace_back(Succ, ICF->getSuccsOf(Succ));
+        }
+      }
+    }
+    for (size_t Idx = 0; Idx < PostOrder.size(); ++Idx) {
+      RPOIndex[PostOrder[Idx]] = PostOrder.size() - 1 - Idx;
+    }
+  }
+
+  const I *ICF;
+  WorklistPolicy Policy;
+  std::deque<PathEdge<N, D>> Queue;
+  std::priority_queue<PrioritizedEdge> Prioritized;
+  std::unordered_set<std::tuple<D, N, D>, EdgeKeyHash> Pending;
+  std::unordered_map<N, unsigned> RPOIndex;
+  size_t NextSeqNo = 0;
+  size_t MaxSize = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_RESULTSVIEW_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_RESULTSVIEW_H_
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <utility>
+
+namespace psr {
+
+/// A view of the (fact, value) pairs that a solver has computed for a single
+/// statement, which can skip the artificial zero fact.
+///
+/// The view refers to the solver's result table directly and is invalidated
+/// by anything that modifies the table, e.g., by solving again.
+template <typename IterTy, typename D> class ResultsView {
+public:
+  class iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<IterTy>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = decltype(*std::declval<IterTy>());
+
+    iterator(IterTy It, IterTy End, const std::optional<D> *SkippedFact)
+        : It(std::move(It)), End(std::move(End)), SkippedFact(SkippedFact) {
+      skip();
+    }
+
+    reference operator*() const { return *It; }
+
+    iterator &operator++() {
+      ++It;
+      skip();
+      return *this;
+    }
+
+    iterator operator++(int) {
+      auto Tmp = *this;
+      ++*this;
+      return Tmp;
+    }
+
+    friend bool operator==(const iterator &LHS, const iterator &RHS) {
+      return LHS.It == RHS.It;
+    }
+    friend bool operator!=(const iterator &LHS, const iterator &RHS) {
+      return !(LHS == RHS);
+    }
+
+  private:
+    void skip() {
+      if (*SkippedFact) {
+        while (It != End && (*It).first == **SkippedFact) {
+          ++It;
+        }
+      }
+    }
+
+    IterTy It;
+    IterTy End;
+    const std::optional<D> *SkippedFact;
+  };
+
+  /// Creates a view of [Begin, End) that skips SkippedFact, if any.
+  ResultsView(IterTy Begin, IterTy End, std::optional<D> SkippedFact)
+      : Begin(std::move(Begin)), End(std::move(End)),
+        SkippedFact(std::move(SkippedFact)) {}
+
+  [[nodiscard]] iterator begin() const { return {Begin, End, &SkippedFact}; }
+  [[nodiscard]] iterator end() const { return {End, End, &SkippedFact}; }
+  [[nodiscard]] bool empty() const { return begin() == end(); }
+
+private:
+  IterTy Begin;
+  IterTy End;
+  std::optional<D> SkippedFact;
+};
+
+/// Creates a view of a row of a solver's result table, i.e., of a Table's
+/// std::unordered_map or of a FlatTable::RowView.
+template <typename RowTy, typename D>
+auto makeResultsView(const RowTy &Row, const D &ZeroValue, bool StripZero) {
+  return ResultsView<decltype(Row.begin()), D>(
+      Row.begin(), Row.end(),
+      StripZero ? std::optional<D>(ZeroValue) : std::nullopt);
+}
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,475 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERCHECKPOINT_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERCHECKPOINT_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/Utils/Logger.h"
+
+namespace llvm {
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/// Identifies a data-flow fact of an analysis on LLVM IR in a checkpoint:
+/// the zero value, an instruction, an argument of a defined function or a
+/// defined global variable or function.
+struct CheckpointFact {
+  enum class Kind : uint8_t { Zero, Instruction, Argument, Global };
+
+  Kind FactKind = Kind::Zero;
+  // the instruction's ID, see ProjectIRDB::getInstructionID()
+  uint64_t InstructionID = 0;
+  // the name of the argument's function or of the global
+  std::string Name;
+  unsigned ArgNo = 0;
+};
+
+/// The state of the construction of the exploded super-graph (Phase I) of
+/// an IDESolver on LLVM IR as it has been committed to a checkpoint by a
+/// SolverCheckpointWriter.
+///
+/// Nodes are referred to by their instruction IDs, see
+/// ProjectIRDB::getInstructionID(), facts and edge functions by their
+/// indices into Facts and Labels. The edge functions are represented by the
+/// strings of IDETabulationProblem::edgeFunctionToSummaryString().
+struct SolverCheckpoint {
+  struct JumpFunction {
+    uint32_t SourceFact;
+    uint64_t Target;
+    uint32_t TargetFact;
+    uint32_t Label;
+  };
+
+  struct EndSummary {
+    uint64_t StartPoint;
+    uint32_t StartFact;
+    uint64_t ExitPoint;
+    uint32_t ExitFact;
+    uint32_t Label;
+  };
+
+  struct Incoming {
+    uint64_t StartPoint;
+    uint32_t StartFact;
+    uint64_t CallSite;
+    uint32_t CallSiteFact;
+  };
+
+  struct PathEdge {
+    uint32_t SourceFact;
+    uint64_t Target;
+    uint32_t TargetFact;
+  };
+
+  std::string AnalysisID;
+  uint64_t IRFingerprint = 0;
+  std::vector<CheckpointFact> Facts;
+  std::vector<std::string> Labels;
+  std::vector<std::pair<uint64_t, uint32_t>> Seeds;
+  // in the order in which they have been recorded; later jump functions and
+  // end summaries replace earlier ones
+  std::vector<JumpFunction> JumpFunctions;
+  std::vector<EndSummary> EndSummaries;
+  std::vector<Incoming> Incomings;
+  std::vector<uint64_t> UnbalancedReturnSites;
+  // the path edges that were pending at the last commit, in the order in
+  // which they have been added to the checkpoint
+  std::vector<PathEdge> Worklist;
+  // the number of path edges processed until the last commit
+  uint64_t NumPathEdges = 0;
+  uint64_t NumCommits = 0;
+  // the size of the checkpoint up to the end of the last commit
+  uint64_t Size = 0;
+
+  /// Reads the checkpoint at Path up to its last complete commit, which
+  /// discards a commit that has been interrupted by a crash. Throws
+  /// std::ios_base::failure if the checkpoint cannot be read or is
+  /// malformed.
+  static SolverCheckpoint read(const std::string &Path);
+};
+
+/// Returns a fingerprint of the modules of IRDB, which tells whether a
+/// checkpoint has been written for the same IR.
+uint64_t getIRFingerprint(const ProjectIRDB &IRDB);
+
+/// Returns the value of the given fact in IRDB, or nullptr if there is no
+/// such value.
+const llvm::Value *resolveCheckpointFact(const ProjectIRDB &IRDB,
+                                         const CheckpointFact &Fact,
+                                         const llvm::Value *ZeroValue);
+
+/// Writes the checkpoint of an IDESolver on LLVM IR incrementally.
+///
+/// The solver adds the seeds, jump functions, end summaries and incoming
+/// edges as it computes them, which are encoded into a buffer right away.
+/// commit() completes the buffer with the changes to the pending path edges
+/// since the previous commit and hands it to a background thread that
+/// appends it to the checkpoint, so that each commit only writes what has
+/// changed since the previous one and the solver only waits for the I/O if
+/// the previous commit has not been written yet.
+///
+/// Each commit is stored as a segment with its size and checksum, such that
+/// SolverCheckpoint::read() recovers the state of the last commit that has
+/// been written completely.
+class SolverCheckpointWriter {
+public:
+  /// Creates or truncates the checkpoint at Path. ZeroValue is the solver's
+  /// zero value. Throws std::ios_base::failure if the checkpoint cannot be
+  /// written.
+  SolverCheckpointWriter(std::string Path, const std::string &AnalysisID,
+                         uint64_t IRFingerprint, const llvm::Value *ZeroValue);
+
+  /// Continues the checkpoint CP that has been read from Path, where
+  /// FactValues holds the values of CP's facts. Whatever follows the last
+  /// commit of CP in the file is discarded. Throws std::ios_base::failure if
+  /// the checkpoint cannot be written.
+  SolverCheckpointWriter(std::string Path, const SolverCheckpoint &CP,
+                         const std::vector<const llvm::Value *> &FactValues,
+                         const llvm::Value *ZeroValue);
+
+  /// Waits until the last commit has been written.
+  ~SolverCheckpointWriter();
+
+  SolverCheckpointWriter(const SolverCheckpointWriter &) = delete;
+  SolverCheckpointWriter &operator=(const SolverCheckpointWriter &) = delete;
+  SolverCheckpointWriter(SolverCheckpointWriter &&) = delete;
+  SolverCheckpointWriter &operator=(SolverCheckpointWriter &&) = delete;
+
+  // The following functions return false if a node, fact or edge function
+  // cannot be represented in the checkpoint, e.g., a constant fact or an
+  // empty label, in which case nothing is recorded.
+
+  bool addSeed(const llvm::Instruction *N, const llvm::Value *D);
+  bool addJumpFunction(const llvm::Value *SourceFact,
+                       const llvm::Instruction *Target,
+                       const llvm::Value *TargetFact,
+                       const std::string &Label);
+  bool addEndSummary(const llvm::Instruction *StartPoint,
+                     const llvm::Value *StartFact,
+                     const llvm::Instruction *ExitPoint,
+                     const llvm::Value *ExitFact, const std::string &Label);
+  bool addIncoming(const llvm::Instruction *StartPoint,
+                   const llvm::Value *StartFact,
+                   const llvm::Instruction *CallSite,
+                   const llvm::Value *CallSiteFact);
+  bool addUnbalancedReturnSite(const llvm::Instruction *N);
+  /// Adds a path edge that is pending at the upcoming commit.
+  bool addPendingPathEdge(const llvm::Value *SourceFact,
+                          const llvm::Instruction *Target,
+                          const llvm::Value *TargetFact);
+
+  /// Commits the records added since the previous commit, with the path
+  /// edges added by addPendingPathEdge() as the pending ones. Only the path
+  /// edges that have become pending or are no longer pending since the
+  /// previous commit are written; the ones that are still pending keep their
+  /// place in the worklist. Returns false if a previous commit could not be
+  /// written, see getError().
+  bool commit(uint64_t NumPathEdges);
+
+  /// Waits until the last commit has been written and returns false if it
+  /// could not be written.
+  bool flush();
+
+  [[nodiscard]] const std::string &getPath() const { return Path; }
+  [[nodiscard]] uint64_t getNumCommits() const { return NumCommits; }
+  [[nodiscard]] std::string getError();
+
+private:
+  void writeSegments();
+  std::optional<uint32_t> getFactID(const llvm::Value *D);
+  std::optional<uint32_t> getLabelID(const std::string &Label);
+
+  std::string Path;
+  const llvm::Value *ZeroValue;
+  std::unordered_map<const llvm::Value *, uint32_t> FactIDs;
+  std::unordered_map<std::string, uint32_t> LabelIDs;
+  // the records since the previous commit
+  std::string Records;
+  // the IDs of the source fact, target node and target fact of the path edges
+  // pending at the previous commit and of the ones added for the next commit
+  using PathEdgeKey = std::tuple<uint32_t, uint64_t, uint32_t>;
+  std::set<PathEdgeKey> CommittedPathEdges;
+  std::vector<PathEdgeKey> PendingPathEdges;
+  uint64_t NumCommits = 0;
+
+  // the segment handed to the background thread, which owns File, if any
+  std::ofstream File;
+  std::thread Writer;
+  std::mutex Mutex;
+  std::condition_variable Changed;
+  std::optional<std::string> Segment;
+  bool Stop = false;
+  std::string Error;
+};
+
+/// Checkpoints the construction of the exploded super-graph (Phase I) of an
+/// IDESolver on LLVM IR and restores it, see
+/// IFDSIDESolverConfig::setCheckpointFile() and
+/// IFDSIDESolverConfig::setResumeFromCheckpoint().
+///
+/// The solver records the changes of its state as it makes them, and commits
+/// them along with its pending path edges whenever isDue(). The checkpointer
+/// stops, reporting on std::cerr, as soon as a change cannot be represented
+/// in the checkpoint or the checkpoint cannot be written, while the solver
+/// carries on without it.
+template <typename EdgeFunctionPtrType> class SolverCheckpointer {
+public:
+  using n_t = const llvm::Instruction *;
+  using d_t = const llvm::Value *;
+  using ToLabelFn = std::function<std::string(const EdgeFunctionPtrType &)>;
+  using FromLabelFn = std::function<EdgeFunctionPtrType(const std::string &)>;
+
+  /// The state of Phase I that resume() has restored, in the order in which
+  /// it has been recorded.
+  struct State {
+    std::vector<std::tuple<d_t, n_t, d_t, EdgeFunctionPtrType>> JumpFunctions;
+    std::vector<std::tuple<n_t, d_t, n_t, d_t, EdgeFunctionPtrType>>
+        EndSummaries;
+    std::vector<std::tuple<n_t, d_t, n_t, d_t>> Incomings;
+    std::vector<n_t> UnbalancedReturnSites;
+    std::vector<std::tuple<d_t, n_t, d_t>> Worklist;
+    uint64_t NumPathEdges = 0;
+  };
+
+  /// Checkpoints to Path and commits every Interval seconds. ToLabel and
+  /// FromLabel convert the edge functions to their strings and back, see
+  /// IDETabulationProblem::edgeFunctionToSummaryString().
+  SolverCheckpointer(std::string Path, unsigned Interval,
+                     std::string AnalysisID, const ProjectIRDB &IRDB,
+                     d_t ZeroValue, ToLabelFn ToLabel, FromLabelFn FromLabel)
+      : Path(std::move(Path)), Interval(Interval),
+        AnalysisID(std::move(AnalysisID)), IRDB(IRDB), ZeroValue(ZeroValue),
+        ToLabel(std::move(ToLabel)), FromLabel(std::move(FromLabel)) {}
+
+  /// Starts a new checkpoint, replacing the one at the path, if any.
+  void start() {
+    try {
+      Writer = std::make_unique<SolverCheckpointWriter>(
+          Path, AnalysisID, getIRFingerprint(IRDB), ZeroValue);
+    } catch (const std::ios_base::failure &E) {
+      std::cerr << "Could not start the solver checkpoint: " << E.what()
+                << '\n';
+    }
+    LastCommit = std::chrono::steady_clock::now();
+  }
+
+  /// Restores the state of Phase I from the checkpoint at the path and
+  /// continues the checkpoint. Returns std::nullopt, reporting on std::cerr,
+  /// if the checkpoint cannot be resumed, e.g., because it has been written
+  /// by another analysis, for other IR or for initial seeds other than
+  /// SeedNodes.
+  std::optional<State> resume(const std::set<std::pair<n_t, d_t>> &SeedNodes) {
+    SolverCheckpoint CP;
+    try {
+      CP = SolverCheckpoint::read(Path);
+    } catch (const std::ios_base::failure &E) {
+      std::cerr << "Could not resume from the solver checkpoint: " << E.what()
+                << '\n';
+      return std::nullopt;
+    }
+    auto Reject = [this](const char *Reason) {
+      std::cerr << "Could not resume from the solver checkpoint " << Path
+                << ": " << Reason << '\n';
+      return std::nullopt;
+    };
+    if (CP.NumCommits == 0) {
+      return Reject("nothing has been committed");
+    }
+    if (CP.AnalysisID != AnalysisID ||
+        CP.IRFingerprint != getIRFingerprint(IRDB)) {
+      return Reject("it belongs to another analysis or other IR");
+    }
+    std::vector<d_t> Facts;
+    Facts.reserve(CP.Facts.size());
+    for (const auto &Fact : CP.Facts) {
+      Facts.push_back(resolveCheckpointFact(IRDB, Fact, ZeroValue));
+      if (!Facts.back()) {
+        return Reject("a data-flow fact does not exist");
+      }
+    }
+    std::vector<EdgeFunctionPtrType> Labels;
+    Labels.reserve(CP.Labels.size());
+    for (const auto &Label : CP.Labels) {
+      Labels.push_back(FromLabel(Label));
+      if (!Labels.back()) {
+        return Reject("an edge function cannot be restored");
+      }
+    }
+    bool NodesExist = true;
+    auto Node = [this, &NodesExist](uint64_t ID) {
+      n_t N = IRDB.getInstruction(ID);
+      NodesExist &= N != nullptr;
+      return N;
+    };
+    std::set<std::pair<n_t, d_t>> CheckpointSeedNodes;
+    for (const auto &[StartPoint, Fact] : CP.Seeds) {
+      CheckpointSeedNodes.emplace(Node(StartPoint), Facts[Fact]);
+    }
+    if (SeedNodes != CheckpointSeedNodes) {
+      return Reject("it has been written for other initial seeds");
+    }
+    State S;
+    for (const auto &JF : CP.JumpFunctions) {
+      S.JumpFunctions.emplace_back(Facts[JF.SourceFact], Node(JF.Target),
+                                   Facts[JF.TargetFact], Labels[JF.Label]);
+    }
+    for (const auto &ES : CP.EndSummaries) {
+      S.EndSummaries.emplace_back(Node(ES.StartPoint), Facts[ES.StartFact],
+                                  Node(ES.ExitPoint), Facts[ES.ExitFact],
+                                  Labels[ES.Label]);
+    }
+    for (const auto &Inc : CP.Incomings) {
+      S.Incomings.emplace_back(Node(Inc.StartPoint), Facts[Inc.StartFact],
+                               Node(Inc.CallSite), Facts[Inc.CallSiteFact]);
+    }
+    for (uint64_t RetSite : CP.UnbalancedReturnSites) {
+      S.UnbalancedReturnSites.push_back(Node(RetSite));
+    }
+    for (const auto &Edge : CP.Worklist) {
+      S.Worklist.emplace_back(Facts[Edge.SourceFact], Node(Edge.Target),
+                              Facts[Edge.TargetFact]);
+    }
+    if (!NodesExist) {
+      return Reject("an instruction does not exist");
+    }
+    S.NumPathEdges = CP.NumPathEdges;
+    LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), INFO)
+                  << "Resume from the checkpoint " << Path << " after "
+                  << CP.NumPathEdges << " path edges with "
+                  << CP.Worklist.size() << " pending path edges");
+    try {
+      Writer =
+          std::make_unique<SolverCheckpointWriter>(Path, CP, Facts, ZeroValue);
+    } catch (const std::ios_base::failure &E) {
+      std::cerr << "Could not continue the solver checkpoint: " << E.what()
+                << '\n';
+    }
+    LastCommit = std::chrono::steady_clock::now();
+    return S;
+  }
+
+  /// Returns false if the checkpointer has not been started or has stopped.
+  [[nodiscard]] bool isActive() const { return Writer != nullptr; }
+
+  void addSeed(n_t StartPoint, d_t Fact) {
+    record([&] { return Writer->addSeed(StartPoint, Fact); });
+  }
+
+  void addJumpFunction(d_t SourceFact, n_t Target, d_t TargetFact,
+                       const EdgeFunctionPtrType &F) {
+    record([&] {
+      return Writer->addJumpFunction(SourceFact, Target, TargetFact,
+                                     ToLabel(F));
+    });
+  }
+
+  void addEndSummary(n_t StartPoint, d_t StartFact, n_t ExitPoint,
+                     d_t ExitFact, const EdgeFunctionPtrType &F) {
+    record([&] {
+      return Writer->addEndSummary(StartPoint, StartFact, ExitPoint, ExitFact,
+                                   ToLabel(F));
+    });
+  }
+
+  void addIncoming(n_t StartPoint, d_t StartFact, n_t CallSite,
+                   d_t CallSiteFact) {
+    record([&] {
+      return Writer->addIncoming(StartPoint, StartFact, CallSite,
+                                 CallSiteFact);
+    });
+  }
+
+  void addUnbalancedReturnSite(n_t RetSite) {
+    record([&] { return Writer->addUnbalancedReturnSite(RetSite); });
+  }
+
+  /// Returns true if the interval has passed since the last commit. Only
+  /// reads the clock every 1024 path edges.
+  [[nodiscard]] bool isDue(uint64_t NumPathEdges) const {
+    return Writer && NumPathEdges % 1024 == 0 &&
+           std::chrono::steady_clock::now() - LastCommit >=
+               std::chrono::seconds(Interval);
+  }
+
+  /// Commits the changes recorded since the previous commit along with the
+  /// path edges pending in Worklist, see PathEdgeWorklist::foreachPending(),
+  /// after NumPathEdges path edges have been processed.
+  template <typename WorklistTy>
+  void commit(const WorklistTy &Worklist, uint64_t NumPathEdges) {
+    if (!Writer) {
+      return;
+    }
+    Worklist.foreachPending([this](d_t Source, n_t Target, d_t TargetFact) {
+      record([&] {
+        return Writer->addPendingPathEdge(Source, Target, TargetFact);
+      });
+    });
+    if (Writer && !Writer->commit(NumPathEdges)) {
+      std::cerr << "Stop writing the solver checkpoint: " << Writer->getError()
+                << '\n';
+      Writer.reset();
+    }
+    LastCommit = std::chrono::steady_clock::now();
+  }
+
+  /// Commits like commit() and stops, waiting until the checkpoint has been
+  /// written.
+  template <typename WorklistTy>
+  void finish(const WorklistTy &Worklist, uint64_t NumPathEdges) {
+    commit(Worklist, NumPathEdges);
+    Writer.reset();
+  }
+
+private:
+  /// Stops if Record() returns false, i.e., if the change cannot be
+  /// represented in the checkpoint.
+  template <typename RecordFn> void record(RecordFn Record) {
+    if (Writer && !Record()) {
+      std::cerr << "Stop writing the solver checkpoint " << Path
+                << ": the solver's state cannot be represented in it\n";
+      Writer.reset();
+    }
+  }
+
+  std::string Path;
+  unsigned Interval;
+  std::string AnalysisID;
+  const ProjectIRDB &IRDB;
+  d_t ZeroValue;
+  ToLabelFn ToLabel;
+  FromLabelFn FromLabel;
+  // nullptr before start() or resume() and once the checkpointer stops
+  std::unique_ptr<SolverCheckpointWriter> Writer;
+  std::chrono::steady_clock::time_point LastCommit;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERPROFILE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SOLVERPROFILE_H_
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace psr {
+
+/// The work of the IDESolver that is attributed to a function or call site.
+struct SolverProfileCounters {
+  // the number of path edges processed
+  uint64_t PathEdges = 0;
+  // the number of flow functions applied and the sizes of their target sets
+  uint64_t FlowFunctionApplications = 0;
+  uint64_t Facts = 0;
+  uint64_t MaxFacts = 0;
+  // the number of edge function compositions
+  uint64_t Compositions = 0;
+  // the wall time spent processing the path edges
+  std::chrono::nanoseconds Time{0};
+
+  void addTargets(size_t NumFacts) {
+    ++FlowFunctionApplications;
+    Facts += NumFacts;
+    MaxFacts = std::max<uint64_t>(MaxFacts, NumFacts);
+  }
+
+  SolverProfileCounters &operator+=(const SolverProfileCounters &Other);
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+};
+
+/// A profile of the exploded super-graph construction of a solver run that
+/// tells which functions and call sites the solver spent its work on.
+///
+/// A path edge is attributed to the function that contains its target and,
+/// if the target is a call site, to that call site. The counters of a function
+/// hence include the ones of its call sites. Processing a call site comprises
+/// applying the summaries of its callees and the call-to-return flow, whereas
+/// the work within the callees is attributed to the callees themselves.
+struct SolverProfile {
+  struct CallSite {
+    std::string StmtId;
+    std::string Label;
+    SolverProfileCounters Counters;
+  };
+
+  struct Function {
+    std::string Name;
+    SolverProfileCounters Counters;
+    std::vector<CallSite> CallSites;
+  };
+
+  // sorted by decreasing time
+  std::vector<Function> Functions;
+
+  /// Sorts the functions and their call sites by decreasing time.
+  void sort();
+
+  [[nodiscard]] nlohmann::json getAsJson() const;
+
+  /// Prints the profile in the collapsed stack format that flame graph tools
+  /// read, i.e., one line "function;call site <time>" per call site and one
+  /// line "function <time>" for the remaining time of each function. Times
+  /// are given in microseconds.
+  void printAsCollapsedStacks(std::ostream &OS) const;
+
+  /// Writes the profile as JSON to Path and as collapsed stacks to
+  /// Path.folded. Throws std::ios_base::failure if a file cannot be written.
+  void write(const std::string &Path) const;
+};
+
+/// Collects the profile of a solver run keyed by the solver's functions and
+/// call sites. The profiler is not synchronized.
+template <typename N, typename F> class SolverProfiler {
+public:
+  /// Attributes the counters of a path edge to the function Fun and, if the
+  /// edge's target is a call site, to CallSite.
+  void add(F Fun, std::optional<N> CallSite,
+           const SolverProfileCounters &Counters) {
+    Functions[Fun] += Counters;
+    if (CallSite) {
+      auto &[Caller, CallSiteCounters] = CallSites[*CallSite];
+      Caller = Fun;
+      CallSiteCounters += Counters;
+    }
+  }
+
+  /// Returns the profile using FunctionName(f) to name functions and
+  /// CallSiteName(n) to obtain the statement ID and label of call sites.
+  template <typename FunctionNameFn, typename CallSiteNameFn>
+  [[nodiscard]] SolverProfile getProfile(FunctionNameFn FunctionName,
+                                         CallSiteNameFn CallSiteName) const {
+    SolverProfile Profile;
+    std::unordered_map<F, size_t> Index;
+    for (const auto &[Fun, Counters] : Functions) {
+      Index.emplace(Fun, Profile.Functions.size());
+      Profile.Functions.push_back({FunctionName(Fun), Counters, {}});
+    }
+    for (const auto &[Site, Entry] : CallSites) {
+      auto [StmtId, Label] = CallSiteName(Site);
+      Profile.Functions[Index.at(Entry.first)].CallSites.push_back(
+          {std::move(StmtId), std::move(Label), Entry.second});
+    }
+    Profile.sort();
+    return Profile;
+  }
+
+private:
+  std::unordered_map<F, SolverProfileCounters> Functions;
+  std::unordered_map<N, std::pair<F, SolverProfileCounters>> CallSites;
+};
+
+} // namespace psr
+
+#endif
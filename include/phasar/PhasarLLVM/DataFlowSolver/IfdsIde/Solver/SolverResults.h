@@ -20,38 +20,63 @@
 #include <set>
 #include <type_traits>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ResultsView.h"
 #include "phasar/PhasarLLVM/Utils/BinaryDomain.h"
+#include "phasar/Utils/FlatTable.h"
 #include "phasar/Utils/Table.h"
 
 namespace psr {
 
+/// Gives access to the results of a solver, which are either stored in a
+/// Table or in a FlatTable.
 template <typename N, typename D, typename L> class SolverResults {
 private:
-  Table<N, D, L> &results;
+  std::variant<Table<N, D, L> *, FlatTable<N, D, L> *> results;
   D zeroValue;
+  bool Complete;
 
 public:
-  SolverResults(Table<N, D, L> &res_tab, D zv)
-      : results(res_tab), zeroValue(zv) {}
+  SolverResults(Table<N, D, L> &res_tab, D zv, bool Complete = true)
+      : results(&res_tab), zeroValue(zv), Complete(Complete) {}
 
-  L resultAt(N stmt, D node) const { return results.get(stmt, node); }
+  SolverResults(FlatTable<N, D, L> &res_tab, D zv, bool Complete = true)
+      : results(&res_tab), zeroValue(zv), Complete(Complete) {}
+
+  /// Returns false if the solver stopped before reaching its fixpoint, e.g.,
+  /// because its budget was exhausted, such that results may be missing.
+  [[nodiscard]] bool isComplete() const { return Complete; }
+
+  L resultAt(N stmt, D node) const {
+    return std::visit(
+        [&](const auto *Tab) -> L { return Tab->get(stmt, node); }, results);
+  }
 
   std::unordered_map<D, L> resultsAt(N stmt, bool stripZero = false) const {
-    std::unordered_map<D, L> result = results.row(stmt);
-    if (stripZero) {
-      for (auto it = result.begin(); it != result.end();) {
-        if (it->first == zeroValue) {
-          it = result.erase(it);
-        } else {
-          ++it;
-        }
-      }
-    }
+    std::unordered_map<D, L> result;
+    foreachResultAt(
+        stmt,
+        [&](const D &Fact, const L &Value) { result.emplace(Fact, Value); },
+        stripZero);
     return result;
   }
 
+  /// Calls Fn(fact, value) for all results at the given statement without
+  /// copying them.
+  template <typename FnTy>
+  void foreachResultAt(N stmt, FnTy Fn, bool stripZero = false) const {
+    std::visit(
+        [&](const auto *Tab) {
+          for (const auto &[Fact, Value] :
+               makeResultsView(Tab->row(stmt), zeroValue, stripZero)) {
+            Fn(Fact, Value);
+          }
+        },
+        results);
+  }
+
   // this function only exists for IFDS problems which use BinaryDomain as their
   // value domain L
   template <typename ValueDomain = L,
@@ -59,15 +84,16 @@ public:
                 std::is_same_v<ValueDomain, BinaryDomain>>>
   std::set<D> ifdsResultsAt(N stmt) const {
     std::set<D> KeySet;
-    std::unordered_map<D, BinaryDomain> ResultMap = this->resultsAt(stmt);
-    for (auto FlowFact : ResultMap) {
-      KeySet.insert(FlowFact.first);
-    }
+    foreachResultAt(stmt,
+                    [&](const D &Fact, const L & /*Value*/) {
+                      KeySet.insert(Fact);
+                    });
     return KeySet;
   }
 
   std::vector<typename Table<N, D, L>::Cell> getAllResultEntries() const {
-    return results.cellVec();
+    return std::visit([](const auto *Tab) { return Tab->cellVec(); },
+                      results);
   }
 };
 
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SUMMARYSTORE_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_SUMMARYSTORE_H_
+
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include "nlohmann/json.hpp"
+
+namespace llvm {
+class Function;
+class Instruction;
+class Value;
+} // namespace llvm
+
+namespace psr {
+
+/// Returns a hash of F's signature and instructions that does not depend on
+/// the module F is contained in, i.e., on the names of its local values or
+/// on metadata IDs. Functions and globals are referred to by their names.
+std::string getFunctionContentHash(const llvm::Function *F);
+
+/// Returns the functions outside of Functions that use any of the mutable
+/// global variables used within Functions. They affect the points-to
+/// information within Functions, since the points-to sets of a global's uses
+/// are merged across functions.
+std::set<const llvm::Function *>
+getGlobalCoupledFunctions(const std::set<const llvm::Function *> &Functions);
+
+/// Identifies the values that a function's persisted summaries refer to
+/// independently of the module: F's n-th argument as "a<n>", F's n-th
+/// instruction as "i<n>" and named globals as "@<name>".
+class FunctionLocalIDs {
+public:
+  explicit FunctionLocalIDs(const llvm::Function *F);
+
+  /// Returns V's ID or std::nullopt if V has none, e.g., if V is a constant or
+  /// a value of another function.
+  [[nodiscard]] std::optional<std::string> getID(const llvm::Value *V) const;
+
+  /// Returns the value with the given ID or nullptr if there is none.
+  [[nodiscard]] const llvm::Value *getValue(llvm::StringRef ID) const;
+
+private:
+  const llvm::Function *F;
+  std::vector<const llvm::Instruction *> Insts;
+  llvm::DenseMap<const llvm::Instruction *, unsigned> InstIndices;
+};
+
+/// A directory of persisted procedure summaries, one JSON file per key.
+/// Entries are replaced atomically, such that concurrent analysis runs may
+/// share a store.
+///
+/// A store may also be kept in memory only, in which case it is shared by
+/// the solvers of a single analysis run on the same IR, e.g., the shards of
+/// a ShardedAnalysis.
+class SummaryStore {
+public:
+  /// Creates a store that keeps its entries in memory.
+  SummaryStore() = default;
+
+  /// Opens the store in Directory, creating the directory if necessary.
+  /// Throws std::ios_base::failure if the directory cannot be created.
+  explicit SummaryStore(std::string Directory);
+
+  /// Returns the key of the summaries of a function for the given analysis
+  /// ID and the content hashes of the function and of all functions that it
+  /// may call transitively.
+  [[nodiscard]] static std::string
+  getKey(llvm::StringRef AnalysisID, std::vector<std::string> ContentHashes);
+
+  /// Returns the summaries stored under Key or std::nullopt if there are
+  /// none or they cannot be read.
+  [[nodiscard]] std::optional<nlohmann::json>
+  load(const std::string &Key) const;
+
+  /// Stores the summaries under Key. Throws std::ios_base::failure if they
+  /// cannot be written.
+  void store(const std::string &Key, const nlohmann::json &Summaries) const;
+
+  [[nodiscard]] const std::string &getDirectory() const { return Directory; }
+
+  /// Returns true if the store keeps its entries in memory. Its entries then
+  /// only have to tell apart the functions of the IR at hand.
+  [[nodiscard]] bool isInMemory() const { return Directory.empty(); }
+
+private:
+  [[nodiscard]] std::string getPath(const std::string &Key) const;
+
+  std::string Directory;
+  // the entries of a store that is kept in memory, which are modified by
+  // store() just like the files of a directory
+  mutable std::mutex EntriesMutex;
+  mutable std::unordered_map<std::string, nlohmann::json> Entries;
+};
+
+} // namespace psr
+
+#endif
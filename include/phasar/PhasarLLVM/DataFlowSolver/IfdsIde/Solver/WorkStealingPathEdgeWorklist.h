@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_PHASARLLVM_IFDSIDE_SOLVER_WORKSTEALINGPATHEDGEWORKLIST_H_
+#define PHASAR_PHASARLLVM_IFDSIDE_SOLVER_WORKSTEALINGPATHEDGEWORKLIST_H_
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/PathEdge.h"
+
+namespace psr {
+
+/// Distributes the path edges of a multi-threaded tabulation (Phase I) among a
+/// fixed number of workers. Each worker owns a deque: edges that a worker
+/// produces are pushed to and taken from the back of its own deque, and idle
+/// workers steal from the front of the other workers' deques.
+///
+/// The worklist counts the edges that have been pushed but not yet reported as
+/// processed via done(). As a worker pushes all successors of an edge before
+/// reporting that edge as processed, the tabulation has reached its fixpoint
+/// as soon as this count drops to zero.
+template <typename N, typename D> class WorkStealingPathEdgeWorklist {
+public:
+  explicit WorkStealingPathEdgeWorklist(size_t NumWorkers) {
+    Shards.reserve(NumWorkers);
+    for (size_t Idx = 0; Idx < NumWorkers; ++Idx) {
+      Shards.push_back(std::make_unique<Shard>());
+    }
+  }
+
+  ~WorkStealingPathEdgeWorklist() = default;
+
+  WorkStealingPathEdgeWorklist(const WorkStealingPathEdgeWorklist &) = delete;
+  WorkStealingPathEdgeWorklist &
+  operator=(const WorkStealingPathEdgeWorklist &) = delete;
+  WorkStealingPathEdgeWorklist(WorkStealingPathEdgeWorklist &&) = delete;
+  WorkStealingPathEdgeWorklist &
+  operator=(WorkStealingPathEdgeWorklist &&) = delete;
+
+  /// Binds the calling thread to the given worker, i.e. the shard that
+  /// receives the edges pushed by this thread.
+  static void setCurrentWorker(size_t WorkerId) { currentWorker() = WorkerId; }
+
+  /// Schedules the given path edge on the calling thread's shard.
+  void push(const PathEdge<N, D> &Edge) {
+    pushTo(currentWorker() % Shards.size(), Edge);
+  }
+
+  /// Schedules the given path edge on the shard of the given worker.
+  void pushTo(size_t WorkerId, const PathEdge<N, D> &Edge) {
+    Outstanding.fetch_add(1, std::memory_order_relaxed);
+    auto &S = *Shards[WorkerId];
+    std::lock_guard<std::mutex> Lock(S.M);
+    S.Queue.push_back(Edge);
+  }
+
+  /// Hands out the next edge for the calling worker: the most recently pushed
+  /// edge of its own shard, or, if that is empty, the oldest edge of another
+  /// worker's shard. Returns std::nullopt if no edge is available right now.
+  std::optional<PathEdge<N, D>> tryPop() {
+    size_t Self = currentWorker() % Shards.size();
+    {
+      auto &S = *Shards[Self];
+      std::lock_guard<std::mutex> Lock(S.M);
+      if (!S.Queue.empty()) {
+        std::optional<PathEdge<N, D>> Edge(S.Queue.back());
+        S.Queue.pop_back();
+        return Edge;
+      }
+    }
+    for (size_t Offset = 1; Offset < Shards.size(); ++Offset) {
+      auto &S = *Shards[(Self + Offset) % Shards.size()];
+      std::lock_guard<std::mutex> Lock(S.M);
+      if (!S.Queue.empty()) {
+        std::optional<PathEdge<N, D>> Edge(S.Queue.front());
+        S.Queue.pop_front();
+        Steals.fetch_add(1, std::memory_order_relaxed);
+        return Edge;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// Reports that an edge obtained from tryPop() has been processed
+  /// completely, including the scheduling of all of its successors.
+  void done() { Outstanding.fetch_sub(1, std::memory_order_acq_rel); }
+
+  /// Returns true if all edges that have ever been pushed are processed.
+  [[nodiscard]] bool finished() const {
+    return Outstanding.load(std::memory_order_acquire) == 0;
+  }
+
+  [[nodiscard]] size_t getNumWorkers() const { return Shards.size(); }
+
+  /// Returns the number of edges that have been taken from a foreign shard.
+  [[nodiscard]] size_t getNumSteals() const {
+    return Steals.load(std::memory_order_relaxed);
+  }
+
+private:
+  struct Shard {
+    std::mutex M;
+    std::deque<PathEdge<N, D>> Queue;
+  };
+
+  static size_t &currentWorker() {
+    static thread_local size_t WorkerId = 0;
+    return WorkerId;
+  }
+
+  std::vector<std::unique_ptr<Shard>> Shards;
+  std::atomic<size_t> Outstanding{0};
+  std::atomic<size_t> Steals{0};
+};
+
+} // namespace psr
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <deque>
 #include <iostream>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -27,6 +28,8 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Contexts/CallStringCTX.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/InterMonoProblem.h"
 #include "phasar/Utils/LLVMShorthands.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/SolverBudget.h"
 
 namespace psr {
 
@@ -49,6 +52,9 @@ protected:
       Analysis;
   std::unordered_set<f_t> AddedFunctions;
   const i_t *ICF;
+  SolverBudget Budget;
+  // tracks Budget while solving, nullptr if the budget is unlimited
+  std::unique_ptr<BudgetMonitor> Monitor;
 
   void initialize() {
     for (auto &[Node, FlowFacts] : IMProblem.initialSeeds()) {
@@ -158,7 +164,8 @@ protected:
 
 public:
   InterMonoSolver(InterMonoProblem<AnalysisDomainTy> &IMP)
-      : IMProblem(IMP), ICF(IMP.getICFG()) {}
+      : IMProblem(IMP), ICF(IMP.getICFG()),
+        Budget(SolverBudget::fromPhasarConfig()) {}
 
   InterMonoSolver(const InterMonoSolver &) = delete;
 
@@ -170,6 +177,16 @@ public:
 
   virtual ~InterMonoSolver() = default;
 
+  /// Bounds the time, memory and number of worklist items that solve() may
+  /// use. If the budget is exhausted, solve() stops with the data-flow facts
+  /// computed so far, which may lack facts, see isComplete().
+  void setBudget(SolverBudget B) { Budget = std::move(B); }
+
+  /// Returns false if solve() stopped because its budget was exhausted.
+  [[nodiscard]] bool isComplete() const {
+    return !Monitor || !Monitor->isExhausted();
+  }
+
   std::unordered_map<
       n_t, std::unordered_map<CallStringCTX<n_t, K>, mono_container_t>>
   getAnalysis() {
@@ -355,8 +372,20 @@ public:
   }
 
   virtual void solve() {
+    if (!Budget.isUnlimited()) {
+      Monitor = std::make_unique<BudgetMonitor>(Budget);
+    }
     initialize();
     while (!Worklist.empty()) {
+      if (Monitor && Monitor->step()) {
+        LOG_IF_ENABLE(BOOST_LOG_SEV(lg::get(), WARNING)
+                      << "Stopped the inter-monotone solver after "
+                      << Monitor->getNumWorkItems() << " worklist items ("
+                      << Monitor->exhaustion()
+                      << "), the results are incomplete");
+        Worklist.clear();
+        break;
+      }
       std::pair<n_t, n_t> Edge = Worklist.front();
       Worklist.pop_front();
       auto Src = Edge.first;
@@ -398,6 +427,10 @@ public:
 
   virtual void dumpResults(std::ostream &OS = std::cout) {
     OS << "======= DUMP LLVM-INTER-MONOTONE-SOLVER RESULTS =======\n";
+    if (!isComplete()) {
+      OS << "Results are incomplete, the solver's budget was exhausted ("
+         << Monitor->exhaustion() << ")\n";
+    }
     for (auto &[Node, ContextMap] : this->Analysis) {
       OS << "Instruction:\n" << this->IMProblem.NtoString(Node);
       OS << "\nFacts:\n";
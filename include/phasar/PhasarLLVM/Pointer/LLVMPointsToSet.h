@@ -12,6 +12,7 @@
 
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
@@ -45,6 +46,13 @@ private:
   LLVMBasedPointsToAnalysis PTA;
   std::unordered_set<const llvm::Function *> AnalyzedFunctions;
   PointsToSetMap PointsToSets;
+  bool ThreadSafe = false;
+  mutable std::mutex Mutex;
+
+  [[nodiscard]] std::unique_lock<std::mutex> lockIfThreadSafe() const {
+    return ThreadSafe ? std::unique_lock<std::mutex>(Mutex)
+                      : std::unique_lock<std::mutex>();
+  }
 
   void computeValuesPointsToSet(const llvm::Value *V);
 
@@ -113,6 +121,15 @@ public:
 
   [[nodiscard]] inline bool empty() const { return AnalyzedFunctions.empty(); }
 
+  /// If set, queries may be issued from multiple threads concurrently. The
+  /// queries are then serialized. Note that the points-to sets handed out
+  /// are shared with the ones that are still being computed: for them to
+  /// stay unchanged, the points-to information must have been computed
+  /// eagerly (UseLazyEvaluation = false) and no aliases may be introduced.
+  void setThreadSafe(bool Set = true) { ThreadSafe = Set; }
+
+  [[nodiscard]] bool isThreadSafe() const { return ThreadSafe; }
+
   void print(std::ostream &OS = std::cout) const override;
 
   [[nodiscard]] nlohmann::json getAsJson() const override;
@@ -12,6 +12,7 @@
 
 #include "llvm/Support/ErrorHandling.h"
 
+#include <functional>
 #include <iostream>
 #include <variant>
 
@@ -103,4 +104,17 @@ inline bool operator<(const LatticeDomain<L> &Lhs,
 
 } // namespace psr
 
+namespace std {
+// Lattice elements are used as keys of hash-based containers, e.g., by the
+// EdgeFunctionSingletonFactory, which requires std::variant<L, Top, Bottom> to
+// be hashable.
+template <> struct hash<psr::Top> {
+  size_t operator()(const psr::Top & /*T*/) const noexcept { return 0; }
+};
+
+template <> struct hash<psr::Bottom> {
+  size_t operator()(const psr::Bottom & /*B*/) const noexcept { return 1; }
+};
+} // namespace std
+
 #endif
@@ -10,9 +10,12 @@
 #ifndef PHASAR_PHASARLLVM_UTILS_SUMMARYSTRATEGY_H_
 #define PHASAR_PHASARLLVM_UTILS_SUMMARYSTRATEGY_H_
 
+#include <cstddef>
 #include <iosfwd>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace psr {
 
@@ -32,6 +35,18 @@ extern const std::map<std::string, SummaryGenerationStrategy>
 
 std::ostream &operator<<(std::ostream &os, const SummaryGenerationStrategy &s);
 
+/// The maximal number of inputs for which the powerset strategy enumerates all
+/// calling contexts; functions with more inputs are summarized for all and
+/// none of their inputs instead.
+static constexpr size_t MaxPowersetSummaryInputs = 10;
+
+/// Returns the calling contexts that a summary generator should compute
+/// summaries for, as bit patterns over a function's NumInputs inputs. For
+/// all_observed, these are the given observed contexts of matching length.
+std::set<std::vector<bool>>
+getSummaryContexts(SummaryGenerationStrategy Strategy, size_t NumInputs,
+                   const std::set<std::vector<bool>> &Observed = {});
+
 } // namespace psr
 
 #endif
@@ -12,12 +12,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <initializer_list>
 
 #include "boost/bimap.hpp"
 #include "boost/bimap/unordered_set_of.hpp"
 
 #include "llvm/ADT/BitVector.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/Support/Compiler.h"
 
 namespace psr {
@@ -239,6 +241,17 @@ public:
 
   [[nodiscard]] bool empty() const noexcept { return Bits.none(); }
 
+  /// Returns a hash value that is consistent with operator==, i.e., that only
+  /// depends on the elements of the set and not on the size of the underlying
+  /// bit vector.
+  [[nodiscard]] size_t hash() const noexcept {
+    size_t Hash = 0;
+    for (int Idx = Bits.find_first(); Idx != -1; Idx = Bits.find_next(Idx)) {
+      Hash = llvm::hash_combine(Hash, Idx);
+    }
+    return Hash;
+  }
+
   void reserve(size_t NewCap) { Bits.reserve(NewCap); }
 
   [[nodiscard]] bool find(const T &Data) const noexcept { return count(Data); }
@@ -318,4 +331,12 @@ public:
 
 } // namespace psr
 
+namespace std {
+template <typename T> struct hash<psr::BitVectorSet<T>> {
+  size_t operator()(const psr::BitVectorSet<T> &BVS) const noexcept {
+    return BVS.hash();
+  }
+};
+} // namespace std
+
 #endif
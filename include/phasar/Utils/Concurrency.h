@@ -0,0 +1,78 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_CONCURRENCY_H_
+#define PHASAR_UTILS_CONCURRENCY_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "phasar/Utils/PAMMMacros.h"
+
+namespace psr {
+
+/// Returns the number of threads that may run work measured by PAMM, e.g.,
+/// the solvers, when NumThreads threads are requested. PAMM's timers,
+/// counters and histograms are not synchronized, so such work runs on a
+/// single thread if PAMM is enabled.
+constexpr unsigned getNumPAMMSafeThreads(unsigned NumThreads) {
+  if constexpr (PAMM_CURR_SEV_LEVEL > PAMM_SEVERITY_LEVEL::Off) {
+    return 1;
+  }
+  return NumThreads;
+}
+
+/// Calls Fn for the indices [0, N) using up to NumThreads threads, including
+/// the calling one. The threads claim the indices in increasing order, one
+/// at a time, such that work items of different sizes are balanced.
+///
+/// If Fn throws, no further indices are claimed, as when the indices are
+/// processed sequentially. Once all threads are done, the first exception is
+/// rethrown on the calling thread.
+inline void parallelFor(size_t N, unsigned NumThreads,
+                        const std::function<void(size_t)> &Fn) {
+  std::atomic<size_t> Next = 0;
+  std::mutex ErrorMutex;
+  std::exception_ptr Error;
+  auto Work = [&] {
+    for (size_t Idx = Next++; Idx < N; Idx = Next++) {
+      try {
+        Fn(Idx);
+      } catch (...) {
+        std::lock_guard<std::mutex> Lock(ErrorMutex);
+        if (!Error) {
+          Error = std::current_exception();
+        }
+        Next = N;
+        return;
+      }
+    }
+  };
+  std::vector<std::thread> Workers;
+  for (size_t I = 1; I < std::min<size_t>(NumThreads, N); ++I) {
+    Workers.emplace_back(Work);
+  }
+  Work();
+  for (auto &Worker : Workers) {
+    Worker.join();
+  }
+  if (Error) {
+    std::rethrow_exception(Error);
+  }
+}
+
+} // namespace psr
+
+#endif
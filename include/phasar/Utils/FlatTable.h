@@ -0,0 +1,594 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_FLATTABLE_H_
+#define PHASAR_UTILS_FLATTABLE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "phasar/Utils/Table.h"
+
+namespace psr {
+
+namespace detail {
+
+/// Scrambles the result of std::hash, which is the identity for pointers and
+/// integers, using the finalizer of splitmix64.
+inline size_t mixHash(uint64_t Hash) {
+  Hash = (Hash ^ (Hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  Hash = (Hash ^ (Hash >> 27)) * 0x94d049bb133111ebULL;
+  return Hash ^ (Hash >> 31);
+}
+
+/// An open-addressing index with linear probing that maps keys to positions
+/// in an array that is owned by the user of the index. The keys are stored in
+/// the index, so that a lookup does not need to touch the array.
+template <typename KeyTy, typename HashFn> class FlatIndex {
+public:
+  static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+  /// Returns the position of the given key or None.
+  [[nodiscard]] uint32_t find(const KeyTy &Key) const {
+    return Slots.empty() ? None : Slots[probe(Key)].Pos;
+  }
+
+  /// Like find(), but makes room for another key first and also returns the
+  /// slot that the key has to be inserted into if it is not present; see
+  /// insertAt().
+  std::pair<uint32_t, size_t> findOrPrepareInsert(const KeyTy &Key) {
+    if ((NumUsed + 1) * 4 > Slots.size() * 3) {
+      grow();
+    }
+    size_t Idx = probe(Key);
+    return {Slots[Idx].Pos, Idx};
+  }
+
+  /// Adds a key to the slot returned by findOrPrepareInsert().
+  void insertAt(size_t Idx, const KeyTy &Key, uint32_t Pos) {
+    Slots[Idx] = {Key, Pos};
+    ++NumUsed;
+  }
+
+  /// Removes the given key, which must be present, using backward-shift
+  /// deletion, so that no tombstones accumulate.
+  void erase(const KeyTy &Key) {
+    size_t Hole = probe(Key);
+    assert(Slots[Hole].Pos != None && "Key is not in the index!");
+    for (size_t Idx = (Hole + 1) & mask(); Slots[Idx].Pos != None;
+         Idx = (Idx + 1) & mask()) {
+      size_t Home = HashFn{}(Slots[Idx].Key) & mask();
+      // move the entry into the hole unless its home lies cyclically within
+      // (Hole, Idx]
+      bool Stays = Hole <= Idx ? (Hole < Home && Home <= Idx)
+                               : (Hole < Home || Home <= Idx);
+      if (!Stays) {
+        Slots[Hole] = std::move(Slots[Idx]);
+        Hole = Idx;
+      }
+    }
+    Slots[Hole] = Slot{};
+    --NumUsed;
+  }
+
+  /// Updates the position of the given key, which must be present.
+  void replace(const KeyTy &Key, uint32_t Pos) {
+    size_t Idx = probe(Key);
+    assert(Slots[Idx].Pos != None && "Key is not in the index!");
+    Slots[Idx].Pos = Pos;
+  }
+
+  void clear() {
+    Slots.clear();
+    NumUsed = 0;
+  }
+
+private:
+  struct Slot {
+    KeyTy Key{};
+    uint32_t Pos = None;
+  };
+
+  [[nodiscard]] size_t mask() const { return Slots.size() - 1; }
+
+  /// Returns the slot that holds the given key or the empty slot at which
+  /// probing for it stopped.
+  [[nodiscard]] size_t probe(const KeyTy &Key) const {
+    size_t Idx = HashFn{}(Key) & mask();
+    while (Slots[Idx].Pos != None && !(Slots[Idx].Key == Key)) {
+      Idx = (Idx + 1) & mask();
+    }
+    return Idx;
+  }
+
+  void grow() {
+    std::vector<Slot> Old(std::max<size_t>(Slots.size() * 2, 16));
+    Old.swap(Slots);
+    for (auto &S : Old) {
+      if (S.Pos == None) {
+        continue;
+      }
+      size_t Idx = HashFn{}(S.Key) & mask();
+      while (Slots[Idx].Pos != None) {
+        Idx = (Idx + 1) & mask();
+      }
+      Slots[Idx] = std::move(S);
+    }
+  }
+
+  std::vector<Slot> Slots;
+  size_t NumUsed = 0;
+};
+
+} // namespace detail
+
+/// An alternative to Table that stores all cells in a single array that is
+/// indexed by a flat open-addressing hash table keyed on (row, column).
+///
+/// The cells of a row are chained through the array, so that row() iterates
+/// them without a lookup per cell. The cells of a column are chained the same
+/// way, but this secondary index is only built by the first column query and
+/// dropped again by remove(). row(), column() and cells() return views into
+/// the table rather than copies; cellSet() and cellVec() remain available and
+/// produce Table's Cell type, so that client code works with both tables.
+///
+/// The row and column keys must be default-constructible. References to values
+/// stay valid when cells are inserted; removing a cell moves the most recently
+/// inserted cell into its place. Like Table, FlatTable may be read by multiple
+/// threads at a time as long as none of them writes; note that the first
+/// column query is a write in that sense.
+template <typename R, typename C, typename V> class FlatTable {
+  static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+public:
+  using Cell = typename Table<R, C, V>::Cell;
+
+  /// A cell stored in the table.
+  class Entry {
+  public:
+    Entry(R Row, C Col, V Val, uint32_t RowPos)
+        : Row(std::move(Row)), Col(std::move(Col)), Val(std::move(Val)),
+          RowPos(RowPos) {}
+
+    [[nodiscard]] const R &getRowKey() const { return Row; }
+    [[nodiscard]] const C &getColumnKey() const { return Col; }
+    [[nodiscard]] const V &getValue() const { return Val; }
+
+  private:
+    friend class FlatTable;
+
+    R Row;
+    C Col;
+    V Val;
+    uint32_t RowPos;
+    uint32_t NextInRow = None;
+  };
+
+  /// A view of the cells of a row (ByRow) or column, which yields pairs of
+  /// the respective other key and the value.
+  template <bool ByRow> class ChainView {
+  public:
+    using key_type = std::conditional_t<ByRow, C, R>;
+
+    class iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<key_type, V>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = std::pair<const key_type &, const V &>;
+
+      iterator(const FlatTable *T, uint32_t Idx) : T(T), Idx(Idx) {}
+
+      reference operator*() const {
+        const auto &E = T->Cells[Idx];
+        if constexpr (ByRow) {
+          return {E.Col, E.Val};
+        } else {
+          return {E.Row, E.Val};
+        }
+      }
+
+      iterator &operator++() {
+        if constexpr (ByRow) {
+          Idx = T->Cells[Idx].NextInRow;
+        } else {
+          Idx = T->NextInColumn[Idx];
+        }
+        return *this;
+      }
+
+      iterator operator++(int) {
+        auto Tmp = *this;
+        ++*this;
+        return Tmp;
+      }
+
+      friend bool operator==(const iterator &LHS, const iterator &RHS) {
+        return LHS.Idx == RHS.Idx;
+      }
+      friend bool operator!=(const iterator &LHS, const iterator &RHS) {
+        return !(LHS == RHS);
+      }
+
+    private:
+      const FlatTable *T;
+      uint32_t Idx;
+    };
+
+    ChainView(const FlatTable *T, uint32_t Head) : T(T), Head(Head) {}
+
+    [[nodiscard]] iterator begin() const { return {T, Head}; }
+    [[nodiscard]] iterator end() const { return {T, None}; }
+    [[nodiscard]] bool empty() const { return Head == None; }
+
+  private:
+    const FlatTable *T;
+    uint32_t Head;
+  };
+
+  using RowView = ChainView<true>;
+  using ColumnView = ChainView<false>;
+
+  FlatTable() = default;
+  FlatTable(const FlatTable &) = default;
+  FlatTable &operator=(const FlatTable &) = default;
+  FlatTable(FlatTable &&) noexcept = default;
+  FlatTable &operator=(FlatTable &&) noexcept = default;
+  ~FlatTable() = default;
+
+  /// Associates the specified value with the specified keys.
+  void insert(R Row, C Col, V Val) {
+    auto [Idx, Slot] = CellIndex.findOrPrepareInsert({Row, Col});
+    if (Idx != None) {
+      Cells[Idx].Val = std::move(Val);
+      return;
+    }
+    addCell(Slot, std::move(Row), std::move(Col), std::move(Val));
+  }
+
+  /// Inserts all cells of the given table whose keys are not yet mapped.
+  void insert(const FlatTable &T) {
+    for (const auto &E : T.Cells) {
+      auto [Idx, Slot] = CellIndex.findOrPrepareInsert({E.Row, E.Col});
+      if (Idx == None) {
+        addCell(Slot, E.Row, E.Col, E.Val);
+      }
+    }
+  }
+
+  void clear() {
+    Cells.clear();
+    CellIndex.clear();
+    RowHeads.clear();
+    RowIndex.clear();
+    LastRowPos = None;
+    NumRows = 0;
+    dropColumnIndex();
+  }
+
+  [[nodiscard]] bool empty() const { return Cells.empty(); }
+
+  /// Returns the number of rows that have one or more values, like
+  /// Table::size().
+  [[nodiscard]] size_t size() const { return NumRows; }
+
+  /// Returns the number of cells.
+  [[nodiscard]] size_t numCells() const { return Cells.size(); }
+
+  /// Returns a view of all cells.
+  [[nodiscard]] const std::deque<Entry> &cells() const { return Cells; }
+
+  /// Returns a set of all row key / column key / value triplets.
+  [[nodiscard]] std::set<Cell> cellSet() const {
+    std::set<Cell> S;
+    for (const auto &E : Cells) {
+      S.emplace(E.Row, E.Col, E.Val);
+    }
+    return S;
+  }
+
+  /// Returns a vector of all row key / column key / value triplets.
+  [[nodiscard]] std::vector<Cell> cellVec() const {
+    std::vector<Cell> Vec;
+    Vec.reserve(Cells.size());
+    for (const auto &E : Cells) {
+      Vec.emplace_back(E.Row, E.Col, E.Val);
+    }
+    return Vec;
+  }
+
+  /// Calls Fn(row key, column key, value) for each cell.
+  template <typename FnTy> void foreachCell(FnTy Fn) const {
+    for (const auto &E : Cells) {
+      Fn(E.Row, E.Col, E.Val);
+    }
+  }
+
+  /// Returns a view of all mappings that have the given row key.
+  [[nodiscard]] RowView row(const R &Row) const {
+    uint32_t Pos = RowIndex.find(Row);
+    return {this, Pos != None ? RowHeads[Pos] : None};
+  }
+
+  /// Returns a view of all mappings that have the given column key. The
+  /// column index is built on demand.
+  [[nodiscard]] ColumnView column(const C &Col) const {
+    buildColumnIndex();
+    uint32_t Pos = ColumnIndex.find(Col);
+    return {this, Pos != None ? ColumnHeads[Pos] : None};
+  }
+
+  /// Returns a set of column keys that have one or more values in the table.
+  [[nodiscard]] std::multiset<C> columnKeySet() const {
+    std::multiset<C> ColKeys;
+    for (const auto &E : Cells) {
+      ColKeys.insert(E.Col);
+    }
+    return ColKeys;
+  }
+
+  /// Returns a set of row keys that have one or more values in the table.
+  [[nodiscard]] std::multiset<R> rowKeySet() const {
+    std::multiset<R> RowKeys;
+    for (uint32_t Head : RowHeads) {
+      if (Head != None) {
+        RowKeys.insert(Cells[Head].Row);
+      }
+    }
+    return RowKeys;
+  }
+
+  /// Returns a collection of all values, which may contain duplicates.
+  [[nodiscard]] std::multiset<V> values() const {
+    std::multiset<V> S;
+    for (const auto &E : Cells) {
+      S.insert(E.Val);
+    }
+    return S;
+  }
+
+  /// Returns true if the table contains a mapping with the specified row and
+  /// column keys.
+  [[nodiscard]] bool contains(const R &Row, const C &Col) const {
+    return CellIndex.find({Row, Col}) != None;
+  }
+
+  /// Returns true if the table contains a mapping with the specified column.
+  [[nodiscard]] bool containsColumn(const C &Col) const {
+    return !column(Col).empty();
+  }
+
+  /// Returns true if the table contains a mapping with the specified row key.
+  [[nodiscard]] bool containsRow(const R &Row) const {
+    return !row(Row).empty();
+  }
+
+  /// Returns true if the table contains a mapping with the specified value.
+  [[nodiscard]] bool containsValue(const V &Val) const {
+    for (const auto &E : Cells) {
+      if (E.Val == Val) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Returns a pointer to the value corresponding to the given row and column
+  /// keys, or nullptr if no such mapping exists.
+  [[nodiscard]] const V *find(const R &Row, const C &Col) const {
+    uint32_t Idx = CellIndex.find({Row, Col});
+    return Idx != None ? &Cells[Idx].Val : nullptr;
+  }
+
+  /// Returns the value corresponding to the given row and column keys, which
+  /// is default-constructed if no such mapping exists.
+  [[nodiscard]] V &get(R Row, C Col) {
+    auto [Idx, Slot] = CellIndex.findOrPrepareInsert({Row, Col});
+    if (Idx != None) {
+      return Cells[Idx].Val;
+    }
+    return addCell(Slot, std::move(Row), std::move(Col), V{}).Val;
+  }
+
+  /// Returns the value corresponding to the given row and column keys, which
+  /// must exist.
+  [[nodiscard]] const V &get(const R &Row, const C &Col) const {
+    if (const V *Val = find(Row, Col)) {
+      return *Val;
+    }
+    throw std::out_of_range("FlatTable::get: no such cell");
+  }
+
+  /// Removes the mapping, if any, associated with the given keys.
+  V remove(const R &Row, const C &Col) {
+    uint32_t Idx = CellIndex.find({Row, Col});
+    if (Idx == None) {
+      return V{};
+    }
+    V Val = std::move(Cells[Idx].Val);
+    eraseCell(Idx);
+    return Val;
+  }
+
+  /// Removes all mappings with the given row key.
+  void remove(const R &Row) {
+    uint32_t Pos = RowIndex.find(Row);
+    if (Pos == None) {
+      return;
+    }
+    // erasing a cell updates the head of the row
+    while (RowHeads[Pos] != None) {
+      eraseCell(RowHeads[Pos]);
+    }
+  }
+
+  friend bool operator==(const FlatTable &LHS, const FlatTable &RHS) {
+    if (LHS.Cells.size() != RHS.Cells.size()) {
+      return false;
+    }
+    for (const auto &E : LHS.Cells) {
+      const V *Val = RHS.find(E.getRowKey(), E.getColumnKey());
+      if (!Val || !(*Val == E.getValue())) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend std::ostream &operator<<(std::ostream &OS, const FlatTable &T) {
+    for (const auto &E : T.Cells) {
+      OS << "< " << E.getRowKey() << " , " << E.getColumnKey() << " , "
+         << E.getValue() << " >\n";
+    }
+    return OS;
+  }
+
+private:
+  template <typename KeyTy> struct KeyHash {
+    size_t operator()(const KeyTy &Key) const {
+      return detail::mixHash(std::hash<KeyTy>{}(Key));
+    }
+  };
+
+  struct CellHash {
+    size_t operator()(const std::pair<R, C> &Key) const {
+      size_t RowHash = std::hash<R>{}(Key.first);
+      return detail::mixHash(RowHash ^
+                             (std::hash<C>{}(Key.second) +
+                              0x9e3779b97f4a7c15ULL + (RowHash << 6) +
+                              (RowHash >> 2)));
+    }
+  };
+
+  uint32_t getOrCreateRow(const R &Row) {
+    // the solvers tend to access the same row several times in a row
+    if (LastRowPos != None && LastRow == Row) {
+      return LastRowPos;
+    }
+    auto [Pos, Slot] = RowIndex.findOrPrepareInsert(Row);
+    if (Pos == None) {
+      Pos = static_cast<uint32_t>(RowHeads.size());
+      RowHeads.push_back(None);
+      RowIndex.insertAt(Slot, Row, Pos);
+    }
+    LastRow = Row;
+    LastRowPos = Pos;
+    return Pos;
+  }
+
+  /// Adds a cell to the slot of CellIndex that has been prepared before.
+  Entry &addCell(size_t Slot, R Row, C Col, V Val) {
+    assert(Cells.size() < None && "Too many cells!");
+    auto Idx = static_cast<uint32_t>(Cells.size());
+    CellIndex.insertAt(Slot, {Row, Col}, Idx);
+    uint32_t RowPos = getOrCreateRow(Row);
+    auto &E = Cells.emplace_back(std::move(Row), std::move(Col),
+                                 std::move(Val), RowPos);
+    // prepend to the chain of the row
+    if (RowHeads[RowPos] == None) {
+      ++NumRows;
+    }
+    E.NextInRow = RowHeads[RowPos];
+    RowHeads[RowPos] = Idx;
+    if (HasColumnIndex) {
+      addToColumnIndex(Idx);
+    }
+    return E;
+  }
+
+  void eraseCell(uint32_t Idx) {
+    // the column chains are not updated, rebuild them on demand
+    dropColumnIndex();
+    auto &E = Cells[Idx];
+    *linkTo(Idx) = E.NextInRow;
+    if (RowHeads[E.RowPos] == None) {
+      --NumRows;
+    }
+    CellIndex.erase({E.Row, E.Col});
+    auto Last = static_cast<uint32_t>(Cells.size() - 1);
+    if (Idx != Last) {
+      auto &Moved = Cells[Last];
+      CellIndex.replace({Moved.Row, Moved.Col}, Idx);
+      *linkTo(Last) = Idx;
+      E = std::move(Moved);
+    }
+    Cells.pop_back();
+  }
+
+  /// Returns the link of the row chain that points to the given cell; rows
+  /// are short enough to not justify doubly-linked chains.
+  uint32_t *linkTo(uint32_t Idx) {
+    uint32_t *Link = &RowHeads[Cells[Idx].RowPos];
+    while (*Link != Idx) {
+      Link = &Cells[*Link].NextInRow;
+    }
+    return Link;
+  }
+
+  void buildColumnIndex() const {
+    if (HasColumnIndex) {
+      return;
+    }
+    HasColumnIndex = true;
+    NextInColumn.reserve(Cells.size());
+    for (uint32_t Idx = 0; Idx < Cells.size(); ++Idx) {
+      addToColumnIndex(Idx);
+    }
+  }
+
+  void addToColumnIndex(uint32_t Idx) const {
+    const C &Col = Cells[Idx].Col;
+    auto [Pos, Slot] = ColumnIndex.findOrPrepareInsert(Col);
+    if (Pos == None) {
+      Pos = static_cast<uint32_t>(ColumnHeads.size());
+      ColumnHeads.push_back(None);
+      ColumnIndex.insertAt(Slot, Col, Pos);
+    }
+    NextInColumn.push_back(ColumnHeads[Pos]);
+    ColumnHeads[Pos] = Idx;
+  }
+
+  void dropColumnIndex() {
+    HasColumnIndex = false;
+    ColumnHeads.clear();
+    ColumnIndex.clear();
+    NextInColumn.clear();
+  }
+
+  std::deque<Entry> Cells;
+  detail::FlatIndex<std::pair<R, C>, CellHash> CellIndex;
+  // the rows are never removed, only their chains become empty
+  std::vector<uint32_t> RowHeads;
+  detail::FlatIndex<R, KeyHash<R>> RowIndex;
+  R LastRow{};
+  uint32_t LastRowPos = None;
+  size_t NumRows = 0;
+  // the column index, which is built by the first column query
+  mutable bool HasColumnIndex = false;
+  mutable std::vector<uint32_t> ColumnHeads;
+  mutable detail::FlatIndex<C, KeyHash<C>> ColumnIndex;
+  mutable std::vector<uint32_t> NextInColumn;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_LRUCACHE_H_
+#define PHASAR_UTILS_LRUCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace psr {
+
+/// A hash-based cache that optionally bounds the number of its entries. If a
+/// capacity is set, inserting into a full cache evicts the least recently used
+/// entry. A capacity of zero means that the cache is unbounded, in which case
+/// lookups do not need to maintain the recency order. The cache counts its
+/// hits, misses and evictions.
+///
+/// Pointers and references to cached values remain valid until their entry is
+/// evicted or the cache is cleared.
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>,
+          typename KeyEqualT = std::equal_to<KeyT>>
+class LRUCache {
+public:
+  explicit LRUCache(size_t Capacity = 0) : Capacity(Capacity) {}
+
+  ~LRUCache() = default;
+
+  LRUCache(const LRUCache &Other)
+      : Entries(Other.Entries), Capacity(Other.Capacity), Hits(Other.Hits),
+        Misses(Other.Misses), Evictions(Other.Evictions) {
+    rebuildIndex();
+  }
+
+  LRUCache &operator=(const LRUCache &Other) {
+    if (this != &Other) {
+      Entries = Other.Entries;
+      Capacity = Other.Capacity;
+      Hits = Other.Hits;
+      Misses = Other.Misses;
+      Evictions = Other.Evictions;
+      rebuildIndex();
+    }
+    return *this;
+  }
+
+  LRUCache(LRUCache &&) noexcept = default;
+  LRUCache &operator=(LRUCache &&) noexcept = default;
+
+  /// Returns the value cached for the given key, or nullptr on a miss.
+  [[nodiscard]] ValueT *lookup(const KeyT &Key) {
+    auto Search = Index.find(Key);
+    if (Search == Index.end()) {
+      ++Misses;
+      return nullptr;
+    }
+    ++Hits;
+    if (Capacity != 0) {
+      Entries.splice(Entries.begin(), Entries, Search->second);
+    }
+    return &Search->second->second;
+  }
+
+  /// Caches the given value for the given key, which must not be cached yet,
+  /// and returns a reference to it. May evict the least recently used entry.
+  ValueT &insert(KeyT Key, ValueT Value) {
+    Entries.emplace_front(std::move(Key), std::move(Value));
+    Index.emplace(Entries.front().first, Entries.begin());
+    evictExcessEntries();
+    return Entries.front().second;
+  }
+
+  /// Sets the maximal number of entries, zero means unbounded.
+  void setCapacity(size_t NewCapacity) {
+    Capacity = NewCapacity;
+    evictExcessEntries();
+  }
+
+  [[nodiscard]] size_t capacity() const noexcept { return Capacity; }
+
+  [[nodiscard]] size_t size() const noexcept { return Index.size(); }
+
+  [[nodiscard]] bool empty() const noexcept { return Index.empty(); }
+
+  [[nodiscard]] size_t hits() const noexcept { return Hits; }
+
+  [[nodiscard]] size_t misses() const noexcept { return Misses; }
+
+  [[nodiscard]] size_t evictions() const noexcept { return Evictions; }
+
+  void clear() {
+    Index.clear();
+    Entries.clear();
+  }
+
+private:
+  using EntryList = std::list<std::pair<KeyT, ValueT>>;
+
+  void evictExcessEntries() {
+    while (Capacity != 0 && Index.size() > Capacity) {
+      Index.erase(Entries.back().first);
+      Entries.pop_back();
+      ++Evictions;
+    }
+  }
+
+  void rebuildIndex() {
+    Index.clear();
+    Index.reserve(Entries.size());
+    for (auto It = Entries.begin(); It != Entries.end(); ++It) {
+      Index.emplace(It->first, It);
+    }
+  }
+
+  // Most recently used first, only ordered if the cache is bounded
+  EntryList Entries;
+  std::unordered_map<KeyT, typename EntryList::iterator, HashT, KeyEqualT>
+      Index;
+  size_t Capacity;
+  size_t Hits = 0;
+  size_t Misses = 0;
+  size_t Evictions = 0;
+};
+
+} // namespace psr
+
+#endif
@@ -52,8 +52,9 @@ std::ostream &operator<<(std::ostream &os, const SeverityLevel &Level);
 extern SeverityLevel LogFilterLevel;
 
 #ifdef DYNAMIC_LOG
+// the solvers may log from several threads
 BOOST_LOG_INLINE_GLOBAL_LOGGER_DEFAULT(
-    lg, boost::log::sources::severity_logger<SeverityLevel>)
+    lg, boost::log::sources::severity_logger_mt<SeverityLevel>)
 // For performance reason, we want to disable any formatting computation
 // that would go straight into logs if logs are deactivated
 // This macro does just that
@@ -68,7 +69,7 @@ BOOST_LOG_INLINE_GLOBAL_LOGGER_DEFAULT(
 
 #define IS_LOG_ENABLED bool(boost::log::core::get()->get_logging_enabled())
 // Register the logger and use it a singleton then, get the logger with:
-// boost::log::sources::severity_logger<SeverityLevel>& lg = lg::get();
+// boost::log::sources::severity_logger_mt<SeverityLevel>& lg = lg::get();
 
 // The logger can also be used as a global variable, which is not recommended.
 // In such a case a global variable would be created like in the following
@@ -93,7 +94,7 @@ template <typename T> struct __lg__ {
                 "The dynamic log is disabled. Please move this call "
                 "to lg::get() into LOG_IF_ENABLE, or use the "
                 "cmake option '-DPHASAR_ENABLE_DYNAMIC_LOG=ON'.");
-  static inline boost::log::sources::severity_logger<SeverityLevel> &get() {
+  static inline boost::log::sources::severity_logger_mt<SeverityLevel> &get() {
     llvm::report_fatal_error(
         "The dynamic log is disabled. Please move this call "
         "to lg::get() into LOG_IF_ENABLE, or use the "
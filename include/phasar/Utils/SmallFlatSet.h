@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SMALLFLATSET_H_
+#define PHASAR_UTILS_SMALLFLATSET_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "llvm/ADT/SmallVector.h"
+
+namespace psr {
+
+/// A set that stores its elements sorted and without duplicates in an
+/// llvm::SmallVector. Up to N elements are stored inline, such that small sets
+/// do not allocate at all. The interface is a subset of the one of std::set
+/// and the iteration order is the same, so SmallFlatSet can be used as the
+/// Container of flow functions and solvers, whose target sets mostly contain
+/// only a handful of data-flow facts.
+///
+/// In contrast to std::set, inserting and erasing elements invalidates all
+/// iterators into the set.
+template <typename T, unsigned N = 4, typename Compare = std::less<T>>
+class SmallFlatSet {
+  using StorageTy = llvm::SmallVector<T, N>;
+
+public:
+  using value_type = T;
+  using key_type = T;
+  using size_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using reference = const T &;
+  using const_reference = const T &;
+  using pointer = const T *;
+  using const_pointer = const T *;
+  // Elements must not be modified in-place as that may break the ordering
+  using iterator = typename StorageTy::const_iterator;
+  using const_iterator = typename StorageTy::const_iterator;
+  using reverse_iterator = typename StorageTy::const_reverse_iterator;
+  using const_reverse_iterator = typename StorageTy::const_reverse_iterator;
+
+  SmallFlatSet() = default;
+
+  SmallFlatSet(std::initializer_list<T> IList) {
+    insert(IList.begin(), IList.end());
+  }
+
+  template <typename InputIt> SmallFlatSet(InputIt First, InputIt Last) {
+    insert(First, Last);
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return Elements.begin();
+  }
+  [[nodiscard]] const_iterator end() const noexcept { return Elements.end(); }
+  [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+    return Elements.rbegin();
+  }
+  [[nodiscard]] const_reverse_iterator rend() const noexcept {
+    return Elements.rend();
+  }
+
+  [[nodiscard]] size_t size() const noexcept { return Elements.size(); }
+  [[nodiscard]] bool empty() const noexcept { return Elements.empty(); }
+
+  void clear() noexcept { Elements.clear(); }
+  void reserve(size_t Size) { Elements.reserve(Size); }
+
+  std::pair<iterator, bool> insert(const T &Val) { return emplaceImpl(Val); }
+  std::pair<iterator, bool> insert(T &&Val) {
+    return emplaceImpl(std::move(Val));
+  }
+
+  /// Inserts the elements of the range [First, Last). Small ranges are
+  /// inserted element-wise, larger ones are appended and merged in one go.
+  template <typename InputIt> void insert(InputIt First, InputIt Last) {
+    using CategoryTy =
+        typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, CategoryTy>) {
+      if (static_cast<size_t>(std::distance(First, Last)) <= N) {
+        for (; First != Last; ++First) {
+          emplaceImpl(*First);
+        }
+        return;
+      }
+    }
+    size_t OldSize = Elements.size();
+    Elements.append(First, Last);
+    auto Mid = Elements.begin() + OldSize;
+    if (!std::is_sorted(Mid, Elements.end(), Compare{})) {
+      std::sort(Mid, Elements.end(), Compare{});
+    }
+    std::inplace_merge(Elements.begin(), Mid, Elements.end(), Compare{});
+    Elements.erase(std::unique(Elements.begin(), Elements.end(), equivalent),
+                   Elements.end());
+  }
+
+  void insert(std::initializer_list<T> IList) {
+    insert(IList.begin(), IList.end());
+  }
+
+  template <typename... ArgsT>
+  std::pair<iterator, bool> emplace(ArgsT &&...Args) {
+    return emplaceImpl(T(std::forward<ArgsT>(Args)...));
+  }
+
+  iterator erase(const_iterator Pos) { return Elements.erase(mutableIt(Pos)); }
+
+  size_t erase(const T &Val) {
+    auto It = find(Val);
+    if (It == end()) {
+      return 0;
+    }
+    Elements.erase(mutableIt(It));
+    return 1;
+  }
+
+  [[nodiscard]] const_iterator find(const T &Val) const {
+    auto It = lowerBound(Val);
+    return It != end() && !Compare{}(Val, *It) ? It : end();
+  }
+
+  [[nodiscard]] size_t count(const T &Val) const {
+    return find(Val) != end();
+  }
+
+  [[nodiscard]] bool contains(const T &Val) const {
+    return find(Val) != end();
+  }
+
+  friend bool operator==(const SmallFlatSet &Lhs, const SmallFlatSet &Rhs) {
+    return Lhs.Elements == Rhs.Elements;
+  }
+
+  friend bool operator!=(const SmallFlatSet &Lhs, const SmallFlatSet &Rhs) {
+    return !(Lhs == Rhs);
+  }
+
+  friend bool operator<(const SmallFlatSet &Lhs, const SmallFlatSet &Rhs) {
+    return std::lexicographical_compare(Lhs.begin(), Lhs.end(), Rhs.begin(),
+                                        Rhs.end(), Compare{});
+  }
+
+  friend std::ostream &operator<<(std::ostream &OS, const SmallFlatSet &S) {
+    OS << '{';
+    bool First = true;
+    for (const auto &Elem : S) {
+      if (!First) {
+        OS << ", ";
+      }
+      OS << Elem;
+      First = false;
+    }
+    return OS << '}';
+  }
+
+private:
+  [[nodiscard]] const_iterator lowerBound(const T &Val) const {
+    return std::lower_bound(Elements.begin(), Elements.end(), Val, Compare{});
+  }
+
+  static bool equivalent(const T &Lhs, const T &Rhs) {
+    return !Compare{}(Lhs, Rhs) && !Compare{}(Rhs, Lhs);
+  }
+
+  template <typename ValT> std::pair<iterator, bool> emplaceImpl(ValT &&Val) {
+    auto It = lowerBound(Val);
+    if (It != end() && !Compare{}(Val, *It)) {
+      return {It, false};
+    }
+    return {Elements.insert(mutableIt(It), std::forward<ValT>(Val)), true};
+  }
+
+  typename StorageTy::iterator mutableIt(const_iterator It) {
+    return Elements.begin() + (It - Elements.begin());
+  }
+
+  StorageTy Elements;
+};
+
+} // namespace psr
+
+#endif
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#ifndef PHASAR_UTILS_SOLVERBUDGET_H_
+#define PHASAR_UTILS_SOLVERBUDGET_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace psr {
+
+/// A flag that lets another thread ask a solver to stop. Copies of a token
+/// share their state, so a token can be handed to a solver's budget and be
+/// cancelled through a copy that is kept by the caller.
+class CancellationToken {
+public:
+  CancellationToken();
+
+  void cancel() const noexcept {
+    Cancelled->store(true, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] bool isCancelled() const noexcept {
+    return Cancelled->load(std::memory_order_relaxed);
+  }
+
+private:
+  std::shared_ptr<std::atomic<bool>> Cancelled;
+};
+
+/// The reason why a solver stopped before reaching its fixpoint.
+enum class BudgetExhaustion { None, Deadline, Memory, WorkItems, Cancelled };
+
+std::string toString(BudgetExhaustion E);
+
+std::ostream &operator<<(std::ostream &OS, BudgetExhaustion E);
+
+/// The resources a solver may use to reach its fixpoint. A solver whose
+/// budget is exhausted stops and reports its results as incomplete. All
+/// limits are off by default.
+struct SolverBudget {
+  // the wall-clock time since the solver started
+  std::optional<std::chrono::milliseconds> TimeLimit;
+  // the resident set size of the process in bytes, zero means unlimited
+  size_t MaxResidentSetSize = 0;
+  // the number of work items, e.g. path edges, zero means unlimited
+  uint64_t MaxWorkItems = 0;
+  // lets the caller stop the solver at any time
+  std::optional<CancellationToken> Cancellation;
+
+  [[nodiscard]] bool isUnlimited() const {
+    return !TimeLimit && MaxResidentSetSize == 0 && MaxWorkItems == 0 &&
+           !Cancellation;
+  }
+
+  /// Returns the budget given by the options "solver-time-limit" (seconds),
+  /// "solver-memory-limit" (MiB) and "solver-max-path-edges".
+  static SolverBudget fromPhasarConfig();
+};
+
+std::ostream &operator<<(std::ostream &OS, const SolverBudget &B);
+
+/// Tracks the resources that a solver uses against its budget. The deadline
+/// starts with the construction of the monitor. The monitor may be shared by
+/// the threads of a solver.
+class BudgetMonitor {
+public:
+  /// The deadline and the resident set size are only checked every
+  /// CheckInterval work items, as reading the clock and especially the
+  /// resident set size is too expensive to be done for each of them.
+  explicit BudgetMonitor(SolverBudget Budget, unsigned CheckInterval = 256);
+
+  /// Accounts for a work item that is about to be processed and returns true
+  /// if the budget is exhausted, in which case the item must not be processed.
+  bool step();
+
+  /// Checks the deadline, the resident set size and the cancellation token
+  /// immediately and returns true if the budget is exhausted.
+  bool check();
+
+  [[nodiscard]] bool isExhausted() const {
+    return exhaustion() != BudgetExhaustion::None;
+  }
+
+  /// Returns the first reason why the budget was exhausted.
+  [[nodiscard]] BudgetExhaustion exhaustion() const {
+    return Exhaustion.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the number of work items that were processed within the budget.
+  [[nodiscard]] uint64_t getNumWorkItems() const;
+
+  [[nodiscard]] const SolverBudget &getBudget() const { return Budget; }
+
+private:
+  bool exhaust(BudgetExhaustion Reason);
+
+  SolverBudget Budget;
+  std::chrono::steady_clock::time_point Deadline;
+  unsigned CheckInterval;
+  std::atomic<uint64_t> NumWorkItems{0};
+  std::atomic<BudgetExhaustion> Exhaustion{BudgetExhaustion::None};
+};
+
+/// Returns the current resident set size of this process in bytes, or its
+/// peak resident set size if the current one cannot be determined.
+size_t getResidentSetSize();
+
+} // namespace psr
+
+#endif
@@ -104,6 +104,16 @@ public:
     return v;
   }
 
+  template <typename FnTy> void foreachCell(FnTy Fn) const {
+    // Calls Fn(row key, column key, value) for each cell without copying the
+    // cells beforehand.
+    for (const auto &m1 : table) {
+      for (const auto &m2 : m1.second) {
+        Fn(m1.first, m2.first, m2.second);
+      }
+    }
+  }
+
   [[nodiscard]] std::unordered_map<R, V> column(C columnKey) const {
     // Returns a view of all mappings that have the given column key.
     std::unordered_map<R, V> column;
@@ -181,6 +191,12 @@ public:
     return table[rowKey][columnKey];
   }
 
+  [[nodiscard]] const V &get(R rowKey, C columnKey) const {
+    // Returns the value corresponding to the given row and column keys, which
+    // must exist.
+    return table.at(rowKey).at(columnKey);
+  }
+
   V remove(R rowKey, C columnKey) {
     // Removes the mapping, if any, associated with the given keys.
     V v = table[rowKey][columnKey];
@@ -195,6 +211,16 @@ public:
     return table[rowKey];
   }
 
+  [[nodiscard]] const std::unordered_map<C, V> &row(R rowKey) const {
+    // Returns a view of all mappings that have the given row key without
+    // adding the row if it does not exist.
+    static const std::unordered_map<C, V> EmptyRow;
+    if (auto RowIter = table.find(rowKey); RowIter != table.end()) {
+      return RowIter->second;
+    }
+    return EmptyRow;
+  }
+
   [[nodiscard]] std::multiset<R> rowKeySet() const {
     // Returns a set of row keys that have one or more values in the table.
     std::multiset<R> s;
@@ -7,6 +7,7 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <functional>
@@ -17,7 +18,12 @@
 #include "llvm/Support/ErrorHandling.h"
 
 #include "phasar/Controller/AnalysisController.h"
+#include "phasar/Config/Configuration.h"
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ShardedAnalysis.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/Strategies.h"
 #include "phasar/PhasarLLVM/AnalysisStrategy/WholeProgramAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDEInstInteractionAnalysis.h"
@@ -39,6 +45,7 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/TypeStateDescriptions/OpenSSLEVPKDFDescription.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoSolverTest.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/InterMonoTaintAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Problems/IntraMonoFullConstantPropagation.h"
@@ -47,6 +54,8 @@
 #include "phasar/PhasarLLVM/DataFlowSolver/Mono/Solver/IntraMonoSolver.h"
 #include "phasar/PhasarLLVM/Plugins/PluginFactories.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
+#include "phasar/Utils/Concurrency.h"
+#include "phasar/Utils/PAMMMacros.h"
 #include "phasar/Utils/Utilities.h"
 
 using namespace std;
@@ -74,6 +83,57 @@ bool needsToEmitPTA(AnalysisControllerEmitterOptions EmitterOptions) {
          (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText);
 }
 
+bool needsToEmitHelperAnalyses(
+    AnalysisControllerEmitterOptions EmitterOptions) {
+  return needsToEmitPTA(EmitterOptions) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsText) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsDot) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsJson) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsText) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsDot) ||
+         (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsJson);
+}
+
+unsigned getNumAnalysisThreads(AnalysisStrategy Strategy,
+                               size_t NumAnalyses) {
+  if (!PhasarConfig::VariablesMap().count("analysis-threads")) {
+    return 1;
+  }
+  unsigned NumThreads = std::max(
+      1U, PhasarConfig::VariablesMap()["analysis-threads"].as<unsigned>());
+  switch (Strategy) {
+  case AnalysisStrategy::WholeProgram:
+    // each analysis is solved by a single thread
+    NumThreads = std::min<size_t>(NumThreads, std::max<size_t>(NumAnalyses, 1));
+    break;
+  case AnalysisStrategy::ModuleWise:
+  case AnalysisStrategy::Sharded:
+    // the modules or shards of each analysis are solved concurrently
+    break;
+  default:
+    return 1;
+  }
+  // PAMM's timers and counters are shared by all solvers
+  if (getNumPAMMSafeThreads(NumThreads) < NumThreads) {
+    std::cerr << "Analyses are solved sequentially if PAMM is enabled\n";
+  }
+  return getNumPAMMSafeThreads(NumThreads);
+}
+
+bool useNativeIFDSSolver(AnalysisStrategy Strategy) {
+  if (Strategy != AnalysisStrategy::WholeProgram ||
+      !PhasarConfig::VariablesMap().count("native-ifds-solver")) {
+    return false;
+  }
+  auto Unsupported =
+      getOptionsUnsupportedByNativeIFDSSolver(IFDSIDESolverConfig());
+  for (const auto &Option : Unsupported) {
+    std::cerr << "The native IFDS solver does not support --" << Option
+              << ", IFDS analyses are solved by the IFDS/IDE solver\n";
+  }
+  return Unsupported.empty();
+}
+
 AnalysisController::AnalysisController(
     ProjectIRDB &IRDB, std::vector<DataFlowAnalysisKind> DataFlowAnalyses,
     std::vector<std::string> AnalysisConfigs, PointerAnalysisType PTATy,
@@ -81,12 +141,25 @@ AnalysisController::AnalysisController(
     const std::set<std::string> &EntryPoints, AnalysisStrategy Strategy,
     AnalysisControllerEmitterOptions EmitterOptions,
     const std::string &ProjectID, const std::string &OutDirectory)
-    : IRDB(IRDB), TH(IRDB), PT(IRDB, !needsToEmitPTA(EmitterOptions), PTATy),
-      ICF(IRDB, CGTy, EntryPoints, &TH, &PT),
+    : IRDB(IRDB),
+      NumAnalysisThreads(
+          getNumAnalysisThreads(Strategy, DataFlowAnalyses.size())),
+      UseNativeIFDSSolver(useNativeIFDSSolver(Strategy)),
       DataFlowAnalyses(std::move(DataFlowAnalyses)),
       AnalysisConfigs(std::move(AnalysisConfigs)), EntryPoints(EntryPoints),
       Strategy(Strategy), EmitterOptions(EmitterOptions), ProjectID(ProjectID),
       OutDirectory(OutDirectory), S(S) {
+  if (Strategy != AnalysisStrategy::ModuleWise ||
+      needsToEmitHelperAnalyses(EmitterOptions)) {
+    TH = std::make_unique<LLVMTypeHierarchy>(IRDB);
+    // analyses and shards that are solved concurrently require points-to
+    // sets that do not change once they have been handed out
+    PT = std::make_unique<LLVMPointsToSet>(
+        IRDB, !needsToEmitPTA(EmitterOptions) && NumAnalysisThreads <= 1,
+        PTATy);
+    ICF = std::make_unique<LLVMBasedICFG>(IRDB, CGTy, EntryPoints, TH.get(),
+                                          PT.get());
+  }
   if (!OutDirectory.empty()) {
     // create directory for results
     ResultDirectory = OutDirectory + "/" + ProjectID + "-" + createTimeStamp();
@@ -99,13 +172,16 @@ AnalysisController::AnalysisController(
 void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   switch (Strategy) {
   case AnalysisStrategy::DemandDriven:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeDemandDriven();
     break;
   case AnalysisStrategy::Incremental:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeIncremental();
     break;
   case AnalysisStrategy::ModuleWise:
-    llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
+    executeModuleWise();
+    break;
+  case AnalysisStrategy::Sharded:
+    executeSharded();
     break;
   case AnalysisStrategy::Variational:
     llvm::report_fatal_error("AnalysisStrategy not supported, yet!");
@@ -118,194 +194,660 @@ void AnalysisController::executeAs(AnalysisStrategy Strategy) {
   }
 }
 
-void AnalysisController::executeDemandDriven() {}
-
-void AnalysisController::executeIncremental() {}
+void AnalysisController::executeDemandDriven() {
+  // the queries are given as the IDs of the instructions at which the
+  // data-flow facts are asked for
+  std::vector<const llvm::Instruction *> Queries;
+  if (PhasarConfig::VariablesMap().count("demand-query")) {
+    for (const auto &ID : PhasarConfig::VariablesMap()["demand-query"]
+                              .as<std::vector<std::string>>()) {
+      const llvm::Instruction *Query = nullptr;
+      if (!ID.empty() &&
+          ID.find_first_not_of("0123456789") == std::string::npos) {
+        Query = IRDB.getInstruction(std::stoul(ID));
+      }
+      if (!Query) {
+        std::cerr << "No instruction with ID '" << ID << "', skipping query\n";
+        continue;
+      }
+      Queries.push_back(Query);
+    }
+  }
+  if (Queries.empty()) {
+    std::cerr << "Demand-driven analysis requires at least one query\n";
+    return;
+  }
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cerr << "Demand-driven analysis does not support plugins\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                           IFDSUninitializedVariables>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis>
+          DDA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(), ICF.get(),
+              TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      DemandDrivenAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      DemandDrivenAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                           IDETypeStateAnalysis>
+          DDA(IRDB, &TSDesc, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+      DDA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis: {
+      CSTDFILEIOTypeStateDescription TSDesc;
+      DemandDrivenAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                           IDETypeStateAnalysis>
+          DDA(IRDB, &TSDesc, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+      DDA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest> DDA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
+                           IFDSLinearConstantAnalysis>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      DemandDrivenAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
+                           IFDSFieldSensTaintAnalysis>
+          DDA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(), ICF.get(),
+              TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      DemandDrivenAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                           IDELinearConstantAnalysis>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      DemandDrivenAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> DDA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      DemandDrivenAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                           IDEInstInteractionAnalysis>
+          DDA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      emitDemandQueryResults(DDA, Queries);
+      DDA.releaseAllHelperAnalyses();
+    } break;
+    default:
+      std::cerr << "Demand-driven analysis does not support "
+                << DataFlowAnalysis << '\n';
+      break;
+    }
+  }
+}
 
-void AnalysisController::executeModuleWise() {}
+void AnalysisController::executeIncremental() {
+  std::string StateDirectory = "phasar-incremental-state";
+  if (PhasarConfig::VariablesMap().count("incremental-state")) {
+    StateDirectory =
+        PhasarConfig::VariablesMap()["incremental-state"].as<std::string>();
+  }
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cerr << "Incremental analysis does not support plugins\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                                IFDSUninitializedVariables>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSConstAnalysis>,
+                                IFDSConstAnalysis>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSTaintAnalysis>,
+                                IFDSTaintAnalysis>
+          IUA(IRDB, StateDirectory, AnalysisConfigPath, EntryPoints, PT.get(),
+              ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDETaintAnalysis>,
+                                IDETaintAnalysis>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      IncrementalUpdateAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                                IDETypeStateAnalysis>
+          IUA(IRDB, StateDirectory, &TSDesc, EntryPoints, PT.get(), ICF.get(),
+              TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+      IUA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis: {
+      CSTDFILEIOTypeStateDescription TSDesc;
+      IncrementalUpdateAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                                IDETypeStateAnalysis>
+          IUA(IRDB, StateDirectory, &TSDesc, EntryPoints, PT.get(), ICF.get(),
+              TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+      IUA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSTypeAnalysis>,
+                                IFDSTypeAnalysis>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
+                                IFDSLinearConstantAnalysis>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
+                                IFDSFieldSensTaintAnalysis>
+          IUA(IRDB, StateDirectory, AnalysisConfigPath, EntryPoints, PT.get(),
+              ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                                IDELinearConstantAnalysis>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> IUA(
+          IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      IncrementalUpdateAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                                IDEInstInteractionAnalysis>
+          IUA(IRDB, StateDirectory, EntryPoints, PT.get(), ICF.get(), TH.get());
+      IUA.solve();
+      emitRequestedDataFlowResults(IUA);
+      IUA.releaseAllHelperAnalyses();
+    } break;
+    default:
+      std::cerr << "Incremental analysis does not support "
+                << DataFlowAnalysis << '\n';
+      break;
+    }
+  }
+}
 
-void AnalysisController::executeVariational() {}
+void AnalysisController::executeModuleWise() {
+  // the modules are analyzed independently of each other
+  unsigned NumThreads = NumAnalysisThreads;
+  size_t ConfigIdx = 0;
+  for (auto _DataFlowAnalysis : DataFlowAnalyses) {
+    std::string AnalysisConfigPath =
+        (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cerr << "Module-wise analysis does not support plugins\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                         IFDSUninitializedVariables>
+          MWA(IRDB, EntryPoints, NumThreads);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis>
+          MWA(IRDB, EntryPoints, NumThreads);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis>
+          MWA(IRDB, AnalysisConfigPath, EntryPoints, NumThreads);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis> MWA(
+          IRDB, EntryPoints, NumThreads);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      ModuleWiseAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest> MWA(
+          IRDB, EntryPoints, NumThreads);
+      MWA.solve();
+      emitRequestedDataFlowResults(MWA);
+    } break;
+    default:
+      std::cerr << "Module-wise analysis does not support " << DataFlowAnalysis
+                << '\n';
+      break;
+    }
+  }
+}
 
-void AnalysisController::executeWholeProgram() {
+void AnalysisController::executeSharded() {
+  // the shards are solved independently of each other
+  unsigned NumThreads = NumAnalysisThreads;
+  ShardingPolicy Policy = ShardingPolicy::EntryPoint;
+  if (PhasarConfig::VariablesMap().count("shard-by") &&
+      PhasarConfig::VariablesMap()["shard-by"].as<std::string>() ==
+          "component") {
+    Policy = ShardingPolicy::Component;
+  }
+  auto Solve = [this, NumThreads, Policy](auto &SA) {
+    SA.setShardingPolicy(Policy);
+    SA.setNumThreads(NumThreads);
+    SA.solve();
+    emitRequestedDataFlowResults(SA);
+    SA.releaseAllHelperAnalyses();
+  };
   size_t ConfigIdx = 0;
   for (auto _DataFlowAnalysis : DataFlowAnalyses) {
     std::string AnalysisConfigPath =
         (ConfigIdx < AnalysisConfigs.size()) ? AnalysisConfigs[ConfigIdx] : "";
-    if (std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
-      auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
-      switch (DataFlowAnalysis) {
-      case DataFlowAnalysisType::IFDSUninitializedVariables: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
-                             IFDSUninitializedVariables>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IFDSConstAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IFDSTaintAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IDETaintAnalysis: {
-        WholeProgramAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
-        OpenSSLEVPKDFDescription TSDesc;
-        WholeProgramAnalysis<IDESolver_P<IDETypeStateAnalysis>,
-                             IDETypeStateAnalysis>
-            WPA(IRDB, &TSDesc, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-        WPA.releaseConfiguration();
-      } break;
-      case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis: {
-        CSTDFILEIOTypeStateDescription TSDesc;
-        WholeProgramAnalysis<IDESolver_P<IDETypeStateAnalysis>,
-                             IDETypeStateAnalysis>
-            WPA(IRDB, &TSDesc, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-        WPA.releaseConfiguration();
-      } break;
-      case DataFlowAnalysisType::IFDSTypeAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IFDSSolverTest: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest> WPA(
-            IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
-                             IFDSLinearConstantAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
-        WholeProgramAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
-                             IFDSFieldSensTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IDELinearConstantAnalysis: {
-        WholeProgramAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
-                             IDELinearConstantAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IDESolverTest: {
-        WholeProgramAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> WPA(
-            IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
-        WholeProgramAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
-                             IDEInstInteractionAnalysis>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IntraMonoFullConstantPropagation: {
-        WholeProgramAnalysis<
-            IntraMonoSolver_P<IntraMonoFullConstantPropagation>,
-            IntraMonoFullConstantPropagation>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::IntraMonoSolverTest: {
-        WholeProgramAnalysis<IntraMonoSolver_P<IntraMonoSolverTest>,
-                             IntraMonoSolverTest>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::InterMonoSolverTest: {
-        WholeProgramAnalysis<InterMonoSolver_P<InterMonoSolverTest, 3>,
-                             InterMonoSolverTest>
-            WPA(IRDB, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      case DataFlowAnalysisType::InterMonoTaintAnalysis: {
-        WholeProgramAnalysis<InterMonoSolver_P<InterMonoTaintAnalysis, 3>,
-                             InterMonoTaintAnalysis>
-            WPA(IRDB, AnalysisConfigPath, EntryPoints, &PT, &ICF, &TH);
-        WPA.solve();
-        emitRequestedDataFlowResults(WPA);
-        WPA.releaseAllHelperAnalyses();
-      } break;
-      default:
-        break;
-      }
-    } else if (std::holds_alternative<IFDSPluginConstructor>(
-                   _DataFlowAnalysis)) {
-      auto Problem = std::get<IFDSPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
-      IFDSSolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
-          *Problem);
-      Solver.solve();
-      emitRequestedDataFlowResults(Solver);
-    } else if (std::holds_alternative<IDEPluginConstructor>(
-                   _DataFlowAnalysis)) {
-      auto Problem = std::get<IDEPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
-      IDESolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
-          *Problem);
-      Solver.solve();
-      emitRequestedDataFlowResults(Solver);
-    } else if (std::holds_alternative<IntraMonoPluginConstructor>(
-                   _DataFlowAnalysis)) {
+    if (!std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+      std::cerr << "Sharded analysis does not support plugins\n";
+      continue;
+    }
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      ShardedAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                      IFDSUninitializedVariables>
+          SA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      ShardedAnalysis<IFDSSolver_P<IFDSConstAnalysis>, IFDSConstAnalysis> SA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      ShardedAnalysis<IFDSSolver_P<IFDSTaintAnalysis>, IFDSTaintAnalysis> SA(
+          IRDB, AnalysisConfigPath, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      ShardedAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis> SA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      ShardedAnalysis<IDESolver_P<IDETypeStateAnalysis>, IDETypeStateAnalysis>
+          SA(IRDB, &TSDesc, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+      SA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis: {
+      CSTDFILEIOTypeStateDescription TSDesc;
+      ShardedAnalysis<IDESolver_P<IDETypeStateAnalysis>, IDETypeStateAnalysis>
+          SA(IRDB, &TSDesc, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+      SA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      ShardedAnalysis<IFDSSolver_P<IFDSTypeAnalysis>, IFDSTypeAnalysis> SA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      ShardedAnalysis<IFDSSolver_P<IFDSSolverTest>, IFDSSolverTest> SA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      ShardedAnalysis<IFDSSolver_P<IFDSLinearConstantAnalysis>,
+                      IFDSLinearConstantAnalysis>
+          SA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      ShardedAnalysis<IFDSSolver_P<IFDSFieldSensTaintAnalysis>,
+                      IFDSFieldSensTaintAnalysis>
+          SA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(), ICF.get(),
+             TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      ShardedAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                      IDELinearConstantAnalysis>
+          SA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      ShardedAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> SA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      ShardedAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                      IDEInstInteractionAnalysis>
+          SA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      Solve(SA);
+    } break;
+    default:
+      std::cerr << "Sharded analysis does not support " << DataFlowAnalysis
+                << '\n';
+      break;
+    }
+  }
+}
+
+void AnalysisController::executeVariational() {}
+
+void AnalysisController::executeWholeProgram() {
+  NextToEmit = 0;
+  if (NumAnalysisThreads <= 1) {
+    for (size_t Idx = 0; Idx < DataFlowAnalyses.size(); ++Idx) {
+      executeWholeProgramAnalysis(Idx);
+      passTurn(Idx);
+    }
+    return;
+  }
+  // The analyses share the type hierarchy, call graph and points-to
+  // information, of which only the latter is modified by queries. Each
+  // analysis is solved by one of the threads, which takes the next analysis
+  // once it has emitted the results of the previous one.
+  PT->setThreadSafe();
+  // as when solving sequentially, no further analysis is started once an
+  // analysis has failed, and the first failure is rethrown
+  try {
+    parallelFor(
+        DataFlowAnalyses.size(), NumAnalysisThreads, [this](size_t Idx) {
+          try {
+            executeWholeProgramAnalysis(Idx);
+          } catch (...) {
+            // the succeeding analyses are waiting for their turn
+            waitForTurn(Idx);
+            passTurn(Idx);
+            throw;
+          }
+          // the analysis may not have emitted any results
+          waitForTurn(Idx);
+          passTurn(Idx);
+        });
+  } catch (...) {
+    PT->setThreadSafe(false);
+    throw;
+  }
+  PT->setThreadSafe(false);
+}
+
+void AnalysisController::waitForTurn(size_t Idx) {
+  std::unique_lock<std::mutex> Lock(EmitMutex);
+  EmitTurn.wait(Lock, [this, Idx]() { return NextToEmit >= Idx; });
+}
+
+void AnalysisController::passTurn(size_t Idx) {
+  {
+    std::lock_guard<std::mutex> Lock(EmitMutex);
+    NextToEmit = std::max(NextToEmit, Idx + 1);
+  }
+  EmitTurn.notify_all();
+}
+
+template <typename ProblemTy, typename... ArgTys>
+void AnalysisController::executeWholeProgramIFDSAnalysis(
+    size_t Idx, const ArgTys &...Args) {
+  auto Solve = [this, Idx](auto &WPA) {
+    WPA.solve();
+    emitRequestedDataFlowResultsInTurn(Idx, WPA);
+    WPA.releaseAllHelperAnalyses();
+  };
+  if (UseNativeIFDSSolver) {
+    WholeProgramAnalysis<NativeIFDSSolver_P<ProblemTy>, ProblemTy> WPA(
+        IRDB, Args..., EntryPoints, PT.get(), ICF.get(), TH.get());
+    Solve(WPA);
+  } else {
+    WholeProgramAnalysis<IFDSSolver_P<ProblemTy>, ProblemTy> WPA(
+        IRDB, Args..., EntryPoints, PT.get(), ICF.get(), TH.get());
+    Solve(WPA);
+  }
+}
 
-      auto Problem = std::get<IntraMonoPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
-      IntraMonoSolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
-          *Problem);
+void AnalysisController::executeWholeProgramAnalysis(size_t Idx) {
+  const auto &_DataFlowAnalysis = DataFlowAnalyses[Idx];
+  // all whole-program analyses are given the first configuration
+  std::string AnalysisConfigPath =
+      AnalysisConfigs.empty() ? "" : AnalysisConfigs.front();
+  if (std::holds_alternative<DataFlowAnalysisType>(_DataFlowAnalysis)) {
+    auto DataFlowAnalysis = std::get<DataFlowAnalysisType>(_DataFlowAnalysis);
+    switch (DataFlowAnalysis) {
+    case DataFlowAnalysisType::IFDSUninitializedVariables: {
+      executeWholeProgramIFDSAnalysis<IFDSUninitializedVariables>(Idx);
+    } break;
+    case DataFlowAnalysisType::IFDSConstAnalysis: {
+      executeWholeProgramIFDSAnalysis<IFDSConstAnalysis>(Idx);
+    } break;
+    case DataFlowAnalysisType::IFDSTaintAnalysis: {
+      executeWholeProgramIFDSAnalysis<IFDSTaintAnalysis>(Idx,
+                                                         AnalysisConfigPath);
+    } break;
+    case DataFlowAnalysisType::IDETaintAnalysis: {
+      WholeProgramAnalysis<IDESolver_P<IDETaintAnalysis>, IDETaintAnalysis>
+          WPA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEOpenSSLTypeStateAnalysis: {
+      OpenSSLEVPKDFDescription TSDesc;
+      WholeProgramAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                           IDETypeStateAnalysis>
+          WPA(IRDB, &TSDesc, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+      WPA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IDECSTDIOTypeStateAnalysis: {
+      CSTDFILEIOTypeStateDescription TSDesc;
+      WholeProgramAnalysis<IDESolver_P<IDETypeStateAnalysis>,
+                           IDETypeStateAnalysis>
+          WPA(IRDB, &TSDesc, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+      WPA.releaseConfiguration();
+    } break;
+    case DataFlowAnalysisType::IFDSTypeAnalysis: {
+      executeWholeProgramIFDSAnalysis<IFDSTypeAnalysis>(Idx);
+    } break;
+    case DataFlowAnalysisType::IFDSSolverTest: {
+      executeWholeProgramIFDSAnalysis<IFDSSolverTest>(Idx);
+    } break;
+    case DataFlowAnalysisType::IFDSLinearConstantAnalysis: {
+      executeWholeProgramIFDSAnalysis<IFDSLinearConstantAnalysis>(Idx);
+    } break;
+    case DataFlowAnalysisType::IFDSFieldSensTaintAnalysis: {
+      executeWholeProgramIFDSAnalysis<IFDSFieldSensTaintAnalysis>(
+          Idx, AnalysisConfigPath);
+    } break;
+    case DataFlowAnalysisType::IDELinearConstantAnalysis: {
+      WholeProgramAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                           IDELinearConstantAnalysis>
+          WPA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDESolverTest: {
+      WholeProgramAnalysis<IDESolver_P<IDESolverTest>, IDESolverTest> WPA(
+          IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IDEInstInteractionAnalysis: {
+      WholeProgramAnalysis<IDESolver_P<IDEInstInteractionAnalysis>,
+                           IDEInstInteractionAnalysis>
+          WPA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IntraMonoFullConstantPropagation: {
+      WholeProgramAnalysis<IntraMonoSolver_P<IntraMonoFullConstantPropagation>,
+                           IntraMonoFullConstantPropagation>
+          WPA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::IntraMonoSolverTest: {
+      WholeProgramAnalysis<IntraMonoSolver_P<IntraMonoSolverTest>,
+                           IntraMonoSolverTest>
+          WPA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::InterMonoSolverTest: {
+      WholeProgramAnalysis<InterMonoSolver_P<InterMonoSolverTest, 3>,
+                           InterMonoSolverTest>
+          WPA(IRDB, EntryPoints, PT.get(), ICF.get(), TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    case DataFlowAnalysisType::InterMonoTaintAnalysis: {
+      WholeProgramAnalysis<InterMonoSolver_P<InterMonoTaintAnalysis, 3>,
+                           InterMonoTaintAnalysis>
+          WPA(IRDB, AnalysisConfigPath, EntryPoints, PT.get(), ICF.get(),
+              TH.get());
+      WPA.solve();
+      emitRequestedDataFlowResultsInTurn(Idx, WPA);
+      WPA.releaseAllHelperAnalyses();
+    } break;
+    default:
+      break;
+    }
+  } else if (std::holds_alternative<IFDSPluginConstructor>(
+                 _DataFlowAnalysis)) {
+    auto Problem = std::get<IFDSPluginConstructor>(_DataFlowAnalysis)(
+        &IRDB, TH.get(), ICF.get(), PT.get(), EntryPoints);
+    using ProblemTy = std::remove_reference<decltype(*Problem)>::type;
+    if (UseNativeIFDSSolver) {
+      NativeIFDSSolver_P<ProblemTy> Solver(*Problem);
       Solver.solve();
-      emitRequestedDataFlowResults(Solver);
-    } else if (std::holds_alternative<InterMonoPluginConstructor>(
-                   _DataFlowAnalysis)) {
-      auto Problem = std::get<InterMonoPluginConstructor>(_DataFlowAnalysis)(
-          &IRDB, &TH, &ICF, &PT, EntryPoints);
-      InterMonoSolver_P<std::remove_reference<decltype(*Problem)>::type, K>
-          Solver(*Problem);
+      emitRequestedDataFlowResultsInTurn(Idx, Solver);
+    } else {
+      IFDSSolver_P<ProblemTy> Solver(*Problem);
       Solver.solve();
-      emitRequestedDataFlowResults(Solver);
+      emitRequestedDataFlowResultsInTurn(Idx, Solver);
     }
+  } else if (std::holds_alternative<IDEPluginConstructor>(_DataFlowAnalysis)) {
+    auto Problem = std::get<IDEPluginConstructor>(_DataFlowAnalysis)(
+        &IRDB, TH.get(), ICF.get(), PT.get(), EntryPoints);
+    IDESolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
+        *Problem);
+    Solver.solve();
+    emitRequestedDataFlowResultsInTurn(Idx, Solver);
+  } else if (std::holds_alternative<IntraMonoPluginConstructor>(
+                 _DataFlowAnalysis)) {
+
+    auto Problem = std::get<IntraMonoPluginConstructor>(_DataFlowAnalysis)(
+        &IRDB, TH.get(), ICF.get(), PT.get(), EntryPoints);
+    IntraMonoSolver_P<std::remove_reference<decltype(*Problem)>::type> Solver(
+        *Problem);
+    Solver.solve();
+    emitRequestedDataFlowResultsInTurn(Idx, Solver);
+  } else if (std::holds_alternative<InterMonoPluginConstructor>(
+                 _DataFlowAnalysis)) {
+    auto Problem = std::get<InterMonoPluginConstructor>(_DataFlowAnalysis)(
+        &IRDB, TH.get(), ICF.get(), PT.get(), EntryPoints);
+    InterMonoSolver_P<std::remove_reference<decltype(*Problem)>::type, K>
+        Solver(*Problem);
+    Solver.solve();
+    emitRequestedDataFlowResultsInTurn(Idx, Solver);
   }
 }
 
@@ -321,74 +863,74 @@ void AnalysisController::emitRequestedHelperAnalysisResults() {
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsText) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-th.txt");
-      TH.print(OFS);
+      TH->print(OFS);
     } else {
-      TH.print();
+      TH->print();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsDot) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-th.dot");
-      TH.printAsDot(OFS);
+      TH->printAsDot(OFS);
     } else {
-      TH.printAsDot();
+      TH->printAsDot();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitTHAsJson) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-th.json");
-      TH.printAsJson(OFS);
+      TH->printAsJson(OFS);
     } else {
-      TH.printAsJson();
+      TH->printAsJson();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsText) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-pta.txt");
-      PT.print(OFS);
+      PT->print(OFS);
     } else {
-      PT.print();
+      PT->print();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsDot) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-pta.dot");
-      PT.print(OFS);
+      PT->print(OFS);
     } else {
-      PT.print();
+      PT->print();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitPTAAsJson) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-pta.json");
-      PT.printAsJson(OFS);
+      PT->printAsJson(OFS);
     } else {
-      PT.printAsJson();
+      PT->printAsJson();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsText) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-cg.txt");
-      ICF.print(OFS);
+      ICF->print(OFS);
     } else {
-      ICF.print();
+      ICF->print();
     }
   }
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsDot) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-cg.dot");
-      ICF.printAsDot(OFS);
+      ICF->printAsDot(OFS);
     } else {
-      ICF.printAsDot();
+      ICF->printAsDot();
     }
   }
 
   if (EmitterOptions & AnalysisControllerEmitterOptions::EmitCGAsJson) {
     if (!ResultDirectory.empty()) {
       std::ofstream OFS(ResultDirectory.string() + "/psr-cg.json");
-      ICF.printAsJson(OFS);
+      ICF->printAsJson(OFS);
     } else {
-      ICF.printAsJson();
+      ICF->printAsJson();
     }
   }
 }
@@ -17,6 +17,7 @@
 #include "llvm/Bitcode/BitcodeWriter.h"
 #include "llvm/Demangle/Demangle.h"
 #include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/LegacyPassManager.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
@@ -214,6 +215,48 @@ llvm::Module *ProjectIRDB::getWPAModule() {
   return WPAModule;
 }
 
+std::unique_ptr<ProjectIRDB>
+ProjectIRDB::getModuleIRDB(llvm::Module *M) const {
+  auto IRDB = std::make_unique<ProjectIRDB>(IRDBOptions::NONE);
+  for (const auto &[File, Module] : Modules) {
+    if (Module.get() == M) {
+      IRDB->Modules[File].reset(M);
+    }
+  }
+  assert(!IRDB->Modules.empty() && "module is not part of this ProjectIRDB");
+  IRDB->WPAModule = M;
+  for (const auto *Alloca : AllocaInstructions) {
+    if (Alloca->getModule() != M) {
+      continue;
+    }
+    IRDB->AllocaInstructions.insert(Alloca);
+    if (const auto *Stack = llvm::dyn_cast<llvm::AllocaInst>(Alloca)) {
+      IRDB->AllocatedTypes.insert(Stack->getAllocatedType());
+      continue;
+    }
+    // the types of heap allocations are those that they are cast to
+    for (const auto *User : Alloca->users()) {
+      if (const auto *Cast = llvm::dyn_cast<llvm::BitCastInst>(User)) {
+        const auto *Ty = Cast->getDestTy()->getPointerElementType();
+        if (AllocatedTypes.count(Ty)) {
+          IRDB->AllocatedTypes.insert(Ty);
+        }
+      }
+    }
+  }
+  for (const auto *RetOrRes : RetOrResInstructions) {
+    if (RetOrRes->getModule() == M) {
+      IRDB->RetOrResInstructions.insert(RetOrRes);
+    }
+  }
+  for (const auto &[ID, Inst] : IDInstructionMapping) {
+    if (Inst->getModule() == M) {
+      IRDB->IDInstructionMapping[ID] = Inst;
+    }
+  }
+  return IRDB;
+}
+
 void ProjectIRDB::buildIDModuleMapping(llvm::Module *M) {
   for (auto &F : *M) {
     for (auto &BB : F) {
@@ -238,6 +281,14 @@ llvm::Instruction *ProjectIRDB::getInstruction(std::size_t Id) {
   return nullptr;
 }
 
+const llvm::Instruction *ProjectIRDB::getInstruction(std::size_t Id) const {
+  if (auto It = IDInstructionMapping.find(Id);
+      It != IDInstructionMapping.end()) {
+    return It->second;
+  }
+  return nullptr;
+}
+
 std::size_t ProjectIRDB::getInstructionID(const llvm::Instruction *I) {
   std::size_t Id = 0;
   if (auto *MD = llvm::cast<llvm::MDString>(
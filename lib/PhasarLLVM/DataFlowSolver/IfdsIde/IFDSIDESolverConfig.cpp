@@ -7,19 +7,91 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <algorithm>
 #include <ostream>
+#include <string>
+
+#include "llvm/ADT/StringSwitch.h"
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryPool.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
 
 using namespace std;
 using namespace psr;
 
 namespace psr {
 
-IFDSIDESolverConfig::IFDSIDESolverConfig() {
-  setFlag(
-      Options, SolverConfigOptions::EmitESG,
-      PhasarConfig::getPhasarConfig().VariablesMap().count("emit-esg-as-dot"));
+std::string toString(const WorklistPolicy &P) {
+  switch (P) {
+  default:
+#define WORKLIST_POLICY_TYPE(NAME, TYPE)                                       \
+  case WorklistPolicy::TYPE:                                                   \
+    return NAME;                                                               \
+    break;
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicy.def"
+  case WorklistPolicy::Invalid:
+    return "Invalid";
+  }
+}
+
+WorklistPolicy toWorklistPolicy(const std::string &S) {
+  WorklistPolicy Type = llvm::StringSwitch<WorklistPolicy>(S)
+#define WORKLIST_POLICY_TYPE(NAME, TYPE) .Case(NAME, WorklistPolicy::TYPE)
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/WorklistPolicy.def"
+                            .Default(WorklistPolicy::Invalid);
+  return Type;
+}
+
+ostream &operator<<(ostream &OS, const WorklistPolicy &P) {
+  return OS << toString(P);
+}
+
+IFDSIDESolverConfig::IFDSIDESolverConfig()
+    : Budget(SolverBudget::fromPhasarConfig()) {
+  const auto &VariablesMap = PhasarConfig::getPhasarConfig().VariablesMap();
+  setFlag(Options, SolverConfigOptions::EmitESG,
+          VariablesMap.count("emit-esg-as-dot"));
+  setFlag(Options, SolverConfigOptions::DenseJumpFunctions,
+          VariablesMap.count("dense-jump-functions"));
+  setFlag(Options, SolverConfigOptions::RetireJumpFunctions,
+          VariablesMap.count("retire-jump-functions"));
+  if (VariablesMap.count("solver-worklist")) {
+    Policy = toWorklistPolicy(VariablesMap["solver-worklist"].as<string>());
+  }
+  if (VariablesMap.count("solver-threads")) {
+    setNumThreads(VariablesMap["solver-threads"].as<unsigned>());
+  }
+  if (VariablesMap.count("flow-edge-function-cache-capacity")) {
+    FlowEdgeFunctionCacheCapacity =
+        VariablesMap["flow-edge-function-cache-capacity"].as<size_t>();
+  }
+  if (VariablesMap.count("esg-log")) {
+    ESGLogFile = VariablesMap["esg-log"].as<string>();
+  }
+  if (VariablesMap.count("solver-profile")) {
+    ProfileFile = VariablesMap["solver-profile"].as<string>();
+  }
+  if (VariablesMap.count("persisted-summaries")) {
+    setComputePersistedSummaries();
+    SummaryStore = VariablesMap["persisted-summaries"].as<string>();
+  }
+  if (VariablesMap.count("solver-checkpoint")) {
+    CheckpointFile = VariablesMap["solver-checkpoint"].as<string>();
+  }
+  if (VariablesMap.count("solver-checkpoint-interval")) {
+    CheckpointInterval =
+        VariablesMap["solver-checkpoint-interval"].as<unsigned>();
+  }
+  setFlag(Options, SolverConfigOptions::ResumeFromCheckpoint,
+          VariablesMap.count("solver-resume"));
+  setFlag(Options, SolverConfigOptions::LazyValues,
+          VariablesMap.count("lazy-values"));
+  if (VariablesMap.count("library-summaries")) {
+    LibrarySummaries = std::make_shared<IFDSSummaryPool>(
+        IFDSSummaryPool::loadFromFile(
+            VariablesMap["library-summaries"].as<string>()));
+  }
 }
 IFDSIDESolverConfig::IFDSIDESolverConfig(SolverConfigOptions Options)
     : Options(Options) {}
@@ -42,6 +114,49 @@ bool IFDSIDESolverConfig::emitESG() const {
 bool IFDSIDESolverConfig::computePersistedSummaries() const {
   return hasFlag(Options, SolverConfigOptions::ComputePersistedSummaries);
 }
+bool IFDSIDESolverConfig::denseJumpFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::DenseJumpFunctions);
+}
+bool IFDSIDESolverConfig::retireJumpFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::RetireJumpFunctions);
+}
+bool IFDSIDESolverConfig::persistJumpFunctions() const {
+  return hasFlag(Options, SolverConfigOptions::PersistJumpFunctions);
+}
+bool IFDSIDESolverConfig::resumeFromCheckpoint() const {
+  return hasFlag(Options, SolverConfigOptions::ResumeFromCheckpoint);
+}
+bool IFDSIDESolverConfig::lazyValues() const {
+  return hasFlag(Options, SolverConfigOptions::LazyValues);
+}
+WorklistPolicy IFDSIDESolverConfig::worklistPolicy() const { return Policy; }
+unsigned IFDSIDESolverConfig::numThreads() const { return NumThreads; }
+size_t IFDSIDESolverConfig::flowEdgeFunctionCacheCapacity() const {
+  return FlowEdgeFunctionCacheCapacity;
+}
+const std::string &IFDSIDESolverConfig::esgLogFile() const {
+  return ESGLogFile;
+}
+const std::string &IFDSIDESolverConfig::profileFile() const {
+  return ProfileFile;
+}
+const std::string &IFDSIDESolverConfig::summaryStore() const {
+  return SummaryStore;
+}
+const SolverBudget &IFDSIDESolverConfig::budget() const { return Budget; }
+const std::string &IFDSIDESolverConfig::checkpointFile() const {
+  return CheckpointFile;
+}
+unsigned IFDSIDESolverConfig::checkpointInterval() const {
+  return CheckpointInterval;
+}
+const IFDSSummaryPool *IFDSIDESolverConfig::librarySummaries() const {
+  return LibrarySummaries.get();
+}
+const std::shared_ptr<psr::SummaryStore> &
+IFDSIDESolverConfig::sharedSummaryStore() const {
+  return SharedSummaryStore;
+}
 
 void IFDSIDESolverConfig::setFollowReturnsPastSeeds(bool Set) {
   setFlag(Options, SolverConfigOptions::FollowReturnsPastSeeds, Set);
@@ -61,6 +176,53 @@ void IFDSIDESolverConfig::setEmitESG(bool Set) {
 void IFDSIDESolverConfig::setComputePersistedSummaries(bool Set) {
   setFlag(Options, SolverConfigOptions::ComputePersistedSummaries, Set);
 }
+void IFDSIDESolverConfig::setDenseJumpFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::DenseJumpFunctions, Set);
+}
+void IFDSIDESolverConfig::setRetireJumpFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::RetireJumpFunctions, Set);
+}
+void IFDSIDESolverConfig::setPersistJumpFunctions(bool Set) {
+  setFlag(Options, SolverConfigOptions::PersistJumpFunctions, Set);
+}
+void IFDSIDESolverConfig::setWorklistPolicy(WorklistPolicy P) { Policy = P; }
+void IFDSIDESolverConfig::setNumThreads(unsigned N) {
+  // hardware_concurrency() may report 0 if the value is not computable
+  NumThreads = std::max(N, 1u);
+}
+void IFDSIDESolverConfig::setFlowEdgeFunctionCacheCapacity(size_t Capacity) {
+  FlowEdgeFunctionCacheCapacity = Capacity;
+}
+void IFDSIDESolverConfig::setESGLogFile(std::string Path) {
+  ESGLogFile = std::move(Path);
+}
+void IFDSIDESolverConfig::setProfileFile(std::string Path) {
+  ProfileFile = std::move(Path);
+}
+void IFDSIDESolverConfig::setSummaryStore(std::string Directory) {
+  SummaryStore = std::move(Directory);
+}
+void IFDSIDESolverConfig::setBudget(SolverBudget B) { Budget = std::move(B); }
+void IFDSIDESolverConfig::setCheckpointFile(std::string Path) {
+  CheckpointFile = std::move(Path);
+}
+void IFDSIDESolverConfig::setCheckpointInterval(unsigned Seconds) {
+  CheckpointInterval = Seconds;
+}
+void IFDSIDESolverConfig::setResumeFromCheckpoint(bool Set) {
+  setFlag(Options, SolverConfigOptions::ResumeFromCheckpoint, Set);
+}
+void IFDSIDESolverConfig::setLazyValues(bool Set) {
+  setFlag(Options, SolverConfigOptions::LazyValues, Set);
+}
+void IFDSIDESolverConfig::setLibrarySummaries(
+    std::shared_ptr<const IFDSSummaryPool> Summaries) {
+  LibrarySummaries = std::move(Summaries);
+}
+void IFDSIDESolverConfig::setSharedSummaryStore(
+    std::shared_ptr<psr::SummaryStore> Store) {
+  SharedSummaryStore = std::move(Store);
+}
 
 ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
   return OS << "IFDSIDESolverConfig:\n"
@@ -71,7 +233,26 @@ ostream &operator<<(ostream &OS, const IFDSIDESolverConfig &SC) {
             << "\trecordEdges: " << SC.recordEdges() << "\n"
             << "\tcomputePersistedSummaries: " << SC.computePersistedSummaries()
             << "\n"
-            << "\temitESG: " << SC.emitESG();
+            << "\temitESG: " << SC.emitESG() << "\n"
+            << "\tdenseJumpFunctions: " << SC.denseJumpFunctions() << "\n"
+            << "\tretireJumpFunctions: " << SC.retireJumpFunctions() << "\n"
+            << "\tpersistJumpFunctions: " << SC.persistJumpFunctions()
+            << "\n"
+            << "\tworklistPolicy: " << SC.worklistPolicy() << "\n"
+            << "\tnumThreads: " << SC.numThreads() << "\n"
+            << "\tflowEdgeFunctionCacheCapacity: "
+            << SC.flowEdgeFunctionCacheCapacity() << "\n"
+            << "\tesgLogFile: " << SC.esgLogFile() << "\n"
+            << "\tprofileFile: " << SC.profileFile() << "\n"
+            << "\tsummaryStore: " << SC.summaryStore() << "\n"
+            << "\tbudget: " << SC.budget() << "\n"
+            << "\tcheckpointFile: " << SC.checkpointFile() << "\n"
+            << "\tcheckpointInterval: " << SC.checkpointInterval() << "\n"
+            << "\tresumeFromCheckpoint: " << SC.resumeFromCheckpoint() << "\n"
+            << "\tlazyValues: " << SC.lazyValues() << "\n"
+            << "\tlibrarySummaries: " << (SC.librarySummaries() != nullptr)
+            << "\n"
+            << "\tsharedSummaryStore: " << (SC.sharedSummaryStore() != nullptr);
 }
 
 } // namespace psr
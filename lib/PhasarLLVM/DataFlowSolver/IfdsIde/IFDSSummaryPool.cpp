@@ -0,0 +1,268 @@
+/******************************************************************************
+ * Copyright (c) 2017 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <ios>
+#include <ostream>
+#include <utility>
+
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/InstrTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Module.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryPool.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+namespace {
+
+/// Applies a function's summaries at one of its call sites.
+class IFDSSummaryFlowFunction : public FlowFunction<const llvm::Value *> {
+public:
+  IFDSSummaryFlowFunction(const IFDSSummaryPool &Pool,
+                          const llvm::CallBase *CallSite, std::string Callee,
+                          const llvm::Value *ZeroValue)
+      : Pool(Pool), CallSite(CallSite), Callee(std::move(Callee)),
+        ZeroValue(ZeroValue) {}
+
+  container_type computeTargets(const llvm::Value *Source) override {
+    const auto *Summaries = Pool.getSummaries(Callee);
+    // the inputs that Source is passed as
+    std::vector<bool> Inputs(Summaries->Inputs.size());
+    if (Source != ZeroValue) {
+      bool Passed = false;
+      for (size_t Idx = 0; Idx < Inputs.size(); ++Idx) {
+        const auto *Actual = getValue(Summaries->Inputs[Idx]);
+        Inputs[Idx] = Actual == Source;
+        Passed |= Inputs[Idx];
+      }
+      if (!Passed) {
+        return {};
+      }
+    }
+    container_type Targets;
+    if (const auto *Outputs = Pool.getCoveringSummary(Callee, Inputs)) {
+      for (const auto &Output : *Outputs) {
+        if (const auto *Target = getValue(Output)) {
+          Targets.insert(Target);
+        }
+      }
+    }
+    return Targets;
+  }
+
+private:
+  /// Returns the caller's value that the given interface ID refers to.
+  const llvm::Value *getValue(const std::string &ID) const {
+    if (ID == "ret") {
+      return CallSite->getType()->isVoidTy() ? nullptr : CallSite;
+    }
+    if (ID.empty()) {
+      return nullptr;
+    }
+    if (ID[0] == '@') {
+      return CallSite->getModule()->getNamedValue(ID.substr(1));
+    }
+    unsigned ArgNo;
+    if (ID[0] != 'a' ||
+        llvm::StringRef(ID).drop_front().getAsInteger(10, ArgNo) ||
+        ArgNo >= CallSite->arg_size()) {
+      return nullptr;
+    }
+    return CallSite->getArgOperand(ArgNo);
+  }
+
+  const IFDSSummaryPool &Pool;
+  const llvm::CallBase *CallSite;
+  std::string Callee;
+  const llvm::Value *ZeroValue;
+};
+
+} // namespace
+
+optional<string> IFDSSummaryPool::getInterfaceID(const llvm::Function *F,
+                                                 const llvm::Instruction *Exit,
+                                                 const llvm::Value *V) {
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    if (Arg->getParent() == F) {
+      return "a" + to_string(Arg->getArgNo());
+    }
+    return nullopt;
+  }
+  if (const auto *Ret = llvm::dyn_cast_or_null<llvm::ReturnInst>(Exit)) {
+    if (Ret->getReturnValue() == V) {
+      return "ret";
+    }
+  }
+  if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+    if (G->hasName()) {
+      return "@" + G->getName().str();
+    }
+  }
+  return nullopt;
+}
+
+vector<string> IFDSSummaryPool::getInputs(const llvm::Function *F) {
+  vector<string> Inputs;
+  for (const auto &Arg : F->args()) {
+    Inputs.push_back("a" + to_string(Arg.getArgNo()));
+  }
+  return Inputs;
+}
+
+void IFDSSummaryPool::insertSummary(const string &FunctionName,
+                                    vector<string> Inputs,
+                                    vector<bool> Context,
+                                    set<string> Outputs) {
+  auto &Summaries = SummaryMap[FunctionName];
+  Summaries.Inputs = std::move(Inputs);
+  Summaries.Outputs[std::move(Context)] = std::move(Outputs);
+}
+
+void IFDSSummaryPool::merge(const IFDSSummaryPool &Other) {
+  for (const auto &[FunctionName, Summaries] : Other.SummaryMap) {
+    auto &Merged = SummaryMap[FunctionName];
+    Merged.Inputs = Summaries.Inputs;
+    for (const auto &[Context, Outputs] : Summaries.Outputs) {
+      Merged.Outputs[Context] = Outputs;
+    }
+  }
+}
+
+bool IFDSSummaryPool::containsSummary(const string &FunctionName) const {
+  return SummaryMap.count(FunctionName);
+}
+
+const IFDSSummaryPool::FunctionSummaries *
+IFDSSummaryPool::getSummaries(const string &FunctionName) const {
+  auto Search = SummaryMap.find(FunctionName);
+  return Search != SummaryMap.end() ? &Search->second : nullptr;
+}
+
+const set<string> *
+IFDSSummaryPool::getSummary(const string &FunctionName,
+                            const vector<bool> &Context) const {
+  const auto *Summaries = getSummaries(FunctionName);
+  if (!Summaries) {
+    return nullptr;
+  }
+  auto Search = Summaries->Outputs.find(Context);
+  return Search != Summaries->Outputs.end() ? &Search->second : nullptr;
+}
+
+const set<string> *
+IFDSSummaryPool::getCoveringSummary(const string &FunctionName,
+                                    const vector<bool> &Inputs) const {
+  const auto *Summaries = getSummaries(FunctionName);
+  if (!Summaries) {
+    return nullptr;
+  }
+  const set<string> *Covering = nullptr;
+  size_t CoveringSize = 0;
+  for (const auto &[Context, Outputs] : Summaries->Outputs) {
+    if (Context.size() != Inputs.size()) {
+      continue;
+    }
+    bool Covers = true;
+    for (size_t Idx = 0; Idx < Inputs.size() && Covers; ++Idx) {
+      Covers = !Inputs[Idx] || Context[Idx];
+    }
+    size_t Size = std::count(Context.begin(), Context.end(), true);
+    if (Covers && (!Covering || Size < CoveringSize)) {
+      Covering = &Outputs;
+      CoveringSize = Size;
+    }
+  }
+  return Covering;
+}
+
+shared_ptr<FlowFunction<const llvm::Value *>>
+IFDSSummaryPool::getSummaryFlowFunction(const llvm::Instruction *CallSite,
+                                        const llvm::Function *Callee,
+                                        const llvm::Value *ZeroValue) const {
+  const auto *CS = llvm::dyn_cast<llvm::CallBase>(CallSite);
+  if (!CS || !containsSummary(Callee->getName().str())) {
+    return nullptr;
+  }
+  return make_shared<IFDSSummaryFlowFunction>(*this, CS,
+                                              Callee->getName().str(),
+                                              ZeroValue);
+}
+
+nlohmann::json IFDSSummaryPool::getAsJson() const {
+  nlohmann::json J = nlohmann::json::object();
+  for (const auto &[FunctionName, Summaries] : SummaryMap) {
+    nlohmann::json &FJ = J[FunctionName];
+    FJ["Inputs"] = Summaries.Inputs;
+    FJ["Contexts"] = nlohmann::json::array();
+    for (const auto &[Context, Outputs] : Summaries.Outputs) {
+      string Bits;
+      for (bool B : Context) {
+        Bits += B ? '1' : '0';
+      }
+      FJ["Contexts"].push_back({{"Context", Bits}, {"Outputs", Outputs}});
+    }
+  }
+  return J;
+}
+
+IFDSSummaryPool IFDSSummaryPool::fromJson(const nlohmann::json &J) {
+  IFDSSummaryPool Pool;
+  for (const auto &[FunctionName, FJ] : J.items()) {
+    auto &Summaries = Pool.SummaryMap[FunctionName];
+    Summaries.Inputs = FJ.at("Inputs").get<vector<string>>();
+    for (const auto &CJ : FJ.at("Contexts")) {
+      vector<bool> Context;
+      for (char C : CJ.at("Context").get<string>()) {
+        Context.push_back(C == '1');
+      }
+      Summaries.Outputs[std::move(Context)] =
+          CJ.at("Outputs").get<set<string>>();
+    }
+  }
+  return Pool;
+}
+
+IFDSSummaryPool IFDSSummaryPool::loadFromFile(const string &Path) {
+  ifstream IFS(Path);
+  if (!IFS) {
+    throw ios_base::failure("could not read file: " + Path);
+  }
+  nlohmann::json J;
+  IFS >> J;
+  return fromJson(J);
+}
+
+void IFDSSummaryPool::print(ostream &OS) const {
+  OS << "IFDSSummaryPool:\n";
+  for (const auto &[FunctionName, Summaries] : SummaryMap) {
+    OS << "Function: " << FunctionName << "\n";
+    for (const auto &[Context, Outputs] : Summaries.Outputs) {
+      OS << "Context: ";
+      for (bool B : Context) {
+        OS << B;
+      }
+      OS << " -> {";
+      bool First = true;
+      for (const auto &Output : Outputs) {
+        OS << (First ? "" : ", ") << Output;
+        First = false;
+      }
+      OS << "}\n";
+    }
+  }
+}
+
+} // namespace psr
@@ -21,15 +21,17 @@ void ObservedCallingContexts::addObservedCTX(const string &FName,
   ObservedCTX[FName].insert(CTX);
 }
 
-bool ObservedCallingContexts::containsCTX(const string &FName) {
+bool ObservedCallingContexts::containsCTX(const string &FName) const {
   return ObservedCTX.find(FName) != ObservedCTX.end();
 }
 
-set<vector<bool>> ObservedCallingContexts::getObservedCTX(const string &FName) {
-  return ObservedCTX[FName];
+set<vector<bool>>
+ObservedCallingContexts::getObservedCTX(const string &FName) const {
+  auto Search = ObservedCTX.find(FName);
+  return Search != ObservedCTX.end() ? Search->second : set<vector<bool>>{};
 }
 
-void ObservedCallingContexts::print() {
+void ObservedCallingContexts::print() const {
   for (auto &Entry : ObservedCTX) {
     cout << Entry.first << "\n";
     for (const auto &Ctx : Entry.second) {
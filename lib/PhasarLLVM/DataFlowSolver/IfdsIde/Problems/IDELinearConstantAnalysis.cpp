@@ -40,9 +40,9 @@ using namespace psr;
 
 namespace psr {
 // Initialize debug counter for edge functions
-unsigned IDELinearConstantAnalysis::CurrGenConstantId = 0;
-unsigned IDELinearConstantAnalysis::CurrLCAIDId = 0;
-unsigned IDELinearConstantAnalysis::CurrBinaryId = 0;
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrGenConstantId{0};
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrLCAIDId{0};
+std::atomic<unsigned> IDELinearConstantAnalysis::CurrBinaryId{0};
 
 const IDELinearConstantAnalysis::l_t IDELinearConstantAnalysis::TOP =
     numeric_limits<IDELinearConstantAnalysis::l_t>::min();
@@ -483,6 +483,145 @@ IDELinearConstantAnalysis::allTopFunction() {
   return make_shared<AllTop<IDELinearConstantAnalysis::l_t>>(TOP);
 }
 
+std::string IDELinearConstantAnalysis::getSummaryAnalysisID() const {
+  return "ide-lca";
+}
+
+const FunctionLocalIDs &
+IDELinearConstantAnalysis::getLocalIDs(const llvm::Function *F) {
+  std::lock_guard<std::mutex> Lock(LocalIDsMutex);
+  return LocalIDs.try_emplace(F, F).first->second;
+}
+
+// The edge functions are represented as follows:
+//  - "id", "lid", "top" and "bottom" for the identities and the constant
+//    functions of the lattice's top and bottom
+//  - "c<constant>" for GenConstant
+//  - "b<z|l|r>:<instruction ID>:<function name>" for BinOp, where the first
+//    character tells whether the current node is the zero value or the left
+//    or right operand of the instruction
+//  - "o<length of F>:<F><G>" for LCAEdgeFunctionComposer
+std::string IDELinearConstantAnalysis::edgeFunctionToSummaryString(
+    const shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>> &EF) {
+  switch (EF->getKind()) {
+  case EdgeFunctionKind::Identity:
+    return "id";
+  case EdgeFunctionKind::AllTop:
+    return "top";
+  case EdgeFunctionKind::AllBottom:
+    return "bottom";
+  default:
+    break;
+  }
+  if (dynamic_cast<LCAIdentity *>(EF.get())) {
+    return "lid";
+  }
+  if (auto *GC = dynamic_cast<GenConstant *>(EF.get())) {
+    return "c" + std::to_string(GC->IntConst);
+  }
+  if (auto *Composer = dynamic_cast<LCAEdgeFunctionComposer *>(EF.get())) {
+    auto F = edgeFunctionToSummaryString(Composer->F);
+    auto G = edgeFunctionToSummaryString(Composer->G);
+    if (F.empty() || G.empty()) {
+      return {};
+    }
+    return "o" + std::to_string(F.size()) + ":" + F + G;
+  }
+  auto *BOP = dynamic_cast<BinOp *>(EF.get());
+  if (!BOP) {
+    return {};
+  }
+  char Kind;
+  if (isZeroValue(BOP->currNode)) {
+    Kind = 'z';
+  } else if (BOP->currNode == BOP->lop) {
+    Kind = 'l';
+  } else if (BOP->currNode == BOP->rop) {
+    Kind = 'r';
+  } else {
+    return {};
+  }
+  // the instruction is a user of both of its operands
+  for (const auto *User : BOP->lop->users()) {
+    const auto *Inst = llvm::dyn_cast<llvm::BinaryOperator>(User);
+    if (!Inst || Inst->getOpcode() != BOP->Op ||
+        Inst->getOperand(0) != BOP->lop || Inst->getOperand(1) != BOP->rop) {
+      continue;
+    }
+    const auto *F = Inst->getFunction();
+    if (auto ID = getLocalIDs(F).getID(Inst)) {
+      return std::string("b") + Kind + ":" + *ID + ":" + F->getName().str();
+    }
+  }
+  return {};
+}
+
+shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
+IDELinearConstantAnalysis::edgeFunctionFromSummaryString(const std::string &S) {
+  if (S == "id") {
+    return EdgeIdentity<IDELinearConstantAnalysis::l_t>::getInstance();
+  }
+  if (S == "lid") {
+    return make_shared<LCAIdentity>();
+  }
+  if (S == "top") {
+    return allTopFunction();
+  }
+  if (S == "bottom") {
+    return make_shared<AllBottom<IDELinearConstantAnalysis::l_t>>(
+        IDELinearConstantAnalysis::BOTTOM);
+  }
+  if (S.empty()) {
+    return nullptr;
+  }
+  llvm::StringRef Rest = llvm::StringRef(S).drop_front();
+  if (S[0] == 'c') {
+    IDELinearConstantAnalysis::l_t IntConst;
+    if (Rest.getAsInteger(10, IntConst)) {
+      return nullptr;
+    }
+    return make_shared<GenConstant>(IntConst);
+  }
+  if (S[0] == 'o') {
+    auto [Length, FG] = Rest.split(':');
+    size_t FLength;
+    if (Length.getAsInteger(10, FLength) || FLength >= FG.size()) {
+      return nullptr;
+    }
+    auto F = edgeFunctionFromSummaryString(FG.take_front(FLength).str());
+    auto G = edgeFunctionFromSummaryString(FG.drop_front(FLength).str());
+    if (!F || !G) {
+      return nullptr;
+    }
+    return make_shared<LCAEdgeFunctionComposer>(F, G);
+  }
+  if (S[0] != 'b' || Rest.size() < 2 || Rest[1] != ':') {
+    return nullptr;
+  }
+  auto [ID, FunctionName] = Rest.drop_front(2).split(':');
+  const auto *F = IRDB->getFunctionDefinition(FunctionName);
+  if (!F) {
+    return nullptr;
+  }
+  const auto *Inst =
+      llvm::dyn_cast_or_null<llvm::BinaryOperator>(getLocalIDs(F).getValue(ID));
+  if (!Inst) {
+    return nullptr;
+  }
+  const auto *Lop = Inst->getOperand(0);
+  const auto *Rop = Inst->getOperand(1);
+  switch (Rest[0]) {
+  case 'z':
+    return make_shared<BinOp>(Inst->getOpcode(), Lop, Rop, ZeroValue);
+  case 'l':
+    return make_shared<BinOp>(Inst->getOpcode(), Lop, Rop, Lop);
+  case 'r':
+    return make_shared<BinOp>(Inst->getOpcode(), Lop, Rop, Rop);
+  default:
+    return nullptr;
+  }
+}
+
 shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>>
 IDELinearConstantAnalysis::LCAEdgeFunctionComposer::composeWith(
     shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>> SecondFunction) {
@@ -605,7 +744,9 @@ IDELinearConstantAnalysis::LCAIdentity::joinWith(
 
 bool IDELinearConstantAnalysis::LCAIdentity::equal_to(
     shared_ptr<EdgeFunction<IDELinearConstantAnalysis::l_t>> Other) const {
-  return this == Other.get();
+  // all instances are equal, e.g., the ones restored from a summary
+  return dynamic_cast<IDELinearConstantAnalysis::LCAIdentity *>(
+             Other.get()) != nullptr;
 }
 
 void IDELinearConstantAnalysis::LCAIdentity::print(ostream &OS,
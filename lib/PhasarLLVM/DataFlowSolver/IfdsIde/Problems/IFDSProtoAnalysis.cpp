@@ -109,4 +109,8 @@ void IFDSProtoAnalysis::printFunction(ostream &OS,
   OS << M->getName().str();
 }
 
+std::string IFDSProtoAnalysis::getSummaryAnalysisID() const {
+  return "ifds-proto";
+}
+
 } // namespace psr
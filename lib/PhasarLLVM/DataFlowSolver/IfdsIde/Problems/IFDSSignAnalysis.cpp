@@ -104,4 +104,8 @@ void IFDSSignAnalysis::printFunction(ostream &OS,
   OS << M->getName().str();
 }
 
+std::string IFDSSignAnalysis::getSummaryAnalysisID() const {
+  return "ifds-sign";
+}
+
 } // namespace psr
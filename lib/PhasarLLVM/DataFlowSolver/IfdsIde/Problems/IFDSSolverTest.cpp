@@ -102,4 +102,8 @@ void IFDSSolverTest::printFunction(ostream &OS, IFDSSolverTest::f_t M) const {
   OS << M->getName().str();
 }
 
+std::string IFDSSolverTest::getSummaryAnalysisID() const {
+  return "ifds-solvertest";
+}
+
 } // namespace psr
@@ -7,6 +7,7 @@
  *     Philipp Schubert and others
  *****************************************************************************/
 
+#include <sstream>
 #include <utility>
 
 #include "llvm/Demangle/Demangle.h"
@@ -307,4 +308,14 @@ void IFDSTaintAnalysis::emitTextReport(
   }
 }
 
+std::string IFDSTaintAnalysis::getSummaryAnalysisID() const {
+  if (PT->isInterProcedural()) {
+    return {};
+  }
+  std::stringstream ID;
+  ID << "ifds-taint:" << PT->getPointerAnalysistype() << ':'
+     << SourceSinkFunctions;
+  return ID.str();
+}
+
 } // namespace psr
@@ -123,4 +123,8 @@ void IFDSTypeAnalysis::printFunction(ostream &OS,
   OS << M->getName().str();
 }
 
+std::string IFDSTypeAnalysis::getSummaryAnalysisID() const {
+  return "ifds-type";
+}
+
 } // namespace psr
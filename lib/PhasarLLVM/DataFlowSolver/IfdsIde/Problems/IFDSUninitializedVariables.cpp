@@ -554,6 +554,10 @@ void IFDSUninitializedVariables::UninitResult::print(std::ostream &OS) {
   }
 }
 
+std::string IFDSUninitializedVariables::getSummaryAnalysisID() const {
+  return "ifds-uninit";
+}
+
 const std::map<IFDSUninitializedVariables::n_t,
                std::set<IFDSUninitializedVariables::d_t>> &
 IFDSUninitializedVariables::getAllUndefUses() const {
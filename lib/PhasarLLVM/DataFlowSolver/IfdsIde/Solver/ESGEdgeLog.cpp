@@ -0,0 +1,462 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <map>
+#include <numeric>
+#include <ostream>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Process.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGEdgeLog.h"
+#include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+#include "phasar/Utils/Utilities.h"
+
+using namespace std;
+using namespace psr;
+
+namespace {
+
+constexpr char Magic[8] = {'P', 'S', 'R', 'E', 'S', 'G', '\0', '\0'};
+constexpr uint32_t Version = 1;
+
+// occupies the first record slot of the log
+struct ESGEdgeLogHeader {
+  char Magic[8];
+  uint32_t Version;
+  uint32_t RecordSize;
+  uint64_t NumRecords;
+};
+
+static_assert(sizeof(ESGEdgeLogHeader) == sizeof(ESGEdgeRecord),
+              "the header must occupy exactly one record slot");
+
+// the minimal size of the memory-mapped window
+constexpr uint64_t MinWindowSize = 4 * 1024 * 1024;
+
+std::string escape(llvm::StringRef S) {
+  std::string Escaped;
+  Escaped.reserve(S.size());
+  for (char C : S) {
+    switch (C) {
+    case '\\':
+      Escaped += "\\\\";
+      break;
+    case '\t':
+      Escaped += "\\t";
+      break;
+    case '\n':
+      Escaped += "\\n";
+      break;
+    default:
+      Escaped += C;
+    }
+  }
+  return Escaped;
+}
+
+std::string unescape(llvm::StringRef S) {
+  std::string Unescaped;
+  Unescaped.reserve(S.size());
+  for (size_t I = 0; I < S.size(); ++I) {
+    if (S[I] == '\\' && I + 1 < S.size()) {
+      char C = S[++I];
+      Unescaped += C == 't' ? '\t' : C == 'n' ? '\n' : C;
+    } else {
+      Unescaped += S[I];
+    }
+  }
+  return Unescaped;
+}
+
+[[noreturn]] void malformed(const std::string &Path) {
+  throw std::ios_base::failure("malformed ESG edge log: " + Path);
+}
+
+/// Reads the name table of the log at Path. Each line is a tab-separated
+/// entry: 'N' <function> <statement id> <is exit> <label> for nodes,
+/// 'F' <is zero> <label> for facts and 'L' <label> for edge function labels.
+void readNames(const std::string &Path, ESGEdgeLog &Log) {
+  std::ifstream Names(Path + ".names");
+  if (!Names) {
+    throw std::ios_base::failure("could not read file: " + Path + ".names");
+  }
+  std::string Line;
+  llvm::SmallVector<llvm::StringRef, 5> Fields;
+  while (std::getline(Names, Line)) {
+    Fields.clear();
+    llvm::StringRef(Line).split(Fields, '\t');
+    if (Fields[0] == "N" && Fields.size() == 5) {
+      Log.Nodes.push_back({unescape(Fields[1]), unescape(Fields[2]),
+                           unescape(Fields[4]), Fields[3] == "1"});
+    } else if (Fields[0] == "F" && Fields.size() == 3) {
+      Log.Facts.push_back({unescape(Fields[2]), Fields[1] == "1"});
+    } else if (Fields[0] == "L" && Fields.size() == 2) {
+      Log.Labels.push_back(unescape(Fields[1]));
+    } else {
+      malformed(Path);
+    }
+  }
+}
+
+} // anonymous namespace
+
+namespace psr {
+
+std::string toString(ESGEdgeKind Kind) {
+  switch (Kind) {
+  case ESGEdgeKind::Normal:
+    return "normal";
+  case ESGEdgeKind::CallToReturn:
+    return "call-to-return";
+  case ESGEdgeKind::Call:
+    return "call";
+  case ESGEdgeKind::Return:
+    return "return";
+  case ESGEdgeKind::EdgeFunction:
+    return "edge-function";
+  }
+  return "unknown";
+}
+
+ESGEdgeLogWriter::ESGEdgeLogWriter(std::string Path)
+    : Path(std::move(Path)), Names(this->Path + ".names") {
+  if (!Names || llvm::sys::fs::openFileForReadWrite(
+                    this->Path, FD, llvm::sys::fs::CD_CreateAlways,
+                    llvm::sys::fs::OF_None)) {
+    FD = -1;
+    throw std::ios_base::failure("could not write file: " + this->Path);
+  }
+  // the window must start at multiples of the mapping's alignment and must
+  // hold whole records
+  uint64_t Granularity =
+      std::lcm(uint64_t(llvm::sys::fs::mapped_file_region::alignment()),
+               uint64_t(sizeof(ESGEdgeRecord)));
+  uint64_t WindowSize =
+      ((MinWindowSize + Granularity - 1) / Granularity) * Granularity;
+  SlotsPerWindow = WindowSize / sizeof(ESGEdgeRecord);
+  mapWindow(0);
+}
+
+ESGEdgeLogWriter::~ESGEdgeLogWriter() {
+  try {
+    close();
+  } catch (const std::ios_base::failure &) {
+    // destructors must not throw; the log remains without a header then
+  }
+}
+
+void ESGEdgeLogWriter::mapWindow(uint64_t FirstSlot) {
+  Window.reset();
+  uint64_t Offset = FirstSlot * sizeof(ESGEdgeRecord);
+  uint64_t WindowSize = SlotsPerWindow * sizeof(ESGEdgeRecord);
+  std::error_code EC = llvm::sys::fs::resize_file(FD, Offset + WindowSize);
+  if (!EC) {
+    Window = std::make_unique<llvm::sys::fs::mapped_file_region>(
+        llvm::sys::fs::convertFDToNativeFile(FD),
+        llvm::sys::fs::mapped_file_region::readwrite, WindowSize, Offset, EC);
+  }
+  if (EC) {
+    Window.reset();
+    throw std::ios_base::failure("could not write file: " + Path);
+  }
+  WindowBegin = FirstSlot;
+}
+
+void ESGEdgeLogWriter::append(const ESGEdgeRecord &Record) {
+  if (NextSlot == WindowBegin + SlotsPerWindow) {
+    mapWindow(NextSlot);
+  }
+  std::memcpy(Window->data() + (NextSlot - WindowBegin) * sizeof(Record),
+              &Record, sizeof(Record));
+  ++NextSlot;
+}
+
+uint32_t ESGEdgeLogWriter::addNode(const ESGNodeName &Name) {
+  Names << "N\t" << escape(Name.Function) << '\t' << escape(Name.StmtId)
+        << '\t' << Name.IsExit << '\t' << escape(Name.Label) << '\n';
+  return NumNodes++;
+}
+
+uint32_t ESGEdgeLogWriter::addFact(const ESGFactName &Name) {
+  Names << "F\t" << Name.IsZero << '\t' << escape(Name.Label) << '\n';
+  return NumFacts++;
+}
+
+uint32_t ESGEdgeLogWriter::addLabel(const std::string &Label) {
+  Names << "L\t" << escape(Label) << '\n';
+  return NumLabels++;
+}
+
+void ESGEdgeLogWriter::close() {
+  if (isClosed()) {
+    return;
+  }
+  Window.reset();
+  Names.close();
+  ESGEdgeLogHeader Header{{}, Version, sizeof(ESGEdgeRecord), size()};
+  std::memcpy(Header.Magic, Magic, sizeof(Magic));
+  std::error_code EC =
+      llvm::sys::fs::resize_file(FD, NextSlot * sizeof(ESGEdgeRecord));
+  if (!EC) {
+    llvm::sys::fs::mapped_file_region HeaderRegion(
+        llvm::sys::fs::convertFDToNativeFile(FD),
+        llvm::sys::fs::mapped_file_region::readwrite, sizeof(Header), 0, EC);
+    if (!EC) {
+      std::memcpy(HeaderRegion.data(), &Header, sizeof(Header));
+    }
+  }
+  llvm::sys::Process::SafelyCloseFileDescriptor(FD);
+  FD = -1;
+  if (EC || !Names) {
+    throw std::ios_base::failure("could not write file: " + Path);
+  }
+}
+
+ESGEdgeLog ESGEdgeLog::read(const std::string &Path) {
+  auto Buffer = llvm::MemoryBuffer::getFile(Path);
+  if (!Buffer) {
+    throw std::ios_base::failure("could not read file: " + Path);
+  }
+  llvm::StringRef Data = (*Buffer)->getBuffer();
+  ESGEdgeLogHeader Header;
+  if (Data.size() < sizeof(Header)) {
+    malformed(Path);
+  }
+  std::memcpy(&Header, Data.data(), sizeof(Header));
+  if (std::memcmp(Header.Magic, Magic, sizeof(Magic)) != 0 ||
+      Header.Version != Version ||
+      Header.RecordSize != sizeof(ESGEdgeRecord) ||
+      Header.NumRecords > Data.size() / sizeof(ESGEdgeRecord) - 1) {
+    malformed(Path);
+  }
+  ESGEdgeLog Log;
+  Log.Records.resize(Header.NumRecords);
+  std::memcpy(Log.Records.data(), Data.data() + sizeof(Header),
+              Header.NumRecords * sizeof(ESGEdgeRecord));
+  readNames(Path, Log);
+  for (const auto &Record : Log.Records) {
+    if (Record.SourceNode >= Log.Nodes.size() ||
+        Record.TargetNode >= Log.Nodes.size() ||
+        Record.SourceFact >= Log.Facts.size() ||
+        Record.TargetFact >= Log.Facts.size() ||
+        (Record.Label != ESGEdgeRecord::None &&
+         Record.Label >= Log.Labels.size()) ||
+        Record.Kind > ESGEdgeKind::EdgeFunction) {
+      malformed(Path);
+    }
+  }
+  return Log;
+}
+
+void ESGEdgeLog::printAsDot(std::ostream &OS) const {
+  // group the flow edges by their nodes as the IDESolver's edge tables do,
+  // and collect the edge function labels of each edge
+  using FactMap = std::map<uint32_t, std::set<uint32_t>>;
+  std::map<std::pair<uint32_t, uint32_t>, FactMap> IntraEdges;
+  std::map<std::pair<uint32_t, uint32_t>, FactMap> InterEdges;
+  std::map<std::tuple<uint32_t, uint32_t, uint32_t, uint32_t>, std::string>
+      EFLabels;
+  for (const auto &Record : Records) {
+    auto NodePair = std::make_pair(Record.SourceNode, Record.TargetNode);
+    switch (Record.Kind) {
+    case ESGEdgeKind::Normal:
+    case ESGEdgeKind::CallToReturn:
+      IntraEdges[NodePair][Record.SourceFact].insert(Record.TargetFact);
+      break;
+    case ESGEdgeKind::Call:
+    case ESGEdgeKind::Return:
+      InterEdges[NodePair][Record.SourceFact].insert(Record.TargetFact);
+      break;
+    case ESGEdgeKind::EdgeFunction:
+      EFLabels[std::make_tuple(Record.SourceNode, Record.SourceFact,
+                               Record.TargetNode, Record.TargetFact)]
+          .append(Labels[Record.Label] + ", ");
+      break;
+    }
+  }
+  auto getEFLabel = [&EFLabels](uint32_t N1, uint32_t D1, uint32_t N2,
+                                uint32_t D2) -> std::string {
+    auto It = EFLabels.find(std::make_tuple(N1, D1, N2, D2));
+    return It != EFLabels.end() ? It->second : "";
+  };
+  // sort by the source statements
+  stringIDLess StrIDLess;
+  auto sorted = [this, &StrIDLess](const auto &Edges) {
+    std::vector<typename std::decay_t<decltype(Edges)>::const_pointer>
+        SortedEdges;
+    for (const auto &Edge : Edges) {
+      SortedEdges.push_back(&Edge);
+    }
+    std::stable_sort(SortedEdges.begin(), SortedEdges.end(),
+                     [this, &StrIDLess](const auto *LHS, const auto *RHS) {
+                       return StrIDLess(Nodes[LHS->first.first].StmtId,
+                                        Nodes[RHS->first.first].StmtId);
+                     });
+    return SortedEdges;
+  };
+
+  DOTGraph<uint32_t> G;
+  DOTFunctionSubGraph *FG = nullptr;
+  for (const auto *Edge : sorted(IntraEdges)) {
+    const auto &[N1Id, N2Id] = Edge->first;
+    const ESGNodeName &N1Name = Nodes[N1Id];
+    const ESGNodeName &N2Name = Nodes[N2Id];
+    const std::string &FnName = N1Name.Function;
+    // get or create function subgraph
+    if (!FG || FG->id != FnName) {
+      FG = &G.functions[FnName];
+      FG->id = FnName;
+    }
+    // create control flow nodes and add them to the function subgraph
+    DOTNode N1(FnName, N1Name.Label, N1Name.StmtId);
+    DOTNode N2(FnName, N2Name.Label, N2Name.StmtId);
+    FG->stmts.insert(N1);
+    if (N2Name.IsExit) {
+      FG->stmts.insert(N2);
+    }
+    FG->intraCFEdges.emplace(N1, N2);
+
+    DOTFactSubGraph *D1_FSG = nullptr;
+    unsigned D1FactId = 0;
+    unsigned D2FactId = 0;
+    for (const auto &[D1Fact, D2Facts] : Edge->second) {
+      DOTNode D1;
+      if (Facts[D1Fact].IsZero) {
+        D1 = {FnName, "Λ", N1Name.StmtId, 0, false, true};
+        D1FactId = 0;
+      } else {
+        D1FactId = G.getFactID(D1Fact);
+        std::string D1Label = Facts[D1Fact].Label;
+        D1_FSG = FG->getOrCreateFactSG(D1FactId, D1Label);
+        D1 = {FnName, D1Label, N1Name.StmtId, D1FactId, false, true};
+        D1_FSG->nodes.insert(std::make_pair(N1Name.StmtId, D1));
+      }
+      for (uint32_t D2Fact : D2Facts) {
+        // the nodes and edges of the zero value are generated automatically
+        if (Facts[D2Fact].IsZero) {
+          continue;
+        }
+        D2FactId = G.getFactID(D2Fact);
+        std::string D2Label = Facts[D2Fact].Label;
+        DOTNode D2 = {FnName, D2Label, N2Name.StmtId, D2FactId, false, true};
+        std::string EFLabel = getEFLabel(N1Id, D1Fact, N2Id, D2Fact);
+        if (D1FactId == D2FactId && !Facts[D1Fact].IsZero) {
+          D1_FSG->nodes.insert(std::make_pair(N2Name.StmtId, D2));
+          D1_FSG->edges.emplace(D1, D2, true, EFLabel);
+        } else {
+          DOTFactSubGraph *D2_FSG = FG->getOrCreateFactSG(D2FactId, D2Label);
+          D2_FSG->nodes.insert(std::make_pair(N2Name.StmtId, D2));
+          FG->crossFactEdges.emplace(D1, D2, true, EFLabel);
+        }
+      }
+    }
+  }
+
+  for (const auto *Edge : sorted(InterEdges)) {
+    const auto &[N1Id, N2Id] = Edge->first;
+    const ESGNodeName &N1Name = Nodes[N1Id];
+    const ESGNodeName &N2Name = Nodes[N2Id];
+    DOTNode N1(N1Name.Function, N1Name.Label, N1Name.StmtId);
+    DOTNode N2(N2Name.Function, N2Name.Label, N2Name.StmtId);
+    // recursive calls never leave the function subgraph and are handled as
+    // intra-procedural control flow
+    if (N1Name.Function == N2Name.Function) {
+      FG = &G.functions[N1Name.Function];
+      FG->intraCFEdges.emplace(N1, N2);
+    } else {
+      // callees that consist of a single statement have no intra-procedural
+      // path edges, so their function subgraph is created here
+      if (!G.functions.count(N1Name.Function)) {
+        FG = &G.functions[N1Name.Function];
+        FG->id = N1Name.Function;
+        FG->stmts.insert(N1);
+      } else if (!G.functions.count(N2Name.Function)) {
+        FG = &G.functions[N2Name.Function];
+        FG->id = N2Name.Function;
+        FG->stmts.insert(N2);
+      }
+      G.interCFEdges.emplace(N1, N2);
+    }
+
+    auto getFactNode = [&G](const ESGNodeName &NName, uint32_t DFact,
+                            const ESGFactName &DName) {
+      if (DName.IsZero) {
+        return DOTNode(NName.Function, "Λ", NName.StmtId, 0, false, true);
+      }
+      unsigned FactId = G.getFactID(DFact);
+      std::string Label = DName.Label;
+      DOTNode D(NName.Function, Label, NName.StmtId, FactId, false, true);
+      if (!G.containsFactSG(NName.Function, FactId)) {
+        auto *FSG =
+            G.functions[NName.Function].getOrCreateFactSG(FactId, Label);
+        FSG->nodes.insert(std::make_pair(NName.StmtId, D));
+      }
+      return D;
+    };
+    for (const auto &[D1Fact, D2Facts] : Edge->second) {
+      DOTNode D1 = getFactNode(N1Name, D1Fact, Facts[D1Fact]);
+      for (uint32_t D2Fact : D2Facts) {
+        DOTNode D2 = getFactNode(N2Name, D2Fact, Facts[D2Fact]);
+        if (Facts[D1Fact].IsZero && Facts[D2Fact].IsZero) {
+          // do not add lambda recursion edges as inter-procedural edges
+          if (D1.funcName != D2.funcName) {
+            G.interLambdaEdges.emplace(D1, D2, true, "AllBottom", "BOT");
+          }
+        } else {
+          G.interFactEdges.emplace(D1, D2, true,
+                                   getEFLabel(N1Id, D1Fact, N2Id, D2Fact));
+        }
+      }
+    }
+  }
+  OS << G;
+}
+
+nlohmann::json ESGEdgeLog::getAsJson() const {
+  nlohmann::json J;
+  J["Nodes"] = nlohmann::json::array();
+  for (const auto &Node : Nodes) {
+    J["Nodes"].push_back({{"Function", Node.Function},
+                          {"StmtId", Node.StmtId},
+                          {"Label", Node.Label},
+                          {"IsExit", Node.IsExit}});
+  }
+  J["Facts"] = nlohmann::json::array();
+  for (const auto &Fact : Facts) {
+    J["Facts"].push_back({{"Label", Fact.Label}, {"IsZero", Fact.IsZero}});
+  }
+  J["Edges"] = nlohmann::json::array();
+  for (const auto &Record : Records) {
+    nlohmann::json Edge = {{"Kind", toString(Record.Kind)},
+                           {"SourceNode", Record.SourceNode},
+                           {"SourceFact", Record.SourceFact},
+                           {"TargetNode", Record.TargetNode},
+                           {"TargetFact", Record.TargetFact}};
+    if (Record.Label != ESGEdgeRecord::None) {
+      Edge["EdgeFunction"] = Labels[Record.Label];
+    }
+    J["Edges"].push_back(std::move(Edge));
+  }
+  return J;
+}
+
+} // namespace psr
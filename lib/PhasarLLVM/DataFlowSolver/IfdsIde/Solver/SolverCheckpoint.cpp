@@ -0,0 +1,655 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <ios>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "boost/filesystem/operations.hpp"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/Argument.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalObject.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Instruction.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/CRC.h"
+#include "llvm/Support/LEB128.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/Config/Configuration.h"
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
+
+using namespace std;
+using namespace psr;
+
+namespace {
+
+constexpr char Magic[8] = {'P', 'S', 'R', 'C', 'K', 'P', 'T', '\0'};
+constexpr uint32_t Version = 2;
+// the size and the checksum of a segment's records
+constexpr size_t SegmentHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+/// The records of a checkpoint segment, each of which is a tag followed by
+/// its fields as unsigned LEB128 numbers. Facts and labels are numbered in
+/// the order of their records. A PathEdge record adds a pending path edge,
+/// a PathEdgeDone record removes one that is no longer pending.
+enum class RecordTag : uint8_t {
+  Fact,
+  Label,
+  Seed,
+  JumpFunction,
+  EndSummary,
+  Incoming,
+  UnbalancedReturnSite,
+  PathEdge,
+  PathEdgeDone,
+  // terminates a segment
+  Commit
+};
+
+void writeFixed(std::string &Out, uint64_t Value, unsigned Bytes) {
+  for (unsigned Idx = 0; Idx < Bytes; ++Idx) {
+    Out += static_cast<char>((Value >> (8 * Idx)) & 0xff);
+  }
+}
+
+uint64_t readFixed(const uint8_t *Data, unsigned Bytes) {
+  uint64_t Value = 0;
+  for (unsigned Idx = 0; Idx < Bytes; ++Idx) {
+    Value |= uint64_t(Data[Idx]) << (8 * Idx);
+  }
+  return Value;
+}
+
+void writeNumber(std::string &Out, uint64_t Value) {
+  llvm::raw_string_ostream OS(Out);
+  llvm::encodeULEB128(Value, OS);
+}
+
+void writeString(std::string &Out, llvm::StringRef S) {
+  writeNumber(Out, S.size());
+  Out.append(S.data(), S.size());
+}
+
+void writeTag(std::string &Out, RecordTag Tag) {
+  Out += static_cast<char>(Tag);
+}
+
+void writePathEdge(std::string &Out, RecordTag Tag,
+                   const std::tuple<uint32_t, uint64_t, uint32_t> &Edge) {
+  writeTag(Out, Tag);
+  writeNumber(Out, std::get<0>(Edge));
+  writeNumber(Out, std::get<1>(Edge));
+  writeNumber(Out, std::get<2>(Edge));
+}
+
+uint32_t getChecksum(llvm::StringRef Data) {
+  return llvm::crc32(llvm::ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(Data.data()), Data.size()));
+}
+
+[[noreturn]] void malformed(const std::string &Path) {
+  throw std::ios_base::failure("malformed solver checkpoint: " + Path);
+}
+
+/// Decodes the records of a segment.
+class RecordReader {
+public:
+  RecordReader(const std::string &Path, const uint8_t *Begin,
+               const uint8_t *End)
+      : Path(Path), Cur(Begin), End(End) {}
+
+  [[nodiscard]] bool atEnd() const { return Cur == End; }
+
+  [[nodiscard]] const uint8_t *position() const { return Cur; }
+
+  uint8_t readByte() {
+    if (Cur == End) {
+      malformed(Path);
+    }
+    return *Cur++;
+  }
+
+  uint64_t readNumber() {
+    unsigned Length = 0;
+    const char *Error = nullptr;
+    uint64_t Value = llvm::decodeULEB128(Cur, &Length, End, &Error);
+    if (Error) {
+      malformed(Path);
+    }
+    Cur += Length;
+    return Value;
+  }
+
+  std::string readString() {
+    uint64_t Length = readNumber();
+    if (Length > uint64_t(End - Cur)) {
+      malformed(Path);
+    }
+    std::string S(reinterpret_cast<const char *>(Cur), Length);
+    Cur += Length;
+    return S;
+  }
+
+  uint32_t readID(size_t Bound) {
+    uint64_t ID = readNumber();
+    if (ID >= Bound) {
+      malformed(Path);
+    }
+    return static_cast<uint32_t>(ID);
+  }
+
+private:
+  const std::string &Path;
+  const uint8_t *Cur;
+  const uint8_t *End;
+};
+
+/// The pending path edges while reading a checkpoint, each with the number
+/// of path edges added before it, which is its position in the worklist.
+struct PendingPathEdges {
+  std::map<std::tuple<uint32_t, uint64_t, uint32_t>, uint64_t> Edges;
+  uint64_t NumAdded = 0;
+};
+
+/// Applies the records of a segment whose checksum has been verified.
+void readSegment(RecordReader &R, SolverCheckpoint &CP,
+                 PendingPathEdges &Pending, const std::string &Path) {
+  while (true) {
+    auto Tag = static_cast<RecordTag>(R.readByte());
+    switch (Tag) {
+    case RecordTag::Fact: {
+      CheckpointFact Fact;
+      Fact.FactKind = static_cast<CheckpointFact::Kind>(R.readByte());
+      switch (Fact.FactKind) {
+      case CheckpointFact::Kind::Zero:
+        break;
+      case CheckpointFact::Kind::Instruction:
+        Fact.InstructionID = R.readNumber();
+        break;
+      case CheckpointFact::Kind::Argument:
+        Fact.Name = R.readString();
+        Fact.ArgNo = static_cast<unsigned>(R.readNumber());
+        break;
+      case CheckpointFact::Kind::Global:
+        Fact.Name = R.readString();
+        break;
+      default:
+        malformed(Path);
+      }
+      CP.Facts.push_back(std::move(Fact));
+      break;
+    }
+    case RecordTag::Label:
+      CP.Labels.push_back(R.readString());
+      break;
+    case RecordTag::Seed: {
+      uint64_t Node = R.readNumber();
+      CP.Seeds.emplace_back(Node, R.readID(CP.Facts.size()));
+      break;
+    }
+    case RecordTag::JumpFunction: {
+      SolverCheckpoint::JumpFunction JF;
+      JF.SourceFact = R.readID(CP.Facts.size());
+      JF.Target = R.readNumber();
+      JF.TargetFact = R.readID(CP.Facts.size());
+      JF.Label = R.readID(CP.Labels.size());
+      CP.JumpFunctions.push_back(JF);
+      break;
+    }
+    case RecordTag::EndSummary: {
+      SolverCheckpoint::EndSummary ES;
+      ES.StartPoint = R.readNumber();
+      ES.StartFact = R.readID(CP.Facts.size());
+      ES.ExitPoint = R.readNumber();
+      ES.ExitFact = R.readID(CP.Facts.size());
+      ES.Label = R.readID(CP.Labels.size());
+      CP.EndSummaries.push_back(ES);
+      break;
+    }
+    case RecordTag::Incoming: {
+      SolverCheckpoint::Incoming Inc;
+      Inc.StartPoint = R.readNumber();
+      Inc.StartFact = R.readID(CP.Facts.size());
+      Inc.CallSite = R.readNumber();
+      Inc.CallSiteFact = R.readID(CP.Facts.size());
+      CP.Incomings.push_back(Inc);
+      break;
+    }
+    case RecordTag::UnbalancedReturnSite:
+      CP.UnbalancedReturnSites.push_back(R.readNumber());
+      break;
+    case RecordTag::PathEdge:
+    case RecordTag::PathEdgeDone: {
+      bool Done = Tag == RecordTag::PathEdgeDone;
+      uint32_t Source = R.readID(CP.Facts.size());
+      uint64_t Target = R.readNumber();
+      uint32_t TargetFact = R.readID(CP.Facts.size());
+      auto Edge = std::make_tuple(Source, Target, TargetFact);
+      if (Done ? !Pending.Edges.erase(Edge)
+               : !Pending.Edges.try_emplace(Edge, Pending.NumAdded++).second) {
+        malformed(Path);
+      }
+      break;
+    }
+    case RecordTag::Commit:
+      CP.NumPathEdges = R.readNumber();
+      ++CP.NumCommits;
+      if (!R.atEnd()) {
+        malformed(Path);
+      }
+      return;
+    default:
+      malformed(Path);
+    }
+  }
+}
+
+std::optional<uint64_t> getNodeID(const llvm::Instruction *I) {
+  if (!I || !I->getMetadata(PhasarConfig::MetaDataKind())) {
+    return std::nullopt;
+  }
+  return ProjectIRDB::getInstructionID(I);
+}
+
+} // anonymous namespace
+
+namespace psr {
+
+SolverCheckpoint SolverCheckpoint::read(const std::string &Path) {
+  auto Buffer = llvm::MemoryBuffer::getFile(Path);
+  if (!Buffer) {
+    throw std::ios_base::failure("could not read file: " + Path);
+  }
+  const auto *Data =
+      reinterpret_cast<const uint8_t *>((*Buffer)->getBufferStart());
+  const auto *End = reinterpret_cast<const uint8_t *>((*Buffer)->getBufferEnd());
+  if (size_t(End - Data) < sizeof(Magic) + sizeof(uint32_t) ||
+      std::memcmp(Data, Magic, sizeof(Magic)) != 0 ||
+      readFixed(Data + sizeof(Magic), sizeof(uint32_t)) != Version) {
+    malformed(Path);
+  }
+  SolverCheckpoint CP;
+  RecordReader Header(Path, Data + sizeof(Magic) + sizeof(uint32_t), End);
+  CP.AnalysisID = Header.readString();
+  CP.IRFingerprint = Header.readNumber();
+  const uint8_t *Cur = Header.position();
+  CP.Size = Cur - Data;
+  PendingPathEdges Pending;
+  // a segment that has not been written completely ends the checkpoint
+  while (size_t(End - Cur) >= SegmentHeaderSize) {
+    uint64_t Size = readFixed(Cur, sizeof(uint64_t));
+    auto Checksum =
+        static_cast<uint32_t>(readFixed(Cur + sizeof(uint64_t), 4));
+    const uint8_t *Begin = Cur + SegmentHeaderSize;
+    if (Size > uint64_t(End - Begin) ||
+        getChecksum(llvm::StringRef(reinterpret_cast<const char *>(Begin),
+                                    Size)) != Checksum) {
+      break;
+    }
+    RecordReader R(Path, Begin, Begin + Size);
+    readSegment(R, CP, Pending, Path);
+    Cur = Begin + Size;
+    CP.Size = Cur - Data;
+  }
+  // restore the order in which the pending path edges have been added
+  std::vector<std::pair<uint64_t, SolverCheckpoint::PathEdge>> Worklist;
+  Worklist.reserve(Pending.Edges.size());
+  for (const auto &[Edge, Position] : Pending.Edges) {
+    Worklist.emplace_back(Position, SolverCheckpoint::PathEdge{
+                                        std::get<0>(Edge), std::get<1>(Edge),
+                                        std::get<2>(Edge)});
+  }
+  std::sort(Worklist.begin(), Worklist.end(),
+            [](const auto &LHS, const auto &RHS) {
+              return LHS.first < RHS.first;
+            });
+  for (const auto &Entry : Worklist) {
+    CP.Worklist.push_back(Entry.second);
+  }
+  return CP;
+}
+
+uint64_t getIRFingerprint(const ProjectIRDB &IRDB) {
+  std::vector<const llvm::Module *> Modules;
+  for (const auto *M : IRDB.getAllModules()) {
+    Modules.push_back(M);
+  }
+  // the modules are ordered by their addresses
+  std::sort(Modules.begin(), Modules.end(),
+            [](const llvm::Module *LHS, const llvm::Module *RHS) {
+              return LHS->getModuleIdentifier() < RHS->getModuleIdentifier();
+            });
+  llvm::MD5 Hash;
+  for (const auto *M : Modules) {
+    Hash.update(M->getModuleIdentifier());
+    for (const auto &F : *M) {
+      Hash.update(F.getName());
+      std::string Size;
+      writeNumber(Size, F.getInstructionCount());
+      Hash.update(Size);
+    }
+  }
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.low();
+}
+
+const llvm::Value *resolveCheckpointFact(const ProjectIRDB &IRDB,
+                                         const CheckpointFact &Fact,
+                                         const llvm::Value *ZeroValue) {
+  switch (Fact.FactKind) {
+  case CheckpointFact::Kind::Zero:
+    return ZeroValue;
+  case CheckpointFact::Kind::Instruction:
+    return IRDB.getInstruction(Fact.InstructionID);
+  case CheckpointFact::Kind::Argument:
+    if (const auto *F = IRDB.getFunctionDefinition(Fact.Name);
+        F && Fact.ArgNo < F->arg_size()) {
+      return F->getArg(Fact.ArgNo);
+    }
+    return nullptr;
+  case CheckpointFact::Kind::Global:
+    if (const auto *G = IRDB.getGlobalVariableDefinition(Fact.Name)) {
+      return G;
+    }
+    return IRDB.getFunctionDefinition(Fact.Name);
+  }
+  return nullptr;
+}
+
+SolverCheckpointWriter::SolverCheckpointWriter(std::string Path,
+                                               const std::string &AnalysisID,
+                                               uint64_t IRFingerprint,
+                                               const llvm::Value *ZeroValue)
+    : Path(std::move(Path)), ZeroValue(ZeroValue) {
+  File.open(this->Path, std::ios::binary | std::ios::trunc);
+  std::string Header(Magic, sizeof(Magic));
+  writeFixed(Header, Version, sizeof(uint32_t));
+  writeString(Header, AnalysisID);
+  writeNumber(Header, IRFingerprint);
+  File.write(Header.data(), Header.size());
+  File.flush();
+  if (!File) {
+    throw std::ios_base::failure("could not write file: " + this->Path);
+  }
+  Writer = std::thread(&SolverCheckpointWriter::writeSegments, this);
+}
+
+SolverCheckpointWriter::SolverCheckpointWriter(
+    std::string Path, const SolverCheckpoint &CP,
+    const std::vector<const llvm::Value *> &FactValues,
+    const llvm::Value *ZeroValue)
+    : Path(std::move(Path)), ZeroValue(ZeroValue),
+      NumCommits(CP.NumCommits) {
+  for (uint32_t ID = 0; ID < FactValues.size(); ++ID) {
+    FactIDs.try_emplace(FactValues[ID], ID);
+  }
+  for (uint32_t ID = 0; ID < CP.Labels.size(); ++ID) {
+    LabelIDs.try_emplace(CP.Labels[ID], ID);
+  }
+  for (const auto &Edge : CP.Worklist) {
+    CommittedPathEdges.emplace(Edge.SourceFact, Edge.Target, Edge.TargetFact);
+  }
+  boost::system::error_code EC;
+  boost::filesystem::resize_file(this->Path, CP.Size, EC);
+  if (!EC) {
+    File.open(this->Path, std::ios::binary | std::ios::app);
+  }
+  if (EC || !File) {
+    throw std::ios_base::failure("could not write file: " + this->Path);
+  }
+  Writer = std::thread(&SolverCheckpointWriter::writeSegments, this);
+}
+
+SolverCheckpointWriter::~SolverCheckpointWriter() {
+  {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Changed.wait(Lock, [this] { return !Segment; });
+    Stop = true;
+  }
+  Changed.notify_all();
+  Writer.join();
+}
+
+std::optional<uint32_t>
+SolverCheckpointWriter::getFactID(const llvm::Value *D) {
+  if (auto It = FactIDs.find(D); It != FactIDs.end()) {
+    return It->second;
+  }
+  std::string Record;
+  writeTag(Record, RecordTag::Fact);
+  if (D == ZeroValue) {
+    Record += static_cast<char>(CheckpointFact::Kind::Zero);
+  } else if (const auto *I = llvm::dyn_cast<llvm::Instruction>(D)) {
+    auto ID = getNodeID(I);
+    if (!ID) {
+      return std::nullopt;
+    }
+    Record += static_cast<char>(CheckpointFact::Kind::Instruction);
+    writeNumber(Record, *ID);
+  } else if (const auto *A = llvm::dyn_cast<llvm::Argument>(D);
+             A && !A->getParent()->isDeclaration()) {
+    // the names of definitions are unique among the modules of a project
+    Record += static_cast<char>(CheckpointFact::Kind::Argument);
+    writeString(Record, A->getParent()->getName());
+    writeNumber(Record, A->getArgNo());
+  } else if (const auto *G = llvm::dyn_cast<llvm::GlobalObject>(D);
+             G && G->hasName() && !G->isDeclaration() &&
+             (llvm::isa<llvm::GlobalVariable>(G) ||
+              llvm::isa<llvm::Function>(G))) {
+    Record += static_cast<char>(CheckpointFact::Kind::Global);
+    writeString(Record, G->getName());
+  } else {
+    return std::nullopt;
+  }
+  Records += Record;
+  auto ID = static_cast<uint32_t>(FactIDs.size());
+  FactIDs.try_emplace(D, ID);
+  return ID;
+}
+
+std::optional<uint32_t>
+SolverCheckpointWriter::getLabelID(const std::string &Label) {
+  if (Label.empty()) {
+    return std::nullopt;
+  }
+  auto [It, Inserted] =
+      LabelIDs.try_emplace(Label, static_cast<uint32_t>(LabelIDs.size()));
+  if (Inserted) {
+    writeTag(Records, RecordTag::Label);
+    writeString(Records, Label);
+  }
+  return It->second;
+}
+
+bool SolverCheckpointWriter::addSeed(const llvm::Instruction *N,
+                                     const llvm::Value *D) {
+  auto Node = getNodeID(N);
+  auto Fact = getFactID(D);
+  if (!Node || !Fact) {
+    return false;
+  }
+  writeTag(Records, RecordTag::Seed);
+  writeNumber(Records, *Node);
+  writeNumber(Records, *Fact);
+  return true;
+}
+
+bool SolverCheckpointWriter::addJumpFunction(const llvm::Value *SourceFact,
+                                             const llvm::Instruction *Target,
+                                             const llvm::Value *TargetFact,
+                                             const std::string &Label) {
+  auto Source = getFactID(SourceFact);
+  auto Node = getNodeID(Target);
+  auto Fact = getFactID(TargetFact);
+  auto LabelID = getLabelID(Label);
+  if (!Source || !Node || !Fact || !LabelID) {
+    return false;
+  }
+  writeTag(Records, RecordTag::JumpFunction);
+  writeNumber(Records, *Source);
+  writeNumber(Records, *Node);
+  writeNumber(Records, *Fact);
+  writeNumber(Records, *LabelID);
+  return true;
+}
+
+bool SolverCheckpointWriter::addEndSummary(const llvm::Instruction *StartPoint,
+                                           const llvm::Value *StartFact,
+                                           const llvm::Instruction *ExitPoint,
+                                           const llvm::Value *ExitFact,
+                                           const std::string &Label) {
+  auto Start = getNodeID(StartPoint);
+  auto SFact = getFactID(StartFact);
+  auto Exit = getNodeID(ExitPoint);
+  auto EFact = getFactID(ExitFact);
+  auto LabelID = getLabelID(Label);
+  if (!Start || !SFact || !Exit || !EFact || !LabelID) {
+    return false;
+  }
+  writeTag(Records, RecordTag::EndSummary);
+  writeNumber(Records, *Start);
+  writeNumber(Records, *SFact);
+  writeNumber(Records, *Exit);
+  writeNumber(Records, *EFact);
+  writeNumber(Records, *LabelID);
+  return true;
+}
+
+bool SolverCheckpointWriter::addIncoming(const llvm::Instruction *StartPoint,
+                                         const llvm::Value *StartFact,
+                                         const llvm::Instruction *CallSite,
+                                         const llvm::Value *CallSiteFact) {
+  auto Start = getNodeID(StartPoint);
+  auto SFact = getFactID(StartFact);
+  auto Site = getNodeID(CallSite);
+  auto CFact = getFactID(CallSiteFact);
+  if (!Start || !SFact || !Site || !CFact) {
+    return false;
+  }
+  writeTag(Records, RecordTag::Incoming);
+  writeNumber(Records, *Start);
+  writeNumber(Records, *SFact);
+  writeNumber(Records, *Site);
+  writeNumber(Records, *CFact);
+  return true;
+}
+
+bool SolverCheckpointWriter::addUnbalancedReturnSite(
+    const llvm::Instruction *N) {
+  auto Node = getNodeID(N);
+  if (!Node) {
+    return false;
+  }
+  writeTag(Records, RecordTag::UnbalancedReturnSite);
+  writeNumber(Records, *Node);
+  return true;
+}
+
+bool SolverCheckpointWriter::addPendingPathEdge(
+    const llvm::Value *SourceFact, const llvm::Instruction *Target,
+    const llvm::Value *TargetFact) {
+  auto Source = getFactID(SourceFact);
+  auto Node = getNodeID(Target);
+  auto Fact = getFactID(TargetFact);
+  if (!Source || !Node || !Fact) {
+    return false;
+  }
+  PendingPathEdges.emplace_back(*Source, *Node, *Fact);
+  return true;
+}
+
+bool SolverCheckpointWriter::commit(uint64_t NumPathEdges) {
+  // Only the changes to the pending path edges since the previous commit are
+  // written. The facts of the pending path edges have been added to Records.
+  std::set<PathEdgeKey> Pending(PendingPathEdges.begin(),
+                                PendingPathEdges.end());
+  for (auto It = CommittedPathEdges.begin();
+       It != CommittedPathEdges.end();) {
+    if (Pending.count(*It)) {
+      ++It;
+      continue;
+    }
+    writePathEdge(Records, RecordTag::PathEdgeDone, *It);
+    It = CommittedPathEdges.erase(It);
+  }
+  // the new ones are added in the order of the worklist, after the ones that
+  // are still pending
+  for (const auto &Edge : PendingPathEdges) {
+    if (CommittedPathEdges.insert(Edge).second) {
+      writePathEdge(Records, RecordTag::PathEdge, Edge);
+    }
+  }
+  PendingPathEdges.clear();
+  writeTag(Records, RecordTag::Commit);
+  writeNumber(Records, NumPathEdges);
+  std::string Data;
+  Data.reserve(SegmentHeaderSize + Records.size());
+  writeFixed(Data, Records.size(), sizeof(uint64_t));
+  writeFixed(Data, getChecksum(Records), sizeof(uint32_t));
+  Data += Records;
+  Records.clear();
+  {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Changed.wait(Lock, [this] { return !Segment; });
+    if (!Error.empty()) {
+      return false;
+    }
+    Segment = std::move(Data);
+  }
+  Changed.notify_all();
+  ++NumCommits;
+  return true;
+}
+
+bool SolverCheckpointWriter::flush() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  Changed.wait(Lock, [this] { return !Segment; });
+  return Error.empty();
+}
+
+std::string SolverCheckpointWriter::getError() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return Error;
+}
+
+void SolverCheckpointWriter::writeSegments() {
+  std::unique_lock<std::mutex> Lock(Mutex);
+  while (true) {
+    Changed.wait(Lock, [this] { return Stop || Segment; });
+    if (!Segment) {
+      return;
+    }
+    // the solver does not touch the segment until it has been reset
+    Lock.unlock();
+    File.write(Segment->data(), Segment->size());
+    File.flush();
+    bool Failed = !File;
+    Lock.lock();
+    if (Failed && Error.empty()) {
+      Error = "could not write file: " + Path;
+    }
+    Segment.reset();
+    Changed.notify_all();
+  }
+}
+
+} // namespace psr
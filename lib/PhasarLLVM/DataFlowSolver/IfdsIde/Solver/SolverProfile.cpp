@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <ios>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverProfile.h"
+
+using namespace std;
+using namespace psr;
+
+namespace {
+
+int64_t toMicroseconds(std::chrono::nanoseconds Time) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Time).count();
+}
+
+// Frames of collapsed stacks are separated by ';' and terminated by the
+// stack's count, so neither may occur within a frame
+std::string toFrame(const std::string &Name) {
+  std::string Frame;
+  Frame.reserve(Name.size());
+  bool Space = false;
+  for (char C : Name) {
+    if (C == ';') {
+      C = ',';
+    }
+    if (std::isspace(static_cast<unsigned char>(C))) {
+      Space = !Frame.empty();
+      continue;
+    }
+    if (Space) {
+      Frame += '_';
+      Space = false;
+    }
+    Frame += C;
+  }
+  return Frame;
+}
+
+template <typename T> void sortByTime(std::vector<T> &Entries) {
+  std::stable_sort(Entries.begin(), Entries.end(),
+                   [](const T &Lhs, const T &Rhs) {
+                     return Lhs.Counters.Time > Rhs.Counters.Time;
+                   });
+}
+
+} // anonymous namespace
+
+namespace psr {
+
+SolverProfileCounters &
+SolverProfileCounters::operator+=(const SolverProfileCounters &Other) {
+  PathEdges += Other.PathEdges;
+  FlowFunctionApplications += Other.FlowFunctionApplications;
+  Facts += Other.Facts;
+  MaxFacts = std::max(MaxFacts, Other.MaxFacts);
+  Compositions += Other.Compositions;
+  Time += Other.Time;
+  return *this;
+}
+
+nlohmann::json SolverProfileCounters::getAsJson() const {
+  return {{"PathEdges", PathEdges},
+          {"FlowFunctionApplications", FlowFunctionApplications},
+          {"Facts", Facts},
+          {"MaxFacts", MaxFacts},
+          {"Compositions", Compositions},
+          {"TimeUs", toMicroseconds(Time)}};
+}
+
+void SolverProfile::sort() {
+  sortByTime(Functions);
+  for (auto &Fun : Functions) {
+    sortByTime(Fun.CallSites);
+  }
+}
+
+nlohmann::json SolverProfile::getAsJson() const {
+  nlohmann::json J;
+  J["Functions"] = nlohmann::json::array();
+  for (const auto &Fun : Functions) {
+    nlohmann::json JFun = Fun.Counters.getAsJson();
+    JFun["Name"] = Fun.Name;
+    JFun["CallSites"] = nlohmann::json::array();
+    for (const auto &Site : Fun.CallSites) {
+      nlohmann::json JSite = Site.Counters.getAsJson();
+      JSite["StmtId"] = Site.StmtId;
+      JSite["Label"] = Site.Label;
+      JFun["CallSites"].push_back(std::move(JSite));
+    }
+    J["Functions"].push_back(std::move(JFun));
+  }
+  return J;
+}
+
+void SolverProfile::printAsCollapsedStacks(std::ostream &OS) const {
+  for (const auto &Fun : Functions) {
+    std::string FunFrame = toFrame(Fun.Name);
+    int64_t SelfTime = toMicroseconds(Fun.Counters.Time);
+    for (const auto &Site : Fun.CallSites) {
+      int64_t SiteTime = toMicroseconds(Site.Counters.Time);
+      SelfTime -= SiteTime;
+      if (SiteTime > 0) {
+        OS << FunFrame << ';' << toFrame(Site.Label) << ' ' << SiteTime
+           << '\n';
+      }
+    }
+    if (SelfTime > 0) {
+      OS << FunFrame << ' ' << SelfTime << '\n';
+    }
+  }
+}
+
+void SolverProfile::write(const std::string &Path) const {
+  std::ofstream JsonFile(Path);
+  if (!JsonFile) {
+    throw std::ios_base::failure("could not write file: " + Path);
+  }
+  JsonFile << getAsJson().dump(2) << '\n';
+  std::ofstream StacksFile(Path + ".folded");
+  if (!StacksFile) {
+    throw std::ios_base::failure("could not write file: " + Path + ".folded");
+  }
+  printAsCollapsedStacks(StacksFile);
+}
+
+} // namespace psr
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/Metadata.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SummaryStore.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+std::string getFunctionContentHash(const llvm::Function *F) {
+  // number the arguments, blocks and instructions in the order of their
+  // occurrence, rather than relying on their names
+  llvm::DenseMap<const llvm::Value *, unsigned> LocalNumbers;
+  for (const auto &Arg : F->args()) {
+    LocalNumbers.try_emplace(&Arg, LocalNumbers.size());
+  }
+  for (const auto &BB : *F) {
+    LocalNumbers.try_emplace(&BB, LocalNumbers.size());
+    for (const auto &I : BB) {
+      LocalNumbers.try_emplace(&I, LocalNumbers.size());
+    }
+  }
+  std::string Buffer;
+  llvm::raw_string_ostream OS(Buffer);
+  auto printOperand = [&OS, &LocalNumbers](const llvm::Value *V) {
+    if (auto It = LocalNumbers.find(V); It != LocalNumbers.end()) {
+      OS << '%' << It->second;
+    } else if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      OS << '@' << G->getName();
+    } else if (llvm::isa<llvm::MetadataAsValue>(V)) {
+      // debug information does not affect the analysis
+      OS << "metadata";
+    } else {
+      V->printAsOperand(OS, /* PrintType */ true);
+    }
+  };
+  OS << F->getName() << ' ';
+  F->getFunctionType()->print(OS);
+  for (const auto &I : llvm::instructions(F)) {
+    OS << '\n' << I.getOpcodeName() << ' ';
+    I.getType()->print(OS);
+    if (const auto *Cmp = llvm::dyn_cast<llvm::CmpInst>(&I)) {
+      OS << ' ' << llvm::CmpInst::getPredicateName(Cmp->getPredicate());
+    } else if (const auto *Alloca = llvm::dyn_cast<llvm::AllocaInst>(&I)) {
+      OS << ' ';
+      Alloca->getAllocatedType()->print(OS);
+    } else if (const auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(&I)) {
+      OS << ' ';
+      GEP->getSourceElementType()->print(OS);
+    } else if (const auto *Phi = llvm::dyn_cast<llvm::PHINode>(&I)) {
+      for (const auto *BB : Phi->blocks()) {
+        OS << ' ';
+        printOperand(BB);
+      }
+    }
+    for (const auto &Op : I.operands()) {
+      OS << ' ';
+      printOperand(Op.get());
+    }
+  }
+  llvm::MD5 Hash;
+  Hash.update(OS.str());
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.digest().str().str();
+}
+
+std::set<const llvm::Function *>
+getGlobalCoupledFunctions(const std::set<const llvm::Function *> &Functions) {
+  std::set<const llvm::GlobalVariable *> Globals;
+  for (const auto *F : Functions) {
+    for (const auto &I : llvm::instructions(F)) {
+      for (const auto &Op : I.operands()) {
+        const auto *G = llvm::dyn_cast<llvm::GlobalVariable>(
+            Op->stripInBoundsOffsets());
+        if (G && !G->isConstant()) {
+          Globals.insert(G);
+        }
+      }
+    }
+  }
+  std::set<const llvm::Function *> Coupled;
+  for (const auto *G : Globals) {
+    // globals may be used through constant expressions, e.g., casts
+    std::vector<const llvm::User *> Users(G->user_begin(), G->user_end());
+    while (!Users.empty()) {
+      const auto *U = Users.back();
+      Users.pop_back();
+      if (const auto *I = llvm::dyn_cast<llvm::Instruction>(U)) {
+        if (!Functions.count(I->getFunction())) {
+          Coupled.insert(I->getFunction());
+        }
+      } else if (llvm::isa<llvm::ConstantExpr>(U)) {
+        Users.insert(Users.end(), U->user_begin(), U->user_end());
+      }
+    }
+  }
+  return Coupled;
+}
+
+FunctionLocalIDs::FunctionLocalIDs(const llvm::Function *F) : F(F) {
+  for (const auto &I : llvm::instructions(F)) {
+    InstIndices[&I] = Insts.size();
+    Insts.push_back(&I);
+  }
+}
+
+std::optional<std::string>
+FunctionLocalIDs::getID(const llvm::Value *V) const {
+  if (const auto *Arg = llvm::dyn_cast<llvm::Argument>(V)) {
+    if (Arg->getParent() == F) {
+      return "a" + std::to_string(Arg->getArgNo());
+    }
+  } else if (const auto *I = llvm::dyn_cast<llvm::Instruction>(V)) {
+    if (auto It = InstIndices.find(I); It != InstIndices.end()) {
+      return "i" + std::to_string(It->second);
+    }
+  } else if (const auto *G = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+    if (G->hasName() && G->getParent() == F->getParent()) {
+      return "@" + G->getName().str();
+    }
+  }
+  return std::nullopt;
+}
+
+const llvm::Value *FunctionLocalIDs::getValue(llvm::StringRef ID) const {
+  if (ID.empty()) {
+    return nullptr;
+  }
+  if (ID[0] == '@') {
+    return F->getParent()->getNamedValue(ID.drop_front());
+  }
+  unsigned Idx;
+  if (ID.drop_front().getAsInteger(10, Idx)) {
+    return nullptr;
+  }
+  if (ID[0] == 'a') {
+    return Idx < F->arg_size() ? F->getArg(Idx) : nullptr;
+  }
+  if (ID[0] == 'i') {
+    return Idx < Insts.size() ? Insts[Idx] : nullptr;
+  }
+  return nullptr;
+}
+
+SummaryStore::SummaryStore(std::string Directory)
+    : Directory(std::move(Directory)) {
+  if (llvm::sys::fs::create_directories(this->Directory)) {
+    throw std::ios_base::failure("could not create directory: " +
+                                 this->Directory);
+  }
+}
+
+std::string SummaryStore::getKey(llvm::StringRef AnalysisID,
+                                 std::vector<std::string> ContentHashes) {
+  // the order in which the functions have been visited does not matter
+  std::sort(ContentHashes.begin(), ContentHashes.end());
+  llvm::MD5 Hash;
+  Hash.update(AnalysisID);
+  for (const auto &ContentHash : ContentHashes) {
+    Hash.update(llvm::StringRef("\0", 1));
+    Hash.update(ContentHash);
+  }
+  llvm::MD5::MD5Result Result;
+  Hash.final(Result);
+  return Result.digest().str().str();
+}
+
+std::string SummaryStore::getPath(const std::string &Key) const {
+  llvm::SmallString<128> Path(Directory);
+  llvm::sys::path::append(Path, Key + ".json");
+  return Path.str().str();
+}
+
+std::optional<nlohmann::json>
+SummaryStore::load(const std::string &Key) const {
+  if (isInMemory()) {
+    std::lock_guard<std::mutex> Lock(EntriesMutex);
+    if (auto Search = Entries.find(Key); Search != Entries.end()) {
+      return Search->second;
+    }
+    return std::nullopt;
+  }
+  std::ifstream IFS(getPath(Key));
+  if (!IFS) {
+    return std::nullopt;
+  }
+  auto Summaries = nlohmann::json::parse(IFS, nullptr,
+                                         /* allow_exceptions */ false);
+  if (Summaries.is_discarded()) {
+    return std::nullopt;
+  }
+  return Summaries;
+}
+
+void SummaryStore::store(const std::string &Key,
+                         const nlohmann::json &Summaries) const {
+  if (isInMemory()) {
+    std::lock_guard<std::mutex> Lock(EntriesMutex);
+    Entries[Key] = Summaries;
+    return;
+  }
+  std::string Path = getPath(Key);
+  // write to a file of our own first, so that readers never observe a
+  // partially written entry; solvers of the same process may store
+  // concurrently as well
+  std::string TmpPath =
+      Path + ".tmp" + std::to_string(llvm::sys::Process::getProcessId()) +
+      "-" + std::to_string(std::hash<std::thread::id>{}(
+                std::this_thread::get_id()));
+  {
+    std::ofstream OFS(TmpPath);
+    OFS << Summaries;
+    if (!OFS) {
+      throw std::ios_base::failure("could not write file: " + TmpPath);
+    }
+  }
+  if (llvm::sys::fs::rename(TmpPath, Path)) {
+    llvm::sys::fs::remove(TmpPath);
+    throw std::ios_base::failure("could not write file: " + Path);
+  }
+}
+
+} // namespace psr
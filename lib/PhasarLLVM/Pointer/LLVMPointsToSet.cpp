@@ -339,6 +339,7 @@ void LLVMPointsToSet::computeFunctionsPointsToSet(llvm::Function *F) {
 AliasResult LLVMPointsToSet::alias(const llvm::Value *V1, const llvm::Value *V2,
                                    const llvm::Instruction *I) {
   // if V1 or V2 is not an interesting pointer those values cannot alias
+  auto Lock = lockIfThreadSafe();
   if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
     return AliasResult::NoAlias;
   }
@@ -351,6 +352,7 @@ AliasResult LLVMPointsToSet::alias(const llvm::Value *V1, const llvm::Value *V2,
 std::shared_ptr<std::unordered_set<const llvm::Value *>>
 LLVMPointsToSet::getPointsToSet(const llvm::Value *V,
                                 const llvm::Instruction *I) {
+  auto Lock = lockIfThreadSafe();
   // if V is not a (interesting) pointer we can return an empty set
   if (!isInterestingPointer(V)) {
     return std::make_shared<std::unordered_set<const llvm::Value *>>();
@@ -368,6 +370,7 @@ std::shared_ptr<std::unordered_set<const llvm::Value *>>
 LLVMPointsToSet::getReachableAllocationSites(const llvm::Value *V,
                                              bool IntraProcOnly,
                                              const llvm::Instruction *I) {
+  auto Lock = lockIfThreadSafe();
   // if V is not a (interesting) pointer we can return an empty set
   if (!isInterestingPointer(V)) {
     return std::make_shared<std::unordered_set<const llvm::Value *>>();
@@ -402,6 +405,7 @@ LLVMPointsToSet::getReachableAllocationSites(const llvm::Value *V,
 bool LLVMPointsToSet::isInReachableAllocationSites(
     const llvm::Value *V, const llvm::Value *PotentialValue, bool IntraProcOnly,
     const llvm::Instruction *I) {
+  auto Lock = lockIfThreadSafe();
   // if V is not a (interesting) pointer we can return an empty set
   if (!isInterestingPointer(V)) {
     return false;
@@ -428,6 +432,7 @@ bool LLVMPointsToSet::isInReachableAllocationSites(
 }
 
 void LLVMPointsToSet::mergeWith(const PointsToInfo &PTI) {
+  auto Lock = lockIfThreadSafe();
   const auto *OtherPTI = dynamic_cast<const LLVMPointsToSet *>(&PTI);
   if (!OtherPTI) {
     llvm::report_fatal_error(
@@ -467,6 +472,7 @@ void LLVMPointsToSet::introduceAlias(const llvm::Value *V1,
                                      const llvm::Value *V2,
                                      const llvm::Instruction *I,
                                      AliasResult Kind) {
+  auto Lock = lockIfThreadSafe();
   //  only introduce aliases if both values are interesting pointer
   if (!isInterestingPointer(V1) || !isInterestingPointer(V2)) {
     return;
@@ -483,6 +489,7 @@ nlohmann::json LLVMPointsToSet::getAsJson() const { return ""_json; }
 void LLVMPointsToSet::printAsJson(std::ostream &OS) const {}
 
 void LLVMPointsToSet::print(std::ostream &OS) const {
+  auto Lock = lockIfThreadSafe();
   for (const auto &[V, PTS] : PointsToSets) {
     OS << "V: " << llvmIRToString(V) << '\n';
     for (const auto &Ptr : *PTS) {
@@ -9,6 +9,7 @@
 
 #include "phasar/PhasarLLVM/Utils/SummaryStrategy.h"
 #include <ostream>
+#include <utility>
 
 using namespace std;
 using namespace psr;
@@ -34,4 +35,42 @@ const map<string, SummaryGenerationStrategy> StringToSummaryGenerationStrategy =
 ostream &operator<<(ostream &OS, const SummaryGenerationStrategy &S) {
   return OS << SummaryGenerationStrategyToString.at(S);
 }
+
+set<vector<bool>> getSummaryContexts(SummaryGenerationStrategy Strategy,
+                                     size_t NumInputs,
+                                     const set<vector<bool>> &Observed) {
+  set<vector<bool>> Contexts;
+  switch (Strategy) {
+  case SummaryGenerationStrategy::always_all:
+    Contexts.insert(vector<bool>(NumInputs, true));
+    break;
+  case SummaryGenerationStrategy::always_none:
+    Contexts.insert(vector<bool>(NumInputs, false));
+    break;
+  case SummaryGenerationStrategy::powerset:
+    if (NumInputs <= MaxPowersetSummaryInputs) {
+      for (size_t Bits = 0; Bits < (size_t(1) << NumInputs); ++Bits) {
+        vector<bool> Context(NumInputs);
+        for (size_t Idx = 0; Idx < NumInputs; ++Idx) {
+          Context[Idx] = (Bits >> Idx) & 1;
+        }
+        Contexts.insert(std::move(Context));
+      }
+      break;
+    }
+    [[fallthrough]];
+  case SummaryGenerationStrategy::all_and_none:
+    Contexts.insert(vector<bool>(NumInputs, true));
+    Contexts.insert(vector<bool>(NumInputs, false));
+    break;
+  case SummaryGenerationStrategy::all_observed:
+    for (const auto &Context : Observed) {
+      if (Context.size() == NumInputs) {
+        Contexts.insert(Context);
+      }
+    }
+    break;
+  }
+  return Contexts;
+}
 } // namespace psr
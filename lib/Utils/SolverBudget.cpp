@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+#include <algorithm>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <utility>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "phasar/Config/Configuration.h"
+#include "phasar/Utils/SolverBudget.h"
+
+using namespace std;
+using namespace psr;
+
+namespace psr {
+
+CancellationToken::CancellationToken()
+    : Cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+std::string toString(BudgetExhaustion E) {
+  switch (E) {
+  case BudgetExhaustion::None:
+    return "none";
+  case BudgetExhaustion::Deadline:
+    return "time limit";
+  case BudgetExhaustion::Memory:
+    return "memory limit";
+  case BudgetExhaustion::WorkItems:
+    return "work limit";
+  case BudgetExhaustion::Cancelled:
+    return "cancelled";
+  }
+  return "unknown";
+}
+
+ostream &operator<<(ostream &OS, BudgetExhaustion E) {
+  return OS << toString(E);
+}
+
+SolverBudget SolverBudget::fromPhasarConfig() {
+  SolverBudget Budget;
+  const auto &VariablesMap = PhasarConfig::VariablesMap();
+  if (VariablesMap.count("solver-time-limit")) {
+    Budget.TimeLimit = std::chrono::seconds(
+        VariablesMap["solver-time-limit"].as<unsigned>());
+  }
+  if (VariablesMap.count("solver-memory-limit")) {
+    Budget.MaxResidentSetSize =
+        VariablesMap["solver-memory-limit"].as<size_t>() * 1024 * 1024;
+  }
+  if (VariablesMap.count("solver-max-path-edges")) {
+    Budget.MaxWorkItems = VariablesMap["solver-max-path-edges"].as<size_t>();
+  }
+  return Budget;
+}
+
+ostream &operator<<(ostream &OS, const SolverBudget &B) {
+  if (B.isUnlimited()) {
+    return OS << "unlimited";
+  }
+  OS << "time limit: ";
+  if (B.TimeLimit) {
+    OS << B.TimeLimit->count() << " ms";
+  } else {
+    OS << "none";
+  }
+  return OS << ", memory limit: " << B.MaxResidentSetSize
+            << " bytes, work limit: " << B.MaxWorkItems
+            << ", cancellable: " << B.Cancellation.has_value();
+}
+
+BudgetMonitor::BudgetMonitor(SolverBudget Budget, unsigned CheckInterval)
+    : Budget(std::move(Budget)), CheckInterval(std::max(CheckInterval, 1u)) {
+  if (this->Budget.TimeLimit) {
+    Deadline = std::chrono::steady_clock::now() + *this->Budget.TimeLimit;
+  }
+}
+
+bool BudgetMonitor::step() {
+  if (isExhausted()) {
+    return true;
+  }
+  uint64_t Item = NumWorkItems.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (Budget.MaxWorkItems != 0 && Item > Budget.MaxWorkItems) {
+    NumWorkItems.fetch_sub(1, std::memory_order_relaxed);
+    return exhaust(BudgetExhaustion::WorkItems);
+  }
+  if (Budget.Cancellation && Budget.Cancellation->isCancelled()) {
+    NumWorkItems.fetch_sub(1, std::memory_order_relaxed);
+    return exhaust(BudgetExhaustion::Cancelled);
+  }
+  // check the first item as well, the process may be over its budget already
+  if ((Item - 1) % CheckInterval == 0 && check()) {
+    NumWorkItems.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+bool BudgetMonitor::check() {
+  if (Budget.Cancellation && Budget.Cancellation->isCancelled()) {
+    return exhaust(BudgetExhaustion::Cancelled);
+  }
+  if (Budget.TimeLimit && std::chrono::steady_clock::now() >= Deadline) {
+    return exhaust(BudgetExhaustion::Deadline);
+  }
+  if (Budget.MaxResidentSetSize != 0 &&
+      getResidentSetSize() > Budget.MaxResidentSetSize) {
+    return exhaust(BudgetExhaustion::Memory);
+  }
+  return isExhausted();
+}
+
+uint64_t BudgetMonitor::getNumWorkItems() const {
+  return NumWorkItems.load(std::memory_order_relaxed);
+}
+
+bool BudgetMonitor::exhaust(BudgetExhaustion Reason) {
+  auto Expected = BudgetExhaustion::None;
+  // keep the first reason if several threads exhaust the budget at once
+  Exhaustion.compare_exchange_strong(Expected, Reason,
+                                     std::memory_order_relaxed);
+  return true;
+}
+
+size_t getResidentSetSize() {
+  // the second field of statm is the number of resident pages
+  std::ifstream Statm("/proc/self/statm");
+  size_t Size = 0;
+  size_t Resident = 0;
+  if (Statm >> Size >> Resident) {
+    return Resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+  struct rusage Usage {};
+  if (getrusage(RUSAGE_SELF, &Usage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  return static_cast<size_t>(Usage.ru_maxrss);
+#else
+  // Linux reports kilobytes
+  return static_cast<size_t>(Usage.ru_maxrss) * 1024;
+#endif
+}
+
+} // namespace psr
@@ -0,0 +1,13 @@
+int pick(int x) {
+  int r = 1;
+  if (x > 0) {
+    r = 2;
+  }
+  return r;
+}
+
+int main() {
+  int a = pick(3);
+  int b = pick(4);
+  return a + b;
+}
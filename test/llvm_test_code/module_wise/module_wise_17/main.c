@@ -0,0 +1,9 @@
+#include "src1.h"
+
+int main() {
+  int a;
+  int b = 1;
+  int c = addTen(a);
+  int d = addTen(b);
+  return c + d;
+}
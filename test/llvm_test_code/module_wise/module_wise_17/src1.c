@@ -0,0 +1,4 @@
+#include "src1.h"
+#include "src2.h"
+
+int addTen(int i) { return identity(i) + 10; }
@@ -0,0 +1,6 @@
+#ifndef SRC1_H_
+#define SRC1_H_
+
+int addTen(int i);
+
+#endif
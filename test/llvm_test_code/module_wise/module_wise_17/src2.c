@@ -0,0 +1,3 @@
+#include "src2.h"
+
+int identity(int z) { return z; }
@@ -0,0 +1,6 @@
+#ifndef SRC2_H_
+#define SRC2_H_
+
+int identity(int z);
+
+#endif
@@ -0,0 +1,6 @@
+#include "src1.h"
+#include "src2.h"
+
+int addTen(int i) { return identity(i) + 10; }
+
+int zero() { return 0; }
@@ -0,0 +1,8 @@
+#ifndef SRC1_H_
+#define SRC1_H_
+
+int addTen(int i);
+
+int zero();
+
+#endif
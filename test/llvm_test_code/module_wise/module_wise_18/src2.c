@@ -0,0 +1,4 @@
+#include "src2.h"
+#include "src1.h"
+
+int identity(int z) { return z + zero(); }
@@ -0,0 +1,22 @@
+int initialized(int a) { return a + 1; }
+
+int maybeUninit(int b) {
+	int c;
+	if (b > 0) {
+		c = b;
+	}
+	return c;
+}
+
+int compute(int d) {
+	int e = initialized(d);
+	return maybeUninit(e);
+}
+
+int main() {
+	int i;
+	int j = 42;
+	int k = compute(j);
+	int l = initialized(i);
+	return k + l;
+}
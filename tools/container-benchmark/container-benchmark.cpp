@@ -0,0 +1,187 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+// Records the target sets of the flow functions that are computed during
+// solver runs on the given LLVM IR file and replays building and merging them
+// with std::set and SmallFlatSet to compare the two containers.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "boost/filesystem/operations.hpp"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/SmallFlatSet.h"
+
+using namespace psr;
+
+namespace {
+
+/// The targets of a single flow function application of a solver run. The
+/// target facts are stored in Facts[Begin, End).
+struct TargetSet {
+  const void *Sink;
+  const void *Source;
+  uint32_t Begin;
+  uint32_t End;
+};
+
+std::vector<TargetSet> Trace;
+std::vector<const void *> Facts;
+
+/// A solver that records the targets of all flow functions it computes in
+/// Trace. The keys and facts of the bundled analyses are pointers.
+template <typename SolverTy> class RecordingSolver : public SolverTy {
+public:
+  using typename SolverTy::container_type;
+  using typename SolverTy::d_t;
+  using typename SolverTy::n_t;
+
+  using SolverTy::SolverTy;
+
+protected:
+  void saveEdges(n_t SourceNode, n_t SinkStmt, d_t SourceVal,
+                 const container_type &DestVals, bool InterP) override {
+    auto Begin = static_cast<uint32_t>(Facts.size());
+    Facts.insert(Facts.end(), DestVals.begin(), DestVals.end());
+    Trace.push_back(
+        {SinkStmt, SourceVal, Begin, static_cast<uint32_t>(Facts.size())});
+    SolverTy::saveEdges(SourceNode, SinkStmt, SourceVal, DestVals, InterP);
+  }
+};
+
+/// Replays the given trace with ContainerTy and returns the time that has
+/// been spent in milliseconds. Each target set is built fact by fact, as flow
+/// functions do, and merged into the facts that are known for its sink and
+/// source, as the solver does along the path edges.
+template <typename ContainerTy>
+double replay(const std::vector<uint32_t> &KeyIdx, size_t NumKeys,
+              int64_t &Checksum) {
+  std::vector<ContainerTy> Merged(NumKeys);
+  auto Start = std::chrono::steady_clock::now();
+  for (size_t Idx = 0; Idx < Trace.size(); ++Idx) {
+    const auto &T = Trace[Idx];
+    ContainerTy Targets;
+    for (uint32_t F = T.Begin; F < T.End; ++F) {
+      Targets.insert(Facts[F]);
+    }
+    auto &Known = Merged[KeyIdx[Idx]];
+    for (const void *Fact : Targets) {
+      Checksum += Known.count(Fact);
+    }
+    Known.insert(Targets.begin(), Targets.end());
+  }
+  for (const auto &Known : Merged) {
+    Checksum += Known.size();
+  }
+  auto End = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(End - Start).count();
+}
+
+void runBenchmark(const std::string &Workload, unsigned Repetitions) {
+  std::vector<uint32_t> KeyIdx;
+  KeyIdx.reserve(Trace.size());
+  std::unordered_map<const void *, std::unordered_map<const void *, uint32_t>>
+      KeyIDs;
+  uint32_t NumKeys = 0;
+  // sizes 0, 1, 2, 3 and more than 3
+  std::array<size_t, 5> Sizes{};
+  for (const auto &T : Trace) {
+    auto [It, Inserted] = KeyIDs[T.Sink].try_emplace(T.Source, NumKeys);
+    NumKeys += Inserted;
+    KeyIdx.push_back(It->second);
+    ++Sizes[std::min<size_t>(T.End - T.Begin, Sizes.size() - 1)];
+  }
+  std::cout << "\nWorkload: " << Workload << " (" << Trace.size()
+            << " target sets with " << Facts.size() << " facts)\n";
+  for (size_t Size = 0; Size < Sizes.size(); ++Size) {
+    std::cout << "  " << std::setw(2)
+              << (Size + 1 < Sizes.size() ? std::to_string(Size) : "4+")
+              << " facts: " << Sizes[Size] << '\n';
+  }
+  double SetTime = std::numeric_limits<double>::max();
+  double FlatSetTime = std::numeric_limits<double>::max();
+  int64_t SetChecksum = 0;
+  int64_t FlatSetChecksum = 0;
+  for (unsigned Rep = 0; Rep < Repetitions; ++Rep) {
+    SetTime = std::min(
+        SetTime, replay<std::set<const void *>>(KeyIdx, NumKeys, SetChecksum));
+    FlatSetTime =
+        std::min(FlatSetTime, replay<SmallFlatSet<const void *>>(
+                                  KeyIdx, NumKeys, FlatSetChecksum));
+  }
+  if (SetChecksum != FlatSetChecksum) {
+    std::cerr << "error: the containers disagree on the results of the "
+                 "replay\n";
+  }
+  std::cout << std::fixed << std::setprecision(3)
+            << "  std::set     : " << SetTime << " ms\n"
+            << "  SmallFlatSet : " << FlatSetTime << " ms\n"
+            << "  Speedup      : " << SetTime / FlatSetTime << "x\n";
+  Trace.clear();
+  Facts.clear();
+}
+
+} // anonymous namespace
+
+int main(int Argc, const char **Argv) {
+  initializeLogger(false);
+  if (Argc < 2 || !boost::filesystem::exists(Argv[1]) ||
+      boost::filesystem::is_directory(Argv[1])) {
+    std::cerr << "container-benchmark\n"
+                 "Replays the flow function targets of solver runs on "
+                 "std::set and SmallFlatSet\n\n"
+                 "Usage: container-benchmark <LLVM IR file> [<repetitions>]\n";
+    return 1;
+  }
+  unsigned Repetitions = Argc > 2 ? std::stoul(Argv[2]) : 5;
+  ProjectIRDB DB({Argv[1]}, IRDBOptions::WPA);
+  if (!DB.getFunctionDefinition("main")) {
+    std::cerr << "error: file does not contain a 'main' function!\n";
+    return 1;
+  }
+  LLVMTypeHierarchy H(DB);
+  LLVMPointsToSet P(DB);
+  LLVMBasedICFG I(DB, CallGraphAnalysisType::OTF, {"main"}, &H, &P);
+  {
+    IDELinearConstantAnalysis Problem(&DB, &H, &I, &P, {"main"});
+    RecordingSolver<IDESolver<IDELinearConstantAnalysis::ProblemAnalysisDomain,
+                              IDELinearConstantAnalysis::container_type>>
+        Solver(Problem);
+    Solver.solve();
+  }
+  runBenchmark("IDELinearConstantAnalysis", Repetitions);
+  {
+    IFDSUninitializedVariables Problem(&DB, &H, &I, &P, {"main"});
+    RecordingSolver<
+        IFDSSolver<IFDSUninitializedVariables::ProblemAnalysisDomain>>
+        Solver(Problem);
+    Solver.solve();
+  }
+  runBenchmark("IFDSUninitializedVariables", Repetitions);
+  return 0;
+}
@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+// Rebuilds the exploded super-graph (ESG) that a solver run has streamed to
+// an ESG edge log as DOT graph or as JSON.
+
+#include <iostream>
+#include <string>
+
+#include "boost/filesystem/operations.hpp"
+
+#include "phasar/Config/Configuration.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGEdgeLog.h"
+#include "phasar/PhasarLLVM/Utils/DOTGraph.h"
+
+using namespace psr;
+
+int main(int Argc, const char **Argv) {
+  std::string Format = Argc > 2 ? Argv[2] : "dot";
+  if (Argc < 2 || Argc > 3 || !boost::filesystem::exists(Argv[1]) ||
+      boost::filesystem::is_directory(Argv[1]) ||
+      (Format != "dot" && Format != "json")) {
+    std::cerr << "esg-reader\n"
+                 "Prints an exploded super-graph (ESG) edge log as DOT graph "
+                 "or as JSON\n\n"
+                 "Usage: esg-reader <ESG edge log> [dot|json]\n";
+    return 1;
+  }
+  try {
+    ESGEdgeLog Log = ESGEdgeLog::read(Argv[1]);
+    if (Format == "json") {
+      std::cout << Log.getAsJson().dump(4) << '\n';
+    } else {
+      DOTConfig::importDOTConfig(PhasarConfig::PhasarDirectory());
+      Log.printAsDot(std::cout);
+    }
+  } catch (const std::ios_base::failure &E) {
+    std::cerr << "error: " << E.what() << '\n';
+    return 1;
+  }
+  return 0;
+}
@@ -20,6 +20,7 @@
 #include "boost/filesystem.hpp"
 #include "phasar/Config/Configuration.h"
 #include "phasar/Controller/AnalysisController.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSIDESolverConfig.h"
 #include "phasar/PhasarLLVM/Plugins/AnalysisPluginController.h"
 #include "phasar/PhasarLLVM/Plugins/PluginFactories.h"
 #include "phasar/PhasarLLVM/Utils/DataFlowAnalysisType.h"
@@ -102,6 +103,13 @@ void validateParamAnalysisStrategy(const std::string &Strategy) {
   }
 }
 
+void validateParamShardBy(const std::string &Policy) {
+  if (Policy != "entry-point" && Policy != "component") {
+    throw boost::program_options::error_with_option_name(
+        "'" + Policy + "' is not a valid sharding policy!");
+  }
+}
+
 void validateParamPointerAnalysis(const std::string &Analysis) {
   if (toPointerAnalysisType(Analysis) == PointerAnalysisType::Invalid) {
     throw boost::program_options::error_with_option_name(
@@ -123,6 +131,13 @@ void validateSoundnessFlag(const std::string &Flag) {
   }
 }
 
+void validateParamSolverWorklist(const std::string &Policy) {
+  if (toWorklistPolicy(Policy) == WorklistPolicy::Invalid) {
+    throw boost::program_options::error_with_option_name(
+        "'" + Policy + "' is not a valid worklist policy!");
+  }
+}
+
 void validateParamAnalysisPlugin(const std::vector<std::string> &Plugins) {
   for (const auto &Plugin : Plugins) {
     boost::filesystem::path PluginPath(Plugin);
@@ -178,6 +193,10 @@ int main(int Argc, const char **Argv) {
       ("entry-points,E", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing(), "Set the entry point(s) to be used")
 			("data-flow-analysis,D", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()/*->notifier(&validateParamDataFlowAnalysis)*/, "Set the analysis to be run")
 			("analysis-strategy", boost::program_options::value<std::string>()->default_value("WPA")->notifier(&validateParamAnalysisStrategy))
+      ("demand-query", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing(), "Set the ID(s) of the instruction(s) at which the data-flow facts are queried (analysis strategy DD only)")
+      ("incremental-state", boost::program_options::value<std::string>(), "Set the directory in which the state of an analysis run is kept for the next run, defaults to 'phasar-incremental-state' (analysis strategy INC only)")
+      ("analysis-threads", boost::program_options::value<unsigned>(), "Set the number of threads that solve the data-flow analyses (analysis strategy WPA), or the modules (MWA) or shards (SHARD) of each analysis, concurrently, defaults to 1; with WPA, the analyses share the type hierarchy, call graph and points-to information and have to be safe to run concurrently, and their results are emitted in the order of the analyses")
+      ("shard-by", boost::program_options::value<std::string>()->default_value("entry-point")->notifier(&validateParamShardBy), "Set how the seeds are partitioned into shards that are solved in parallel (entry-point, component): one shard per entry point or per connected component of the call graph (analysis strategy SHARD only)")
       ("analysis-config", boost::program_options::value<std::vector<std::string>>()->multitoken()->zero_tokens()->composing()->notifier(&validateParamAnalysisConfig), "Set the analysis's configuration (if required)")
       ("pointer-analysis,P", boost::program_options::value<std::string>()->notifier(&validateParamPointerAnalysis)->default_value("CFLAnders"), "Set the points-to analysis to be used (CFLSteens, CFLAnders).  CFLSteens is ~O(N) but inaccurate while CFLAnders O(N^3) but more accurate.")
       ("call-graph-analysis,C", boost::program_options::value<std::string>()->notifier(&validateParamCallGraphAnalysis)->default_value("OTF"), "Set the call-graph algorithm to be used (NORESOLVE, CHA, RTA, DTA, VTA, OTF)")
@@ -197,6 +216,23 @@ int main(int Argc, const char **Argv) {
       ("emit-text-report", "Emit textual report of solver results")
       ("emit-graphical-report", "Emit graphical report of solver results")
       ("emit-esg-as-dot", "Emit the exploded super-graph (ESG) as DOT graph")
+      ("esg-log", boost::program_options::value<std::string>(), "Stream the exploded super-graph (ESG) edges to the given binary log file instead of keeping them in memory (see the esg-reader tool)")
+      ("solver-profile", boost::program_options::value<std::string>(), "Profile the work of the IFDS/IDE solver per function and call site and write it as JSON to the given file and as collapsed stacks for flame graph tools to <file>.folded")
+      ("persisted-summaries", boost::program_options::value<std::string>(), "Apply the procedure summaries persisted in the given directory at call sites instead of analyzing the callees, and persist the summaries computed by the IFDS/IDE solver there (for analyses that support it)")
+      ("library-summaries", boost::program_options::value<std::string>(), "Apply the precomputed summaries of library functions in the given JSON file at their call sites (IFDS analyses only)")
+      ("dense-jump-functions", "Let the IFDS/IDE solver store its jump functions in a compact, integer-indexed data structure")
+      ("retire-jump-functions", "Let the IFDS/IDE solver drop the jump functions inside of a function once no work is pending for it and recompute them per function when computing the values (bounds memory, single-threaded only)")
+      ("lazy-values", "Let the IFDS/IDE solver compute the values at a node only once the results at the node are queried (saves time and memory if only few nodes are looked at; all values are computed when all results are emitted)")
+      ("solver-threads", boost::program_options::value<unsigned>(), "Set the number of threads the IFDS/IDE solver uses to construct the exploded super-graph (requires an analysis whose flow and edge functions are thread-safe, ignored if PAMM is enabled)")
+      ("flow-edge-function-cache-capacity", boost::program_options::value<size_t>(), "Bound the number of entries of each of the IFDS/IDE solver's flow and edge function caches, evicting the least recently used ones (default: unbounded)")
+      ("solver-time-limit", boost::program_options::value<unsigned>(), "Stop the construction of the exploded super-graph (IFDS/IDE) or the fixpoint iteration (monotone) after the given number of seconds and report incomplete results computed so far")
+      ("solver-memory-limit", boost::program_options::value<size_t>(), "Stop the construction of the exploded super-graph (IFDS/IDE) or the fixpoint iteration (monotone) once the resident set size exceeds the given number of MiB and report incomplete results computed so far")
+      ("solver-max-path-edges", boost::program_options::value<size_t>(), "Stop the construction of the exploded super-graph (IFDS/IDE) after processing the given number of path edges, or the fixpoint iteration (monotone) after the given number of worklist items, and report incomplete results computed so far")
+      ("solver-checkpoint", boost::program_options::value<std::string>(), "Checkpoint the construction of the exploded super-graph (IFDS/IDE) to the given file periodically, when a solver limit is hit and when it is done (for analyses that support persisted summaries, single-threaded only)")
+      ("solver-checkpoint-interval", boost::program_options::value<unsigned>(), "Set the number of seconds between two checkpoints (default: 600)")
+      ("solver-resume", "Resume the construction of the exploded super-graph (IFDS/IDE) from the file given by --solver-checkpoint if it was written by the same analysis for the same IR")
+      ("native-ifds-solver", "Solve whole-program IFDS analyses with a solver that does not construct edge functions (faster, but only supports --solver-worklist of the solver options; falls back to the IFDS/IDE solver if others are set)")
+      ("solver-worklist", boost::program_options::value<std::string>()->notifier(&validateParamSolverWorklist)->default_value("FIFO"), "Set the order in which the IFDS/IDE solver processes path edges (FIFO, LIFO, RPO)")
       ("emit-th-as-text", "Emit the type hierarchy as text")
       ("emit-th-as-dot", "Emit the type hierarchy as DOT graph")
       ("emit-th-as-json", "Emit the type hierarchy as JSON")
@@ -289,14 +325,21 @@ int main(int Argc, const char **Argv) {
   } else {
     Strategy = AnalysisStrategy::WholeProgram;
   }
+  if (PhasarConfig::VariablesMap().count("mwa")) {
+    Strategy = AnalysisStrategy::ModuleWise;
+  }
   if (!PhasarConfig::VariablesMap().count("module")) {
     std::cout << "At least on LLVM target module is required!\n"
                  "Specify a LLVM target module or re-run with '--help'\n";
     return 0;
   }
-  // setup IRDB as source code manager
+  // setup IRDB as source code manager; module-wise analysis does not link
+  // the modules
   ProjectIRDB IRDB(
-      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>());
+      PhasarConfig::VariablesMap()["module"].as<std::vector<std::string>>(),
+      Strategy == AnalysisStrategy::ModuleWise
+          ? IRDBOptions::OWNS
+          : (IRDBOptions::WPA | IRDBOptions::OWNS));
 
   // store enabled data-flow analyses
   std::vector<DataFlowAnalysisKind> DataFlowAnalyses;
@@ -0,0 +1,423 @@
+/******************************************************************************
+ * Copyright (c) 2021 Philipp Schubert.
+ * All rights reserved. This program and the accompanying materials are made
+ * available under the terms of LICENSE.txt.
+ *
+ * Contributors:
+ *     Philipp Schubert and others
+ *****************************************************************************/
+
+// Records the table accesses of solver runs on the given LLVM IR file and
+// replays them on Table and FlatTable to compare the two implementations.
+// The replay uses the solver's value types, e.g., edge functions and nested
+// tables, and inserts the values that the solver inserted.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "boost/filesystem/operations.hpp"
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/FlatTable.h"
+#include "phasar/Utils/Logger.h"
+#include "phasar/Utils/Table.h"
+
+using namespace psr;
+
+namespace {
+
+enum class TableOp : uint8_t { Insert, Get, Contains, Lookup, Row, Remove };
+
+constexpr size_t NumTableOps = static_cast<size_t>(TableOp::Remove) + 1;
+
+const char *toString(TableOp Op) {
+  switch (Op) {
+  case TableOp::Insert:
+    return "insert";
+  case TableOp::Get:
+    return "get";
+  case TableOp::Contains:
+    return "contains";
+  case TableOp::Lookup:
+    return "const get";
+  case TableOp::Row:
+    return "row";
+  case TableOp::Remove:
+    return "remove";
+  }
+  return "unknown";
+}
+
+/// A single table access of a solver run. The keys of the solver's tables
+/// are pointers.
+struct TableAccess {
+  TableOp Op;
+  // index into RecordedTables
+  uint32_t Table;
+  // for Insert the index of the inserted value; for Get on a table of tables
+  // the index of the returned (nested) table in RecordedTables
+  uint32_t Arg;
+  const void *Row;
+  const void *Col;
+};
+
+std::vector<TableAccess> Trace;
+
+class TableReplay;
+
+/// A table of the solver whose accesses have been recorded.
+class RecordedTable {
+public:
+  virtual ~RecordedTable() = default;
+  [[nodiscard]] virtual std::unique_ptr<TableReplay> replayOnTable() const = 0;
+  [[nodiscard]] virtual std::unique_ptr<TableReplay>
+  replayOnFlatTable() const = 0;
+};
+
+std::vector<std::unique_ptr<RecordedTable>> RecordedTables;
+
+// tables are identified by their addresses and value types during the run
+std::map<std::pair<const void *, std::type_index>, uint32_t> RecordedTableIDs;
+
+template <typename R, typename C, typename V> class RecordingTable;
+
+template <typename V> struct IsRecordingTable : std::false_type {};
+template <typename R, typename C, typename V>
+struct IsRecordingTable<RecordingTable<R, C, V>> : std::true_type {};
+
+/// The type of the values of a recorded table with values of type V when it
+/// is replayed on tables of type TableImpl, i.e., nested recorded tables are
+/// replaced by TableImpl.
+template <template <typename, typename, typename> class TableImpl,
+          typename V>
+struct Replayed {
+  using type = V;
+};
+template <template <typename, typename, typename> class TableImpl,
+          typename R, typename C, typename V>
+struct Replayed<TableImpl, RecordingTable<R, C, V>> {
+  using type = TableImpl<const void *, const void *,
+                         typename Replayed<TableImpl, V>::type>;
+};
+
+template <template <typename, typename, typename> class TableImpl,
+          typename V>
+typename Replayed<TableImpl, V>::type toReplayed(const V &Val) {
+  if constexpr (IsRecordingTable<V>::value) {
+    typename Replayed<TableImpl, V>::type Result;
+    Val.foreachCell([&Result](auto Row, auto Col, const auto &Nested) {
+      Result.insert(Row, Col, toReplayed<TableImpl>(Nested));
+    });
+    return Result;
+  } else {
+    return Val;
+  }
+}
+
+template <typename V, typename = void> struct HasSize : std::false_type {};
+template <typename V>
+struct HasSize<V, std::void_t<decltype(std::declval<V>().size())>>
+    : std::true_type {};
+
+/// Condenses a value into the checksum of a replay, which must not depend on
+/// the table implementation.
+template <typename V> int64_t digest(const V &Val) {
+  if constexpr (std::is_arithmetic_v<V> || std::is_enum_v<V>) {
+    return static_cast<int64_t>(Val);
+  } else if constexpr (std::is_constructible_v<bool, V>) {
+    // edge functions
+    return static_cast<bool>(Val);
+  } else if constexpr (HasSize<V>::value) {
+    return static_cast<int64_t>(Val.size());
+  } else {
+    return 1;
+  }
+}
+
+/// Replays the accesses to a recorded table on a table of type TableTy.
+class TableReplay {
+public:
+  virtual ~TableReplay() = default;
+  virtual void replay(const TableAccess &A,
+                      std::vector<std::unique_ptr<TableReplay>> &Replays,
+                      int64_t &Checksum) = 0;
+  /// Redirects the accesses to the given table, which is nested in another
+  /// replayed table and has just been returned by a Get.
+  virtual void bind(void *Nested) = 0;
+};
+
+template <typename TableTy, typename ValueTy>
+class TableReplayOn : public TableReplay {
+public:
+  explicit TableReplayOn(std::vector<ValueTy> Values)
+      : Values(std::move(Values)) {}
+
+  void replay(const TableAccess &A,
+              std::vector<std::unique_ptr<TableReplay>> &Replays,
+              int64_t &Checksum) override {
+    switch (A.Op) {
+    case TableOp::Insert:
+      T->insert(A.Row, A.Col, Values[A.Arg]);
+      break;
+    case TableOp::Get: {
+      auto &Val = T->get(A.Row, A.Col);
+      if (A.Arg != None) {
+        Replays[A.Arg]->bind(&Val);
+      }
+      Checksum += digest(Val);
+      break;
+    }
+    case TableOp::Contains:
+      Checksum += T->contains(A.Row, A.Col);
+      break;
+    case TableOp::Lookup: {
+      const auto &Val = std::as_const(*T).get(A.Row, A.Col);
+      if (A.Arg != None) {
+        // only const accesses of the nested table follow
+        Replays[A.Arg]->bind(const_cast<ValueTy *>(&Val));
+      }
+      Checksum += digest(Val);
+      break;
+    }
+    case TableOp::Row:
+      for (const auto &[Col, Val] : T->row(A.Row)) {
+        Checksum += digest(Val);
+      }
+      break;
+    case TableOp::Remove:
+      Checksum += digest(T->remove(A.Row, A.Col));
+      break;
+    }
+  }
+
+  void bind(void *Nested) override { T = static_cast<TableTy *>(Nested); }
+
+  static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+private:
+  // the replayed table itself unless it is nested in another one
+  TableTy Own;
+  TableTy *T = &Own;
+  std::vector<ValueTy> Values;
+};
+
+template <typename V> class RecordedTableOf : public RecordedTable {
+public:
+  [[nodiscard]] std::unique_ptr<TableReplay> replayOnTable() const override {
+    return replayOn<Table>();
+  }
+
+  [[nodiscard]] std::unique_ptr<TableReplay>
+  replayOnFlatTable() const override {
+    return replayOn<FlatTable>();
+  }
+
+  // the values that have been inserted into the table
+  std::vector<V> Values;
+
+private:
+  template <template <typename, typename, typename> class TableImpl>
+  [[nodiscard]] std::unique_ptr<TableReplay> replayOn() const {
+    using ValueTy = typename Replayed<TableImpl, V>::type;
+    std::vector<ValueTy> Converted;
+    Converted.reserve(Values.size());
+    for (const auto &Val : Values) {
+      Converted.push_back(toReplayed<TableImpl>(Val));
+    }
+    return std::make_unique<TableReplayOn<
+        TableImpl<const void *, const void *, ValueTy>, ValueTy>>(
+        std::move(Converted));
+  }
+};
+
+/// Returns the index of the table at the given address in RecordedTables.
+template <typename V> uint32_t getRecordedTableID(const void *Table) {
+  auto [It, Inserted] = RecordedTableIDs.try_emplace(
+      {Table, std::type_index(typeid(V))}, RecordedTables.size());
+  if (Inserted) {
+    RecordedTables.push_back(std::make_unique<RecordedTableOf<V>>());
+  }
+  return It->second;
+}
+
+/// A Table that records all accesses of the solver in Trace, together with
+/// the inserted values. Values that the solver modifies through references
+/// are not recorded, unless they are tables themselves.
+template <typename R, typename C, typename V>
+class RecordingTable : public Table<R, C, V> {
+  static_assert(std::is_pointer_v<R> && std::is_pointer_v<C>,
+                "Only tables with pointer keys can be recorded");
+
+public:
+  // merging whole tables is not recorded
+  using Table<R, C, V>::insert;
+
+  void insert(R Row, C Col, V Val) {
+    auto ID = getRecordedTableID<V>(this);
+    auto &Values =
+        static_cast<RecordedTableOf<V> &>(*RecordedTables[ID]).Values;
+    record(TableOp::Insert, Row, Col, static_cast<uint32_t>(Values.size()));
+    Values.push_back(Val);
+    Table<R, C, V>::insert(Row, Col, std::move(Val));
+  }
+
+  [[nodiscard]] V &get(R Row, C Col) {
+    auto &Val = Table<R, C, V>::get(Row, Col);
+    record(TableOp::Get, Row, Col, nestedTableID(Val));
+    return Val;
+  }
+
+  [[nodiscard]] const V &get(R Row, C Col) const {
+    const auto &Val = Table<R, C, V>::get(Row, Col);
+    record(TableOp::Lookup, Row, Col, nestedTableID(Val));
+    return Val;
+  }
+
+  [[nodiscard]] bool contains(R Row, C Col) const {
+    record(TableOp::Contains, Row, Col);
+    return Table<R, C, V>::contains(Row, Col);
+  }
+
+  [[nodiscard]] std::unordered_map<C, V> &row(R Row) {
+    record(TableOp::Row, Row, nullptr);
+    return Table<R, C, V>::row(Row);
+  }
+
+  [[nodiscard]] const std::unordered_map<C, V> &row(R Row) const {
+    record(TableOp::Row, Row, nullptr);
+    return Table<R, C, V>::row(Row);
+  }
+
+  V remove(R Row, C Col) {
+    record(TableOp::Remove, Row, Col);
+    return Table<R, C, V>::remove(Row, Col);
+  }
+
+  using value_type = V;
+
+private:
+  static constexpr uint32_t None = std::numeric_limits<uint32_t>::max();
+
+  void record(TableOp Op, R Row, C Col, uint32_t Arg = None) const {
+    Trace.push_back({Op, getRecordedTableID<V>(this), Arg, Row, Col});
+  }
+
+  static uint32_t nestedTableID(const V &Val) {
+    if constexpr (IsRecordingTable<V>::value) {
+      return getRecordedTableID<typename V::value_type>(&Val);
+    } else {
+      return None;
+    }
+  }
+};
+
+/// Replays the trace on the recorded tables using the given replays and
+/// returns the time that has been spent in milliseconds.
+double replay(std::vector<std::unique_ptr<TableReplay>> Replays,
+              int64_t &Checksum) {
+  auto Start = std::chrono::steady_clock::now();
+  for (const auto &A : Trace) {
+    Replays[A.Table]->replay(A, Replays, Checksum);
+  }
+  auto End = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(End - Start).count();
+}
+
+void runBenchmark(const std::string &Workload, unsigned Repetitions) {
+  std::vector<size_t> NumOps(NumTableOps, 0);
+  for (const auto &A : Trace) {
+    ++NumOps[static_cast<size_t>(A.Op)];
+  }
+  std::cout << "\nWorkload: " << Workload << " (" << Trace.size()
+            << " accesses to " << RecordedTables.size() << " tables)\n";
+  for (size_t Op = 0; Op < NumTableOps; ++Op) {
+    std::cout << "  " << std::setw(10) << toString(static_cast<TableOp>(Op))
+              << ": " << NumOps[Op] << '\n';
+  }
+  double TableTime = std::numeric_limits<double>::max();
+  double FlatTableTime = std::numeric_limits<double>::max();
+  int64_t TableChecksum = 0;
+  int64_t FlatTableChecksum = 0;
+  for (unsigned Rep = 0; Rep < Repetitions; ++Rep) {
+    // set up the tables and the values to insert before the clock starts
+    std::vector<std::unique_ptr<TableReplay>> OnTable;
+    std::vector<std::unique_ptr<TableReplay>> OnFlatTable;
+    for (const auto &Recorded : RecordedTables) {
+      OnTable.push_back(Recorded->replayOnTable());
+      OnFlatTable.push_back(Recorded->replayOnFlatTable());
+    }
+    TableTime = std::min(TableTime, replay(std::move(OnTable), TableChecksum));
+    FlatTableTime = std::min(
+        FlatTableTime, replay(std::move(OnFlatTable), FlatTableChecksum));
+  }
+  if (TableChecksum != FlatTableChecksum) {
+    std::cerr << "error: the tables disagree on the results of the replay\n";
+  }
+  std::cout << std::fixed << std::setprecision(3)
+            << "  Table     : " << TableTime << " ms\n"
+            << "  FlatTable : " << FlatTableTime << " ms\n"
+            << "  Speedup   : " << TableTime / FlatTableTime << "x\n";
+  Trace.clear();
+  RecordedTables.clear();
+  RecordedTableIDs.clear();
+}
+
+} // anonymous namespace
+
+int main(int Argc, const char **Argv) {
+  initializeLogger(false);
+  if (Argc < 2 || !boost::filesystem::exists(Argv[1]) ||
+      boost::filesystem::is_directory(Argv[1])) {
+    std::cerr << "table-benchmark\n"
+                 "Replays the table accesses of solver runs on Table and "
+                 "FlatTable\n\n"
+                 "Usage: table-benchmark <LLVM IR file> [<repetitions>]\n";
+    return 1;
+  }
+  unsigned Repetitions = Argc > 2 ? std::stoul(Argv[2]) : 5;
+  ProjectIRDB DB({Argv[1]}, IRDBOptions::WPA);
+  if (!DB.getFunctionDefinition("main")) {
+    std::cerr << "error: file does not contain a 'main' function!\n";
+    return 1;
+  }
+  LLVMTypeHierarchy H(DB);
+  LLVMPointsToSet P(DB);
+  LLVMBasedICFG I(DB, CallGraphAnalysisType::OTF, {"main"}, &H, &P);
+  {
+    IDELinearConstantAnalysis Problem(&DB, &H, &I, &P, {"main"});
+    IDESolver<IDELinearConstantAnalysis::ProblemAnalysisDomain,
+              IDELinearConstantAnalysis::container_type, RecordingTable>
+        Solver(Problem);
+    Solver.solve();
+  }
+  runBenchmark("IDELinearConstantAnalysis", Repetitions);
+  {
+    IFDSUninitializedVariables Problem(&DB, &H, &I, &P, {"main"});
+    IFDSSolver<IFDSUninitializedVariables::ProblemAnalysisDomain,
+               RecordingTable>
+        Solver(Problem);
+    Solver.solve();
+  }
+  runBenchmark("IFDSUninitializedVariables", Repetitions);
+  return 0;
+}
@@ -0,0 +1,100 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctionHandle.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+using namespace psr;
+
+struct AddTwoEF : EdgeFunction<int>, std::enable_shared_from_this<AddTwoEF> {
+  int computeTarget(int Source) override { return Source + 2; };
+  std::shared_ptr<EdgeFunction<int>>
+  composeWith(std::shared_ptr<EdgeFunction<int>> SecondFunction) override {
+    if (SecondFunction->getKind() == EdgeFunctionKind::Identity) {
+      return this->shared_from_this();
+    }
+    return SecondFunction;
+  }
+  std::shared_ptr<EdgeFunction<int>>
+  joinWith(std::shared_ptr<EdgeFunction<int>> OtherFunction) override {
+    if (OtherFunction.get() == this) {
+      return this->shared_from_this();
+    }
+    return std::make_shared<AllBottom<int>>(-1);
+  };
+  bool equal_to(std::shared_ptr<EdgeFunction<int>> Other) const override {
+    return this == Other.get();
+  }
+};
+
+class EdgeFunctionHandleTest : public ::testing::Test {
+protected:
+  std::vector<std::shared_ptr<EdgeFunction<int>>> EFs{
+      EdgeIdentity<int>::getInstance(), std::make_shared<AllTop<int>>(42),
+      std::make_shared<AllBottom<int>>(-1), std::make_shared<AddTwoEF>()};
+};
+
+TEST_F(EdgeFunctionHandleTest, HandleKinds) {
+  EXPECT_TRUE(EdgeFunctionHandle<int>(EFs[0]).isIdentity());
+  EXPECT_TRUE(EdgeFunctionHandle<int>(EFs[1]).isAllTop());
+  EXPECT_TRUE(EdgeFunctionHandle<int>(EFs[2]).isAllBottom());
+  EXPECT_EQ(EdgeFunctionHandle<int>(EFs[3]).getKind(), EdgeFunctionKind::Other);
+  EXPECT_EQ(EdgeFunctionHandle<int>(EFs[1]).getConstant(), 42);
+  EXPECT_EQ(EdgeFunctionHandle<int>(EFs[2]).getConstant(), -1);
+}
+
+TEST_F(EdgeFunctionHandleTest, HandleComputeTarget) {
+  EXPECT_EQ(EdgeFunctionHandle<int>::identity().computeTarget(7), 7);
+  EXPECT_EQ(EdgeFunctionHandle<int>::allTop(42).computeTarget(7), 42);
+  EXPECT_EQ(EdgeFunctionHandle<int>::allBottom(-1).computeTarget(7), -1);
+  EXPECT_EQ(EdgeFunctionHandle<int>(EFs[3]).computeTarget(7), 9);
+}
+
+TEST_F(EdgeFunctionHandleTest, HandleMatchesVirtualImplementation) {
+  for (const auto &F : EFs) {
+    for (const auto &G : EFs) {
+      EdgeFunctionHandle<int> FH(F);
+      EdgeFunctionHandle<int> GH(G);
+      EXPECT_EQ(FH.equal_to(GH), F->equal_to(G))
+          << F->str() << " == " << G->str();
+      EXPECT_TRUE(FH.composeWith(GH).get()->equal_to(F->composeWith(G)))
+          << F->str() << " * " << G->str();
+      EXPECT_TRUE(FH.joinWith(GH).get()->equal_to(F->joinWith(G)))
+          << F->str() << " v " << G->str();
+    }
+  }
+}
+
+TEST_F(EdgeFunctionHandleTest, HandleReturnsOperands) {
+  EdgeFunctionHandle<int> Id(EFs[0]);
+  EdgeFunctionHandle<int> Top(EFs[1]);
+  EdgeFunctionHandle<int> Bot(EFs[2]);
+  EdgeFunctionHandle<int> Other(EFs[3]);
+  // Neither of these operations must create a new edge function.
+  EXPECT_EQ(Id.composeWith(Other).get(), EFs[3]);
+  EXPECT_EQ(Top.composeWith(Other).get(), EFs[1]);
+  EXPECT_EQ(Top.joinWith(Other).get(), EFs[3]);
+  EXPECT_EQ(Bot.joinWith(Other).get(), EFs[2]);
+  EXPECT_EQ(Id.joinWith(Bot).get(), EFs[2]);
+  EXPECT_EQ(Id.joinWith(Top).get(), EFs[0]);
+}
+
+TEST_F(EdgeFunctionHandleTest, InlineConstants) {
+  auto Top = EdgeFunctionHandle<int>::allTop(42);
+  auto Bot = EdgeFunctionHandle<int>::allBottom(-1);
+  EXPECT_EQ(Top, EdgeFunctionHandle<int>(EFs[1]));
+  EXPECT_EQ(Bot, EdgeFunctionHandle<int>(EFs[2]));
+  EXPECT_NE(Top, EdgeFunctionHandle<int>::allTop(13));
+  EXPECT_NE(Top, Bot);
+  EXPECT_EQ(Top.joinWith(Bot), Bot);
+  EXPECT_EQ(EdgeFunctionHandle<int>::identity().joinWith(Top),
+            EdgeFunctionHandle<int>::identity());
+  EXPECT_TRUE(Top.get()->equal_to(EFs[1]));
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,8 +2,8 @@
 
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/EdgeFunctions.h"
 
-#include <chrono>
 #include <thread>
+#include <vector>
 
 namespace psr::internal {
 struct TestEdgeFunction
@@ -13,10 +13,6 @@ struct TestEdgeFunction
 
   TestEdgeFunction(int Val) : Val(Val) {}
 
-  static decltype(auto) getTestCacheData() {
-    return EdgeFunctionSingletonFactory<TestEdgeFunction, int>::getCacheData();
-  }
-
   int computeTarget(int Source) override { return 42; }
 
   EdgeFunctionPtrType composeWith(EdgeFunctionPtrType secondFunction) override {
@@ -45,7 +41,7 @@ TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctions) {
   auto EF1 = TestEdgeFunction::createEdgeFunction(42);
   auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
 
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
+  EXPECT_EQ(TestEdgeFunction::size(), 2U);
 }
 
 TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsWithCorrectData) {
@@ -61,7 +57,7 @@ TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsTwice) {
   auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
   auto EF3 = TestEdgeFunction::createEdgeFunction(42);
 
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
+  EXPECT_EQ(TestEdgeFunction::size(), 2U);
   EXPECT_EQ(EF1.get(), EF3.get());
 }
 
@@ -69,53 +65,55 @@ TEST(EdgeFunctionSingletonFactoryTest, selfCleanExpiredEdgeFunctions) {
   auto EF1 = TestEdgeFunction::createEdgeFunction(42);
   {
     auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
+    EXPECT_EQ(TestEdgeFunction::size(), 2U);
   } // EF2 deleted after scope
 
-  TestEdgeFunction::cleanExpiredEdgeFunctions();
+  EXPECT_EQ(TestEdgeFunction::size(), 1U);
+}
 
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 1U);
+TEST(EdgeFunctionSingletonFactoryTest, recreateExpiredEdgeFunctions) {
+  {
+    auto EF1 = TestEdgeFunction::createEdgeFunction(42);
+  } // EF1 deleted after scope
+  auto EF2 = TestEdgeFunction::createEdgeFunction(42);
+
+  EXPECT_EQ(EF2->Val, 42);
+  EXPECT_EQ(TestEdgeFunction::size(), 1U);
 }
 
 //===----------------------------------------------------------------------===//
 // Threaded tests
 
 TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsThreaded) {
-  TestEdgeFunction::initEdgeFunctionCleaner();
-
-  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
-  auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
-
-  std::lock_guard<std::mutex> DataLock(
-      TestEdgeFunction::getTestCacheData().DataMutex);
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
-}
-
-TEST(EdgeFunctionSingletonFactoryTest, createEdgeFunctionsTwiceThreaded) {
-  TestEdgeFunction::initEdgeFunctionCleaner();
-
-  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
-  auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
-  auto EF3 = TestEdgeFunction::createEdgeFunction(42);
-
-  std::lock_guard<std::mutex> DataLock(
-      TestEdgeFunction::getTestCacheData().DataMutex);
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 2U);
-  EXPECT_EQ(EF1.get(), EF3.get());
-}
-
-TEST(EdgeFunctionSingletonFactoryTest, selfCleanExpiredEdgeFunctionsThreaded) {
-  TestEdgeFunction::initEdgeFunctionCleaner();
-
-  auto EF1 = TestEdgeFunction::createEdgeFunction(42);
-  {
-    auto EF2 = TestEdgeFunction::createEdgeFunction(1337);
-  } // EF2 deleted after scope
+  constexpr int NumThreads = 8;
+  constexpr int NumKeys = 256;
+
+  std::vector<std::vector<std::shared_ptr<TestEdgeFunction>>> Results(
+      NumThreads);
+  std::vector<std::thread> Threads;
+  for (int T = 0; T < NumThreads; ++T) {
+    Threads.emplace_back([&Results, T] {
+      for (int Round = 0; Round < 16; ++Round) {
+        Results[T].clear();
+        for (int K = 0; K < NumKeys; ++K) {
+          Results[T].push_back(TestEdgeFunction::createEdgeFunction(K));
+        }
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
 
-  std::this_thread::sleep_for(std::chrono::seconds{3});
+  EXPECT_EQ(TestEdgeFunction::size(), static_cast<size_t>(NumKeys));
+  for (int T = 1; T < NumThreads; ++T) {
+    for (int K = 0; K < NumKeys; ++K) {
+      EXPECT_EQ(Results[0][K].get(), Results[T][K].get());
+    }
+  }
 
-  std::lock_guard<std::mutex> DataLock(
-      TestEdgeFunction::getTestCacheData().DataMutex);
-  EXPECT_EQ(TestEdgeFunction::getTestCacheData().Storage.size(), 1U);
+  Results.clear();
+  EXPECT_EQ(TestEdgeFunction::size(), 0U);
 }
 
 // main function for the test case
@@ -0,0 +1,71 @@
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/FactInterner.h"
+
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+
+#include "llvm/IR/Value.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace psr;
+
+TEST(FactInterner, StableDenseIDs) {
+  FactInterner<int> Interner;
+  EXPECT_EQ(Interner.size(), 0U);
+  // enough facts to grow the index several times
+  for (int I = 0; I < 1000; ++I) {
+    EXPECT_EQ(Interner.getOrCreateID(I * 7), static_cast<uint32_t>(I));
+  }
+  EXPECT_EQ(Interner.size(), 1000U);
+  for (int I = 999; I >= 0; --I) {
+    EXPECT_EQ(Interner.getOrCreateID(I * 7), static_cast<uint32_t>(I));
+    EXPECT_EQ(Interner.getID(I * 7), static_cast<uint32_t>(I));
+  }
+  EXPECT_EQ(Interner.size(), 1000U);
+}
+
+TEST(FactInterner, RoundTrip) {
+  FactInterner<std::string> Interner;
+  std::vector<std::string> Facts{"a", "b", "", "a.b", "b.a"};
+  std::vector<FactInterner<std::string>::IdType> IDs;
+  for (const auto &Fact : Facts) {
+    IDs.push_back(Interner.getOrCreateID(Fact));
+  }
+  for (size_t I = 0; I < Facts.size(); ++I) {
+    EXPECT_EQ(Interner.getFact(IDs[I]), Facts[I]);
+    EXPECT_EQ(Interner.getID(Interner.getFact(IDs[I])), IDs[I]);
+  }
+  EXPECT_EQ(Interner.getID("c"), FactInterner<std::string>::None);
+  Interner.clear();
+  EXPECT_EQ(Interner.size(), 0U);
+  EXPECT_EQ(Interner.getID("a"), FactInterner<std::string>::None);
+  EXPECT_EQ(Interner.getOrCreateID("b"), 0U);
+}
+
+TEST(FactInterner, ZeroFact) {
+  FactInterner<const llvm::Value *> Interner;
+  const llvm::Value *Zero = LLVMZeroValue::getInstance();
+  EXPECT_EQ(Interner.getID(Zero), FactInterner<const llvm::Value *>::None);
+  // the solvers intern the zero value first, so it gets ID 0
+  EXPECT_EQ(Interner.getOrCreateID(Zero), 0U);
+  // pointer facts whose low bits are zero must not collide with it
+  std::vector<std::unique_ptr<int>> Objects;
+  for (int I = 0; I < 100; ++I) {
+    Objects.push_back(std::make_unique<int>(I));
+    Interner.getOrCreateID(
+        reinterpret_cast<const llvm::Value *>(Objects.back().get()));
+  }
+  EXPECT_EQ(Interner.getID(Zero), 0U);
+  EXPECT_EQ(Interner.getFact(0), Zero);
+  EXPECT_TRUE(LLVMZeroValue::getInstance()->isLLVMZeroValue(
+      Interner.getFact(Interner.getOrCreateID(Zero))));
+  EXPECT_EQ(Interner.size(), 101U);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,12 +1,24 @@
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <map>
 #include <memory>
 #include <tuple>
 
 #include "gtest/gtest.h"
 
+#include "llvm/ADT/SmallString.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/Support/FileSystem.h"
+
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/DemandDrivenAnalysis.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IDELinearConstantAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/ESGEdgeLog.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IDESolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
@@ -29,8 +41,12 @@ protected:
 
   void SetUp() override { boost::log::core::get()->set_logging_enabled(false); }
 
+  template <template <typename, typename, typename> class TableTy = Table>
   IDELinearConstantAnalysis::lca_results_t
-  doAnalysis(const std::string &LlvmFilePath, bool PrintDump = false) {
+  doAnalysis(const std::string &LlvmFilePath, bool PrintDump = false,
+             const std::function<void(IFDSIDESolverConfig &)> &Configure =
+                 nullptr,
+             bool *Complete = nullptr) {
     auto IR_Files = {PathToLlFiles + LlvmFilePath};
     IRDB = std::make_unique<ProjectIRDB>(IR_Files, IRDBOptions::WPA);
     ValueAnnotationPass::resetValueID();
@@ -45,8 +61,16 @@ protected:
         IRDB.get(), &TH, &ICFG, &PT,
         {hasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str()
                        : "main"});
-    IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+    if (Configure) {
+      Configure(LCAProblem.getIFDSIDESolverConfig());
+    }
+    IDESolver<IDELinearConstantAnalysis::ProblemAnalysisDomain,
+              IDELinearConstantAnalysis::container_type, TableTy>
+        LCASolver(LCAProblem);
     LCASolver.solve();
+    if (Complete) {
+      *Complete = LCASolver.getSolverResults().isComplete();
+    }
     if (PrintDump) {
       IRDB->print();
       ICFG.print();
@@ -57,6 +81,19 @@ protected:
 
   void TearDown() override {}
 
+  static std::set<LCACompactResult_t>
+  flattenResults(const IDELinearConstantAnalysis::lca_results_t &Results) {
+    std::set<LCACompactResult_t> Flat;
+    for (const auto &[FName, Lines] : Results) {
+      for (const auto &[Line, Result] : Lines) {
+        for (const auto &[Var, Val] : Result.variableToValue) {
+          Flat.emplace(FName, Line, Var, Val);
+        }
+      }
+    }
+    return Flat;
+  }
+
   /**
    * We map instruction id to value for the ground truth. ID has to be
    * a string since Argument ID's are not integer type (e.g. main.0 for argc).
@@ -329,6 +366,292 @@ TEST_F(IDELinearConstantAnalysisTest, HandleLoopTest_05) {
   EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
 }
 
+/* ============== WORKLIST POLICY TESTS ============== */
+TEST_F(IDELinearConstantAnalysisTest, HandleLoopTestLIFO) {
+  auto Results = doAnalysis("while_03_cpp_dbg.ll", false, [](auto &Config) {
+    Config.setWorklistPolicy(WorklistPolicy::LIFO);
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  GroundTruth.emplace("main", 7, "a", 13);
+  GroundTruth.emplace("main", 8, "a", 13);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleLoopTestRPO) {
+  auto Results = doAnalysis("while_03_cpp_dbg.ll", false, [](auto &Config) {
+    Config.setWorklistPolicy(WorklistPolicy::ReversePostOrder);
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  GroundTruth.emplace("main", 7, "a", 13);
+  GroundTruth.emplace("main", 8, "a", 13);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleRecursionTestRPO) {
+  auto Results =
+      doAnalysis("recursion_03_cpp_dbg.ll", false, [](auto &Config) {
+        Config.setWorklistPolicy(WorklistPolicy::ReversePostOrder);
+      });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 9, "a", 1);
+  GroundTruth.emplace("main", 10, "a", 1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z3fooj"].find(1) == Results["_Z3fooj"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleLoopTestConcurrent) {
+  auto Results = doAnalysis("while_03_cpp_dbg.ll", false,
+                            [](auto &Config) { Config.setNumThreads(4); });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  GroundTruth.emplace("main", 7, "a", 13);
+  GroundTruth.emplace("main", 8, "a", 13);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleRecursionTestConcurrent) {
+  auto Results = doAnalysis("recursion_03_cpp_dbg.ll", false,
+                            [](auto &Config) { Config.setNumThreads(4); });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 9, "a", 1);
+  GroundTruth.emplace("main", 10, "a", 1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z3fooj"].find(1) == Results["_Z3fooj"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestConcurrentExitJoin) {
+  // pick's exit edge is processed with the value of one branch first and
+  // re-propagated with the join of both branches, which is not constant; the
+  // second call site applies the end summary that has been stored
+  auto Sequential = flattenResults(doAnalysis("call_13_cpp_dbg.ll"));
+  for (const auto &[FName, Line, Var, Val] : Sequential) {
+    EXPECT_FALSE(FName == "main" && (Var == "a" || Var == "b"))
+        << Var << " = " << Val << " at line " << Line;
+  }
+  auto Concurrently = [](auto &Config) { Config.setNumThreads(4); };
+  for (unsigned Run = 0; Run < 10; ++Run) {
+    auto Results = doAnalysis("call_13_cpp_dbg.ll", false, Concurrently);
+    EXPECT_EQ(flattenResults(Results), Sequential);
+  }
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleLoopTestDenseJumpFunctions) {
+  auto Results = doAnalysis("while_03_cpp_dbg.ll", false, [](auto &Config) {
+    Config.setDenseJumpFunctions();
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  GroundTruth.emplace("main", 7, "a", 13);
+  GroundTruth.emplace("main", 8, "a", 13);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestDenseJumpFunctions) {
+  auto Results = doAnalysis("call_06_cpp_dbg.ll", false, [](auto &Config) {
+    Config.setDenseJumpFunctions();
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z9incrementi", 1, "a", 42);
+  GroundTruth.emplace("_Z9incrementi", 2, "a", 43);
+
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 43);
+  GroundTruth.emplace("main", 8, "i", 43);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleLoopTestFlatTable) {
+  auto Results = doAnalysis<FlatTable>("while_03_cpp_dbg.ll");
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 2, "i", 42);
+  GroundTruth.emplace("main", 7, "a", 13);
+  GroundTruth.emplace("main", 8, "a", 13);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["main"].find(4) == Results["main"].end());
+  EXPECT_TRUE(Results["main"].find(6) == Results["main"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestFlatTable) {
+  auto Results = doAnalysis<FlatTable>("call_06_cpp_dbg.ll");
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z9incrementi", 1, "a", 42);
+  GroundTruth.emplace("_Z9incrementi", 2, "a", 43);
+
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 43);
+  GroundTruth.emplace("main", 8, "i", 43);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestRetireJumpFunctions) {
+  auto Results = doAnalysis("call_06_cpp_dbg.ll", false, [](auto &Config) {
+    Config.setRetireJumpFunctions();
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z9incrementi", 1, "a", 42);
+  GroundTruth.emplace("_Z9incrementi", 2, "a", 43);
+
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 43);
+  GroundTruth.emplace("main", 8, "i", 43);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleRecursionTestRetireJumpFunctions) {
+  auto Results =
+      doAnalysis("recursion_03_cpp_dbg.ll", false, [](auto &Config) {
+        Config.setRetireJumpFunctions();
+        Config.setDenseJumpFunctions();
+      });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("main", 9, "a", 1);
+  GroundTruth.emplace("main", 10, "a", 1);
+  compareResults(Results, GroundTruth);
+  EXPECT_TRUE(Results["_Z3fooj"].find(1) == Results["_Z3fooj"].end());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestESGEdgeLog) {
+  const std::string LogPath = "call_06_cpp_dbg.esglog";
+  auto Results = doAnalysis("call_06_cpp_dbg.ll", false, [&](auto &Config) {
+    Config.setESGLogFile(LogPath);
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z9incrementi", 1, "a", 42);
+  GroundTruth.emplace("_Z9incrementi", 2, "a", 43);
+
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 43);
+  GroundTruth.emplace("main", 8, "i", 43);
+  compareResults(Results, GroundTruth);
+  ESGEdgeLog Log = ESGEdgeLog::read(LogPath);
+  EXPECT_FALSE(Log.Records.empty());
+  std::set<ESGEdgeKind> Kinds;
+  std::set<std::string> Functions;
+  for (const auto &Record : Log.Records) {
+    Kinds.insert(Record.Kind);
+    Functions.insert(Log.Nodes[Record.SourceNode].Function);
+  }
+  EXPECT_EQ(Kinds, (std::set<ESGEdgeKind>{
+                       ESGEdgeKind::Normal, ESGEdgeKind::CallToReturn,
+                       ESGEdgeKind::Call, ESGEdgeKind::Return}));
+  EXPECT_TRUE(Functions.count("main"));
+  EXPECT_TRUE(Functions.count("_Z9incrementi"));
+  std::remove(LogPath.c_str());
+  std::remove((LogPath + ".names").c_str());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestSolverProfile) {
+  const std::string ProfilePath = "call_06_cpp_dbg.profile.json";
+  auto Results = doAnalysis("call_06_cpp_dbg.ll", false, [&](auto &Config) {
+    Config.setProfileFile(ProfilePath);
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z9incrementi", 1, "a", 42);
+  GroundTruth.emplace("_Z9incrementi", 2, "a", 43);
+
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 43);
+  GroundTruth.emplace("main", 8, "i", 43);
+  compareResults(Results, GroundTruth);
+  std::ifstream ProfileFile(ProfilePath);
+  ASSERT_TRUE(ProfileFile.good());
+  nlohmann::json Profile;
+  ProfileFile >> Profile;
+  std::map<std::string, nlohmann::json> Functions;
+  for (const auto &Fun : Profile["Functions"]) {
+    Functions[Fun["Name"].get<std::string>()] = Fun;
+  }
+  ASSERT_TRUE(Functions.count("main"));
+  ASSERT_TRUE(Functions.count("_Z9incrementi"));
+  EXPECT_GT(Functions["_Z9incrementi"]["PathEdges"].get<uint64_t>(), 0U);
+  EXPECT_TRUE(Functions["_Z9incrementi"]["CallSites"].empty());
+  const auto &CallSites = Functions["main"]["CallSites"];
+  ASSERT_FALSE(CallSites.empty());
+  uint64_t CallSitePathEdges = 0;
+  for (const auto &Site : CallSites) {
+    CallSitePathEdges += Site["PathEdges"].get<uint64_t>();
+  }
+  EXPECT_GE(Functions["main"]["PathEdges"].get<uint64_t>(),
+            CallSitePathEdges);
+  EXPECT_GT(Functions["main"]["Compositions"].get<uint64_t>(), 0U);
+  std::ifstream StacksFile(ProfilePath + ".folded");
+  EXPECT_TRUE(StacksFile.good());
+  std::remove(ProfilePath.c_str());
+  std::remove((ProfilePath + ".folded").c_str());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestBudget) {
+  bool Complete = false;
+  auto Full = flattenResults(
+      doAnalysis("call_06_cpp_dbg.ll", false, nullptr, &Complete));
+  EXPECT_TRUE(Complete);
+  SolverBudget Budget;
+  Budget.MaxWorkItems = 8;
+  auto Partial = flattenResults(doAnalysis(
+      "call_06_cpp_dbg.ll", false,
+      [&](auto &Config) { Config.setBudget(Budget); }, &Complete));
+  EXPECT_FALSE(Complete);
+  EXPECT_LT(Partial.size(), Full.size());
+  EXPECT_TRUE(std::includes(Full.begin(), Full.end(), Partial.begin(),
+                            Partial.end()));
+  // a cancelled solver stops before processing any path edge
+  Budget = SolverBudget();
+  Budget.Cancellation.emplace();
+  Budget.Cancellation->cancel();
+  auto Cancelled = doAnalysis(
+      "call_06_cpp_dbg.ll", false,
+      [&](auto &Config) { Config.setBudget(Budget); }, &Complete);
+  EXPECT_FALSE(Complete);
+  EXPECT_TRUE(flattenResults(Cancelled).empty());
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestCheckpoint) {
+  llvm::SmallString<128> CheckpointFile;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("phasar-checkpoint", "bin",
+                                                  CheckpointFile));
+  bool Complete = false;
+  auto Full = flattenResults(
+      doAnalysis("call_06_cpp_dbg.ll", false, nullptr, &Complete));
+  EXPECT_TRUE(Complete);
+  SolverBudget Budget;
+  Budget.MaxWorkItems = 8;
+  doAnalysis(
+      "call_06_cpp_dbg.ll", false,
+      [&](auto &Config) {
+        Config.setCheckpointFile(CheckpointFile.str().str());
+        Config.setBudget(Budget);
+      },
+      &Complete);
+  EXPECT_FALSE(Complete);
+  auto CP = SolverCheckpoint::read(CheckpointFile.str().str());
+  EXPECT_EQ(CP.AnalysisID, "ide-lca");
+  EXPECT_FALSE(CP.Labels.empty());
+  EXPECT_FALSE(CP.Worklist.empty());
+  // the edge functions are restored from their summary strings
+  auto Resumed = flattenResults(doAnalysis(
+      "call_06_cpp_dbg.ll", false,
+      [&](auto &Config) {
+        Config.setCheckpointFile(CheckpointFile.str().str());
+        Config.setResumeFromCheckpoint();
+      },
+      &Complete));
+  EXPECT_TRUE(Complete);
+  EXPECT_EQ(Resumed, Full);
+  CP = SolverCheckpoint::read(CheckpointFile.str().str());
+  EXPECT_TRUE(CP.Worklist.empty());
+  llvm::sys::fs::remove(CheckpointFile);
+}
+
 /* ============== CALL TESTS ============== */
 TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_01) {
   auto Results = doAnalysis("call_01_cpp_dbg.ll");
@@ -410,6 +733,126 @@ TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_07) {
               Results["_Z9incrementi"].end());
 }
 
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_07_DemandDriven) {
+  auto IR_Files = {PathToLlFiles + "call_07_cpp_dbg.ll"};
+  IRDB = std::make_unique<ProjectIRDB>(IR_Files, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  LLVMTypeHierarchy TH(*IRDB);
+  LLVMPointsToSet PT(*IRDB);
+  LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                     Soundness::Soundy, /*IncludeGlobals*/ true);
+  auto hasGlobalCtor = IRDB->getFunctionDefinition(
+                           LLVMBasedICFG::GlobalCRuntimeModelName) != nullptr;
+  std::set<std::string> EntryPoints = {
+      hasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str() : "main"};
+  IDELinearConstantAnalysis LCAProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                       EntryPoints);
+  IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+  LCASolver.solve();
+  DemandDrivenAnalysis<IDESolver_P<IDELinearConstantAnalysis>,
+                       IDELinearConstantAnalysis>
+      DDA(*IRDB, EntryPoints, &PT, &ICFG, &TH);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  const auto *Increment = IRDB->getFunctionDefinition("_Z9incrementi");
+  // a query at main's entry does not need to explore the rest of main
+  EXPECT_EQ(DDA.resultsAt(&Main->front().front()),
+            LCASolver.resultsAt(&Main->front().front(), true));
+  size_t NumRelevantAtEntry = DDA.getNumRelevantNodes();
+  for (const auto &I : llvm::instructions(Main)) {
+    EXPECT_EQ(DDA.resultsAt(&I), LCASolver.resultsAt(&I, true));
+  }
+  for (const auto &I : llvm::instructions(Increment)) {
+    EXPECT_EQ(DDA.resultsAt(&I), LCASolver.resultsAt(&I, true));
+  }
+  EXPECT_LT(NumRelevantAtEntry, DDA.getNumRelevantNodes());
+  // the helper analyses are owned by this test
+  DDA.releaseAllHelperAnalyses();
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_07_LazyValues) {
+  auto IR_Files = {PathToLlFiles + "call_07_cpp_dbg.ll"};
+  IRDB = std::make_unique<ProjectIRDB>(IR_Files, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  LLVMTypeHierarchy TH(*IRDB);
+  LLVMPointsToSet PT(*IRDB);
+  LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                     Soundness::Soundy, /*IncludeGlobals*/ true);
+  auto hasGlobalCtor = IRDB->getFunctionDefinition(
+                           LLVMBasedICFG::GlobalCRuntimeModelName) != nullptr;
+  std::set<std::string> EntryPoints = {
+      hasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str() : "main"};
+  IDELinearConstantAnalysis LCAProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                       EntryPoints);
+  IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+  LCASolver.solve();
+  IDELinearConstantAnalysis LazyProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                        EntryPoints);
+  LazyProblem.getIFDSIDESolverConfig().setLazyValues();
+  IDESolver_P<IDELinearConstantAnalysis> LazySolver(LazyProblem);
+  LazySolver.solve();
+  // the values are computed at the queried nodes only
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  for (const auto &I : llvm::instructions(Main)) {
+    EXPECT_EQ(LazySolver.resultsAt(&I, true), LCASolver.resultsAt(&I, true));
+  }
+  // and at all other nodes once all results are looked at
+  EXPECT_EQ(
+      flattenResults(LazyProblem.getLCAResults(LazySolver.getSolverResults())),
+      flattenResults(LCAProblem.getLCAResults(LCASolver.getSolverResults())));
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestLazyValuesRetired) {
+  auto Results = doAnalysis("call_06_cpp_dbg.ll", false, [](auto &Config) {
+    Config.setLazyValues();
+    Config.setRetireJumpFunctions();
+  });
+  std::set<LCACompactResult_t> GroundTruth;
+  GroundTruth.emplace("_Z9incrementi", 1, "a", 42);
+  GroundTruth.emplace("_Z9incrementi", 2, "a", 43);
+
+  GroundTruth.emplace("main", 6, "i", 42);
+  GroundTruth.emplace("main", 7, "i", 43);
+  GroundTruth.emplace("main", 8, "i", 43);
+  compareResults(Results, GroundTruth);
+}
+
+TEST_F(IDELinearConstantAnalysisTest, HandleCallTestLazyValuesRetiredQueries) {
+  auto IR_Files = {PathToLlFiles + "call_06_cpp_dbg.ll"};
+  IRDB = std::make_unique<ProjectIRDB>(IR_Files, IRDBOptions::WPA);
+  ValueAnnotationPass::resetValueID();
+  LLVMTypeHierarchy TH(*IRDB);
+  LLVMPointsToSet PT(*IRDB);
+  LLVMBasedICFG ICFG(*IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PT,
+                     Soundness::Soundy, /*IncludeGlobals*/ true);
+  auto hasGlobalCtor = IRDB->getFunctionDefinition(
+                           LLVMBasedICFG::GlobalCRuntimeModelName) != nullptr;
+  std::set<std::string> EntryPoints = {
+      hasGlobalCtor ? LLVMBasedICFG::GlobalCRuntimeModelName.str() : "main"};
+  IDELinearConstantAnalysis LCAProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                       EntryPoints);
+  IDESolver_P<IDELinearConstantAnalysis> LCASolver(LCAProblem);
+  LCASolver.solve();
+  IDELinearConstantAnalysis LazyProblem(IRDB.get(), &TH, &ICFG, &PT,
+                                        EntryPoints);
+  LazyProblem.getIFDSIDESolverConfig().setLazyValues();
+  LazyProblem.getIFDSIDESolverConfig().setRetireJumpFunctions();
+  IDESolver_P<IDELinearConstantAnalysis> LazySolver(LazyProblem);
+  LazySolver.solve();
+  // each query re-tabulates the function of the queried node, the callee
+  // first, whose values depend on the ones at its call site in main
+  for (const auto *Name : {"_Z9incrementi", "main"}) {
+    const auto *F = IRDB->getFunctionDefinition(Name);
+    ASSERT_NE(F, nullptr);
+    for (const auto &I : llvm::instructions(F)) {
+      EXPECT_EQ(LazySolver.resultsAt(&I, true), LCASolver.resultsAt(&I, true))
+          << "at " << llvmIRToString(&I);
+    }
+  }
+  EXPECT_EQ(
+      flattenResults(LazyProblem.getLCAResults(LazySolver.getSolverResults())),
+      flattenResults(LCAProblem.getLCAResults(LCASolver.getSolverResults())));
+}
+
 TEST_F(IDELinearConstantAnalysisTest, HandleCallTest_08) {
   auto Results = doAnalysis("call_08_cpp_dbg.ll");
   std::set<LCACompactResult_t> GroundTruth;
@@ -279,6 +279,39 @@ TEST_F(IFDSConstAnalysisTest, HandleCallReturnTest_03) {
   compareResults({0}, Llvmconstsolver);
 }
 
+/* ============== RESULT QUERY TESTS ============== */
+TEST_F(IFDSConstAnalysisTest, ResultsViewMatchesResultsAt) {
+  initialize({PathToLlFiles + "call/param/call_param_07_cpp_m2r_dbg.ll"});
+  IFDSSolver_P<IFDSConstAnalysis> Llvmconstsolver(*Constproblem);
+  Llvmconstsolver.solve();
+  for (const auto *F : IRDB->getAllFunctions()) {
+    size_t NumVisited = 0;
+    Llvmconstsolver.foreachResultIn(
+        F,
+        [&](const llvm::Instruction *Inst, const llvm::Value *Fact,
+            BinaryDomain Value) {
+          EXPECT_EQ(Llvmconstsolver.resultAt(Inst, Fact), Value);
+          EXPECT_FALSE(Constproblem->isZeroValue(Fact));
+          ++NumVisited;
+        },
+        /*StripZero*/ true);
+    size_t NumResults = 0;
+    for (const auto *Inst : ICFG->getAllInstructionsOf(F)) {
+      auto Results = Llvmconstsolver.resultsAt(Inst, /*StripZero*/ true);
+      size_t NumViewed = 0;
+      for (const auto &[Fact, Value] :
+           Llvmconstsolver.resultsViewAt(Inst, /*StripZero*/ true)) {
+        ASSERT_TRUE(Results.count(Fact));
+        EXPECT_EQ(Results.at(Fact), Value);
+        ++NumViewed;
+      }
+      EXPECT_EQ(Results.size(), NumViewed);
+      NumResults += NumViewed;
+    }
+    EXPECT_EQ(NumResults, NumVisited);
+  }
+}
+
 /* ============== ARRAY TESTS ============== */
 TEST_F(IFDSConstAnalysisTest, HandleArrayTest_01) {
   initialize({PathToLlFiles + "array/array_01_cpp_m2r_dbg.ll"});
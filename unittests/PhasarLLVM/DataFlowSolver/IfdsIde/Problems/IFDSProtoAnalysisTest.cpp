@@ -0,0 +1,126 @@
+#include <map>
+#include <memory>
+#include <set>
+
+#include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/LLVMZeroValue.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSProtoAnalysis.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
+#include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
+#include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "phasar/Utils/LLVMShorthands.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "gtest/gtest.h"
+
+#include "TestConfig.h"
+
+using namespace std;
+using namespace psr;
+
+/* ============== TEST FIXTURE ============== */
+
+// IFDSProtoAnalysis generates the pointer operand of each store. Its flow
+// functions have no side effects, so it can be solved with several threads.
+class IFDSProtoAnalysisTest : public ::testing::Test {
+protected:
+  const std::string PathToLlFiles =
+      unittest::PathToLLTestFiles + "linear_constant/";
+
+  using ResultsTy =
+      map<const llvm::Instruction *, set<IFDSProtoAnalysis::d_t>>;
+
+  unique_ptr<ProjectIRDB> IRDB;
+  unique_ptr<LLVMTypeHierarchy> TH;
+  unique_ptr<LLVMBasedICFG> ICFG;
+  unique_ptr<LLVMPointsToInfo> PT;
+  set<string> EntryPoints;
+
+  IFDSProtoAnalysisTest() = default;
+  ~IFDSProtoAnalysisTest() override = default;
+
+  void initialize(const std::string &IRFile, set<string> EPs) {
+    IRDB = make_unique<ProjectIRDB>(vector<string>{PathToLlFiles + IRFile},
+                                    IRDBOptions::WPA);
+    EntryPoints = std::move(EPs);
+    TH = make_unique<LLVMTypeHierarchy>(*IRDB);
+    PT = make_unique<LLVMPointsToSet>(*IRDB);
+    ICFG = make_unique<LLVMBasedICFG>(*IRDB, CallGraphAnalysisType::OTF,
+                                      EntryPoints, TH.get(), PT.get());
+  }
+
+  void SetUp() override {
+    boost::log::core::get()->set_logging_enabled(false);
+    ValueAnnotationPass::resetValueID();
+  }
+
+  void TearDown() override {}
+
+  /// Solves the analysis using NumThreads solver threads and returns the
+  /// facts that hold at each instruction of the module.
+  ResultsTy solve(unsigned NumThreads) {
+    IFDSProtoAnalysis Problem(IRDB.get(), TH.get(), ICFG.get(), PT.get(),
+                              EntryPoints);
+    Problem.getIFDSIDESolverConfig().setNumThreads(NumThreads);
+    IFDSSolver_P<IFDSProtoAnalysis> Solver(Problem);
+    Solver.solve();
+    ResultsTy Results;
+    for (const auto *F : IRDB->getAllFunctions()) {
+      for (const auto &I : llvm::instructions(F)) {
+        Results[&I] = Solver.ifdsResultsAt(&I);
+      }
+    }
+    return Results;
+  }
+}; // Test Fixture
+
+TEST_F(IFDSProtoAnalysisTest, HandleCallTestConcurrent) {
+  initialize("call_07_cpp_dbg.ll", {"main"});
+  auto Results = solve(4);
+  const auto *Main = IRDB->getFunctionDefinition("main");
+  set<IFDSProtoAnalysis::d_t> Stored;
+  const llvm::Instruction *Exit = nullptr;
+  for (const auto &I : llvm::instructions(Main)) {
+    if (const auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+      Stored.insert(Store->getPointerOperand());
+    }
+    if (llvm::isa<llvm::ReturnInst>(&I)) {
+      Exit = &I;
+    }
+  }
+  ASSERT_NE(Exit, nullptr);
+  set<IFDSProtoAnalysis::d_t> Facts;
+  for (const auto *Fact : Results[Exit]) {
+    if (!LLVMZeroValue::getInstance()->isLLVMZeroValue(Fact)) {
+      Facts.insert(Fact);
+    }
+  }
+  EXPECT_EQ(Facts, Stored);
+  EXPECT_EQ(Results, solve(1));
+}
+
+TEST_F(IFDSProtoAnalysisTest, HandleCallTestConcurrentValues) {
+  // seed every function, such that the values of the nodes of several
+  // functions are computed by different threads in Phase II(ii)
+  initialize("call_11_cpp_dbg.ll", {"main", "_Z3fooi", "_Z3bari"});
+  auto Sequential = solve(1);
+  auto Concurrent = solve(4);
+  for (const auto &[Inst, Facts] : Sequential) {
+    if (llvm::isa<llvm::ReturnInst>(Inst)) {
+      // the zero value and the stored parameters or locals
+      EXPECT_GT(Facts.size(), 1U) << llvmIRToString(Inst);
+    }
+    if (ICFG->isCallSite(Inst) || ICFG->isStartPoint(Inst)) {
+      continue;
+    }
+    EXPECT_EQ(Concurrent[Inst], Facts) << llvmIRToString(Inst);
+  }
+}
+
+// main function for the test case
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
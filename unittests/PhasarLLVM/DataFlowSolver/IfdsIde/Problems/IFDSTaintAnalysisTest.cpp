@@ -4,9 +4,12 @@
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSTaintAnalysis.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
 #include "gtest/gtest.h"
 
 #include "TestConfig.h"
@@ -116,6 +119,43 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_04) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_Native) {
+  initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+  NativeIFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[19] = set<string>{"18"};
+  GroundTruth[24] = set<string>{"23"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSTaintAnalysisTest, TaintTest_04_PersistedSummaries) {
+  llvm::SmallString<128> SummaryDir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("phasar-summaries",
+                                                    SummaryDir));
+  for (int Run = 0; Run < 2; ++Run) {
+    ValueAnnotationPass::resetValueID();
+    initialize({PathToLlFiles + "dummy_source_sink/taint_04_cpp_dbg.ll"});
+    EXPECT_FALSE(TaintProblem->getSummaryAnalysisID().empty());
+    TaintProblem->getIFDSIDESolverConfig().setComputePersistedSummaries();
+    TaintProblem->getIFDSIDESolverConfig().setSummaryStore(
+        SummaryDir.str().str());
+    IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+    TaintSolver.solve();
+    // the leaks are found in main, whose callees' summaries are applied in
+    // the second run
+    map<int, set<string>> GroundTruth;
+    GroundTruth[19] = set<string>{"18"};
+    GroundTruth[24] = set<string>{"23"};
+    compareResults(GroundTruth);
+  }
+  std::error_code EC;
+  llvm::sys::fs::directory_iterator It(SummaryDir, EC);
+  EXPECT_FALSE(EC);
+  EXPECT_NE(It, llvm::sys::fs::directory_iterator());
+  llvm::sys::fs::remove_directories(SummaryDir);
+}
+
 TEST_F(IFDSTaintAnalysisTest, TaintTest_05) {
   initialize({PathToLlFiles + "dummy_source_sink/taint_05_cpp_dbg.ll"});
   IFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
@@ -175,6 +215,17 @@ TEST_F(IFDSTaintAnalysisTest, TaintTest_ExceptionHandling_03) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSTaintAnalysisTest, TaintTest_ExceptionHandling_03_Native) {
+  initialize(
+      {PathToLlFiles + "dummy_source_sink/taint_exception_03_cpp_dbg.ll"});
+  NativeIFDSSolver_P<IFDSTaintAnalysis> TaintSolver(*TaintProblem);
+  TaintSolver.solve();
+  map<int, set<string>> GroundTruth;
+  GroundTruth[11] = set<string>{"10"};
+  GroundTruth[21] = set<string>{"20"};
+  compareResults(GroundTruth);
+}
+
 TEST_F(IFDSTaintAnalysisTest, TaintTest_ExceptionHandling_04) {
   initialize(
       {PathToLlFiles + "dummy_source_sink/taint_exception_04_cpp_dbg.ll"});
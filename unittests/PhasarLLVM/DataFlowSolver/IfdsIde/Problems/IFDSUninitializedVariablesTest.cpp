@@ -1,13 +1,26 @@
+#include <algorithm>
+#include <fstream>
 #include <memory>
 
 #include "phasar/DB/ProjectIRDB.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/IncrementalUpdateAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ModuleWiseAnalysis.h"
+#include "phasar/PhasarLLVM/AnalysisStrategy/ShardedAnalysis.h"
 #include "phasar/PhasarLLVM/ControlFlow/LLVMBasedICFG.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Problems/IFDSUninitializedVariables.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/IFDSSummaryPool.h"
 #include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/IFDSSummaryGenerator.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/NativeIFDSSolver.h"
+#include "phasar/PhasarLLVM/DataFlowSolver/IfdsIde/Solver/SolverCheckpoint.h"
 #include "phasar/PhasarLLVM/Passes/ValueAnnotationPass.h"
 #include "phasar/PhasarLLVM/Pointer/LLVMPointsToSet.h"
 #include "phasar/PhasarLLVM/TypeHierarchy/LLVMTypeHierarchy.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/FileSystem.h"
 #include "gtest/gtest.h"
 
 #include "TestConfig.h"
@@ -111,6 +124,162 @@ TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_SHOULD_LEAK) {
   compareResults(GroundTruth);
 }
 
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_SHOULD_LEAK_Native) {
+  initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+  NativeIFDSSolver Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth;
+  GroundTruth[5] = {"0"};
+  GroundTruth[6] = {"5"};
+  GroundTruth[16] = {"9"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_PersistedSummaries) {
+  llvm::SmallString<128> SummaryDir;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("phasar-summaries",
+                                                    SummaryDir));
+  for (int Run = 0; Run < 2; ++Run) {
+    ValueAnnotationPass::resetValueID();
+    initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+    UninitProblem->getIFDSIDESolverConfig().setComputePersistedSummaries();
+    UninitProblem->getIFDSIDESolverConfig().setSummaryStore(
+        SummaryDir.str().str());
+    IFDSSolver Solver(*UninitProblem);
+    Solver.solve();
+    map<int, set<string>> GroundTruth;
+    if (Run == 0) {
+      GroundTruth[5] = {"0"};
+      GroundTruth[6] = {"5"};
+    }
+    // the second run applies the summaries of addTen(int), whose undef-uses
+    // are not reported again
+    GroundTruth[16] = {"9"};
+    compareResults(GroundTruth);
+  }
+  llvm::sys::fs::remove_directories(SummaryDir);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_Incremental) {
+  llvm::SmallString<128> StateDir;
+  ASSERT_FALSE(
+      llvm::sys::fs::createUniqueDirectory("phasar-incremental", StateDir));
+  using IncrementalUninit =
+      IncrementalUpdateAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                                IFDSUninitializedVariables>;
+  initialize({PathToLlFiles + "incremental_01_c_dbg.ll"});
+  {
+    IncrementalUninit IUA(*IRDB, StateDir.str().str(), EntryPoints);
+    EXPECT_TRUE(IUA.isInitialRun());
+    IUA.solve();
+  }
+  // only maybeUninit(int) has changed, such that the jump functions of
+  // initialized(int) are restored rather than re-tabulated
+  ValueAnnotationPass::resetValueID();
+  initialize({PathToLlFiles + "incremental_02_c_dbg.ll"});
+  IncrementalUninit IUA(*IRDB, StateDir.str().str(), EntryPoints);
+  EXPECT_FALSE(IUA.isInitialRun());
+  EXPECT_EQ(IUA.getChangedFunctions(), std::set<std::string>{"maybeUninit"});
+  EXPECT_TRUE(IUA.getRemovedFunctions().empty());
+  IUA.solve();
+  IFDSSolver Solver(*UninitProblem);
+  Solver.solve();
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      EXPECT_EQ(IUA.resultsAt(&I, true), Solver.resultsAt(&I, true))
+          << "at " << llvmIRToString(&I);
+    }
+  }
+  // the undef-uses are recorded by the flow functions, which the restored
+  // jump functions of initialized(int) have to be replayed for
+  const auto &UndefUses = IUA.getProblem().getAllUndefUses();
+  EXPECT_EQ(UndefUses, UninitProblem->getAllUndefUses());
+  const auto *Initialized = IRDB->getFunctionDefinition("initialized");
+  EXPECT_TRUE(std::any_of(UndefUses.begin(), UndefUses.end(),
+                          [Initialized](const auto &Use) {
+                            return Use.first->getFunction() == Initialized;
+                          }));
+  llvm::sys::fs::remove_directories(StateDir);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_LibrarySummaries) {
+  initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+  IFDSSummaryGenerator<IFDSUninitializedVariables> Generator(
+      SummaryGenerationStrategy::all_and_none, IRDB.get(), TH.get(),
+      ICFG.get(), PT.get(), EntryPoints);
+  auto Pool = std::make_shared<IFDSSummaryPool>();
+  Generator.generateSummaries({IRDB->getFunctionDefinition("addTen")}, *Pool);
+  // addTen(int) returns an undefined value if and only if it is passed one
+  ASSERT_TRUE(Pool->getSummary("addTen", {false}));
+  EXPECT_TRUE(Pool->getSummary("addTen", {false})->empty());
+  ASSERT_TRUE(Pool->getSummary("addTen", {true}));
+  EXPECT_TRUE(Pool->getSummary("addTen", {true})->count("ret"));
+  // the pool survives a round trip through its JSON representation
+  Pool = std::make_shared<IFDSSummaryPool>(
+      IFDSSummaryPool::fromJson(Pool->getAsJson()));
+
+  ValueAnnotationPass::resetValueID();
+  initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+  UninitProblem->getIFDSIDESolverConfig().setLibrarySummaries(Pool);
+  IFDSSolver Solver(*UninitProblem);
+  Solver.solve();
+  // the undef-uses within addTen(int) are not reported as it is not analyzed
+  map<int, set<string>> GroundTruth;
+  GroundTruth[16] = {"9"};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_03_Checkpoint) {
+  llvm::SmallString<128> CheckpointFile;
+  ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("phasar-checkpoint", "bin",
+                                                  CheckpointFile));
+  initialize({PathToLlFiles + "callnoret_c_dbg.ll"});
+  IFDSSolver Solver(*UninitProblem);
+  Solver.solve();
+
+  auto &Config = UninitProblem->getIFDSIDESolverConfig();
+  Config.setCheckpointFile(CheckpointFile.str().str());
+  SolverBudget Budget;
+  Budget.MaxWorkItems = 8;
+  Config.setBudget(Budget);
+  {
+    IFDSSolver Stopped(*UninitProblem);
+    Stopped.solve();
+    EXPECT_FALSE(Stopped.isComplete());
+  }
+  auto CP = SolverCheckpoint::read(CheckpointFile.str().str());
+  EXPECT_EQ(CP.AnalysisID, UninitProblem->getSummaryAnalysisID());
+  EXPECT_EQ(CP.NumPathEdges, 8U);
+  EXPECT_FALSE(CP.Worklist.empty());
+  // a commit that has not been written completely is ignored
+  {
+    std::ofstream File(CheckpointFile.str().str(),
+                       std::ios::binary | std::ios::app);
+    // the segment's size and checksum followed by less than that size
+    const char Segment[] = {16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2};
+    File.write(Segment, sizeof(Segment));
+  }
+  EXPECT_EQ(SolverCheckpoint::read(CheckpointFile.str().str()).Size, CP.Size);
+
+  Config.setBudget({});
+  Config.setResumeFromCheckpoint();
+  IFDSSolver Resumed(*UninitProblem);
+  Resumed.solve();
+  EXPECT_TRUE(Resumed.isComplete());
+  for (const auto *F : IRDB->getAllFunctions()) {
+    for (const auto &I : llvm::instructions(F)) {
+      EXPECT_EQ(Resumed.resultsAt(&I, true), Solver.resultsAt(&I, true))
+          << "at " << llvmIRToString(&I);
+    }
+  }
+  // the resumed run has committed the fixpoint
+  CP = SolverCheckpoint::read(CheckpointFile.str().str());
+  EXPECT_TRUE(CP.Worklist.empty());
+  EXPECT_GT(CP.NumPathEdges, 8U);
+  llvm::sys::fs::remove(CheckpointFile);
+}
+
 TEST_F(IFDSUninitializedVariablesTest, UninitTest_04_SHOULD_NOT_LEAK) {
   initialize({PathToLlFiles + "ctor_default_cpp_dbg.ll"});
   IFDSSolver Solver(*UninitProblem);
@@ -385,6 +554,131 @@ TEST_F(IFDSUninitializedVariablesTest, UninitTest_21_SHOULD_LEAK) {
   // 37 => {17}; actual leak
   compareResults(GroundTruth);
 }
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_21_SHOULD_LEAK_Native) {
+
+  initialize({PathToLlFiles + "virtual_call_cpp_dbg.ll"});
+  NativeIFDSSolver_P<IFDSUninitializedVariables> Solver(*UninitProblem);
+  Solver.solve();
+
+  map<int, set<string>> GroundTruth = {
+      {3, {"0"}}, {8, {"5"}}, {10, {"5"}}, {35, {"34"}}, {37, {"17"}}};
+  compareResults(GroundTruth);
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_22_ModuleWise) {
+  const std::string PathToModules =
+      unittest::PathToLLTestFiles + "module_wise/module_wise_17/";
+  // the modules are not linked
+  ProjectIRDB MWIRDB({PathToModules + "main_c.ll", PathToModules + "src1_c.ll",
+                      PathToModules + "src2_c.ll"},
+                     IRDBOptions::OWNS);
+  ASSERT_EQ(MWIRDB.getNumberOfModules(), 3U);
+  ModuleWiseAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                     IFDSUninitializedVariables>
+      MWA(MWIRDB, EntryPoints, 2);
+  MWA.solve();
+  // the functions that other modules call are summarized
+  const auto *Summaries = MWA.getModuleSummaries();
+  ASSERT_NE(Summaries, nullptr);
+  EXPECT_TRUE(Summaries->containsSummary("addTen"));
+  EXPECT_TRUE(Summaries->containsSummary("identity"));
+  EXPECT_FALSE(Summaries->containsSummary("main"));
+  // returns the names of the facts that hold at the returns of a function
+  auto FactsAtReturn = [&](const std::string &Name) {
+    std::set<std::string> Facts;
+    for (const auto &I :
+         llvm::instructions(MWIRDB.getFunctionDefinition(Name))) {
+      if (llvm::isa<llvm::ReturnInst>(&I)) {
+        for (const auto *Fact : MWA.ifdsResultsAt(&I)) {
+          Facts.insert(Fact->getName().str());
+        }
+      }
+    }
+    return Facts;
+  };
+  // the uninitialized value that main passes to addTen flows through the
+  // callees in the other modules ...
+  EXPECT_TRUE(FactsAtReturn("addTen").count("i"));
+  EXPECT_TRUE(FactsAtReturn("addTen").count("call"));
+  EXPECT_TRUE(FactsAtReturn("identity").count("z"));
+  // ... and back into main, but the initialized one does not
+  auto MainFacts = FactsAtReturn("main");
+  EXPECT_TRUE(MainFacts.count("c"));
+  EXPECT_FALSE(MainFacts.count("d"));
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_22_ModuleWiseCycle) {
+  const std::string PathToModules =
+      unittest::PathToLLTestFiles + "module_wise/module_wise_18/";
+  // src1 and src2 call functions of each other
+  ProjectIRDB MWIRDB({PathToModules + "main_c.ll", PathToModules + "src1_c.ll",
+                      PathToModules + "src2_c.ll"},
+                     IRDBOptions::OWNS);
+  ASSERT_EQ(MWIRDB.getNumberOfModules(), 3U);
+  ModuleWiseAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                     IFDSUninitializedVariables>
+      MWA(MWIRDB, EntryPoints, 2);
+  // the flows along the cycle are not resolved, which affects main as well,
+  // as it calls into the cycle
+  EXPECT_FALSE(MWA.isComplete());
+  EXPECT_EQ(MWA.getIncompleteModules().size(), 3U);
+  MWA.solve();
+  // the uninitialized value that main passes to addTen still flows into it
+  std::set<std::string> Facts;
+  for (const auto &I :
+       llvm::instructions(MWIRDB.getFunctionDefinition("addTen"))) {
+    if (llvm::isa<llvm::ReturnInst>(&I)) {
+      for (const auto *Fact : MWA.ifdsResultsAt(&I)) {
+        Facts.insert(Fact->getName().str());
+      }
+    }
+  }
+  EXPECT_TRUE(Facts.count("i"));
+}
+
+TEST_F(IFDSUninitializedVariablesTest, UninitTest_23_Sharded) {
+  // both functions are entry points, so they are seeded separately
+  const std::set<std::string> ShardEntryPoints = {"main", "addTen"};
+  ProjectIRDB ShardIRDB({PathToLlFiles + "callnoret_c_dbg.ll"},
+                        IRDBOptions::WPA);
+  LLVMTypeHierarchy ShardTH(ShardIRDB);
+  LLVMPointsToSet ShardPT(ShardIRDB, false);
+  LLVMBasedICFG ShardICF(ShardIRDB, CallGraphAnalysisType::OTF,
+                         ShardEntryPoints, &ShardTH, &ShardPT);
+  IFDSUninitializedVariables Problem(&ShardIRDB, &ShardTH, &ShardICF,
+                                     &ShardPT, ShardEntryPoints);
+  IFDSSolver_P<IFDSUninitializedVariables> Solver(Problem);
+  Solver.solve();
+  for (auto Policy : {ShardingPolicy::EntryPoint, ShardingPolicy::Component}) {
+    ShardedAnalysis<IFDSSolver_P<IFDSUninitializedVariables>,
+                    IFDSUninitializedVariables>
+        SA(ShardIRDB, ShardEntryPoints, &ShardPT, &ShardICF, &ShardTH);
+    SA.setShardingPolicy(Policy);
+    SA.setNumThreads(2);
+    SA.solve();
+    SA.releaseAllHelperAnalyses();
+    if (Policy == ShardingPolicy::EntryPoint) {
+      ASSERT_EQ(SA.getNumShards(), 2U);
+      EXPECT_EQ(SA.getShardFunctions(0), std::set<std::string>{"addTen"});
+      EXPECT_EQ(SA.getShardFunctions(1), std::set<std::string>{"main"});
+    } else {
+      // main calls addTen
+      ASSERT_EQ(SA.getNumShards(), 1U);
+      EXPECT_EQ(SA.getShardFunctions(0),
+                (std::set<std::string>{"addTen", "main"}));
+    }
+    EXPECT_TRUE(SA.isComplete());
+    // the merged results are the ones of the whole-program analysis
+    for (const auto &Name : ShardEntryPoints) {
+      for (const auto &I :
+           llvm::instructions(ShardIRDB.getFunctionDefinition(Name))) {
+        EXPECT_EQ(SA.ifdsResultsAt(&I), Solver.ifdsResultsAt(&I));
+      }
+    }
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -1,3 +1,8 @@
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "phasar/Config/Configuration.h"
@@ -58,6 +63,42 @@ TEST(LLVMPointsToSet, Global_01) {
   std::cout << '\n';
 }
 
+TEST(LLVMPointsToSet, ThreadSafe_01) {
+  ProjectIRDB IRDB({unittest::PathToLLTestFiles + "pointers/call_01_cpp.ll"});
+  LLVMPointsToSet PTS(IRDB, false);
+  LLVMTypeHierarchy TH(IRDB);
+  LLVMBasedICFG ICF(IRDB, CallGraphAnalysisType::OTF, {"main"}, &TH, &PTS);
+  std::unordered_map<const llvm::Value *,
+                     std::unordered_set<const llvm::Value *>>
+      Expected;
+  for (const auto *F : IRDB.getAllFunctions()) {
+    for (const auto &BB : *F) {
+      for (const auto &I : BB) {
+        Expected[&I] = *PTS.getPointsToSet(&I);
+      }
+    }
+  }
+  PTS.setThreadSafe();
+  ASSERT_TRUE(PTS.isThreadSafe());
+  std::vector<std::unordered_map<const llvm::Value *,
+                                 std::unordered_set<const llvm::Value *>>>
+      Results(4);
+  std::vector<std::thread> Threads;
+  for (auto &Result : Results) {
+    Threads.emplace_back([&PTS, &Expected, &Result]() {
+      for (const auto &Entry : Expected) {
+        Result[Entry.first] = *PTS.getPointsToSet(Entry.first);
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+  for (const auto &Result : Results) {
+    EXPECT_EQ(Expected, Result);
+  }
+}
+
 int main(int Argc, char **Argv) {
   ::testing::InitGoogleTest(&Argc, Argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "phasar/Utils/FlatTable.h"
+#include "phasar/Utils/Table.h"
+
+using namespace psr;
+
+TEST(FlatTable, insertAndGet) {
+  FlatTable<int, int, std::string> T;
+  EXPECT_TRUE(T.empty());
+  T.insert(1, 2, "a");
+  T.insert(1, 3, "b");
+  T.insert(2, 2, "c");
+  T.insert(1, 2, "d");
+  EXPECT_EQ(T.numCells(), 3U);
+  EXPECT_EQ(T.size(), 2U);
+  EXPECT_TRUE(T.contains(1, 2));
+  EXPECT_FALSE(T.contains(2, 3));
+  EXPECT_EQ(std::as_const(T).get(1, 2), "d");
+  EXPECT_THROW((void)std::as_const(T).get(2, 3), std::out_of_range);
+  T.get(2, 3) += "e";
+  EXPECT_EQ(std::as_const(T).get(2, 3), "e");
+  EXPECT_EQ(T.find(3, 3), nullptr);
+}
+
+TEST(FlatTable, rowAndColumnViews) {
+  FlatTable<int, int, int> T;
+  T.insert(1, 1, 11);
+  T.insert(1, 2, 12);
+  T.insert(2, 2, 22);
+  std::map<int, int> Row;
+  for (const auto &[Col, Val] : T.row(1)) {
+    Row[Col] = Val;
+  }
+  EXPECT_EQ(Row, (std::map<int, int>{{1, 11}, {2, 12}}));
+  EXPECT_TRUE(T.row(3).empty());
+  std::map<int, int> Column;
+  for (const auto &[RowKey, Val] : T.column(2)) {
+    Column[RowKey] = Val;
+  }
+  EXPECT_EQ(Column, (std::map<int, int>{{1, 12}, {2, 22}}));
+  // the column index is kept up to date by insertions
+  T.insert(3, 2, 32);
+  Column.clear();
+  for (const auto &[RowKey, Val] : T.column(2)) {
+    Column[RowKey] = Val;
+  }
+  EXPECT_EQ(Column.size(), 3U);
+  EXPECT_TRUE(T.containsColumn(1));
+  EXPECT_FALSE(T.containsColumn(3));
+}
+
+TEST(FlatTable, remove) {
+  FlatTable<int, int, int> T;
+  for (int Row = 0; Row < 4; ++Row) {
+    for (int Col = 0; Col < 4; ++Col) {
+      T.insert(Row, Col, Row * 10 + Col);
+    }
+  }
+  EXPECT_EQ(T.remove(1, 1), 11);
+  EXPECT_EQ(T.remove(1, 1), 0);
+  T.remove(2);
+  EXPECT_FALSE(T.containsRow(2));
+  EXPECT_EQ(T.size(), 3U);
+  EXPECT_EQ(T.numCells(), 11U);
+  EXPECT_EQ(std::as_const(T).get(3, 3), 33);
+  EXPECT_FALSE(T.contains(2, 0));
+  EXPECT_TRUE(T.containsColumn(0));
+}
+
+TEST(FlatTable, sameCellsAsTable) {
+  std::mt19937 Gen(42);
+  Table<int, int, int> Expected;
+  FlatTable<int, int, int> T;
+  for (int Idx = 0; Idx < 10000; ++Idx) {
+    int Row = Gen() % 64;
+    int Col = Gen() % 64;
+    int Val = Gen() % 100;
+    switch (Gen() % 4) {
+    case 0:
+      Expected.remove(Row, Col);
+      T.remove(Row, Col);
+      break;
+    case 1:
+      Expected.get(Row, Col) += Val;
+      T.get(Row, Col) += Val;
+      break;
+    default:
+      Expected.insert(Row, Col, Val);
+      T.insert(Row, Col, Val);
+      break;
+    }
+  }
+  EXPECT_EQ(Expected.cellSet(), T.cellSet());
+  for (int Row = 0; Row < 64; ++Row) {
+    size_t NumCells = 0;
+    for (const auto &[Col, Val] : T.row(Row)) {
+      EXPECT_EQ(Expected.get(Row, Col), Val);
+      ++NumCells;
+    }
+    EXPECT_EQ(Expected.row(Row).size(), NumCells);
+  }
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include <string>
+#include <tuple>
+
+#include "phasar/Utils/LRUCache.h"
+
+using namespace psr;
+
+TEST(LRUCache, unboundedLookupAndInsert) {
+  LRUCache<int, std::string> C;
+  EXPECT_TRUE(C.empty());
+  EXPECT_EQ(C.lookup(1), nullptr);
+  C.insert(1, "a");
+  C.insert(2, "b");
+  ASSERT_NE(C.lookup(1), nullptr);
+  EXPECT_EQ(*C.lookup(1), "a");
+  *C.lookup(2) += "c";
+  EXPECT_EQ(*C.lookup(2), "bc");
+  EXPECT_EQ(C.size(), 2U);
+  EXPECT_EQ(C.hits(), 4U);
+  EXPECT_EQ(C.misses(), 1U);
+  EXPECT_EQ(C.evictions(), 0U);
+}
+
+TEST(LRUCache, evictLeastRecentlyUsed) {
+  LRUCache<int, int> C(2);
+  C.insert(1, 10);
+  C.insert(2, 20);
+  // touch 1, such that 2 is the least recently used entry
+  EXPECT_NE(C.lookup(1), nullptr);
+  C.insert(3, 30);
+  EXPECT_EQ(C.size(), 2U);
+  EXPECT_EQ(C.evictions(), 1U);
+  EXPECT_EQ(C.lookup(2), nullptr);
+  EXPECT_NE(C.lookup(1), nullptr);
+  EXPECT_NE(C.lookup(3), nullptr);
+  C.setCapacity(1);
+  EXPECT_EQ(C.size(), 1U);
+  EXPECT_NE(C.lookup(3), nullptr);
+  EXPECT_EQ(C.lookup(1), nullptr);
+}
+
+TEST(LRUCache, copyKeepsEntriesAndOrder) {
+  LRUCache<int, int> C(2);
+  C.insert(1, 10);
+  C.insert(2, 20);
+  LRUCache<int, int> D(C);
+  C.insert(3, 30);
+  EXPECT_EQ(C.lookup(1), nullptr);
+  EXPECT_NE(D.lookup(1), nullptr);
+  // 2 is now the least recently used entry of the copy
+  D.insert(3, 30);
+  EXPECT_EQ(D.lookup(2), nullptr);
+  EXPECT_EQ(*D.lookup(1), 10);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include <set>
+#include <string>
+#include <vector>
+
+#include "phasar/Utils/SmallFlatSet.h"
+
+using namespace psr;
+
+TEST(SmallFlatSet, insertKeepsElementsSortedAndUnique) {
+  SmallFlatSet<int> S;
+  EXPECT_TRUE(S.empty());
+  EXPECT_TRUE(S.insert(3).second);
+  EXPECT_TRUE(S.insert(1).second);
+  EXPECT_FALSE(S.insert(3).second);
+  EXPECT_TRUE(S.insert(2).second);
+  EXPECT_EQ(S.size(), 3U);
+  EXPECT_EQ(std::vector<int>(S.begin(), S.end()), (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(*S.insert(2).first, 2);
+  EXPECT_TRUE(S.contains(1));
+  EXPECT_EQ(S.count(4), 0U);
+  EXPECT_EQ(S.find(4), S.end());
+}
+
+TEST(SmallFlatSet, rangeInsertMatchesStdSet) {
+  std::vector<int> Values{9, 4, 7, 4, 1, 12, 0, 7, 3, 15, 2, 9};
+  SmallFlatSet<int, 2> S{5, 3};
+  std::set<int> Expected{5, 3};
+  // both, the element-wise and the merging insertion
+  S.insert(Values.begin(), Values.begin() + 2);
+  Expected.insert(Values.begin(), Values.begin() + 2);
+  S.insert(Values.begin(), Values.end());
+  Expected.insert(Values.begin(), Values.end());
+  EXPECT_EQ(std::vector<int>(S.begin(), S.end()),
+            std::vector<int>(Expected.begin(), Expected.end()));
+  SmallFlatSet<int, 2> FromSet(Expected.begin(), Expected.end());
+  EXPECT_EQ(S, FromSet);
+}
+
+TEST(SmallFlatSet, eraseAndCompare) {
+  SmallFlatSet<std::string> S{"b", "a", "c"};
+  EXPECT_EQ(S.erase("x"), 0U);
+  EXPECT_EQ(S.erase("b"), 1U);
+  EXPECT_EQ(S.size(), 2U);
+  SmallFlatSet<std::string> T{"c", "a"};
+  EXPECT_EQ(S, T);
+  T.erase(T.begin());
+  EXPECT_NE(S, T);
+  EXPECT_TRUE(S < T);
+  T.clear();
+  EXPECT_TRUE(T.empty());
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}
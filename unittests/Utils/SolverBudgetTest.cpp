@@ -0,0 +1,64 @@
+#include "gtest/gtest.h"
+#include <chrono>
+
+#include "phasar/Utils/SolverBudget.h"
+
+using namespace psr;
+
+TEST(SolverBudget, unlimitedBudgetIsNeverExhausted) {
+  SolverBudget Budget;
+  EXPECT_TRUE(Budget.isUnlimited());
+  BudgetMonitor M(Budget);
+  for (unsigned Idx = 0; Idx < 1000; ++Idx) {
+    EXPECT_FALSE(M.step());
+  }
+  EXPECT_FALSE(M.isExhausted());
+  EXPECT_EQ(M.getNumWorkItems(), 1000U);
+}
+
+TEST(SolverBudget, stopAfterMaxWorkItems) {
+  SolverBudget Budget;
+  Budget.MaxWorkItems = 3;
+  EXPECT_FALSE(Budget.isUnlimited());
+  BudgetMonitor M(Budget);
+  EXPECT_FALSE(M.step());
+  EXPECT_FALSE(M.step());
+  EXPECT_FALSE(M.step());
+  EXPECT_TRUE(M.step());
+  EXPECT_TRUE(M.step());
+  EXPECT_EQ(M.exhaustion(), BudgetExhaustion::WorkItems);
+  EXPECT_EQ(M.getNumWorkItems(), 3U);
+}
+
+TEST(SolverBudget, stopOnCancellation) {
+  SolverBudget Budget;
+  Budget.Cancellation.emplace();
+  // copies share the state of the token
+  CancellationToken Token = *Budget.Cancellation;
+  BudgetMonitor M(Budget);
+  EXPECT_FALSE(M.step());
+  Token.cancel();
+  EXPECT_TRUE(M.step());
+  EXPECT_EQ(M.exhaustion(), BudgetExhaustion::Cancelled);
+  EXPECT_EQ(M.getNumWorkItems(), 1U);
+}
+
+TEST(SolverBudget, stopAtDeadlineAndMemoryLimit) {
+  SolverBudget Budget;
+  Budget.TimeLimit = std::chrono::milliseconds(0);
+  BudgetMonitor Late(Budget);
+  // the deadline is checked with the first work item
+  EXPECT_TRUE(Late.step());
+  EXPECT_EQ(Late.exhaustion(), BudgetExhaustion::Deadline);
+  EXPECT_GT(getResidentSetSize(), 0U);
+  Budget = SolverBudget();
+  Budget.MaxResidentSetSize = 1;
+  BudgetMonitor Full(Budget);
+  EXPECT_TRUE(Full.check());
+  EXPECT_EQ(Full.exhaustion(), BudgetExhaustion::Memory);
+}
+
+int main(int Argc, char **Argv) {
+  ::testing::InitGoogleTest(&Argc, Argv);
+  return RUN_ALL_TESTS();
+}